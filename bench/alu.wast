@@ -0,0 +1,73 @@
+;; Integer ALU: a mix of i32 and i64 arithmetic, bitwise and shift operators
+;; on locals, in a single loop.
+(module
+  (global (export "iterations") i32 (i32.const 500000))
+  (func $run (export "run") (param $n i32) (result i32)
+    (local $i i32) (local $x i32) (local $y i32) (local $z i64)
+    i32.const 0x12345678
+    set_local $x
+    i32.const 0x9abcdef0
+    set_local $y
+    i64.const 0x0123456789abcdef
+    set_local $z
+    block $done
+      loop $loop
+        get_local $i
+        get_local $n
+        i32.ge_u
+        br_if $done
+        ;; x = rotl(x ^ (x << 13), 7) + y * 3
+        get_local $x
+        get_local $x
+        i32.const 13
+        i32.shl
+        i32.xor
+        i32.const 7
+        i32.rotl
+        get_local $y
+        i32.const 3
+        i32.mul
+        i32.add
+        set_local $x
+        ;; y = (y >> 5) - (x & 0xff) | popcnt(x)
+        get_local $y
+        i32.const 5
+        i32.shr_u
+        get_local $x
+        i32.const 0xff
+        i32.and
+        i32.sub
+        get_local $x
+        i32.popcnt
+        i32.or
+        set_local $y
+        ;; z = z * 6364136223846793005 + x
+        get_local $z
+        i64.const 6364136223846793005
+        i64.mul
+        get_local $x
+        i64.extend_u/i32
+        i64.add
+        set_local $z
+        get_local $i
+        i32.const 1
+        i32.add
+        set_local $i
+        br $loop
+      end
+    end
+    get_local $x
+    get_local $y
+    i32.xor
+    get_local $z
+    get_local $z
+    i64.const 32
+    i64.shr_u
+    i64.xor
+    i32.wrap/i64
+    i32.xor)
+  (func (export "verify") (result i32)
+    i32.const 1000
+    call $run
+    i32.const 0x50471477
+    i32.eq))
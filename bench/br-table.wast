@@ -0,0 +1,104 @@
+;; br_table: a state machine that dispatches on its state with br_table each
+;; iteration, like a bytecode interpreter loop.
+(module
+  (global (export "iterations") i32 (i32.const 500000))
+  (func $run (export "run") (param $n i32) (result i32)
+    (local $i i32) (local $state i32) (local $acc i32)
+    block $done
+      loop $loop
+        get_local $i
+        get_local $n
+        i32.ge_u
+        br_if $done
+        get_local $i
+        i32.const 1
+        i32.add
+        set_local $i
+        block $next
+          block $s7
+            block $s6
+              block $s5
+                block $s4
+                  block $s3
+                    block $s2
+                      block $s1
+                        block $s0
+                          get_local $state
+                          br_table $s0 $s1 $s2 $s3 $s4 $s5 $s6 $s7 $s0
+                        end
+                        get_local $acc
+                        i32.const 1
+                        i32.add
+                        set_local $acc
+                        i32.const 3
+                        set_local $state
+                        br $next
+                      end
+                      get_local $acc
+                      i32.const 2
+                      i32.shl
+                      set_local $acc
+                      i32.const 6
+                      set_local $state
+                      br $next
+                    end
+                    get_local $acc
+                    i32.const 0x5bd1e995
+                    i32.xor
+                    set_local $acc
+                    i32.const 1
+                    set_local $state
+                    br $next
+                  end
+                  get_local $acc
+                  i32.const 3
+                  i32.shr_u
+                  set_local $acc
+                  get_local $acc
+                  get_local $i
+                  i32.add
+                  i32.const 7
+                  i32.and
+                  set_local $state
+                  br $next
+                end
+                get_local $acc
+                i32.const 17
+                i32.sub
+                set_local $acc
+                i32.const 2
+                set_local $state
+                br $next
+              end
+              get_local $acc
+              i32.const 9
+              i32.rotl
+              set_local $acc
+              i32.const 7
+              set_local $state
+              br $next
+            end
+            get_local $acc
+            get_local $i
+            i32.add
+            set_local $acc
+            i32.const 5
+            set_local $state
+            br $next
+          end
+          get_local $acc
+          i32.const 0x01000193
+          i32.mul
+          set_local $acc
+          i32.const 4
+          set_local $state
+        end
+        br $loop
+      end
+    end
+    get_local $acc)
+  (func (export "verify") (result i32)
+    i32.const 1000
+    call $run
+    i32.const 0xef90e100
+    i32.eq))
@@ -0,0 +1,45 @@
+;; call_indirect: a loop that calls one of eight functions through the table,
+;; picked by the low bits of a running value.
+(module
+  (type $i_i (func (param i32) (result i32)))
+  (func $f0 (type $i_i) get_local 0 i32.const 1 i32.add)
+  (func $f1 (type $i_i) get_local 0 i32.const 3 i32.mul)
+  (func $f2 (type $i_i) get_local 0 i32.const 0x55555555 i32.xor)
+  (func $f3 (type $i_i) get_local 0 i32.const 5 i32.rotl)
+  (func $f4 (type $i_i) get_local 0 i32.const 7 i32.sub)
+  (func $f5 (type $i_i) get_local 0 i32.const 1 i32.shr_u)
+  (func $f6 (type $i_i) get_local 0 i32.const 0x1234 i32.or)
+  (func $f7 (type $i_i) get_local 0 i32.popcnt get_local 0 i32.add)
+  (table anyfunc (elem $f0 $f1 $f2 $f3 $f4 $f5 $f6 $f7))
+  (global (export "iterations") i32 (i32.const 200000))
+  (func $run (export "run") (param $n i32) (result i32)
+    (local $i i32) (local $x i32)
+    i32.const 0x2545f491
+    set_local $x
+    block $done
+      loop $loop
+        get_local $i
+        get_local $n
+        i32.ge_u
+        br_if $done
+        get_local $x
+        get_local $x
+        get_local $i
+        i32.add
+        i32.const 7
+        i32.and
+        call_indirect $i_i
+        set_local $x
+        get_local $i
+        i32.const 1
+        i32.add
+        set_local $i
+        br $loop
+      end
+    end
+    get_local $x)
+  (func (export "verify") (result i32)
+    i32.const 1000
+    call $run
+    i32.const 0x122a8ae2
+    i32.eq))
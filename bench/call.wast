@@ -0,0 +1,29 @@
+;; Calls: naive recursive Fibonacci, so nearly every instruction is a call, a
+;; return or the few ops between them.
+(module
+  (global (export "iterations") i32 (i32.const 27))
+  (func $fib (param $n i32) (result i32)
+    get_local $n
+    i32.const 2
+    i32.lt_u
+    if i32
+      get_local $n
+    else
+      get_local $n
+      i32.const 1
+      i32.sub
+      call $fib
+      get_local $n
+      i32.const 2
+      i32.sub
+      call $fib
+      i32.add
+    end)
+  (func (export "run") (param $n i32) (result i32)
+    get_local $n
+    call $fib)
+  (func (export "verify") (result i32)
+    i32.const 24
+    call $fib
+    i32.const 46368
+    i32.eq))
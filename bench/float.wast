@@ -0,0 +1,110 @@
+;; Floating point: counts the points of a grid that are in the Mandelbrot set,
+;; using f64 multiply, add and compare, with some f32 and conversions mixed in.
+(module
+  (global (export "iterations") i32 (i32.const 96))
+  (func $escape (param $cr f64) (param $ci f64) (result i32)
+    (local $zr f64) (local $zi f64) (local $t f64) (local $k i32)
+    block $done
+      loop $loop
+        get_local $k
+        i32.const 64
+        i32.ge_u
+        br_if $done
+        get_local $zr
+        get_local $zr
+        f64.mul
+        get_local $zi
+        get_local $zi
+        f64.mul
+        f64.add
+        f64.const 4
+        f64.gt
+        br_if $done
+        get_local $zr
+        get_local $zr
+        f64.mul
+        get_local $zi
+        get_local $zi
+        f64.mul
+        f64.sub
+        get_local $cr
+        f64.add
+        set_local $t
+        f64.const 2
+        get_local $zr
+        f64.mul
+        get_local $zi
+        f64.mul
+        get_local $ci
+        f64.add
+        set_local $zi
+        get_local $t
+        set_local $zr
+        get_local $k
+        i32.const 1
+        i32.add
+        set_local $k
+        br $loop
+      end
+    end
+    get_local $k)
+  ;; n is the grid size; the result is the sum of the escape counts
+  (func $run (export "run") (param $n i32) (result i32)
+    (local $x i32) (local $y i32) (local $sum i32) (local $scale f32)
+    f32.const 3
+    get_local $n
+    f32.convert_u/i32
+    f32.div
+    set_local $scale
+    block $y_done
+      loop $y_loop
+        get_local $y
+        get_local $n
+        i32.ge_u
+        br_if $y_done
+        i32.const 0
+        set_local $x
+        block $x_done
+          loop $x_loop
+            get_local $x
+            get_local $n
+            i32.ge_u
+            br_if $x_done
+            get_local $x
+            f32.convert_u/i32
+            get_local $scale
+            f32.mul
+            f64.promote/f32
+            f64.const 2
+            f64.sub
+            get_local $y
+            f32.convert_u/i32
+            get_local $scale
+            f32.mul
+            f64.promote/f32
+            f64.const 1.5
+            f64.sub
+            call $escape
+            get_local $sum
+            i32.add
+            set_local $sum
+            get_local $x
+            i32.const 1
+            i32.add
+            set_local $x
+            br $x_loop
+          end
+        end
+        get_local $y
+        i32.const 1
+        i32.add
+        set_local $y
+        br $y_loop
+      end
+    end
+    get_local $sum)
+  (func (export "verify") (result i32)
+    i32.const 16
+    call $run
+    i32.const 4077
+    i32.eq))
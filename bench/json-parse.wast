@@ -0,0 +1,351 @@
+;; JSON: a recursive descent parser, validating a 2.4k JSON document and
+;; counting its values.
+;;
+;; memory layout:
+;;     0  "true", "false" and "null", 8 bytes apart
+;;  1024  the document, followed by a 0 byte
+(module
+  (memory 1)
+  (data (i32.const 0) "true\00\00\00\00false\00\00\00null")
+  (data (i32.const 1024)
+    "{\n"
+    "  \"name\": \"wabt\",\n"
+    "  \"version\": \"1.0.0-pre\",\n"
+    "  \"description\": \"The WebAssembly Binary Toolkit\",\n"
+    "  \"keywords\": [\n"
+    "    \"wasm\",\n"
+    "    \"webassembly\",\n"
+    "    \"interpreter\",\n"
+    "    \"binary\",\n"
+    "    \"text format\"\n"
+    "  ],\n"
+    "  \"license\": \"Apache-2.0\",\n"
+    "  \"tools\": [\n"
+    "    {\n"
+    "      \"name\": \"wast2wasm\",\n"
+    "      \"input\": \".wast\",\n"
+    "      \"output\": \".wasm\",\n"
+    "      \"flags\": [\n"
+    "        \"-o\",\n"
+    "        \"-v\",\n"
+    "        \"--spec\",\n"
+    "        \"--no-check\"\n"
+    "      ],\n"
+    "      \"stable\": true\n"
+    "    },\n"
+    "    {\n"
+    "      \"name\": \"wasm2wast\",\n"
+    "      \"input\": \".wasm\",\n"
+    "      \"output\": \".wast\",\n"
+    "      \"flags\": [\n"
+    "        \"-o\",\n"
+    "        \"--no-debug-names\",\n"
+    "        \"--generate-names\"\n"
+    "      ],\n"
+    "      \"stable\": true\n"
+    "    },\n"
+    "    {\n"
+    "      \"name\": \"wasm-interp\",\n"
+    "      \"input\": \".wasm\",\n"
+    "      \"output\": null,\n"
+    "      \"flags\": [\n"
+    "        \"--trace\",\n"
+    "        \"--run-all-exports\",\n"
+    "        \"-V\",\n"
+    "        \"-C\"\n"
+    "      ],\n"
+    "      \"stable\": false\n"
+    "    },\n"
+    "    {\n"
+    "      \"name\": \"wasmdump\",\n"
+    "      \"input\": \".wasm\",\n"
+    "      \"output\": null,\n"
+    "      \"flags\": [\n"
+    "        \"-h\",\n"
+    "        \"-x\",\n"
+    "        \"-d\",\n"
+    "        \"-r\"\n"
+    "      ],\n"
+    "      \"stable\": false\n"
+    "    }\n"
+    "  ],\n"
+    "  \"limits\": {\n"
+    "    \"pages\": 65536,\n"
+    "    \"page_size\": 65536,\n"
+    "    \"max_table\": 10000000,\n"
+    "    \"stack\": {\n"
+    "      \"values\": 65536,\n"
+    "      \"frames\": 65536\n"
+    "    }\n"
+    "  },\n"
+    "  \"samples\": [\n"
+    "    0,\n"
+    "    1,\n"
+    "    -1,\n"
+    "    3.14159,\n"
+    "    -0.0025,\n"
+    "    6.02214076e+23,\n"
+    "    1e+100,\n"
+    "    0.5,\n"
+    "    42,\n"
+    "    -0.0,\n"
+    "    123456789,\n"
+    "    2147483647,\n"
+    "    -2147483648\n"
+    "  ],\n"
+    "  \"escapes\": \"tab\\there, newline\\nthere, quote \\\" and backslash "
+    "\\\\ and \\u00e9 and \\u2603\",\n"
+    "  \"matrix\": [\n"
+    "    [\n"
+    "      1,\n"
+    "      0,\n"
+    "      0,\n"
+    "      0\n"
+    "    ],\n"
+    "    [\n"
+    "      0,\n"
+    "      1,\n"
+    "      0,\n"
+    "      0\n"
+    "    ],\n"
+    "    [\n"
+    "      0,\n"
+    "      0,\n"
+    "      1,\n"
+    "      0\n"
+    "    ],\n"
+    "    [\n"
+    "      0.25,\n"
+    "      -0.75,\n"
+    "      150.0,\n"
+    "      1\n"
+    "    ]\n"
+    "  ],\n"
+    "  \"nested\": {\n"
+    "    \"a\": {\n"
+    "      \"b\": {\n"
+    "        \"c\": {\n"
+    "          \"d\": {\n"
+    "            \"e\": [\n"
+    "              true,\n"
+    "              false,\n"
+    "              null,\n"
+    "              {\n"
+    "                \"f\": \"g\"\n"
+    "              }\n"
+    "            ]\n"
+    "          }\n"
+    "        }\n"
+    "      }\n"
+    "    }\n"
+    "  },\n"
+    "  \"empty\": {\n"
+    "    \"object\": {},\n"
+    "    \"array\": [],\n"
+    "    \"string\": \"\"\n"
+    "  },\n"
+    "  \"history\": [\n"
+    "    {\n"
+    "      \"date\": \"2017-01-13\",\n"
+    "      \"event\": \"binary format 0xd\",\n"
+    "      \"files\": 213,\n"
+    "      \"passed\": true\n"
+    "    },\n"
+    "    {\n"
+    "      \"date\": \"2017-03-02\",\n"
+    "      \"event\": \"interpreter rewrite\",\n"
+    "      \"files\": 57,\n"
+    "      \"passed\": true\n"
+    "    },\n"
+    "    {\n"
+    "      \"date\": \"2017-04-21\",\n"
+    "      \"event\": \"C++ conversion\",\n"
+    "      \"files\": 96,\n"
+    "      \"passed\": false\n"
+    "    }\n"
+    "  ]\n"
+    "}\n"
+  )
+  (global (export "iterations") i32 (i32.const 80))
+  (global $pos (mut i32) (i32.const 0))
+  (global $count (mut i32) (i32.const 0))
+
+  (func $peek (result i32)
+    (i32.load8_u (get_global $pos)))
+
+  (func $advance
+    (set_global $pos (i32.add (get_global $pos) (i32.const 1))))
+
+  (func $skip_ws
+    (local $c i32)
+    (loop $loop
+      (set_local $c (call $peek))
+      (if (i32.or (i32.or (i32.eq (get_local $c) (i32.const 0x20))
+                          (i32.eq (get_local $c) (i32.const 0x09)))
+                  (i32.or (i32.eq (get_local $c) (i32.const 0x0a))
+                          (i32.eq (get_local $c) (i32.const 0x0d))))
+        (then
+          (call $advance)
+          (br $loop)))))
+
+  ;; expects the byte |c|, and skips the whitespace after it
+  (func $expect (param $c i32) (result i32)
+    (if (i32.ne (call $peek) (get_local $c))
+      (then (return (i32.const 0))))
+    (call $advance)
+    (call $skip_ws)
+    (i32.const 1))
+
+  (func $is_digit (param $c i32) (result i32)
+    (i32.lt_u (i32.sub (get_local $c) (i32.const 0x30)) (i32.const 10)))
+
+  (func $skip_digits (result i32)
+    (local $start i32)
+    (set_local $start (get_global $pos))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (call $is_digit (call $peek))))
+        (call $advance)
+        (br $loop)))
+    (i32.ne (get_global $pos) (get_local $start)))
+
+  ;; the literal at |p| in memory, |len| bytes long
+  (func $parse_literal (param $p i32) (param $len i32) (result i32)
+    (local $i i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (get_local $len)))
+        (if (i32.ne (call $peek)
+                    (i32.load8_u (i32.add (get_local $p) (get_local $i))))
+          (then (return (i32.const 0))))
+        (call $advance)
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $loop)))
+    (i32.const 1))
+
+  (func $parse_string (result i32)
+    (local $c i32)
+    (if (i32.ne (call $peek) (i32.const 0x22))
+      (then (return (i32.const 0))))
+    (call $advance)
+    (loop $loop
+      (set_local $c (call $peek))
+      (if (i32.eqz (get_local $c))
+        (then (return (i32.const 0))))
+      (call $advance)
+      (if (i32.eq (get_local $c) (i32.const 0x22))
+        (then (return (i32.const 1))))
+      ;; skip the escaped character; \uXXXX is checked as plain characters
+      (if (i32.eq (get_local $c) (i32.const 0x5c))
+        (then
+          (if (i32.eqz (call $peek))
+            (then (return (i32.const 0))))
+          (call $advance)))
+      (br $loop))
+    (unreachable))
+
+  (func $parse_number (result i32)
+    (local $c i32)
+    (if (i32.eq (call $peek) (i32.const 0x2d))
+      (then (call $advance)))
+    (if (i32.eqz (call $skip_digits))
+      (then (return (i32.const 0))))
+    (if (i32.eq (call $peek) (i32.const 0x2e))
+      (then
+        (call $advance)
+        (if (i32.eqz (call $skip_digits))
+          (then (return (i32.const 0))))))
+    (if (i32.eq (i32.or (call $peek) (i32.const 0x20)) (i32.const 0x65))
+      (then
+        (call $advance)
+        (set_local $c (call $peek))
+        (if (i32.or (i32.eq (get_local $c) (i32.const 0x2b))
+                    (i32.eq (get_local $c) (i32.const 0x2d)))
+          (then (call $advance)))
+        (if (i32.eqz (call $skip_digits))
+          (then (return (i32.const 0))))))
+    (i32.const 1))
+
+  (func $parse_array (result i32)
+    (drop (call $expect (i32.const 0x5b)))
+    (if (call $expect (i32.const 0x5d))
+      (then (return (i32.const 1))))
+    (loop $loop
+      (if (i32.eqz (call $parse_value))
+        (then (return (i32.const 0))))
+      (br_if $loop (call $expect (i32.const 0x2c))))
+    (call $expect (i32.const 0x5d)))
+
+  (func $parse_object (result i32)
+    (drop (call $expect (i32.const 0x7b)))
+    (if (call $expect (i32.const 0x7d))
+      (then (return (i32.const 1))))
+    (loop $loop
+      (if (i32.eqz (call $parse_string))
+        (then (return (i32.const 0))))
+      (call $skip_ws)
+      (if (i32.eqz (call $expect (i32.const 0x3a)))
+        (then (return (i32.const 0))))
+      (if (i32.eqz (call $parse_value))
+        (then (return (i32.const 0))))
+      (br_if $loop (call $expect (i32.const 0x2c))))
+    (call $expect (i32.const 0x7d)))
+
+  ;; parses a value and the whitespace after it
+  (func $parse_value (result i32)
+    (local $c i32) (local $ok i32)
+    (set_global $count (i32.add (get_global $count) (i32.const 1)))
+    (set_local $c (call $peek))
+    (block $parsed
+      (block $literal
+        (block $number
+          (block $string
+            (block $array
+              (block $object
+                (br_if $object (i32.eq (get_local $c) (i32.const 0x7b)))
+                (br_if $array (i32.eq (get_local $c) (i32.const 0x5b)))
+                (br_if $string (i32.eq (get_local $c) (i32.const 0x22)))
+                (br_if $number (i32.eq (get_local $c) (i32.const 0x2d)))
+                (br_if $number (call $is_digit (get_local $c)))
+                (br $literal))
+              (set_local $ok (call $parse_object))
+              (br $parsed))
+            (set_local $ok (call $parse_array))
+            (br $parsed))
+          (set_local $ok (call $parse_string))
+          (br $parsed))
+        (set_local $ok (call $parse_number))
+        (br $parsed))
+      (set_local $ok
+        (if i32 (i32.eq (get_local $c) (i32.const 0x74))
+          (then (call $parse_literal (i32.const 0) (i32.const 4)))
+          (else
+            (if i32 (i32.eq (get_local $c) (i32.const 0x66))
+              (then (call $parse_literal (i32.const 8) (i32.const 5)))
+              (else (call $parse_literal (i32.const 16) (i32.const 4))))))))
+    (call $skip_ws)
+    (get_local $ok))
+
+  ;; returns the number of values in the document, or -1 if it is invalid
+  (func $parse (result i32)
+    (set_global $pos (i32.const 1024))
+    (set_global $count (i32.const 0))
+    (call $skip_ws)
+    (if (i32.eqz (call $parse_value))
+      (then (return (i32.const -1))))
+    (if (call $peek)
+      (then (return (i32.const -1))))
+    (get_global $count))
+
+  (func (export "run") (param $n i32) (result i32)
+    (local $i i32) (local $result i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (get_local $n)))
+        (set_local $result (call $parse))
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $loop)))
+    (get_local $result))
+
+  (func (export "verify") (result i32)
+    (i32.eq (call $parse) (i32.const 125))))
@@ -0,0 +1,112 @@
+;; Matrix multiply: C = A * B for 48x48 f64 matrices, with a naive triple
+;; loop. The elements are small integers, so the result is exact.
+;;
+;; memory layout (row-major):
+;;       0  A
+;;   18432  B
+;;   36864  C
+(module
+  (memory 1)
+  (global (export "iterations") i32 (i32.const 3))
+
+  (func $init
+    (local $i i32) (local $j i32) (local $p i32)
+    (block $i_done
+      (loop $i_loop
+        (br_if $i_done (i32.ge_u (get_local $i) (i32.const 48)))
+        (set_local $j (i32.const 0))
+        (block $j_done
+          (loop $j_loop
+            (br_if $j_done (i32.ge_u (get_local $j) (i32.const 48)))
+            ;; A[i][j] = (i + 2j) % 7 - 3, B[i][j] = (3i + j) % 5 - 2
+            (f64.store
+              (get_local $p)
+              (f64.convert_s/i32
+                (i32.sub
+                  (i32.rem_u
+                    (i32.add (get_local $i)
+                             (i32.shl (get_local $j) (i32.const 1)))
+                    (i32.const 7))
+                  (i32.const 3))))
+            (f64.store offset=18432
+              (get_local $p)
+              (f64.convert_s/i32
+                (i32.sub
+                  (i32.rem_u
+                    (i32.add (i32.mul (get_local $i) (i32.const 3))
+                             (get_local $j))
+                    (i32.const 5))
+                  (i32.const 2))))
+            (set_local $p (i32.add (get_local $p) (i32.const 8)))
+            (set_local $j (i32.add (get_local $j) (i32.const 1)))
+            (br $j_loop)))
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $i_loop))))
+
+  (func $multiply
+    (local $i i32) (local $j i32) (local $k i32)
+    (local $a i32) (local $b i32) (local $sum f64)
+    (block $i_done
+      (loop $i_loop
+        (br_if $i_done (i32.ge_u (get_local $i) (i32.const 48)))
+        (set_local $j (i32.const 0))
+        (block $j_done
+          (loop $j_loop
+            (br_if $j_done (i32.ge_u (get_local $j) (i32.const 48)))
+            ;; a = &A[i][0], b = &B[0][j]
+            (set_local $a (i32.mul (get_local $i) (i32.const 384)))
+            (set_local $b (i32.shl (get_local $j) (i32.const 3)))
+            (set_local $sum (f64.const 0))
+            (set_local $k (i32.const 0))
+            (block $k_done
+              (loop $k_loop
+                (br_if $k_done (i32.ge_u (get_local $k) (i32.const 48)))
+                (set_local $sum
+                  (f64.add
+                    (get_local $sum)
+                    (f64.mul (f64.load (get_local $a))
+                             (f64.load offset=18432 (get_local $b)))))
+                (set_local $a (i32.add (get_local $a) (i32.const 8)))
+                (set_local $b (i32.add (get_local $b) (i32.const 384)))
+                (set_local $k (i32.add (get_local $k) (i32.const 1)))
+                (br $k_loop)))
+            (f64.store offset=36864
+              (i32.add (i32.mul (get_local $i) (i32.const 384))
+                       (i32.shl (get_local $j) (i32.const 3)))
+              (get_local $sum))
+            (set_local $j (i32.add (get_local $j) (i32.const 1)))
+            (br $j_loop)))
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $i_loop))))
+
+  ;; sum of C[i][j] * ((48i + j) % 13 + 1)
+  (func $checksum (result i32)
+    (local $n i32) (local $sum f64)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $n) (i32.const 2304)))
+        (set_local $sum
+          (f64.add
+            (get_local $sum)
+            (f64.mul
+              (f64.load offset=36864 (i32.shl (get_local $n) (i32.const 3)))
+              (f64.convert_u/i32
+                (i32.add (i32.rem_u (get_local $n) (i32.const 13))
+                         (i32.const 1))))))
+        (set_local $n (i32.add (get_local $n) (i32.const 1)))
+        (br $loop)))
+    (i32.trunc_s/f64 (get_local $sum)))
+
+  (func (export "run") (param $n i32) (result i32)
+    (local $i i32)
+    (call $init)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (get_local $n)))
+        (call $multiply)
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $loop)))
+    (call $checksum))
+
+  (func (export "verify") (result i32)
+    (i32.eq (call $checksum) (i32.const 154))))
@@ -0,0 +1,86 @@
+;; Memory: fills a 64k buffer with i32 stores, then reads it back with i32,
+;; i64 and byte loads.
+(module
+  (memory 1)
+  (global (export "iterations") i32 (i32.const 24))
+  (func $fill (param $seed i32)
+    (local $p i32)
+    block $done
+      loop $loop
+        get_local $p
+        i32.const 0x10000
+        i32.ge_u
+        br_if $done
+        get_local $p
+        get_local $p
+        get_local $seed
+        i32.mul
+        i32.store
+        get_local $p
+        i32.const 4
+        i32.add
+        set_local $p
+        br $loop
+      end
+    end)
+  (func $sum (result i32)
+    (local $p i32) (local $sum i32) (local $wide i64)
+    block $done
+      loop $loop
+        get_local $p
+        i32.const 0x10000
+        i32.ge_u
+        br_if $done
+        get_local $sum
+        get_local $p
+        i32.load
+        i32.add
+        get_local $p
+        i32.load8_u offset=5
+        i32.add
+        set_local $sum
+        get_local $wide
+        get_local $p
+        i64.load offset=8
+        i64.xor
+        set_local $wide
+        get_local $p
+        i32.const 16
+        i32.add
+        set_local $p
+        br $loop
+      end
+    end
+    get_local $sum
+    get_local $wide
+    i32.wrap/i64
+    i32.add)
+  (func $run (export "run") (param $n i32) (result i32)
+    (local $i i32) (local $sum i32)
+    block $done
+      loop $loop
+        get_local $i
+        get_local $n
+        i32.ge_u
+        br_if $done
+        get_local $i
+        i32.const 0x9e3779b9
+        i32.mul
+        call $fill
+        call $sum
+        get_local $sum
+        i32.add
+        set_local $sum
+        get_local $i
+        i32.const 1
+        i32.add
+        set_local $i
+        br $loop
+      end
+    end
+    get_local $sum)
+  (func (export "verify") (result i32)
+    i32.const 2
+    call $run
+    i32.const 0xea2f7800
+    i32.eq))
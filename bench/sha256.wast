@@ -0,0 +1,210 @@
+;; SHA-256 of a 1000 byte message, hashed again on every iteration.
+;;
+;; memory layout:
+;;     0  K, the 64 round constants
+;;   256  the initial hash value
+;;   288  the expected digest, for verify
+;;   320  the hash value
+;;   512  W, the message schedule
+;;  1024  the message, padded to 16 blocks
+(module
+  (memory 1)
+  (data (i32.const 0)
+    "\98\2f\8a\42\91\44\37\71\cf\fb\c0\b5\a5\db\b5\e9"
+    "\5b\c2\56\39\f1\11\f1\59\a4\82\3f\92\d5\5e\1c\ab"
+    "\98\aa\07\d8\01\5b\83\12\be\85\31\24\c3\7d\0c\55"
+    "\74\5d\be\72\fe\b1\de\80\a7\06\dc\9b\74\f1\9b\c1"
+    "\c1\69\9b\e4\86\47\be\ef\c6\9d\c1\0f\cc\a1\0c\24"
+    "\6f\2c\e9\2d\aa\84\74\4a\dc\a9\b0\5c\da\88\f9\76"
+    "\52\51\3e\98\6d\c6\31\a8\c8\27\03\b0\c7\7f\59\bf"
+    "\f3\0b\e0\c6\47\91\a7\d5\51\63\ca\06\67\29\29\14"
+    "\85\0a\b7\27\38\21\1b\2e\fc\6d\2c\4d\13\0d\38\53"
+    "\54\73\0a\65\bb\0a\6a\76\2e\c9\c2\81\85\2c\72\92"
+    "\a1\e8\bf\a2\4b\66\1a\a8\70\8b\4b\c2\a3\51\6c\c7"
+    "\19\e8\92\d1\24\06\99\d6\85\35\0e\f4\70\a0\6a\10"
+    "\16\c1\a4\19\08\6c\37\1e\4c\77\48\27\b5\bc\b0\34"
+    "\b3\0c\1c\39\4a\aa\d8\4e\4f\ca\9c\5b\f3\6f\2e\68"
+    "\ee\82\8f\74\6f\63\a5\78\14\78\c8\84\08\02\c7\8c"
+    "\fa\ff\be\90\eb\6c\50\a4\f7\a3\f9\be\f2\78\71\c6"
+  )
+  (data (i32.const 256)
+    "\67\e6\09\6a\85\ae\67\bb\72\f3\6e\3c\3a\f5\4f\a5"
+    "\7f\52\0e\51\8c\68\05\9b\ab\d9\83\1f\19\cd\e0\5b"
+  )
+  (data (i32.const 288)
+    "\d5\e7\97\50\50\2f\35\87\e6\2a\06\97\da\7b\f3\79"
+    "\f8\d9\02\58\4c\a1\ab\75\a1\d1\b4\8c\79\a1\ad\88"
+  )
+  (global (export "iterations") i32 (i32.const 64))
+
+  (func $load_be (param $p i32) (result i32)
+    (i32.or
+      (i32.or
+        (i32.shl (i32.load8_u (get_local $p)) (i32.const 24))
+        (i32.shl (i32.load8_u offset=1 (get_local $p)) (i32.const 16)))
+      (i32.or
+        (i32.shl (i32.load8_u offset=2 (get_local $p)) (i32.const 8))
+        (i32.load8_u offset=3 (get_local $p)))))
+
+  (func $init_message
+    (local $i i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (i32.const 1000)))
+        (i32.store8 offset=1024
+          (get_local $i)
+          (i32.add (i32.mul (get_local $i) (i32.const 31)) (i32.const 7)))
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $loop)))
+    ;; the padding: a 1 bit, zeroes, then the length in bits (8000)
+    (i32.store8 (i32.const 2024) (i32.const 0x80))
+    (i32.store8 (i32.const 2046) (i32.const 0x1f))
+    (i32.store8 (i32.const 2047) (i32.const 0x40)))
+
+  (func $block (param $p i32)
+    (local $t i32) (local $w i32) (local $x i32)
+    (local $a i32) (local $b i32) (local $c i32) (local $d i32)
+    (local $e i32) (local $f i32) (local $g i32) (local $h i32)
+    (local $t1 i32) (local $t2 i32)
+    ;; W[0..15] are the block's words
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $t) (i32.const 16)))
+        (i32.store offset=512
+          (i32.shl (get_local $t) (i32.const 2))
+          (call $load_be
+            (i32.add (get_local $p) (i32.shl (get_local $t) (i32.const 2)))))
+        (set_local $t (i32.add (get_local $t) (i32.const 1)))
+        (br $loop)))
+    ;; W[t] = W[t-16] + s0(W[t-15]) + W[t-7] + s1(W[t-2])
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $t) (i32.const 64)))
+        (set_local $w (i32.shl (get_local $t) (i32.const 2)))
+        (set_local $x (i32.load offset=452 (get_local $w)))
+        (set_local $t1
+          (i32.xor
+            (i32.xor (i32.rotr (get_local $x) (i32.const 7))
+                     (i32.rotr (get_local $x) (i32.const 18)))
+            (i32.shr_u (get_local $x) (i32.const 3))))
+        (set_local $x (i32.load offset=504 (get_local $w)))
+        (set_local $t2
+          (i32.xor
+            (i32.xor (i32.rotr (get_local $x) (i32.const 17))
+                     (i32.rotr (get_local $x) (i32.const 19)))
+            (i32.shr_u (get_local $x) (i32.const 10))))
+        (i32.store offset=512
+          (get_local $w)
+          (i32.add
+            (i32.add (i32.load offset=448 (get_local $w)) (get_local $t1))
+            (i32.add (i32.load offset=484 (get_local $w)) (get_local $t2))))
+        (set_local $t (i32.add (get_local $t) (i32.const 1)))
+        (br $loop)))
+
+    (set_local $a (i32.load (i32.const 320)))
+    (set_local $b (i32.load (i32.const 324)))
+    (set_local $c (i32.load (i32.const 328)))
+    (set_local $d (i32.load (i32.const 332)))
+    (set_local $e (i32.load (i32.const 336)))
+    (set_local $f (i32.load (i32.const 340)))
+    (set_local $g (i32.load (i32.const 344)))
+    (set_local $h (i32.load (i32.const 348)))
+    (set_local $t (i32.const 0))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $t) (i32.const 64)))
+        (set_local $w (i32.shl (get_local $t) (i32.const 2)))
+        ;; t1 = h + S1(e) + ch(e, f, g) + K[t] + W[t]
+        (set_local $t1
+          (i32.add
+            (i32.add
+              (get_local $h)
+              (i32.xor
+                (i32.xor (i32.rotr (get_local $e) (i32.const 6))
+                         (i32.rotr (get_local $e) (i32.const 11)))
+                (i32.rotr (get_local $e) (i32.const 25))))
+            (i32.add
+              (i32.xor
+                (i32.and (get_local $e) (get_local $f))
+                (i32.and (i32.xor (get_local $e) (i32.const -1))
+                         (get_local $g)))
+              (i32.add (i32.load (get_local $w))
+                       (i32.load offset=512 (get_local $w))))))
+        ;; t2 = S0(a) + maj(a, b, c)
+        (set_local $t2
+          (i32.add
+            (i32.xor
+              (i32.xor (i32.rotr (get_local $a) (i32.const 2))
+                       (i32.rotr (get_local $a) (i32.const 13)))
+              (i32.rotr (get_local $a) (i32.const 22)))
+            (i32.xor
+              (i32.xor (i32.and (get_local $a) (get_local $b))
+                       (i32.and (get_local $a) (get_local $c)))
+              (i32.and (get_local $b) (get_local $c)))))
+        (set_local $h (get_local $g))
+        (set_local $g (get_local $f))
+        (set_local $f (get_local $e))
+        (set_local $e (i32.add (get_local $d) (get_local $t1)))
+        (set_local $d (get_local $c))
+        (set_local $c (get_local $b))
+        (set_local $b (get_local $a))
+        (set_local $a (i32.add (get_local $t1) (get_local $t2)))
+        (set_local $t (i32.add (get_local $t) (i32.const 1)))
+        (br $loop)))
+
+    (i32.store (i32.const 320)
+               (i32.add (i32.load (i32.const 320)) (get_local $a)))
+    (i32.store (i32.const 324)
+               (i32.add (i32.load (i32.const 324)) (get_local $b)))
+    (i32.store (i32.const 328)
+               (i32.add (i32.load (i32.const 328)) (get_local $c)))
+    (i32.store (i32.const 332)
+               (i32.add (i32.load (i32.const 332)) (get_local $d)))
+    (i32.store (i32.const 336)
+               (i32.add (i32.load (i32.const 336)) (get_local $e)))
+    (i32.store (i32.const 340)
+               (i32.add (i32.load (i32.const 340)) (get_local $f)))
+    (i32.store (i32.const 344)
+               (i32.add (i32.load (i32.const 344)) (get_local $g)))
+    (i32.store (i32.const 348)
+               (i32.add (i32.load (i32.const 348)) (get_local $h))))
+
+  (func $hash
+    (local $i i32) (local $p i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (i32.const 32)))
+        (i32.store offset=320 (get_local $i)
+                   (i32.load offset=256 (get_local $i)))
+        (set_local $i (i32.add (get_local $i) (i32.const 4)))
+        (br $loop)))
+    (set_local $p (i32.const 1024))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $p) (i32.const 2048)))
+        (call $block (get_local $p))
+        (set_local $p (i32.add (get_local $p) (i32.const 64)))
+        (br $loop))))
+
+  (func (export "run") (param $n i32) (result i32)
+    (local $i i32)
+    (call $init_message)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (get_local $i) (get_local $n)))
+        (call $hash)
+        (set_local $i (i32.add (get_local $i) (i32.const 1)))
+        (br $loop)))
+    (i32.load (i32.const 320)))
+
+  (func (export "verify") (result i32)
+    (local $i i32)
+    (block $mismatch
+      (loop $loop
+        (br_if $mismatch
+          (i32.ne (i32.load offset=320 (get_local $i))
+                  (i32.load offset=288 (get_local $i))))
+        (set_local $i (i32.add (get_local $i) (i32.const 4)))
+        (br_if $loop (i32.lt_u (get_local $i) (i32.const 32))))
+      (return (i32.const 1)))
+    (i32.const 0)))
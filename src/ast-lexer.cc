@@ -429,6 +429,8 @@ int ast_lexer_lex(WABT_AST_PARSER_STYPE* lval,
       <i> "module"              { RETURN(MODULE); }
       <i> "table"               { RETURN(TABLE); }
       <i> "memory"              { RETURN(MEMORY); }
+      <i> "memory.copy"         { RETURN(MEMORY_COPY); }
+      <i> "memory.fill"         { RETURN(MEMORY_FILL); }
       <i> "start"               { RETURN(START); }
       <i> "elem"                { RETURN(ELEM); }
       <i> "data"                { RETURN(DATA); }
@@ -192,7 +192,7 @@ static bool on_read_binary_error(uint32_t offset, const char* error,
 %token GET_LOCAL SET_LOCAL TEE_LOCAL GET_GLOBAL SET_GLOBAL
 %token LOAD STORE OFFSET_EQ_NAT ALIGN_EQ_NAT
 %token CONST UNARY BINARY COMPARE CONVERT SELECT
-%token UNREACHABLE CURRENT_MEMORY GROW_MEMORY
+%token UNREACHABLE CURRENT_MEMORY GROW_MEMORY MEMORY_COPY MEMORY_FILL
 %token FUNC START TYPE PARAM RESULT LOCAL GLOBAL
 %token MODULE TABLE ELEM MEMORY DATA OFFSET IMPORT EXPORT
 %token REGISTER INVOKE GET
@@ -573,6 +573,12 @@ plain_instr :
   | GROW_MEMORY {
       $$ = Expr::CreateGrowMemory();
     }
+  | MEMORY_COPY {
+      $$ = Expr::CreateMemoryCopy();
+    }
+  | MEMORY_FILL {
+      $$ = Expr::CreateMemoryFill();
+    }
 ;
 block_instr :
     BLOCK labeling_opt block END labeling_opt {
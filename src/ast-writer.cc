@@ -461,6 +461,14 @@ static void write_expr(Context* ctx, const Expr* expr) {
       write_puts_newline(ctx, get_opcode_name(Opcode::CurrentMemory));
       break;
 
+    case ExprType::MemoryCopy:
+      write_puts_newline(ctx, get_opcode_name(Opcode::MemoryCopy));
+      break;
+
+    case ExprType::MemoryFill:
+      write_puts_newline(ctx, get_opcode_name(Opcode::MemoryFill));
+      break;
+
     case ExprType::Nop:
       write_puts_newline(ctx, get_opcode_name(Opcode::Nop));
       break;
@@ -151,7 +151,7 @@ void make_type_binding_reverse_mapping(
   for (const auto& pair : bindings) {
     assert(static_cast<size_t>(pair.second.index) <
            out_reverse_mapping->size());
-    (*out_reverse_mapping)[pair.second.index] = pair.first;
+    (*out_reverse_mapping)[pair.second.index] = pair.first.str();
   }
 }
 
@@ -292,6 +292,8 @@ Expr::~Expr() {
     case ExprType::CurrentMemory:
     case ExprType::GrowMemory:
     case ExprType::Load:
+    case ExprType::MemoryCopy:
+    case ExprType::MemoryFill:
     case ExprType::Nop:
     case ExprType::Return:
     case ExprType::Select:
@@ -426,6 +428,16 @@ Expr* Expr::CreateLoop(Block* block) {
   return expr;
 }
 
+// static
+Expr* Expr::CreateMemoryCopy() {
+  return new Expr(ExprType::MemoryCopy);
+}
+
+// static
+Expr* Expr::CreateMemoryFill() {
+  return new Expr(ExprType::MemoryFill);
+}
+
 // static
 Expr* Expr::CreateNop() {
   return new Expr(ExprType::Nop);
@@ -844,6 +856,14 @@ static Result visit_expr(Expr* expr, ExprVisitor* visitor) {
       CALLBACK(end_loop_expr);
       break;
 
+    case ExprType::MemoryCopy:
+      CALLBACK(on_memory_copy_expr);
+      break;
+
+    case ExprType::MemoryFill:
+      CALLBACK(on_memory_fill_expr);
+      break;
+
     case ExprType::Nop:
       CALLBACK(on_nop_expr);
       break;
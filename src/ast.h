@@ -96,6 +96,8 @@ enum class ExprType {
   If,
   Load,
   Loop,
+  MemoryCopy,
+  MemoryFill,
   Nop,
   Return,
   Select,
@@ -144,6 +146,8 @@ struct Expr {
   static Expr* CreateIf(struct Block* true_, struct Expr* false_ = nullptr);
   static Expr* CreateLoad(Opcode, uint32_t align, uint64_t offset);
   static Expr* CreateLoop(struct Block*);
+  static Expr* CreateMemoryCopy();
+  static Expr* CreateMemoryFill();
   static Expr* CreateNop();
   static Expr* CreateReturn();
   static Expr* CreateSelect();
@@ -490,6 +494,8 @@ struct ExprVisitor {
   Result (*on_load_expr)(Expr*, void* user_data);
   Result (*begin_loop_expr)(Expr*, void* user_data);
   Result (*end_loop_expr)(Expr*, void* user_data);
+  Result (*on_memory_copy_expr)(Expr*, void* user_data);
+  Result (*on_memory_fill_expr)(Expr*, void* user_data);
   Result (*on_nop_expr)(Expr*, void* user_data);
   Result (*on_return_expr)(Expr*, void* user_data);
   Result (*on_select_expr)(Expr*, void* user_data);
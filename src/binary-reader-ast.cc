@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <string>
 #include <vector>
 
 #include "ast.h"
@@ -49,6 +50,14 @@ struct LabelNode {
 LabelNode::LabelNode(LabelType label_type, Expr** first)
     : label_type(label_type), first(first), last(nullptr) {}
 
+struct ThreadError {
+  ThreadError(uint32_t offset, const char* message)
+      : offset(offset), message(message) {}
+
+  uint32_t offset;
+  std::string message;
+};
+
 struct Context {
   BinaryErrorHandler* error_handler = nullptr;
   Module* module = nullptr;
@@ -57,6 +66,15 @@ struct Context {
   std::vector<LabelNode> label_stack;
   uint32_t max_depth = 0;
   Expr** current_init_expr = nullptr;
+
+  /* Only set on the contexts of the threads decoding function bodies. Their
+   * errors are kept, and reported on the reading thread when the threads are
+   * done. */
+  Context* parent = nullptr;
+  std::vector<ThreadError> thread_errors;
+  /* On the reading thread, the number of decoding threads not yet merged;
+   * |thread_errors| then holds the errors of the thread that failed first. */
+  uint32_t num_running_threads = 0;
 };
 
 }  // namespace
@@ -116,6 +134,10 @@ static Result append_expr(Context* ctx, Expr* expr) {
 }
 
 static bool handle_error(Context* ctx, uint32_t offset, const char* message) {
+  if (ctx->parent) {
+    ctx->thread_errors.emplace_back(offset, message);
+    return true;
+  }
   if (ctx->error_handler->on_error) {
     return ctx->error_handler->on_error(offset, message,
                                         ctx->error_handler->user_data);
@@ -458,11 +480,11 @@ static Result on_br_if_expr(uint32_t depth, void* user_data) {
   return append_expr(ctx, expr);
 }
 
-static Result on_br_table_expr(BinaryReaderContext* context,
-                               uint32_t num_targets,
-                               uint32_t* target_depths,
-                               uint32_t default_target_depth) {
-  Context* ctx = static_cast<Context*>(context->user_data);
+static Result on_br_table_expr(uint32_t num_targets,
+                               const uint32_t* target_depths,
+                               uint32_t default_target_depth,
+                               void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
   VarVector* targets = new VarVector();
   targets->resize(num_targets);
   for (uint32_t i = 0; i < num_targets; ++i) {
@@ -606,6 +628,18 @@ static Result on_loop_expr(uint32_t num_types,
   return Result::Ok;
 }
 
+static Result on_memory_copy_expr(void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  Expr* expr = Expr::CreateMemoryCopy();
+  return append_expr(ctx, expr);
+}
+
+static Result on_memory_fill_expr(void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  Expr* expr = Expr::CreateMemoryFill();
+  return append_expr(ctx, expr);
+}
+
 static Result on_nop_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   Expr* expr = Expr::CreateNop();
@@ -663,6 +697,264 @@ static Result on_unreachable_expr(void* user_data) {
   return append_expr(ctx, expr);
 }
 
+/* |sig_type| is only set for block, loop and if, which have one result type
+ * at most. */
+static uint32_t get_sig_type_count(Type sig_type) {
+  return sig_type == Type::Void ? 0 : 1;
+}
+
+/* Each instruction is handled by its callback above; a failure is reported
+ * the way the reader reports a failed callback. */
+#define INSTRUCTION_RESULT(member, result)                       \
+  if (WABT_FAILED(result)) {                                     \
+    handle_error(ctx, instr.offset, #member " callback failed"); \
+    return Result::Error;                                        \
+  }                                                              \
+  break
+
+#define INSTRUCTION0(member) INSTRUCTION_RESULT(member, member(ctx))
+#define INSTRUCTION(member, ...) \
+  INSTRUCTION_RESULT(member, member(__VA_ARGS__, ctx))
+
+static Result on_function_body_instructions(
+    const BinaryReaderFunctionBody* body,
+    void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  const std::vector<BinaryReaderInstruction>& instructions =
+      body->instructions;
+  /* the last instruction is the function's end; see end_function_body */
+  for (size_t i = 0; i + 1 < instructions.size(); ++i) {
+    const BinaryReaderInstruction& instr = instructions[i];
+    switch (instr.opcode) {
+      case Opcode::Unreachable:
+        INSTRUCTION0(on_unreachable_expr);
+      case Opcode::Nop:
+        INSTRUCTION0(on_nop_expr);
+      case Opcode::Block: {
+        Type sig_type = instr.sig_type;
+        INSTRUCTION(on_block_expr, get_sig_type_count(sig_type), &sig_type);
+      }
+      case Opcode::Loop: {
+        Type sig_type = instr.sig_type;
+        INSTRUCTION(on_loop_expr, get_sig_type_count(sig_type), &sig_type);
+      }
+      case Opcode::If: {
+        Type sig_type = instr.sig_type;
+        INSTRUCTION(on_if_expr, get_sig_type_count(sig_type), &sig_type);
+      }
+      case Opcode::Else:
+        INSTRUCTION0(on_else_expr);
+      case Opcode::End:
+        INSTRUCTION0(on_end_expr);
+      case Opcode::Br:
+        INSTRUCTION(on_br_expr, instr.index);
+      case Opcode::BrIf:
+        INSTRUCTION(on_br_if_expr, instr.index);
+      case Opcode::BrTable: {
+        const BinaryReaderBrTableImmediate& br_table = instr.br_table;
+        INSTRUCTION(on_br_table_expr, br_table.num_targets,
+                    &body->br_targets[br_table.first_target],
+                    br_table.default_target);
+      }
+      case Opcode::Return:
+        INSTRUCTION0(on_return_expr);
+      case Opcode::Call:
+        INSTRUCTION(on_call_expr, instr.index);
+      case Opcode::CallIndirect:
+        INSTRUCTION(on_call_indirect_expr, instr.index);
+      case Opcode::Drop:
+        INSTRUCTION0(on_drop_expr);
+      case Opcode::Select:
+        INSTRUCTION0(on_select_expr);
+      case Opcode::GetLocal:
+        INSTRUCTION(on_get_local_expr, instr.index);
+      case Opcode::SetLocal:
+        INSTRUCTION(on_set_local_expr, instr.index);
+      case Opcode::TeeLocal:
+        INSTRUCTION(on_tee_local_expr, instr.index);
+      case Opcode::GetGlobal:
+        INSTRUCTION(on_get_global_expr, instr.index);
+      case Opcode::SetGlobal:
+        INSTRUCTION(on_set_global_expr, instr.index);
+      case Opcode::I32Load:
+      case Opcode::I64Load:
+      case Opcode::F32Load:
+      case Opcode::F64Load:
+      case Opcode::I32Load8S:
+      case Opcode::I32Load8U:
+      case Opcode::I32Load16S:
+      case Opcode::I32Load16U:
+      case Opcode::I64Load8S:
+      case Opcode::I64Load8U:
+      case Opcode::I64Load16S:
+      case Opcode::I64Load16U:
+      case Opcode::I64Load32S:
+      case Opcode::I64Load32U:
+        INSTRUCTION(on_load_expr, instr.opcode, instr.memory.alignment_log2,
+                    instr.memory.offset);
+      case Opcode::I32Store:
+      case Opcode::I64Store:
+      case Opcode::F32Store:
+      case Opcode::F64Store:
+      case Opcode::I32Store8:
+      case Opcode::I32Store16:
+      case Opcode::I64Store8:
+      case Opcode::I64Store16:
+      case Opcode::I64Store32:
+        INSTRUCTION(on_store_expr, instr.opcode, instr.memory.alignment_log2,
+                    instr.memory.offset);
+      case Opcode::CurrentMemory:
+        INSTRUCTION0(on_current_memory_expr);
+      case Opcode::GrowMemory:
+        INSTRUCTION0(on_grow_memory_expr);
+      case Opcode::MemoryCopy:
+        INSTRUCTION0(on_memory_copy_expr);
+      case Opcode::MemoryFill:
+        INSTRUCTION0(on_memory_fill_expr);
+      case Opcode::I32Const:
+        INSTRUCTION(on_i32_const_expr, instr.i32);
+      case Opcode::I64Const:
+        INSTRUCTION(on_i64_const_expr, instr.i64);
+      case Opcode::F32Const:
+        INSTRUCTION(on_f32_const_expr, instr.f32_bits);
+      case Opcode::F64Const:
+        INSTRUCTION(on_f64_const_expr, instr.f64_bits);
+      case Opcode::I32Add:
+      case Opcode::I32Sub:
+      case Opcode::I32Mul:
+      case Opcode::I32DivS:
+      case Opcode::I32DivU:
+      case Opcode::I32RemS:
+      case Opcode::I32RemU:
+      case Opcode::I32And:
+      case Opcode::I32Or:
+      case Opcode::I32Xor:
+      case Opcode::I32Shl:
+      case Opcode::I32ShrU:
+      case Opcode::I32ShrS:
+      case Opcode::I32Rotr:
+      case Opcode::I32Rotl:
+      case Opcode::I64Add:
+      case Opcode::I64Sub:
+      case Opcode::I64Mul:
+      case Opcode::I64DivS:
+      case Opcode::I64DivU:
+      case Opcode::I64RemS:
+      case Opcode::I64RemU:
+      case Opcode::I64And:
+      case Opcode::I64Or:
+      case Opcode::I64Xor:
+      case Opcode::I64Shl:
+      case Opcode::I64ShrU:
+      case Opcode::I64ShrS:
+      case Opcode::I64Rotr:
+      case Opcode::I64Rotl:
+      case Opcode::F32Add:
+      case Opcode::F32Sub:
+      case Opcode::F32Mul:
+      case Opcode::F32Div:
+      case Opcode::F32Min:
+      case Opcode::F32Max:
+      case Opcode::F32Copysign:
+      case Opcode::F64Add:
+      case Opcode::F64Sub:
+      case Opcode::F64Mul:
+      case Opcode::F64Div:
+      case Opcode::F64Min:
+      case Opcode::F64Max:
+      case Opcode::F64Copysign:
+        INSTRUCTION(on_binary_expr, instr.opcode);
+      case Opcode::I32Eq:
+      case Opcode::I32Ne:
+      case Opcode::I32LtS:
+      case Opcode::I32LeS:
+      case Opcode::I32LtU:
+      case Opcode::I32LeU:
+      case Opcode::I32GtS:
+      case Opcode::I32GeS:
+      case Opcode::I32GtU:
+      case Opcode::I32GeU:
+      case Opcode::I64Eq:
+      case Opcode::I64Ne:
+      case Opcode::I64LtS:
+      case Opcode::I64LeS:
+      case Opcode::I64LtU:
+      case Opcode::I64LeU:
+      case Opcode::I64GtS:
+      case Opcode::I64GeS:
+      case Opcode::I64GtU:
+      case Opcode::I64GeU:
+      case Opcode::F32Eq:
+      case Opcode::F32Ne:
+      case Opcode::F32Lt:
+      case Opcode::F32Le:
+      case Opcode::F32Gt:
+      case Opcode::F32Ge:
+      case Opcode::F64Eq:
+      case Opcode::F64Ne:
+      case Opcode::F64Lt:
+      case Opcode::F64Le:
+      case Opcode::F64Gt:
+      case Opcode::F64Ge:
+        INSTRUCTION(on_compare_expr, instr.opcode);
+      case Opcode::I32Clz:
+      case Opcode::I32Ctz:
+      case Opcode::I32Popcnt:
+      case Opcode::I64Clz:
+      case Opcode::I64Ctz:
+      case Opcode::I64Popcnt:
+      case Opcode::F32Abs:
+      case Opcode::F32Neg:
+      case Opcode::F32Ceil:
+      case Opcode::F32Floor:
+      case Opcode::F32Trunc:
+      case Opcode::F32Nearest:
+      case Opcode::F32Sqrt:
+      case Opcode::F64Abs:
+      case Opcode::F64Neg:
+      case Opcode::F64Ceil:
+      case Opcode::F64Floor:
+      case Opcode::F64Trunc:
+      case Opcode::F64Nearest:
+      case Opcode::F64Sqrt:
+        INSTRUCTION(on_unary_expr, instr.opcode);
+      case Opcode::I32TruncSF32:
+      case Opcode::I32TruncSF64:
+      case Opcode::I32TruncUF32:
+      case Opcode::I32TruncUF64:
+      case Opcode::I32WrapI64:
+      case Opcode::I64TruncSF32:
+      case Opcode::I64TruncSF64:
+      case Opcode::I64TruncUF32:
+      case Opcode::I64TruncUF64:
+      case Opcode::I64ExtendSI32:
+      case Opcode::I64ExtendUI32:
+      case Opcode::F32ConvertSI32:
+      case Opcode::F32ConvertUI32:
+      case Opcode::F32ConvertSI64:
+      case Opcode::F32ConvertUI64:
+      case Opcode::F32DemoteF64:
+      case Opcode::F32ReinterpretI32:
+      case Opcode::F64ConvertSI32:
+      case Opcode::F64ConvertUI32:
+      case Opcode::F64ConvertSI64:
+      case Opcode::F64ConvertUI64:
+      case Opcode::F64PromoteF32:
+      case Opcode::F64ReinterpretI64:
+      case Opcode::I32ReinterpretF32:
+      case Opcode::I64ReinterpretF64:
+      case Opcode::I32Eqz:
+      case Opcode::I64Eqz:
+        INSTRUCTION(on_convert_expr, instr.opcode);
+    }
+  }
+  return Result::Ok;
+}
+
+#undef INSTRUCTION_RESULT
+#undef INSTRUCTION0
+#undef INSTRUCTION
+
 static Result end_function_body(uint32_t index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(pop_label(ctx));
@@ -670,6 +962,43 @@ static Result end_function_body(uint32_t index, void* user_data) {
   return Result::Ok;
 }
 
+static void* begin_function_bodies_thread(uint32_t thread_index,
+                                          void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  Context* thread_ctx = new Context();
+  thread_ctx->error_handler = ctx->error_handler;
+  thread_ctx->module = ctx->module;
+  thread_ctx->parent = ctx;
+  ctx->num_running_threads++;
+  return thread_ctx;
+}
+
+/* Each function's expressions were added to it directly, so only the errors
+ * are left to merge. A thread stops at its first bad function, whose error
+ * from the binary reader comes last, with its offset. Only the errors of the
+ * thread with the lowest such offset are reported, since those are the ones
+ * reading serially would report. */
+static Result end_function_bodies_thread(uint32_t thread_index,
+                                         void* thread_user_data,
+                                         void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  Context* thread_ctx = static_cast<Context*>(thread_user_data);
+  std::vector<ThreadError>& errors = thread_ctx->thread_errors;
+  if (!errors.empty() &&
+      (ctx->thread_errors.empty() ||
+       errors.back().offset < ctx->thread_errors.back().offset)) {
+    ctx->thread_errors.swap(errors);
+  }
+  delete thread_ctx;
+
+  if (--ctx->num_running_threads == 0) {
+    for (const ThreadError& error : ctx->thread_errors)
+      handle_error(ctx, error.offset, error.message.c_str());
+    ctx->thread_errors.clear();
+  }
+  return Result::Ok;
+}
+
 static Result on_elem_segment_count(uint32_t count, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   ctx->module->elem_segments.reserve(count);
@@ -925,39 +1254,10 @@ Result read_binary_ast(const void* data,
   reader.on_function_bodies_count = on_function_bodies_count;
   reader.begin_function_body = begin_function_body;
   reader.on_local_decl = on_local_decl;
-  reader.on_binary_expr = on_binary_expr;
-  reader.on_block_expr = on_block_expr;
-  reader.on_br_expr = on_br_expr;
-  reader.on_br_if_expr = on_br_if_expr;
-  reader.on_br_table_expr = on_br_table_expr;
-  reader.on_call_expr = on_call_expr;
-  reader.on_call_indirect_expr = on_call_indirect_expr;
-  reader.on_compare_expr = on_compare_expr;
-  reader.on_convert_expr = on_convert_expr;
-  reader.on_current_memory_expr = on_current_memory_expr;
-  reader.on_drop_expr = on_drop_expr;
-  reader.on_else_expr = on_else_expr;
-  reader.on_end_expr = on_end_expr;
-  reader.on_f32_const_expr = on_f32_const_expr;
-  reader.on_f64_const_expr = on_f64_const_expr;
-  reader.on_get_global_expr = on_get_global_expr;
-  reader.on_get_local_expr = on_get_local_expr;
-  reader.on_grow_memory_expr = on_grow_memory_expr;
-  reader.on_i32_const_expr = on_i32_const_expr;
-  reader.on_i64_const_expr = on_i64_const_expr;
-  reader.on_if_expr = on_if_expr;
-  reader.on_load_expr = on_load_expr;
-  reader.on_loop_expr = on_loop_expr;
-  reader.on_nop_expr = on_nop_expr;
-  reader.on_return_expr = on_return_expr;
-  reader.on_select_expr = on_select_expr;
-  reader.on_set_global_expr = on_set_global_expr;
-  reader.on_set_local_expr = on_set_local_expr;
-  reader.on_store_expr = on_store_expr;
-  reader.on_tee_local_expr = on_tee_local_expr;
-  reader.on_unary_expr = on_unary_expr;
-  reader.on_unreachable_expr = on_unreachable_expr;
+  reader.on_function_body_instructions = on_function_body_instructions;
   reader.end_function_body = end_function_body;
+  reader.begin_function_bodies_thread = begin_function_bodies_thread;
+  reader.end_function_bodies_thread = end_function_bodies_thread;
 
   reader.on_elem_segment_count = on_elem_segment_count;
   reader.begin_elem_segment = begin_elem_segment;
@@ -0,0 +1,771 @@
+/*
+ * Copyright 2017 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WABT_BINARY_READER_DELEGATE_H_
+#define WABT_BINARY_READER_DELEGATE_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "binary.h"
+#include "binary-reader.h"
+#include "common.h"
+#include "config.h"
+
+#if HAVE_ALLOCA
+#include <alloca.h>
+#endif
+
+namespace wabt {
+
+/* read_function_body reads the instructions of a function body and calls the
+ * member functions of a delegate directly, instead of through the function
+ * pointers of BinaryReader. The calls can be inlined, and the callbacks the
+ * delegate doesn't handle compile away.
+ *
+ * A delegate derives from BinaryReaderDelegate, which does nothing for every
+ * callback, and hides the callbacks it handles. They are the instruction
+ * callbacks of BinaryReader without the user_data; the ones that take a
+ * BinaryReaderContext* there take the offset instead. The reader uses a
+ * delegate through its read_function_body callback, e.g.:
+ *
+ *   static Result read_function_body_callback(BinaryReaderFunctionBody* body,
+ *                                             void* user_data) {
+ *     MyDelegate delegate(static_cast<Context*>(user_data));
+ *     return read_function_body(body, &delegate);
+ *   }
+ */
+struct BinaryReaderDelegate {
+  /* Returns true if the error was handled, otherwise it is printed. */
+  bool on_error(size_t offset, const char* message) { return false; }
+
+  Result on_opcode(size_t offset, Opcode opcode) { return Result::Ok; }
+  Result on_opcode_bare(size_t offset) { return Result::Ok; }
+  Result on_opcode_uint32(size_t offset, uint32_t value) { return Result::Ok; }
+  Result on_opcode_uint32_uint32(size_t offset,
+                                 uint32_t value,
+                                 uint32_t value2) {
+    return Result::Ok;
+  }
+  Result on_opcode_uint64(size_t offset, uint64_t value) { return Result::Ok; }
+  Result on_opcode_f32(size_t offset, uint32_t value) { return Result::Ok; }
+  Result on_opcode_f64(size_t offset, uint64_t value) { return Result::Ok; }
+  Result on_opcode_block_sig(size_t offset,
+                             uint32_t num_types,
+                             Type* sig_types) {
+    return Result::Ok;
+  }
+  Result on_binary_expr(Opcode opcode) { return Result::Ok; }
+  Result on_block_expr(uint32_t num_types, Type* sig_types) {
+    return Result::Ok;
+  }
+  Result on_br_expr(uint32_t depth) { return Result::Ok; }
+  Result on_br_if_expr(uint32_t depth) { return Result::Ok; }
+  Result on_br_table_expr(size_t offset,
+                          uint32_t num_targets,
+                          uint32_t* target_depths,
+                          uint32_t default_target_depth) {
+    return Result::Ok;
+  }
+  Result on_call_expr(uint32_t func_index) { return Result::Ok; }
+  Result on_call_indirect_expr(uint32_t sig_index) { return Result::Ok; }
+  Result on_compare_expr(Opcode opcode) { return Result::Ok; }
+  Result on_convert_expr(Opcode opcode) { return Result::Ok; }
+  Result on_drop_expr() { return Result::Ok; }
+  Result on_else_expr() { return Result::Ok; }
+  Result on_end_expr() { return Result::Ok; }
+  Result on_end_func() { return Result::Ok; }
+  Result on_f32_const_expr(uint32_t value_bits) { return Result::Ok; }
+  Result on_f64_const_expr(uint64_t value_bits) { return Result::Ok; }
+  Result on_get_global_expr(uint32_t global_index) { return Result::Ok; }
+  Result on_get_local_expr(uint32_t local_index) { return Result::Ok; }
+  Result on_grow_memory_expr() { return Result::Ok; }
+  Result on_i32_const_expr(uint32_t value) { return Result::Ok; }
+  Result on_i64_const_expr(uint64_t value) { return Result::Ok; }
+  Result on_if_expr(uint32_t num_types, Type* sig_types) { return Result::Ok; }
+  Result on_load_expr(Opcode opcode, uint32_t alignment_log2, uint32_t offset) {
+    return Result::Ok;
+  }
+  Result on_loop_expr(uint32_t num_types, Type* sig_types) {
+    return Result::Ok;
+  }
+  Result on_current_memory_expr() { return Result::Ok; }
+  Result on_memory_copy_expr() { return Result::Ok; }
+  Result on_memory_fill_expr() { return Result::Ok; }
+  Result on_nop_expr() { return Result::Ok; }
+  Result on_return_expr() { return Result::Ok; }
+  Result on_select_expr() { return Result::Ok; }
+  Result on_set_global_expr(uint32_t global_index) { return Result::Ok; }
+  Result on_set_local_expr(uint32_t local_index) { return Result::Ok; }
+  Result on_store_expr(Opcode opcode,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    return Result::Ok;
+  }
+  Result on_tee_local_expr(uint32_t local_index) { return Result::Ok; }
+  Result on_unary_expr(Opcode opcode) { return Result::Ok; }
+  Result on_unreachable_expr() { return Result::Ok; }
+};
+
+template <typename Delegate>
+Result WABT_PRINTF_FORMAT(3, 4)
+    function_body_error(BinaryReaderFunctionBody* body,
+                        Delegate* delegate,
+                        const char* format,
+                        ...) {
+  WABT_SNPRINTF_ALLOCA(buffer, length, format);
+  if (!delegate->on_error(body->offset, buffer)) {
+    /* Not great to just print, but we don't want to eat the error either. */
+    fprintf(stderr, "*ERROR*: @0x%08zx: %s\n", body->offset, buffer);
+  }
+  return Result::Error;
+}
+
+#define RAISE_ERROR(...) \
+  return function_body_error(body, delegate, __VA_ARGS__)
+
+#define RAISE_ERROR_UNLESS(cond, ...) \
+  if (!(cond))                        \
+    RAISE_ERROR(__VA_ARGS__);
+
+#define IN_SIZE(type)                                         \
+  if (body->offset + sizeof(type) > body->read_end)           \
+    RAISE_ERROR("unable to read " #type ": %s", desc);        \
+  memcpy(out_value, body->data + body->offset, sizeof(type)); \
+  body->offset += sizeof(type);                               \
+  return Result::Ok
+
+template <typename Delegate>
+Result read_body_u8(BinaryReaderFunctionBody* body,
+                    Delegate* delegate,
+                    uint8_t* out_value,
+                    const char* desc) {
+  IN_SIZE(uint8_t);
+}
+
+template <typename Delegate>
+Result read_body_f32(BinaryReaderFunctionBody* body,
+                     Delegate* delegate,
+                     uint32_t* out_value,
+                     const char* desc) {
+  IN_SIZE(float);
+}
+
+template <typename Delegate>
+Result read_body_f64(BinaryReaderFunctionBody* body,
+                     Delegate* delegate,
+                     uint64_t* out_value,
+                     const char* desc) {
+  IN_SIZE(double);
+}
+
+#undef IN_SIZE
+
+template <typename Delegate>
+Result read_body_u32_leb128(BinaryReaderFunctionBody* body,
+                            Delegate* delegate,
+                            uint32_t* out_value,
+                            const char* desc) {
+  const uint8_t* p = body->data + body->offset;
+  /* Most immediates fit in one byte, so that case is inlined. */
+  if (WABT_LIKELY(body->offset < body->read_end && (*p & 0x80) == 0)) {
+    *out_value = *p;
+    body->offset++;
+    return Result::Ok;
+  }
+  size_t bytes_read =
+      read_u32_leb128(p, body->data + body->read_end, out_value);
+  if (!bytes_read)
+    RAISE_ERROR("unable to read u32 leb128: %s", desc);
+  body->offset += bytes_read;
+  return Result::Ok;
+}
+
+template <typename Delegate>
+Result read_body_i32_leb128(BinaryReaderFunctionBody* body,
+                            Delegate* delegate,
+                            uint32_t* out_value,
+                            const char* desc) {
+  const uint8_t* p = body->data + body->offset;
+  size_t bytes_read =
+      read_i32_leb128(p, body->data + body->read_end, out_value);
+  if (!bytes_read)
+    RAISE_ERROR("unable to read i32 leb128: %s", desc);
+  body->offset += bytes_read;
+  return Result::Ok;
+}
+
+template <typename Delegate>
+Result read_body_i64_leb128(BinaryReaderFunctionBody* body,
+                            Delegate* delegate,
+                            uint64_t* out_value,
+                            const char* desc) {
+  const uint8_t* p = body->data + body->offset;
+  size_t bytes_read =
+      read_i64_leb128(p, body->data + body->read_end, out_value);
+  if (!bytes_read)
+    RAISE_ERROR("unable to read i64 leb128: %s", desc);
+  body->offset += bytes_read;
+  return Result::Ok;
+}
+
+template <typename Delegate>
+Result read_body_type(BinaryReaderFunctionBody* body,
+                      Delegate* delegate,
+                      Type* out_value,
+                      const char* desc) {
+  uint32_t type = 0;
+  if (WABT_FAILED(read_body_i32_leb128(body, delegate, &type, desc)))
+    return Result::Error;
+  /* Must be in the vs7 range: [-128, 127). */
+  if (static_cast<int32_t>(type) < -128 || static_cast<int32_t>(type) > 127)
+    RAISE_ERROR("invalid type: %d", type);
+  *out_value = static_cast<Type>(type);
+  return Result::Ok;
+}
+
+#define IN(read, out_value, desc)                         \
+  if (WABT_FAILED(read(body, delegate, out_value, desc))) \
+    return Result::Error
+
+#define IN_U8(out_value, desc) IN(read_body_u8, out_value, desc)
+#define IN_F32(out_value, desc) IN(read_body_f32, out_value, desc)
+#define IN_F64(out_value, desc) IN(read_body_f64, out_value, desc)
+#define IN_U32_LEB128(out_value, desc) \
+  IN(read_body_u32_leb128, out_value, desc)
+#define IN_I32_LEB128(out_value, desc) \
+  IN(read_body_i32_leb128, out_value, desc)
+#define IN_I64_LEB128(out_value, desc) \
+  IN(read_body_i64_leb128, out_value, desc)
+#define IN_TYPE(out_value, desc) IN(read_body_type, out_value, desc)
+
+#define CALLBACK0(member)                                \
+  RAISE_ERROR_UNLESS(WABT_SUCCEEDED(delegate->member()), \
+                     #member " callback failed")
+
+#define CALLBACK(member, ...)                                       \
+  RAISE_ERROR_UNLESS(WABT_SUCCEEDED(delegate->member(__VA_ARGS__)), \
+                     #member " callback failed")
+
+#define CALLBACK_CTX0(member)                                        \
+  RAISE_ERROR_UNLESS(WABT_SUCCEEDED(delegate->member(body->offset)), \
+                     #member " callback failed")
+
+#define CALLBACK_CTX(member, ...)                                  \
+  RAISE_ERROR_UNLESS(                                              \
+      WABT_SUCCEEDED(delegate->member(body->offset, __VA_ARGS__)), \
+      #member " callback failed")
+
+/* Reads the instructions from body->offset to body->end_offset. On error,
+ * body->offset is where the error was found. */
+template <typename Delegate>
+Result read_function_body(BinaryReaderFunctionBody* body, Delegate* delegate) {
+  bool seen_end_opcode = false;
+  while (body->offset < body->end_offset) {
+    uint8_t opcode_u8 = 0;
+    IN_U8(&opcode_u8, "opcode");
+    Opcode opcode = static_cast<Opcode>(opcode_u8);
+    if (opcode_u8 == WABT_BINARY_PREFIX_BULK_MEMORY) {
+      uint32_t code;
+      IN_U32_LEB128(&code, "bulk memory opcode");
+      switch (code) {
+        case WABT_BINARY_BULK_MEMORY_COPY:
+          opcode = Opcode::MemoryCopy;
+          break;
+        case WABT_BINARY_BULK_MEMORY_FILL:
+          opcode = Opcode::MemoryFill;
+          break;
+        default:
+          RAISE_ERROR("unexpected bulk memory opcode: %d (0x%x)", code, code);
+      }
+    } else if (get_opcode_encoded_size(opcode) != 1) {
+      /* prefixed opcodes must not be read from their unprefixed code */
+      RAISE_ERROR("unexpected opcode: %d (0x%x)", opcode_u8, opcode_u8);
+    }
+    CALLBACK_CTX(on_opcode, opcode);
+    switch (opcode) {
+      case Opcode::Unreachable:
+        CALLBACK0(on_unreachable_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::Block: {
+        Type sig_type = Type::Void;
+        IN_TYPE(&sig_type, "block signature type");
+        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
+                           "expected valid block signature type");
+        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
+        CALLBACK(on_block_expr, num_types, &sig_type);
+        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
+        break;
+      }
+
+      case Opcode::Loop: {
+        Type sig_type = Type::Void;
+        IN_TYPE(&sig_type, "loop signature type");
+        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
+                           "expected valid block signature type");
+        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
+        CALLBACK(on_loop_expr, num_types, &sig_type);
+        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
+        break;
+      }
+
+      case Opcode::If: {
+        Type sig_type = Type::Void;
+        IN_TYPE(&sig_type, "if signature type");
+        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
+                           "expected valid block signature type");
+        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
+        CALLBACK(on_if_expr, num_types, &sig_type);
+        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
+        break;
+      }
+
+      case Opcode::Else:
+        CALLBACK0(on_else_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::Select:
+        CALLBACK0(on_select_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::Br: {
+        uint32_t depth;
+        IN_U32_LEB128(&depth, "br depth");
+        CALLBACK(on_br_expr, depth);
+        CALLBACK_CTX(on_opcode_uint32, depth);
+        break;
+      }
+
+      case Opcode::BrIf: {
+        uint32_t depth;
+        IN_U32_LEB128(&depth, "br_if depth");
+        CALLBACK(on_br_if_expr, depth);
+        CALLBACK_CTX(on_opcode_uint32, depth);
+        break;
+      }
+
+      case Opcode::BrTable: {
+        uint32_t num_targets;
+        IN_U32_LEB128(&num_targets, "br_table target count");
+        /* each depth is at least one byte, so a bogus count can't
+         * overallocate */
+        size_t max_targets =
+            std::min<size_t>(num_targets, body->read_end - body->offset);
+        body->target_depths.resize(max_targets);
+        size_t size;
+        size_t num_decoded = read_u32_leb128s(
+            body->data + body->offset, body->data + body->read_end,
+            body->target_depths.data(), max_targets, &size);
+        body->offset += size;
+        if (num_decoded < num_targets) {
+          /* raises the same error as reading the depths one at a time */
+          uint32_t target_depth;
+          IN_U32_LEB128(&target_depth, "br_table target depth");
+        }
+
+        uint32_t default_target_depth;
+        IN_U32_LEB128(&default_target_depth, "br_table default target depth");
+
+        uint32_t* target_depths =
+            num_targets ? body->target_depths.data() : nullptr;
+
+        CALLBACK_CTX(on_br_table_expr, num_targets, target_depths,
+                     default_target_depth);
+        break;
+      }
+
+      case Opcode::Return:
+        CALLBACK0(on_return_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::Nop:
+        CALLBACK0(on_nop_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::Drop:
+        CALLBACK0(on_drop_expr);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::End:
+        if (body->offset == body->end_offset) {
+          seen_end_opcode = true;
+          CALLBACK0(on_end_func);
+        } else {
+          CALLBACK0(on_end_expr);
+        }
+        break;
+
+      case Opcode::I32Const: {
+        uint32_t value = 0;
+        IN_I32_LEB128(&value, "i32.const value");
+        CALLBACK(on_i32_const_expr, value);
+        CALLBACK_CTX(on_opcode_uint32, value);
+        break;
+      }
+
+      case Opcode::I64Const: {
+        uint64_t value = 0;
+        IN_I64_LEB128(&value, "i64.const value");
+        CALLBACK(on_i64_const_expr, value);
+        CALLBACK_CTX(on_opcode_uint64, value);
+        break;
+      }
+
+      case Opcode::F32Const: {
+        uint32_t value_bits = 0;
+        IN_F32(&value_bits, "f32.const value");
+        CALLBACK(on_f32_const_expr, value_bits);
+        CALLBACK_CTX(on_opcode_f32, value_bits);
+        break;
+      }
+
+      case Opcode::F64Const: {
+        uint64_t value_bits = 0;
+        IN_F64(&value_bits, "f64.const value");
+        CALLBACK(on_f64_const_expr, value_bits);
+        CALLBACK_CTX(on_opcode_f64, value_bits);
+        break;
+      }
+
+      case Opcode::GetGlobal: {
+        uint32_t global_index;
+        IN_U32_LEB128(&global_index, "get_global global index");
+        CALLBACK(on_get_global_expr, global_index);
+        CALLBACK_CTX(on_opcode_uint32, global_index);
+        break;
+      }
+
+      case Opcode::GetLocal: {
+        uint32_t local_index;
+        IN_U32_LEB128(&local_index, "get_local local index");
+        CALLBACK(on_get_local_expr, local_index);
+        CALLBACK_CTX(on_opcode_uint32, local_index);
+        break;
+      }
+
+      case Opcode::SetGlobal: {
+        uint32_t global_index;
+        IN_U32_LEB128(&global_index, "set_global global index");
+        CALLBACK(on_set_global_expr, global_index);
+        CALLBACK_CTX(on_opcode_uint32, global_index);
+        break;
+      }
+
+      case Opcode::SetLocal: {
+        uint32_t local_index;
+        IN_U32_LEB128(&local_index, "set_local local index");
+        CALLBACK(on_set_local_expr, local_index);
+        CALLBACK_CTX(on_opcode_uint32, local_index);
+        break;
+      }
+
+      case Opcode::Call: {
+        uint32_t func_index;
+        IN_U32_LEB128(&func_index, "call function index");
+        RAISE_ERROR_UNLESS(func_index < body->num_funcs,
+                           "invalid call function index");
+        CALLBACK(on_call_expr, func_index);
+        CALLBACK_CTX(on_opcode_uint32, func_index);
+        break;
+      }
+
+      case Opcode::CallIndirect: {
+        uint32_t sig_index;
+        IN_U32_LEB128(&sig_index, "call_indirect signature index");
+        RAISE_ERROR_UNLESS(sig_index < body->num_signatures,
+                           "invalid call_indirect signature index");
+        uint32_t reserved;
+        IN_U32_LEB128(&reserved, "call_indirect reserved");
+        RAISE_ERROR_UNLESS(reserved == 0,
+                           "call_indirect reserved value must be 0");
+        CALLBACK(on_call_indirect_expr, sig_index);
+        CALLBACK_CTX(on_opcode_uint32_uint32, sig_index, reserved);
+        break;
+      }
+
+      case Opcode::TeeLocal: {
+        uint32_t local_index;
+        IN_U32_LEB128(&local_index, "tee_local local index");
+        CALLBACK(on_tee_local_expr, local_index);
+        CALLBACK_CTX(on_opcode_uint32, local_index);
+        break;
+      }
+
+      case Opcode::I32Load8S:
+      case Opcode::I32Load8U:
+      case Opcode::I32Load16S:
+      case Opcode::I32Load16U:
+      case Opcode::I64Load8S:
+      case Opcode::I64Load8U:
+      case Opcode::I64Load16S:
+      case Opcode::I64Load16U:
+      case Opcode::I64Load32S:
+      case Opcode::I64Load32U:
+      case Opcode::I32Load:
+      case Opcode::I64Load:
+      case Opcode::F32Load:
+      case Opcode::F64Load: {
+        uint32_t alignment_log2;
+        IN_U32_LEB128(&alignment_log2, "load alignment");
+        uint32_t offset;
+        IN_U32_LEB128(&offset, "load offset");
+
+        CALLBACK(on_load_expr, opcode, alignment_log2, offset);
+        CALLBACK_CTX(on_opcode_uint32_uint32, alignment_log2, offset);
+        break;
+      }
+
+      case Opcode::I32Store8:
+      case Opcode::I32Store16:
+      case Opcode::I64Store8:
+      case Opcode::I64Store16:
+      case Opcode::I64Store32:
+      case Opcode::I32Store:
+      case Opcode::I64Store:
+      case Opcode::F32Store:
+      case Opcode::F64Store: {
+        uint32_t alignment_log2;
+        IN_U32_LEB128(&alignment_log2, "store alignment");
+        uint32_t offset;
+        IN_U32_LEB128(&offset, "store offset");
+
+        CALLBACK(on_store_expr, opcode, alignment_log2, offset);
+        CALLBACK_CTX(on_opcode_uint32_uint32, alignment_log2, offset);
+        break;
+      }
+
+      case Opcode::CurrentMemory: {
+        uint32_t reserved;
+        IN_U32_LEB128(&reserved, "current_memory reserved");
+        RAISE_ERROR_UNLESS(reserved == 0,
+                           "current_memory reserved value must be 0");
+        CALLBACK0(on_current_memory_expr);
+        CALLBACK_CTX(on_opcode_uint32, reserved);
+        break;
+      }
+
+      case Opcode::GrowMemory: {
+        uint32_t reserved;
+        IN_U32_LEB128(&reserved, "grow_memory reserved");
+        RAISE_ERROR_UNLESS(reserved == 0,
+                           "grow_memory reserved value must be 0");
+        CALLBACK0(on_grow_memory_expr);
+        CALLBACK_CTX(on_opcode_uint32, reserved);
+        break;
+      }
+
+      case Opcode::MemoryCopy: {
+        uint32_t dst_reserved;
+        uint32_t src_reserved;
+        IN_U32_LEB128(&dst_reserved, "memory.copy reserved");
+        IN_U32_LEB128(&src_reserved, "memory.copy reserved");
+        RAISE_ERROR_UNLESS(dst_reserved == 0 && src_reserved == 0,
+                           "memory.copy reserved value must be 0");
+        CALLBACK0(on_memory_copy_expr);
+        CALLBACK_CTX(on_opcode_uint32_uint32, dst_reserved, src_reserved);
+        break;
+      }
+
+      case Opcode::MemoryFill: {
+        uint32_t reserved;
+        IN_U32_LEB128(&reserved, "memory.fill reserved");
+        RAISE_ERROR_UNLESS(reserved == 0,
+                           "memory.fill reserved value must be 0");
+        CALLBACK0(on_memory_fill_expr);
+        CALLBACK_CTX(on_opcode_uint32, reserved);
+        break;
+      }
+
+      case Opcode::I32Add:
+      case Opcode::I32Sub:
+      case Opcode::I32Mul:
+      case Opcode::I32DivS:
+      case Opcode::I32DivU:
+      case Opcode::I32RemS:
+      case Opcode::I32RemU:
+      case Opcode::I32And:
+      case Opcode::I32Or:
+      case Opcode::I32Xor:
+      case Opcode::I32Shl:
+      case Opcode::I32ShrU:
+      case Opcode::I32ShrS:
+      case Opcode::I32Rotr:
+      case Opcode::I32Rotl:
+      case Opcode::I64Add:
+      case Opcode::I64Sub:
+      case Opcode::I64Mul:
+      case Opcode::I64DivS:
+      case Opcode::I64DivU:
+      case Opcode::I64RemS:
+      case Opcode::I64RemU:
+      case Opcode::I64And:
+      case Opcode::I64Or:
+      case Opcode::I64Xor:
+      case Opcode::I64Shl:
+      case Opcode::I64ShrU:
+      case Opcode::I64ShrS:
+      case Opcode::I64Rotr:
+      case Opcode::I64Rotl:
+      case Opcode::F32Add:
+      case Opcode::F32Sub:
+      case Opcode::F32Mul:
+      case Opcode::F32Div:
+      case Opcode::F32Min:
+      case Opcode::F32Max:
+      case Opcode::F32Copysign:
+      case Opcode::F64Add:
+      case Opcode::F64Sub:
+      case Opcode::F64Mul:
+      case Opcode::F64Div:
+      case Opcode::F64Min:
+      case Opcode::F64Max:
+      case Opcode::F64Copysign:
+        CALLBACK(on_binary_expr, opcode);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::I32Eq:
+      case Opcode::I32Ne:
+      case Opcode::I32LtS:
+      case Opcode::I32LeS:
+      case Opcode::I32LtU:
+      case Opcode::I32LeU:
+      case Opcode::I32GtS:
+      case Opcode::I32GeS:
+      case Opcode::I32GtU:
+      case Opcode::I32GeU:
+      case Opcode::I64Eq:
+      case Opcode::I64Ne:
+      case Opcode::I64LtS:
+      case Opcode::I64LeS:
+      case Opcode::I64LtU:
+      case Opcode::I64LeU:
+      case Opcode::I64GtS:
+      case Opcode::I64GeS:
+      case Opcode::I64GtU:
+      case Opcode::I64GeU:
+      case Opcode::F32Eq:
+      case Opcode::F32Ne:
+      case Opcode::F32Lt:
+      case Opcode::F32Le:
+      case Opcode::F32Gt:
+      case Opcode::F32Ge:
+      case Opcode::F64Eq:
+      case Opcode::F64Ne:
+      case Opcode::F64Lt:
+      case Opcode::F64Le:
+      case Opcode::F64Gt:
+      case Opcode::F64Ge:
+        CALLBACK(on_compare_expr, opcode);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::I32Clz:
+      case Opcode::I32Ctz:
+      case Opcode::I32Popcnt:
+      case Opcode::I64Clz:
+      case Opcode::I64Ctz:
+      case Opcode::I64Popcnt:
+      case Opcode::F32Abs:
+      case Opcode::F32Neg:
+      case Opcode::F32Ceil:
+      case Opcode::F32Floor:
+      case Opcode::F32Trunc:
+      case Opcode::F32Nearest:
+      case Opcode::F32Sqrt:
+      case Opcode::F64Abs:
+      case Opcode::F64Neg:
+      case Opcode::F64Ceil:
+      case Opcode::F64Floor:
+      case Opcode::F64Trunc:
+      case Opcode::F64Nearest:
+      case Opcode::F64Sqrt:
+        CALLBACK(on_unary_expr, opcode);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      case Opcode::I32TruncSF32:
+      case Opcode::I32TruncSF64:
+      case Opcode::I32TruncUF32:
+      case Opcode::I32TruncUF64:
+      case Opcode::I32WrapI64:
+      case Opcode::I64TruncSF32:
+      case Opcode::I64TruncSF64:
+      case Opcode::I64TruncUF32:
+      case Opcode::I64TruncUF64:
+      case Opcode::I64ExtendSI32:
+      case Opcode::I64ExtendUI32:
+      case Opcode::F32ConvertSI32:
+      case Opcode::F32ConvertUI32:
+      case Opcode::F32ConvertSI64:
+      case Opcode::F32ConvertUI64:
+      case Opcode::F32DemoteF64:
+      case Opcode::F32ReinterpretI32:
+      case Opcode::F64ConvertSI32:
+      case Opcode::F64ConvertUI32:
+      case Opcode::F64ConvertSI64:
+      case Opcode::F64ConvertUI64:
+      case Opcode::F64PromoteF32:
+      case Opcode::F64ReinterpretI64:
+      case Opcode::I32ReinterpretF32:
+      case Opcode::I64ReinterpretF64:
+      case Opcode::I32Eqz:
+      case Opcode::I64Eqz:
+        CALLBACK(on_convert_expr, opcode);
+        CALLBACK_CTX0(on_opcode_bare);
+        break;
+
+      default:
+        RAISE_ERROR("unexpected opcode: %d (0x%x)", static_cast<int>(opcode),
+                    static_cast<unsigned>(opcode));
+    }
+  }
+  RAISE_ERROR_UNLESS(body->offset == body->end_offset,
+                     "function body longer than given size");
+  RAISE_ERROR_UNLESS(seen_end_opcode, "function body must end with END opcode");
+  return Result::Ok;
+}
+
+#undef IN
+#undef IN_U8
+#undef IN_F32
+#undef IN_F64
+#undef IN_U32_LEB128
+#undef IN_I32_LEB128
+#undef IN_I64_LEB128
+#undef IN_TYPE
+#undef CALLBACK0
+#undef CALLBACK
+#undef CALLBACK_CTX0
+#undef CALLBACK_CTX
+#undef RAISE_ERROR
+#undef RAISE_ERROR_UNLESS
+
+}  // namespace wabt
+
+#endif /* WABT_BINARY_READER_DELEGATE_H_ */
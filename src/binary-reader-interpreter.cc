@@ -23,6 +23,7 @@
 
 #include <vector>
 
+#include "binary-reader-delegate.h"
 #include "binary-reader.h"
 #include "interpreter.h"
 #include "type-checker.h"
@@ -63,14 +64,34 @@ typedef std::vector<uint32_t> Uint32Vector;
 typedef std::vector<Uint32Vector> Uint32VectorVector;
 
 struct Label {
-  Label(uint32_t offset, uint32_t fixup_offset);
+  Label(uint32_t offset, uint32_t fixup_offset, bool is_dead);
 
   uint32_t offset; /* branch location in the istream */
   uint32_t fixup_offset;
+  /* the label's block can't be reached, so nothing in it is emitted */
+  bool is_dead;
 };
 
-Label::Label(uint32_t offset, uint32_t fixup_offset)
-    : offset(offset), fixup_offset(fixup_offset) {}
+Label::Label(uint32_t offset, uint32_t fixup_offset, bool is_dead)
+    : offset(offset), fixup_offset(fixup_offset), is_dead(is_dead) {}
+
+/* A get_local or constant whose emission is deferred, so it can be used as
+ * an operand of a register binop. */
+struct PendingOperand {
+  uint32_t kind; /* WABT_REG_OPERAND_* */
+  Type type;
+  /* type stack height before the operand is pushed */
+  uint32_t height;
+  uint32_t local_index;
+  uint64_t value;
+};
+
+/* An i32.const or i64.const that has been emitted. */
+struct EmittedConst {
+  uint32_t offset; /* of the opcode in the istream */
+  Type type;
+  uint64_t value;
+};
 
 struct Context {
   Context();
@@ -80,12 +101,37 @@ struct Context {
   InterpreterEnvironment* env = nullptr;
   DefinedInterpreterModule* module = nullptr;
   DefinedInterpreterFunc* current_func = nullptr;
+  uint32_t current_func_env_index = WABT_INVALID_INDEX;
   TypeChecker typechecker;
   std::vector<Label> label_stack;
   Uint32VectorVector func_fixups;
   Uint32VectorVector depth_fixups;
   MemoryWriter istream_writer;
   uint32_t istream_offset = 0;
+  InterpreterIstreamEncoding istream_encoding =
+      InterpreterIstreamEncoding::Packed;
+  bool register_ops = false;
+  /* emit CountCall/CountLoop, so hot functions can be recompiled */
+  bool count_hotness = false;
+  /* the mapped file being read, when data segments are mapped from it */
+  const MappedFile* data_segment_file = nullptr;
+  /* recompiling a single function of an existing module */
+  bool is_recompile = false;
+  uint32_t num_loops = 0; /* loops seen so far in the current function */
+  std::vector<PendingOperand> pending_operands;
+  /* a register binop whose destination isn't known yet */
+  bool has_pending_binop = false;
+  Opcode pending_binop;
+  PendingOperand pending_lhs;
+  PendingOperand pending_rhs;
+  /* type stack height with the operands of the pending binop popped */
+  uint32_t pending_binop_height = 0;
+  /* the current instruction can't be reached, so it isn't emitted */
+  bool is_dead_code = false;
+  /* constants at the end of the istream, with nothing emitted or branching
+   * to a label after them; they are the values on the top of the stack, so
+   * an instruction that uses them can be folded with them */
+  std::vector<EmittedConst> trailing_consts;
   /* mappings from module index space to env index space; this won't just be a
    * translation, because imported values will be resolved as well */
   Uint32Vector sig_index_mapping;
@@ -222,26 +268,70 @@ static Result emit_data(Context* ctx, const void* data, size_t size) {
   return Result::Ok;
 }
 
-static Result emit_opcode(Context* ctx, Opcode opcode) {
-  return emit_data(ctx, &opcode, sizeof(uint8_t));
+static bool is_aligned_istream(Context* ctx) {
+  return ctx->istream_encoding == InterpreterIstreamEncoding::Aligned;
 }
 
-static Result emit_opcode(Context* ctx, InterpreterOpcode opcode) {
-  return emit_data(ctx, &opcode, sizeof(uint8_t));
+static size_t get_table_entry_size(Context* ctx) {
+  return is_aligned_istream(ctx) ? WABT_ALIGNED_TABLE_ENTRY_SIZE
+                                 : WABT_TABLE_ENTRY_SIZE;
 }
 
-static Result emit_i8(Context* ctx, uint8_t value) {
+static Result emit_i32(Context* ctx, uint32_t value) {
   return emit_data(ctx, &value, sizeof(value));
 }
 
-static Result emit_i32(Context* ctx, uint32_t value) {
+/* opcodes and u8 immediates take a full word in the aligned encoding */
+static Result emit_i8(Context* ctx, uint8_t value) {
+  if (is_aligned_istream(ctx))
+    return emit_i32(ctx, value);
   return emit_data(ctx, &value, sizeof(value));
 }
 
+static Result emit_opcode(Context* ctx, Opcode opcode) {
+  ctx->trailing_consts.clear();
+  return emit_i8(ctx, static_cast<uint8_t>(opcode));
+}
+
+static Result emit_opcode(Context* ctx, InterpreterOpcode opcode) {
+  if (opcode != InterpreterOpcode::I32Const &&
+      opcode != InterpreterOpcode::I64Const) {
+    ctx->trailing_consts.clear();
+  }
+  return emit_i8(ctx, static_cast<uint8_t>(opcode));
+}
+
 static Result emit_i64(Context* ctx, uint64_t value) {
+  if (is_aligned_istream(ctx) && (ctx->istream_offset % sizeof(value)) != 0)
+    CHECK_RESULT(emit_i32(ctx, 0));
   return emit_data(ctx, &value, sizeof(value));
 }
 
+static Result emit_const(Context* ctx, Type type, uint64_t value) {
+  EmittedConst emitted;
+  emitted.offset = get_istream_offset(ctx);
+  emitted.type = type;
+  emitted.value = value;
+  if (type == Type::I32) {
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::I32Const));
+    CHECK_RESULT(emit_i32(ctx, value));
+  } else {
+    assert(type == Type::I64);
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::I64Const));
+    CHECK_RESULT(emit_i64(ctx, value));
+  }
+  ctx->trailing_consts.push_back(emitted);
+  return Result::Ok;
+}
+
+/* Removes the last trailing constant from the istream. */
+static EmittedConst pop_trailing_const(Context* ctx) {
+  EmittedConst emitted = ctx->trailing_consts.back();
+  ctx->trailing_consts.pop_back();
+  ctx->istream_offset = emitted.offset;
+  return emitted;
+}
+
 static Result emit_i32_at(Context* ctx, uint32_t offset, uint32_t value) {
   return emit_data_at(ctx, offset, &value, sizeof(value));
 }
@@ -252,6 +342,9 @@ static Result emit_drop_keep(Context* ctx, uint32_t drop, uint8_t keep) {
   if (drop > 0) {
     if (drop == 1 && keep == 0) {
       CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Drop));
+    } else if (keep == 1) {
+      CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::DropKeep1));
+      CHECK_RESULT(emit_i32(ctx, drop));
     } else {
       CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::DropKeep));
       CHECK_RESULT(emit_i32(ctx, drop));
@@ -330,6 +423,11 @@ static Result emit_br_table_offset(Context* ctx, uint32_t depth) {
   return Result::Ok;
 }
 
+static bool top_label_has_fixups(Context* ctx) {
+  uint32_t top = ctx->label_stack.size() - 1;
+  return top < ctx->depth_fixups.size() && !ctx->depth_fixups[top].empty();
+}
+
 static Result fixup_top_label(Context* ctx) {
   uint32_t offset = get_istream_offset(ctx);
   uint32_t top = ctx->label_stack.size() - 1;
@@ -357,11 +455,142 @@ static Result emit_func_offset(Context* ctx,
   return Result::Ok;
 }
 
+/* depth of a local from the top of the value stack, when the stack has
+ * |height| values above the locals */
+static uint32_t get_local_depth(Context* ctx,
+                                uint32_t height,
+                                uint32_t local_index) {
+  return height + ctx->current_func->param_and_local_types.size() -
+         local_index;
+}
+
+static uint32_t translate_local_index(Context* ctx, uint32_t local_index) {
+  return get_local_depth(ctx, ctx->typechecker.type_stack.size(), local_index);
+}
+
+static Result emit_pending_operand(Context* ctx, const PendingOperand& operand) {
+  if (operand.kind == WABT_REG_OPERAND_LOCAL) {
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::GetLocal));
+    CHECK_RESULT(emit_i32(
+        ctx, get_local_depth(ctx, operand.height, operand.local_index)));
+  } else {
+    CHECK_RESULT(emit_const(ctx, operand.type, operand.value));
+  }
+  return Result::Ok;
+}
+
+static Result emit_reg_binop_operand(Context* ctx,
+                                     const PendingOperand& operand) {
+  if (operand.kind == WABT_REG_OPERAND_LOCAL) {
+    CHECK_RESULT(emit_i32(ctx, get_local_depth(ctx, ctx->pending_binop_height,
+                                               operand.local_index)));
+  } else if (operand.kind == WABT_REG_OPERAND_CONST) {
+    if (operand.type == Type::I32)
+      CHECK_RESULT(emit_i32(ctx, operand.value));
+    else
+      CHECK_RESULT(emit_i64(ctx, operand.value));
+  }
+  return Result::Ok;
+}
+
+/* Emit the pending binop; its result is pushed if |dst_kind| is
+ * WABT_REG_OPERAND_STACK, or stored to |dst_local_index|. */
+static Result emit_pending_binop(Context* ctx,
+                                 uint32_t dst_kind,
+                                 uint32_t dst_local_index) {
+  assert(ctx->has_pending_binop);
+  ctx->has_pending_binop = false;
+  const PendingOperand& lhs = ctx->pending_lhs;
+  const PendingOperand& rhs = ctx->pending_rhs;
+  CHECK_RESULT(emit_opcode(ctx, rhs.type == Type::I32
+                                    ? InterpreterOpcode::I32RegBinop
+                                    : InterpreterOpcode::I64RegBinop));
+  CHECK_RESULT(emit_i8(ctx, static_cast<uint8_t>(ctx->pending_binop)));
+  CHECK_RESULT(
+      emit_i8(ctx, WABT_REG_BINOP_MODE(lhs.kind, rhs.kind, dst_kind)));
+  CHECK_RESULT(emit_reg_binop_operand(ctx, lhs));
+  CHECK_RESULT(emit_reg_binop_operand(ctx, rhs));
+  if (dst_kind == WABT_REG_OPERAND_LOCAL) {
+    CHECK_RESULT(emit_i32(ctx, get_local_depth(ctx, ctx->pending_binop_height,
+                                               dst_local_index)));
+  }
+  return Result::Ok;
+}
+
+static Result flush_pending(Context* ctx) {
+  if (ctx->has_pending_binop)
+    CHECK_RESULT(emit_pending_binop(ctx, WABT_REG_OPERAND_STACK, 0));
+  for (const PendingOperand& operand : ctx->pending_operands)
+    CHECK_RESULT(emit_pending_operand(ctx, operand));
+  ctx->pending_operands.clear();
+  return Result::Ok;
+}
+
+/* |height| is the type stack height before the operand was pushed */
+static Result push_pending_operand(Context* ctx,
+                                   uint32_t kind,
+                                   Type type,
+                                   uint32_t height,
+                                   uint32_t local_index,
+                                   uint64_t value) {
+  if (ctx->has_pending_binop)
+    CHECK_RESULT(emit_pending_binop(ctx, WABT_REG_OPERAND_STACK, 0));
+  /* a binop uses at most two operands, so older ones can be emitted now */
+  if (ctx->pending_operands.size() == 2) {
+    CHECK_RESULT(emit_pending_operand(ctx, ctx->pending_operands[0]));
+    ctx->pending_operands.erase(ctx->pending_operands.begin());
+  }
+  PendingOperand operand;
+  operand.kind = kind;
+  operand.type = type;
+  operand.height = height;
+  operand.local_index = local_index;
+  operand.value = value;
+  ctx->pending_operands.push_back(operand);
+  return Result::Ok;
+}
+
 static bool on_error(BinaryReaderContext* ctx, const char* message) {
   return handle_error(ctx->offset, message,
                       static_cast<Context*>(ctx->user_data));
 }
 
+static bool is_load_opcode(Opcode opcode) {
+  return opcode >= Opcode::I32Load && opcode <= Opcode::I64Load32U;
+}
+
+static Result begin_instruction(Context* ctx, Opcode opcode) {
+  /* Code after an unconditional branch is never executed, so it is only type
+   * checked. Blocks that begin there are dead as well. */
+  ctx->is_dead_code = typechecker_is_unreachable(&ctx->typechecker) ||
+                      top_label(ctx)->is_dead;
+  switch (opcode) {
+    /* these handle pending operands themselves */
+    case Opcode::GetLocal:
+    case Opcode::SetLocal:
+    case Opcode::I32Const:
+    case Opcode::I64Const:
+      break;
+
+    default:
+      if (!is_interpreter_reg_binop(opcode))
+        CHECK_RESULT(flush_pending(ctx));
+      break;
+  }
+  /* Only these can be folded with the constants before them. Anything else
+   * may place a label after the constants, even if it emits nothing. */
+  if (opcode != Opcode::I32Const && opcode != Opcode::I64Const &&
+      opcode != Opcode::BrIf && !is_interpreter_reg_binop(opcode) &&
+      !is_load_opcode(opcode)) {
+    ctx->trailing_consts.clear();
+  }
+  return Result::Ok;
+}
+
+static Result on_opcode(BinaryReaderContext* context, Opcode opcode) {
+  return begin_instruction(static_cast<Context*>(context->user_data), opcode);
+}
+
 static Result on_signature_count(uint32_t count, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   ctx->sig_index_mapping.resize(count);
@@ -679,6 +908,8 @@ static Result on_function_signature(uint32_t index,
   Context* ctx = static_cast<Context*>(user_data);
   DefinedInterpreterFunc* func =
       new DefinedInterpreterFunc(translate_sig_index_to_env(ctx, sig_index));
+  func->module_index = ctx->env->modules.size() - 1;
+  func->module_func_index = index;
   ctx->env->funcs.emplace_back(func);
   return Result::Ok;
 }
@@ -887,8 +1118,8 @@ static Result on_elem_segment_function_index(uint32_t index,
   Context* ctx = static_cast<Context*>(user_data);
   assert(ctx->module->table_index != WABT_INVALID_INDEX);
   InterpreterTable* table = &ctx->env->tables[ctx->module->table_index];
-  table->func_indexes[ctx->table_offset++] =
-      translate_func_index_to_env(ctx, func_index);
+  set_interpreter_table_element(ctx->env, table, ctx->table_offset++,
+                                translate_func_index_to_env(ctx, func_index));
   return Result::Ok;
 }
 
@@ -926,13 +1157,21 @@ static Result on_data_segment_data(uint32_t index,
     assert(ctx->module->memory_index != WABT_INVALID_INDEX);
     InterpreterMemory* memory = &ctx->env->memories[ctx->module->memory_index];
     uint32_t address = ctx->init_expr_value.value.i32;
-    memcpy(&memory->data[address], src_data, size);
+    if (ctx->data_segment_file) {
+      const char* file_data = ctx->data_segment_file->data;
+      size_t file_offset = static_cast<const char*>(src_data) - file_data;
+      memory->data.copy_from_file(address, ctx->data_segment_file, file_offset,
+                                  size);
+    } else {
+      memcpy(&memory->data[address], src_data, size);
+    }
   }
   return Result::Ok;
 }
 
+/* A label pushed in dead code is dead too. */
 static void push_label(Context* ctx, uint32_t offset, uint32_t fixup_offset) {
-  ctx->label_stack.emplace_back(offset, fixup_offset);
+  ctx->label_stack.emplace_back(offset, fixup_offset, ctx->is_dead_code);
 }
 
 static void pop_label(Context* ctx) {
@@ -970,14 +1209,29 @@ static Result begin_function_body(BinaryReaderContext* context,
   func->local_count = 0;
 
   ctx->current_func = func;
+  ctx->current_func_env_index = translate_func_index_to_env(ctx, index);
+  ctx->num_loops = 0;
   ctx->depth_fixups.clear();
   ctx->label_stack.clear();
+  ctx->is_dead_code = false;
+  ctx->trailing_consts.clear();
 
-  /* fixup function references */
-  uint32_t defined_index = translate_module_func_index_to_defined(ctx, index);
-  Uint32Vector& fixups = ctx->func_fixups[defined_index];
-  for (uint32_t fixup: fixups)
-    CHECK_RESULT(emit_i32_at(ctx, fixup, func->offset));
+  /* fixup function references; a recompiled function has none, since all
+   * functions of the module have offsets by then */
+  if (!ctx->is_recompile) {
+    uint32_t defined_index =
+        translate_module_func_index_to_defined(ctx, index);
+    Uint32Vector& fixups = ctx->func_fixups[defined_index];
+    for (uint32_t fixup: fixups)
+      CHECK_RESULT(emit_i32_at(ctx, fixup, func->offset));
+  }
+
+  /* This must be the first instruction; it is overwritten with a br to the
+   * recompiled code. */
+  if (ctx->count_hotness) {
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::CountCall));
+    CHECK_RESULT(emit_i32(ctx, ctx->current_func_env_index));
+  }
 
   /* append param types */
   for (Type param_type: sig->param_types)
@@ -993,12 +1247,19 @@ static Result begin_function_body(BinaryReaderContext* context,
 
 static Result end_function_body(uint32_t index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
+  CHECK_RESULT(flush_pending(ctx));
+  /* If the end of the function can't be reached by falling through or by a
+   * branch, the implicit return is dead code. */
+  bool is_reachable = !typechecker_is_unreachable(&ctx->typechecker) ||
+                      top_label_has_fixups(ctx);
   fixup_top_label(ctx);
   uint32_t drop_count, keep_count;
   CHECK_RESULT(get_return_drop_keep_count(ctx, &drop_count, &keep_count));
   CHECK_RESULT(typechecker_end_function(&ctx->typechecker));
-  CHECK_RESULT(emit_drop_keep(ctx, drop_count, keep_count));
-  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Return));
+  if (is_reachable) {
+    CHECK_RESULT(emit_drop_keep(ctx, drop_count, keep_count));
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Return));
+  }
   pop_label(ctx);
   ctx->current_func = nullptr;
   return Result::Ok;
@@ -1051,13 +1312,69 @@ static Result check_align(Context* ctx,
 static Result on_unary_expr(Opcode opcode, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_unary(&ctx->typechecker, opcode));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, opcode));
   return Result::Ok;
 }
 
+/* Folds |opcode| if both of its operands are constants, which are either the
+ * pending operands or the trailing constants. Binops that can trap, like
+ * division, are never folded. */
+static Result fold_binop(Context* ctx, Opcode opcode, bool* out_folded) {
+  *out_folded = false;
+  if (!is_interpreter_reg_binop(opcode))
+    return Result::Ok;
+  Type result_type = get_opcode_result_type(opcode);
+  std::vector<PendingOperand>& pending = ctx->pending_operands;
+  if (pending.size() == 2 && pending[0].kind == WABT_REG_OPERAND_CONST &&
+      pending[1].kind == WABT_REG_OPERAND_CONST) {
+    pending[0].value =
+        eval_interpreter_reg_binop(opcode, pending[0].value, pending[1].value);
+    pending[0].type = result_type;
+    pending.pop_back();
+    *out_folded = true;
+  } else if (pending.empty() && !ctx->has_pending_binop &&
+             ctx->trailing_consts.size() >= 2) {
+    EmittedConst rhs = pop_trailing_const(ctx);
+    EmittedConst lhs = pop_trailing_const(ctx);
+    CHECK_RESULT(emit_const(
+        ctx, result_type,
+        eval_interpreter_reg_binop(opcode, lhs.value, rhs.value)));
+    *out_folded = true;
+  }
+  return Result::Ok;
+}
+
 static Result on_binary_expr(Opcode opcode, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_binary(&ctx->typechecker, opcode));
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  bool folded;
+  CHECK_RESULT(fold_binop(ctx, opcode, &folded));
+  if (folded)
+    return Result::Ok;
+  bool is_reg_binop =
+      !ctx->pending_operands.empty() && is_interpreter_reg_binop(opcode);
+  if (is_reg_binop) {
+    /* the operands are the pending operands, or the value on the top of the
+     * stack and one pending operand */
+    ctx->pending_rhs = ctx->pending_operands.back();
+    if (ctx->pending_operands.size() == 2) {
+      ctx->pending_lhs = ctx->pending_operands[0];
+      ctx->pending_binop_height = ctx->pending_lhs.height;
+    } else {
+      WABT_ZERO_MEMORY(ctx->pending_lhs);
+      ctx->pending_lhs.kind = WABT_REG_OPERAND_STACK;
+      ctx->pending_binop_height = ctx->pending_rhs.height - 1;
+    }
+    ctx->pending_operands.clear();
+    ctx->pending_binop = opcode;
+    ctx->has_pending_binop = true;
+    return Result::Ok;
+  }
+  CHECK_RESULT(flush_pending(ctx));
   CHECK_RESULT(emit_opcode(ctx, opcode));
   return Result::Ok;
 }
@@ -1079,6 +1396,19 @@ static Result on_loop_expr(uint32_t num_types,
   TypeVector sig(sig_types, sig_types + num_types);
   CHECK_RESULT(typechecker_on_loop(&ctx->typechecker, &sig));
   push_label(ctx, get_istream_offset(ctx), WABT_INVALID_OFFSET);
+  /* dead loops are still counted, so loop indexes are the same when the
+   * function is recompiled */
+  if (ctx->is_dead_code) {
+    if (ctx->is_recompile)
+      ctx->current_func->loop_offsets.push_back(get_istream_offset(ctx));
+  } else if (ctx->count_hotness) {
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::CountLoop));
+    CHECK_RESULT(emit_i32(ctx, ctx->current_func_env_index));
+    CHECK_RESULT(emit_i32(ctx, ctx->num_loops));
+  } else if (ctx->is_recompile) {
+    ctx->current_func->loop_offsets.push_back(get_istream_offset(ctx));
+  }
+  ctx->num_loops++;
   return Result::Ok;
 }
 
@@ -1086,6 +1416,10 @@ static Result on_if_expr(uint32_t num_types, Type* sig_types, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   TypeVector sig(sig_types, sig_types + num_types);
   CHECK_RESULT(typechecker_on_if(&ctx->typechecker, &sig));
+  if (ctx->is_dead_code) {
+    push_label(ctx, WABT_INVALID_OFFSET, WABT_INVALID_OFFSET);
+    return Result::Ok;
+  }
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::BrUnless));
   uint32_t fixup_offset = get_istream_offset(ctx);
   CHECK_RESULT(emit_i32(ctx, WABT_INVALID_OFFSET));
@@ -1097,10 +1431,17 @@ static Result on_else_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_else(&ctx->typechecker));
   Label* label = top_label(ctx);
+  if (label->is_dead)
+    return Result::Ok;
   uint32_t fixup_cond_offset = label->fixup_offset;
-  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Br));
-  label->fixup_offset = get_istream_offset(ctx);
-  CHECK_RESULT(emit_i32(ctx, WABT_INVALID_OFFSET));
+  if (ctx->is_dead_code) {
+    /* the true branch doesn't fall through, so it needs no br to the end */
+    label->fixup_offset = WABT_INVALID_OFFSET;
+  } else {
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Br));
+    label->fixup_offset = get_istream_offset(ctx);
+    CHECK_RESULT(emit_i32(ctx, WABT_INVALID_OFFSET));
+  }
   CHECK_RESULT(emit_i32_at(ctx, fixup_cond_offset, get_istream_offset(ctx)));
   return Result::Ok;
 }
@@ -1111,7 +1452,12 @@ static Result on_end_expr(void* user_data) {
   CHECK_RESULT(typechecker_get_label(&ctx->typechecker, 0, &label));
   LabelType label_type = label->label_type;
   CHECK_RESULT(typechecker_on_end(&ctx->typechecker));
-  if (label_type == LabelType::If || label_type == LabelType::Else) {
+  if (top_label(ctx)->is_dead) {
+    pop_label(ctx);
+    return Result::Ok;
+  }
+  if ((label_type == LabelType::If || label_type == LabelType::Else) &&
+      top_label(ctx)->fixup_offset != WABT_INVALID_OFFSET) {
     CHECK_RESULT(emit_i32_at(ctx, top_label(ctx)->fixup_offset,
                              get_istream_offset(ctx)));
   }
@@ -1125,6 +1471,8 @@ static Result on_br_expr(uint32_t depth, void* user_data) {
   uint32_t drop_count, keep_count;
   CHECK_RESULT(get_br_drop_keep_count(ctx, depth, &drop_count, &keep_count));
   CHECK_RESULT(typechecker_on_br(&ctx->typechecker, depth));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_br(ctx, depth, drop_count, keep_count));
   return Result::Ok;
 }
@@ -1133,7 +1481,21 @@ static Result on_br_if_expr(uint32_t depth, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   uint32_t drop_count, keep_count;
   CHECK_RESULT(typechecker_on_br_if(&ctx->typechecker, depth));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(get_br_drop_keep_count(ctx, depth, &drop_count, &keep_count));
+  if (!ctx->trailing_consts.empty()) {
+    /* the condition is a constant, so the branch is never or always taken */
+    if (pop_trailing_const(ctx).value == 0)
+      return Result::Ok;
+    return emit_br(ctx, depth, drop_count, keep_count);
+  }
+  if (drop_count == 0) {
+    /* nothing to drop, so the branch can be taken directly */
+    CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::BrIf));
+    CHECK_RESULT(emit_br_offset(ctx, depth, get_label(ctx, depth)->offset));
+    return Result::Ok;
+  }
   /* flip the br_if so if <cond> is true it can drop values from the stack */
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::BrUnless));
   uint32_t fixup_br_offset = get_istream_offset(ctx);
@@ -1143,12 +1505,19 @@ static Result on_br_if_expr(uint32_t depth, void* user_data) {
   return Result::Ok;
 }
 
-static Result on_br_table_expr(BinaryReaderContext* context,
-                               uint32_t num_targets,
-                               uint32_t* target_depths,
-                               uint32_t default_target_depth) {
-  Context* ctx = static_cast<Context*>(context->user_data);
+static Result emit_br_table(Context* ctx,
+                            uint32_t num_targets,
+                            uint32_t* target_depths,
+                            uint32_t default_target_depth) {
   CHECK_RESULT(typechecker_begin_br_table(&ctx->typechecker));
+  if (ctx->is_dead_code) {
+    for (uint32_t i = 0; i <= num_targets; ++i) {
+      uint32_t depth =
+          i != num_targets ? target_depths[i] : default_target_depth;
+      CHECK_RESULT(typechecker_on_br_table_target(&ctx->typechecker, depth));
+    }
+    return typechecker_end_br_table(&ctx->typechecker);
+  }
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::BrTable));
   CHECK_RESULT(emit_i32(ctx, num_targets));
   uint32_t fixup_table_offset = get_istream_offset(ctx);
@@ -1156,7 +1525,7 @@ static Result on_br_table_expr(BinaryReaderContext* context,
   /* not necessary for the interpreter, but it makes it easier to disassemble.
    * This opcode specifies how many bytes of data follow. */
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Data));
-  CHECK_RESULT(emit_i32(ctx, (num_targets + 1) * WABT_TABLE_ENTRY_SIZE));
+  CHECK_RESULT(emit_i32(ctx, (num_targets + 1) * get_table_entry_size(ctx)));
   CHECK_RESULT(emit_i32_at(ctx, fixup_table_offset, get_istream_offset(ctx)));
 
   for (uint32_t i = 0; i <= num_targets; ++i) {
@@ -1169,6 +1538,14 @@ static Result on_br_table_expr(BinaryReaderContext* context,
   return Result::Ok;
 }
 
+static Result on_br_table_expr(BinaryReaderContext* context,
+                               uint32_t num_targets,
+                               uint32_t* target_depths,
+                               uint32_t default_target_depth) {
+  return emit_br_table(static_cast<Context*>(context->user_data), num_targets,
+                       target_depths, default_target_depth);
+}
+
 static Result on_call_expr(uint32_t func_index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   InterpreterFunc* func = get_func_by_module_index(ctx, func_index);
@@ -1176,6 +1553,8 @@ static Result on_call_expr(uint32_t func_index, void* user_data) {
       get_signature_by_env_index(ctx, func->sig_index);
   CHECK_RESULT(typechecker_on_call(&ctx->typechecker, &sig->param_types,
                                    &sig->result_types));
+  if (ctx->is_dead_code)
+    return Result::Ok;
 
   if (func->is_host) {
     CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::CallHost));
@@ -1197,39 +1576,59 @@ static Result on_call_indirect_expr(uint32_t sig_index, void* user_data) {
   InterpreterFuncSignature* sig = get_signature_by_module_index(ctx, sig_index);
   CHECK_RESULT(typechecker_on_call_indirect(
       &ctx->typechecker, &sig->param_types, &sig->result_types));
+  if (ctx->is_dead_code)
+    return Result::Ok;
 
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::CallIndirect));
   CHECK_RESULT(emit_i32(ctx, ctx->module->table_index));
-  CHECK_RESULT(emit_i32(ctx, translate_sig_index_to_env(ctx, sig_index)));
+  /* Emit the canonical signature index, so the signature check at runtime is
+   * a single comparison with InterpreterTableEntry::sig_index. */
+  uint32_t env_sig_index = translate_sig_index_to_env(ctx, sig_index);
+  CHECK_RESULT(
+      emit_i32(ctx, get_canonical_sig_index(ctx->env, env_sig_index)));
   return Result::Ok;
 }
 
 static Result on_drop_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_drop(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Drop));
   return Result::Ok;
 }
 
 static Result on_i32_const_expr(uint32_t value, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
+  uint32_t height = ctx->typechecker.type_stack.size();
   CHECK_RESULT(typechecker_on_const(&ctx->typechecker, Type::I32));
-  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::I32Const));
-  CHECK_RESULT(emit_i32(ctx, value));
-  return Result::Ok;
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  if (ctx->register_ops) {
+    return push_pending_operand(ctx, WABT_REG_OPERAND_CONST, Type::I32, height,
+                                0, value);
+  }
+  return emit_const(ctx, Type::I32, value);
 }
 
 static Result on_i64_const_expr(uint64_t value, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
+  uint32_t height = ctx->typechecker.type_stack.size();
   CHECK_RESULT(typechecker_on_const(&ctx->typechecker, Type::I64));
-  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::I64Const));
-  CHECK_RESULT(emit_i64(ctx, value));
-  return Result::Ok;
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  if (ctx->register_ops) {
+    return push_pending_operand(ctx, WABT_REG_OPERAND_CONST, Type::I64, height,
+                                0, value);
+  }
+  return emit_const(ctx, Type::I64, value);
 }
 
 static Result on_f32_const_expr(uint32_t value_bits, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_const(&ctx->typechecker, Type::F32));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::F32Const));
   CHECK_RESULT(emit_i32(ctx, value_bits));
   return Result::Ok;
@@ -1238,6 +1637,8 @@ static Result on_f32_const_expr(uint32_t value_bits, void* user_data) {
 static Result on_f64_const_expr(uint64_t value_bits, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_const(&ctx->typechecker, Type::F64));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::F64Const));
   CHECK_RESULT(emit_i64(ctx, value_bits));
   return Result::Ok;
@@ -1248,6 +1649,8 @@ static Result on_get_global_expr(uint32_t global_index, void* user_data) {
   CHECK_GLOBAL(ctx, global_index);
   Type type = get_global_type_by_module_index(ctx, global_index);
   CHECK_RESULT(typechecker_on_get_global(&ctx->typechecker, type));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::GetGlobal));
   CHECK_RESULT(emit_i32(ctx, translate_global_index_to_env(ctx, global_index)));
   return Result::Ok;
@@ -1264,16 +1667,13 @@ static Result on_set_global_expr(uint32_t global_index, void* user_data) {
   }
   CHECK_RESULT(
       typechecker_on_set_global(&ctx->typechecker, global->typed_value.type));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::SetGlobal));
   CHECK_RESULT(emit_i32(ctx, translate_global_index_to_env(ctx, global_index)));
   return Result::Ok;
 }
 
-static uint32_t translate_local_index(Context* ctx, uint32_t local_index) {
-  return ctx->typechecker.type_stack.size() +
-         ctx->current_func->param_and_local_types.size() - local_index;
-}
-
 static Result on_get_local_expr(uint32_t local_index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_LOCAL(ctx, local_index);
@@ -1281,8 +1681,15 @@ static Result on_get_local_expr(uint32_t local_index, void* user_data) {
   /* Get the translated index before calling typechecker_on_get_local
    * because it will update the type stack size. We need the index to be
    * relative to the old stack size. */
+  uint32_t height = ctx->typechecker.type_stack.size();
   uint32_t translated_local_index = translate_local_index(ctx, local_index);
   CHECK_RESULT(typechecker_on_get_local(&ctx->typechecker, type));
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  if (ctx->register_ops) {
+    return push_pending_operand(ctx, WABT_REG_OPERAND_LOCAL, type, height,
+                                local_index, 0);
+  }
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::GetLocal));
   CHECK_RESULT(emit_i32(ctx, translated_local_index));
   return Result::Ok;
@@ -1293,6 +1700,11 @@ static Result on_set_local_expr(uint32_t local_index, void* user_data) {
   CHECK_LOCAL(ctx, local_index);
   Type type = get_local_type_by_index(ctx->current_func, local_index);
   CHECK_RESULT(typechecker_on_set_local(&ctx->typechecker, type));
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  if (ctx->has_pending_binop)
+    return emit_pending_binop(ctx, WABT_REG_OPERAND_LOCAL, local_index);
+  CHECK_RESULT(flush_pending(ctx));
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::SetLocal));
   CHECK_RESULT(emit_i32(ctx, translate_local_index(ctx, local_index)));
   return Result::Ok;
@@ -1303,6 +1715,8 @@ static Result on_tee_local_expr(uint32_t local_index, void* user_data) {
   CHECK_LOCAL(ctx, local_index);
   Type type = get_local_type_by_index(ctx->current_func, local_index);
   CHECK_RESULT(typechecker_on_tee_local(&ctx->typechecker, type));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::TeeLocal));
   CHECK_RESULT(emit_i32(ctx, translate_local_index(ctx, local_index)));
   return Result::Ok;
@@ -1312,11 +1726,75 @@ static Result on_grow_memory_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(check_has_memory(ctx, Opcode::GrowMemory));
   CHECK_RESULT(typechecker_on_grow_memory(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::GrowMemory));
   CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
   return Result::Ok;
 }
 
+static Result on_memory_copy_expr(void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  CHECK_RESULT(check_has_memory(ctx, Opcode::MemoryCopy));
+  CHECK_RESULT(typechecker_on_memory_copy(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::MemoryCopy));
+  CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
+  return Result::Ok;
+}
+
+static Result on_memory_fill_expr(void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  CHECK_RESULT(check_has_memory(ctx, Opcode::MemoryFill));
+  CHECK_RESULT(typechecker_on_memory_fill(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::MemoryFill));
+  CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
+  return Result::Ok;
+}
+
+static Result emit_load_store(Context* ctx, Opcode opcode, uint32_t offset) {
+  if (ctx->module->memory_index == 0 && is_load_opcode(opcode) &&
+      !ctx->trailing_consts.empty()) {
+    /* the address is a constant, so it is folded into the offset */
+    uint64_t address =
+        static_cast<uint32_t>(ctx->trailing_consts.back().value) +
+        static_cast<uint64_t>(offset);
+    if (address <= UINT32_MAX) {
+      WABT_STATIC_ASSERT(static_cast<int>(InterpreterOpcode::I64Load32UAbs) -
+                             static_cast<int>(InterpreterOpcode::I32LoadAbs) ==
+                         static_cast<int>(Opcode::I64Load32U) -
+                             static_cast<int>(Opcode::I32Load));
+      int abs_code = static_cast<int>(InterpreterOpcode::I32LoadAbs) +
+                     static_cast<int>(opcode) -
+                     static_cast<int>(Opcode::I32Load);
+      pop_trailing_const(ctx);
+      CHECK_RESULT(emit_opcode(ctx, static_cast<InterpreterOpcode>(abs_code)));
+      CHECK_RESULT(emit_i32(ctx, address));
+      return Result::Ok;
+    }
+  }
+
+  if (ctx->module->memory_index == 0) {
+    /* the *Mem0 opcodes are in the same order as the loads and stores */
+    WABT_STATIC_ASSERT(static_cast<int>(InterpreterOpcode::I64Store32Mem0) -
+                           static_cast<int>(InterpreterOpcode::I32LoadMem0) ==
+                       static_cast<int>(Opcode::I64Store32) -
+                           static_cast<int>(Opcode::I32Load));
+    int mem0_code = static_cast<int>(InterpreterOpcode::I32LoadMem0) +
+                    static_cast<int>(opcode) -
+                    static_cast<int>(Opcode::I32Load);
+    CHECK_RESULT(emit_opcode(ctx, static_cast<InterpreterOpcode>(mem0_code)));
+  } else {
+    CHECK_RESULT(emit_opcode(ctx, opcode));
+    CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
+  }
+  CHECK_RESULT(emit_i32(ctx, offset));
+  return Result::Ok;
+}
+
 static Result on_load_expr(Opcode opcode,
                            uint32_t alignment_log2,
                            uint32_t offset,
@@ -1326,10 +1804,9 @@ static Result on_load_expr(Opcode opcode,
   CHECK_RESULT(
       check_align(ctx, alignment_log2, get_opcode_memory_size(opcode)));
   CHECK_RESULT(typechecker_on_load(&ctx->typechecker, opcode));
-  CHECK_RESULT(emit_opcode(ctx, opcode));
-  CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
-  CHECK_RESULT(emit_i32(ctx, offset));
-  return Result::Ok;
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  return emit_load_store(ctx, opcode, offset);
 }
 
 static Result on_store_expr(Opcode opcode,
@@ -1341,16 +1818,17 @@ static Result on_store_expr(Opcode opcode,
   CHECK_RESULT(
       check_align(ctx, alignment_log2, get_opcode_memory_size(opcode)));
   CHECK_RESULT(typechecker_on_store(&ctx->typechecker, opcode));
-  CHECK_RESULT(emit_opcode(ctx, opcode));
-  CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
-  CHECK_RESULT(emit_i32(ctx, offset));
-  return Result::Ok;
+  if (ctx->is_dead_code)
+    return Result::Ok;
+  return emit_load_store(ctx, opcode, offset);
 }
 
 static Result on_current_memory_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(check_has_memory(ctx, Opcode::CurrentMemory));
   CHECK_RESULT(typechecker_on_current_memory(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::CurrentMemory));
   CHECK_RESULT(emit_i32(ctx, ctx->module->memory_index));
   return Result::Ok;
@@ -1365,6 +1843,8 @@ static Result on_return_expr(void* user_data) {
   uint32_t drop_count, keep_count;
   CHECK_RESULT(get_return_drop_keep_count(ctx, &drop_count, &keep_count));
   CHECK_RESULT(typechecker_on_return(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_drop_keep(ctx, drop_count, keep_count));
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Return));
   return Result::Ok;
@@ -1373,6 +1853,8 @@ static Result on_return_expr(void* user_data) {
 static Result on_select_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_select(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Select));
   return Result::Ok;
 }
@@ -1380,32 +1862,212 @@ static Result on_select_expr(void* user_data) {
 static Result on_unreachable_expr(void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   CHECK_RESULT(typechecker_on_unreachable(&ctx->typechecker));
+  if (ctx->is_dead_code)
+    return Result::Ok;
   CHECK_RESULT(emit_opcode(ctx, InterpreterOpcode::Unreachable));
   return Result::Ok;
 }
 
-Result read_binary_interpreter(InterpreterEnvironment* env,
-                               const void* data,
-                               size_t size,
-                               const ReadBinaryOptions* options,
-                               BinaryErrorHandler* error_handler,
-                               DefinedInterpreterModule** out_module) {
-  Context ctx;
-  BinaryReader reader;
+namespace {
+
+/* The instruction callbacks, called directly by read_function_body; see
+ * binary-reader-delegate.h. */
+struct FunctionBodyDelegate : BinaryReaderDelegate {
+  explicit FunctionBodyDelegate(Context* ctx) : ctx(ctx) {}
+
+  bool on_error(size_t offset, const char* message) {
+    return handle_error(offset, message, ctx);
+  }
+  Result on_opcode(size_t offset, Opcode opcode) {
+    return begin_instruction(ctx, opcode);
+  }
+  Result on_binary_expr(Opcode opcode) {
+    return wabt::on_binary_expr(opcode, ctx);
+  }
+  Result on_block_expr(uint32_t num_types, Type* sig_types) {
+    return wabt::on_block_expr(num_types, sig_types, ctx);
+  }
+  Result on_br_expr(uint32_t depth) { return wabt::on_br_expr(depth, ctx); }
+  Result on_br_if_expr(uint32_t depth) {
+    return wabt::on_br_if_expr(depth, ctx);
+  }
+  Result on_br_table_expr(size_t offset,
+                          uint32_t num_targets,
+                          uint32_t* target_depths,
+                          uint32_t default_target_depth) {
+    return emit_br_table(ctx, num_targets, target_depths,
+                         default_target_depth);
+  }
+  Result on_call_expr(uint32_t func_index) {
+    return wabt::on_call_expr(func_index, ctx);
+  }
+  Result on_call_indirect_expr(uint32_t sig_index) {
+    return wabt::on_call_indirect_expr(sig_index, ctx);
+  }
+  Result on_compare_expr(Opcode opcode) {
+    return wabt::on_binary_expr(opcode, ctx);
+  }
+  Result on_convert_expr(Opcode opcode) {
+    return wabt::on_unary_expr(opcode, ctx);
+  }
+  Result on_current_memory_expr() {
+    return wabt::on_current_memory_expr(ctx);
+  }
+  Result on_drop_expr() { return wabt::on_drop_expr(ctx); }
+  Result on_else_expr() { return wabt::on_else_expr(ctx); }
+  Result on_end_expr() { return wabt::on_end_expr(ctx); }
+  Result on_f32_const_expr(uint32_t value_bits) {
+    return wabt::on_f32_const_expr(value_bits, ctx);
+  }
+  Result on_f64_const_expr(uint64_t value_bits) {
+    return wabt::on_f64_const_expr(value_bits, ctx);
+  }
+  Result on_get_global_expr(uint32_t global_index) {
+    return wabt::on_get_global_expr(global_index, ctx);
+  }
+  Result on_get_local_expr(uint32_t local_index) {
+    return wabt::on_get_local_expr(local_index, ctx);
+  }
+  Result on_grow_memory_expr() { return wabt::on_grow_memory_expr(ctx); }
+  Result on_i32_const_expr(uint32_t value) {
+    return wabt::on_i32_const_expr(value, ctx);
+  }
+  Result on_i64_const_expr(uint64_t value) {
+    return wabt::on_i64_const_expr(value, ctx);
+  }
+  Result on_if_expr(uint32_t num_types, Type* sig_types) {
+    return wabt::on_if_expr(num_types, sig_types, ctx);
+  }
+  Result on_load_expr(Opcode opcode, uint32_t alignment_log2, uint32_t offset) {
+    return wabt::on_load_expr(opcode, alignment_log2, offset, ctx);
+  }
+  Result on_loop_expr(uint32_t num_types, Type* sig_types) {
+    return wabt::on_loop_expr(num_types, sig_types, ctx);
+  }
+  Result on_memory_copy_expr() { return wabt::on_memory_copy_expr(ctx); }
+  Result on_memory_fill_expr() { return wabt::on_memory_fill_expr(ctx); }
+  Result on_nop_expr() { return wabt::on_nop_expr(ctx); }
+  Result on_return_expr() { return wabt::on_return_expr(ctx); }
+  Result on_select_expr() { return wabt::on_select_expr(ctx); }
+  Result on_set_global_expr(uint32_t global_index) {
+    return wabt::on_set_global_expr(global_index, ctx);
+  }
+  Result on_set_local_expr(uint32_t local_index) {
+    return wabt::on_set_local_expr(local_index, ctx);
+  }
+  Result on_store_expr(Opcode opcode,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    return wabt::on_store_expr(opcode, alignment_log2, offset, ctx);
+  }
+  Result on_tee_local_expr(uint32_t local_index) {
+    return wabt::on_tee_local_expr(local_index, ctx);
+  }
+  Result on_unary_expr(Opcode opcode) {
+    return wabt::on_unary_expr(opcode, ctx);
+  }
+  Result on_unreachable_expr() { return wabt::on_unreachable_expr(ctx); }
+
+  Context* ctx;
+};
+
+}  // namespace
 
-  InterpreterEnvironmentMark mark = mark_interpreter_environment(env);
+static Result read_function_body_callback(BinaryReaderFunctionBody* body,
+                                          void* user_data) {
+  FunctionBodyDelegate delegate(static_cast<Context*>(user_data));
+  return read_function_body(body, &delegate);
+}
+
+/* The function pointers are still set, since they are used instead of
+ * read_function_body_callback when the reader logs. */
+static void set_function_body_callbacks(BinaryReader* reader) {
+  reader->on_opcode = on_opcode;
+  reader->read_function_body = read_function_body_callback;
+  reader->begin_function_body = begin_function_body;
+  reader->on_local_decl_count = on_local_decl_count;
+  reader->on_local_decl = on_local_decl;
+  reader->on_binary_expr = on_binary_expr;
+  reader->on_block_expr = on_block_expr;
+  reader->on_br_expr = on_br_expr;
+  reader->on_br_if_expr = on_br_if_expr;
+  reader->on_br_table_expr = on_br_table_expr;
+  reader->on_call_expr = on_call_expr;
+  reader->on_call_indirect_expr = on_call_indirect_expr;
+  reader->on_compare_expr = on_binary_expr;
+  reader->on_convert_expr = on_unary_expr;
+  reader->on_current_memory_expr = on_current_memory_expr;
+  reader->on_drop_expr = on_drop_expr;
+  reader->on_else_expr = on_else_expr;
+  reader->on_end_expr = on_end_expr;
+  reader->on_f32_const_expr = on_f32_const_expr;
+  reader->on_f64_const_expr = on_f64_const_expr;
+  reader->on_get_global_expr = on_get_global_expr;
+  reader->on_get_local_expr = on_get_local_expr;
+  reader->on_grow_memory_expr = on_grow_memory_expr;
+  reader->on_i32_const_expr = on_i32_const_expr;
+  reader->on_i64_const_expr = on_i64_const_expr;
+  reader->on_if_expr = on_if_expr;
+  reader->on_load_expr = on_load_expr;
+  reader->on_loop_expr = on_loop_expr;
+  reader->on_memory_copy_expr = on_memory_copy_expr;
+  reader->on_memory_fill_expr = on_memory_fill_expr;
+  reader->on_nop_expr = on_nop_expr;
+  reader->on_return_expr = on_return_expr;
+  reader->on_select_expr = on_select_expr;
+  reader->on_set_global_expr = on_set_global_expr;
+  reader->on_set_local_expr = on_set_local_expr;
+  reader->on_store_expr = on_store_expr;
+  reader->on_tee_local_expr = on_tee_local_expr;
+  reader->on_unary_expr = on_unary_expr;
+  reader->on_unreachable_expr = on_unreachable_expr;
+  reader->end_function_body = end_function_body;
+}
+
+/* Overwrites the CountCall at the entry of a function's baseline code with a
+ * br to its recompiled code; both are an opcode and a u32. */
+static Result emit_br_at(Context* ctx, uint32_t offset, uint32_t target) {
+  uint32_t istream_offset = ctx->istream_offset;
+  ctx->istream_offset = offset;
+  Result result = emit_opcode(ctx, InterpreterOpcode::Br);
+  if (WABT_SUCCEEDED(result))
+    result = emit_i32(ctx, target);
+  ctx->istream_offset = istream_offset;
+  return result;
+}
 
+static Result recompile_func(InterpreterEnvironment* env,
+                             InterpreterThread* thread,
+                             uint32_t func_index) {
+  DefinedInterpreterFunc* func = env->funcs[func_index]->as_defined();
   DefinedInterpreterModule* module =
-      new DefinedInterpreterModule(env->istream.size);
-  env->modules.emplace_back(module);
+      env->modules[func->module_index]->as_defined();
+  assert(!func->is_tiered_up && !module->binary.empty());
 
-  WABT_ZERO_MEMORY(reader);
+  uint32_t baseline_offset = func->offset;
+  uint32_t local_decl_count = func->local_decl_count;
+  uint32_t local_count = func->local_count;
+  std::vector<Type> param_and_local_types;
+  param_and_local_types.swap(func->param_and_local_types);
+
+  BinaryErrorHandler error_handler;
+  WABT_ZERO_MEMORY(error_handler);
+  BinaryReader reader;
 
+  Context ctx;
   ctx.reader = &reader;
-  ctx.error_handler = error_handler;
+  ctx.error_handler = &error_handler;
   ctx.env = env;
   ctx.module = module;
-  ctx.istream_offset = env->istream.size;
+  size_t istream_start = env->istream.size;
+  ctx.istream_offset = istream_start;
+  ctx.istream_encoding = env->istream_encoding;
+  ctx.register_ops = true;
+  ctx.is_recompile = true;
+  ctx.sig_index_mapping = module->sig_index_mapping;
+  ctx.func_index_mapping = module->func_index_mapping;
+  ctx.global_index_mapping = module->global_index_mapping;
+  ctx.num_func_imports = module->num_func_imports;
   CHECK_RESULT(init_mem_writer_existing(&ctx.istream_writer, &env->istream));
 
   TypeCheckerErrorHandler tc_error_handler;
@@ -1416,76 +2078,140 @@ Result read_binary_interpreter(InterpreterEnvironment* env,
   WABT_ZERO_MEMORY(reader);
   reader.user_data = &ctx;
   reader.on_error = on_error;
-  reader.on_signature_count = on_signature_count;
-  reader.on_signature = on_signature;
-  reader.on_import_count = on_import_count;
-  reader.on_import = on_import;
-  reader.on_import_func = on_import_func;
-  reader.on_import_table = on_import_table;
-  reader.on_import_memory = on_import_memory;
-  reader.on_import_global = on_import_global;
-  reader.on_function_signatures_count = on_function_signatures_count;
-  reader.on_function_signature = on_function_signature;
-  reader.on_table = on_table;
-  reader.on_memory = on_memory;
-  reader.on_global_count = on_global_count;
-  reader.begin_global = begin_global;
-  reader.end_global_init_expr = end_global_init_expr;
-  reader.on_export = on_export;
-  reader.on_start_function = on_start_function;
-  reader.begin_function_body = begin_function_body;
-  reader.on_local_decl_count = on_local_decl_count;
-  reader.on_local_decl = on_local_decl;
-  reader.on_binary_expr = on_binary_expr;
-  reader.on_block_expr = on_block_expr;
-  reader.on_br_expr = on_br_expr;
-  reader.on_br_if_expr = on_br_if_expr;
-  reader.on_br_table_expr = on_br_table_expr;
-  reader.on_call_expr = on_call_expr;
-  reader.on_call_indirect_expr = on_call_indirect_expr;
-  reader.on_compare_expr = on_binary_expr;
-  reader.on_convert_expr = on_unary_expr;
-  reader.on_current_memory_expr = on_current_memory_expr;
-  reader.on_drop_expr = on_drop_expr;
-  reader.on_else_expr = on_else_expr;
-  reader.on_end_expr = on_end_expr;
-  reader.on_f32_const_expr = on_f32_const_expr;
-  reader.on_f64_const_expr = on_f64_const_expr;
-  reader.on_get_global_expr = on_get_global_expr;
-  reader.on_get_local_expr = on_get_local_expr;
-  reader.on_grow_memory_expr = on_grow_memory_expr;
-  reader.on_i32_const_expr = on_i32_const_expr;
-  reader.on_i64_const_expr = on_i64_const_expr;
-  reader.on_if_expr = on_if_expr;
-  reader.on_load_expr = on_load_expr;
-  reader.on_loop_expr = on_loop_expr;
-  reader.on_nop_expr = on_nop_expr;
-  reader.on_return_expr = on_return_expr;
-  reader.on_select_expr = on_select_expr;
-  reader.on_set_global_expr = on_set_global_expr;
-  reader.on_set_local_expr = on_set_local_expr;
-  reader.on_store_expr = on_store_expr;
-  reader.on_tee_local_expr = on_tee_local_expr;
-  reader.on_unary_expr = on_unary_expr;
-  reader.on_unreachable_expr = on_unreachable_expr;
-  reader.end_function_body = end_function_body;
-  reader.end_elem_segment_init_expr = end_elem_segment_init_expr;
-  reader.on_elem_segment_function_index = on_elem_segment_function_index_check;
-  reader.on_data_segment_data = on_data_segment_data_check;
-  reader.on_init_expr_f32_const_expr = on_init_expr_f32_const_expr;
-  reader.on_init_expr_f64_const_expr = on_init_expr_f64_const_expr;
-  reader.on_init_expr_get_global_expr = on_init_expr_get_global_expr;
-  reader.on_init_expr_i32_const_expr = on_init_expr_i32_const_expr;
-  reader.on_init_expr_i64_const_expr = on_init_expr_i64_const_expr;
-
-  const uint32_t num_function_passes = 1;
-  Result result =
-      read_binary(data, size, &reader, num_function_passes, options);
+  set_function_body_callbacks(&reader);
+
+  ReadBinaryOptions options = WABT_READ_BINARY_OPTIONS_DEFAULT;
+  Result result = read_binary_indexed_function_body(
+      module->binary.data(), module->binary.size(), &module->binary_index,
+      func->module_func_index, &reader, &options);
+  if (WABT_SUCCEEDED(result))
+    result = emit_br_at(&ctx, baseline_offset, func->offset);
   steal_mem_writer_output_buffer(&ctx.istream_writer, &env->istream);
+
+  if (WABT_FAILED(result)) {
+    /* keep running the baseline code */
+    env->istream.size = istream_start;
+    func->offset = baseline_offset;
+    func->local_decl_count = local_decl_count;
+    func->local_count = local_count;
+    func->param_and_local_types.swap(param_and_local_types);
+    func->loop_offsets.clear();
+    return Result::Error;
+  }
+
+  env->istream.size = ctx.istream_offset;
+  for (InterpreterTable& table : env->tables) {
+    for (InterpreterTableEntry& entry : table.entries) {
+      if (!entry.is_host && entry.offset == baseline_offset)
+        entry.offset = func->offset;
+    }
+  }
+  func->is_tiered_up = true;
+  func->baseline_offset = baseline_offset;
+  return Result::Ok;
+}
+
+/* The state of reading one module, with read_binary or a BinaryReaderStream.
+ */
+struct InterpreterModuleStream {
+  Context ctx;
+  BinaryReader reader;
+  TypeCheckerErrorHandler tc_error_handler;
+  InterpreterEnvironmentMark mark;
+  uint32_t tier_up_threshold = 0;
+  const ReadBinaryOptions* options = nullptr;
+  BinaryReaderStream* binary_stream = nullptr;
+};
+
+static Result begin_read_module(
+    InterpreterModuleStream* stream,
+    InterpreterEnvironment* env,
+    const ReadBinaryOptions* options,
+    const ReadBinaryInterpreterOptions* interp_options,
+    BinaryErrorHandler* error_handler) {
+  Context* ctx = &stream->ctx;
+  BinaryReader* reader = &stream->reader;
+
+  /* The encoding can only be chosen while the istream is empty. */
+  if (env->istream.size == 0)
+    env->istream_encoding = interp_options->istream_encoding;
+  if (env->istream_encoding != interp_options->istream_encoding) {
+    ctx->error_handler = error_handler;
+    print_error(ctx, "istream encoding doesn't match the environment's");
+    return Result::Error;
+  }
+
+  stream->mark = mark_interpreter_environment(env);
+  stream->tier_up_threshold = interp_options->tier_up_threshold;
+  stream->options = options;
+
+  DefinedInterpreterModule* module =
+      new DefinedInterpreterModule(env->istream.size);
+  env->modules.emplace_back(module);
+
+  ctx->reader = reader;
+  ctx->error_handler = error_handler;
+  ctx->env = env;
+  ctx->module = module;
+  ctx->istream_offset = env->istream.size;
+  ctx->istream_encoding = env->istream_encoding;
+  ctx->register_ops = interp_options->register_ops;
+  ctx->count_hotness = interp_options->tier_up_threshold != 0;
+  ctx->data_segment_file = interp_options->data_segment_file;
+  CHECK_RESULT(init_mem_writer_existing(&ctx->istream_writer, &env->istream));
+
+  stream->tc_error_handler.on_error = on_typechecker_error;
+  stream->tc_error_handler.user_data = ctx;
+  ctx->typechecker.error_handler = &stream->tc_error_handler;
+
+  WABT_ZERO_MEMORY(*reader);
+  reader->user_data = ctx;
+  reader->on_error = on_error;
+  reader->on_signature_count = on_signature_count;
+  reader->on_signature = on_signature;
+  reader->on_import_count = on_import_count;
+  reader->on_import = on_import;
+  reader->on_import_func = on_import_func;
+  reader->on_import_table = on_import_table;
+  reader->on_import_memory = on_import_memory;
+  reader->on_import_global = on_import_global;
+  reader->on_function_signatures_count = on_function_signatures_count;
+  reader->on_function_signature = on_function_signature;
+  reader->on_table = on_table;
+  reader->on_memory = on_memory;
+  reader->on_global_count = on_global_count;
+  reader->begin_global = begin_global;
+  reader->end_global_init_expr = end_global_init_expr;
+  reader->on_export = on_export;
+  reader->on_start_function = on_start_function;
+  set_function_body_callbacks(reader);
+  reader->end_elem_segment_init_expr = end_elem_segment_init_expr;
+  reader->on_elem_segment_function_index =
+      on_elem_segment_function_index_check;
+  reader->on_data_segment_data = on_data_segment_data_check;
+  reader->on_init_expr_f32_const_expr = on_init_expr_f32_const_expr;
+  reader->on_init_expr_f64_const_expr = on_init_expr_f64_const_expr;
+  reader->on_init_expr_get_global_expr = on_init_expr_get_global_expr;
+  reader->on_init_expr_i32_const_expr = on_init_expr_i32_const_expr;
+  reader->on_init_expr_i64_const_expr = on_init_expr_i64_const_expr;
+  return Result::Ok;
+}
+
+/* |result| is the result of reading all of |data| with stream->reader. */
+static Result end_read_module(InterpreterModuleStream* stream,
+                              Result result,
+                              const void* data,
+                              size_t size,
+                              DefinedInterpreterModule** out_module) {
+  Context* ctx = &stream->ctx;
+  InterpreterEnvironment* env = ctx->env;
+  DefinedInterpreterModule* module = ctx->module;
+  steal_mem_writer_output_buffer(&ctx->istream_writer, &env->istream);
   if (WABT_SUCCEEDED(result)) {
     /* Another pass on the read binary to assign data and elem segments. */
+    BinaryReader reader;
     WABT_ZERO_MEMORY(reader);
-    reader.user_data = &ctx;
+    reader.user_data = ctx;
     reader.on_error = on_error;
     reader.end_elem_segment_init_expr = end_elem_segment_init_expr;
     reader.on_elem_segment_function_index = on_elem_segment_function_index;
@@ -1496,17 +2222,98 @@ Result read_binary_interpreter(InterpreterEnvironment* env,
     reader.on_init_expr_i32_const_expr = on_init_expr_i32_const_expr;
     reader.on_init_expr_i64_const_expr = on_init_expr_i64_const_expr;
 
-    result = read_binary(data, size, &reader, num_function_passes, options);
+    const uint32_t num_function_passes = 1;
+    result =
+        read_binary(data, size, &reader, num_function_passes, stream->options);
     assert(WABT_SUCCEEDED(result));
 
-    env->istream.size = ctx.istream_offset;
-    ctx.module->istream_end = env->istream.size;
+    env->istream.size = ctx->istream_offset;
+    module->istream_end = env->istream.size;
+    if (ctx->count_hotness) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      module->binary.assign(bytes, bytes + size);
+      result = read_binary_index(module->binary.data(), module->binary.size(),
+                                 &module->binary_index, nullptr);
+      assert(WABT_SUCCEEDED(result));
+      module->sig_index_mapping = ctx->sig_index_mapping;
+      module->func_index_mapping = ctx->func_index_mapping;
+      module->global_index_mapping = ctx->global_index_mapping;
+      module->num_func_imports = ctx->num_func_imports;
+      env->tier_up_threshold = stream->tier_up_threshold;
+      env->recompile_func = recompile_func;
+    }
     *out_module = module;
   } else {
-    reset_interpreter_environment_to_mark(env, mark);
+    reset_interpreter_environment_to_mark(env, stream->mark);
     *out_module = nullptr;
   }
   return result;
 }
 
+Result read_binary_interpreter(
+    InterpreterEnvironment* env,
+    const void* data,
+    size_t size,
+    const ReadBinaryOptions* options,
+    const ReadBinaryInterpreterOptions* interp_options,
+    BinaryErrorHandler* error_handler,
+    DefinedInterpreterModule** out_module) {
+  InterpreterModuleStream stream;
+  if (interp_options->data_segment_file)
+    assert(data == interp_options->data_segment_file->data);
+  CHECK_RESULT(begin_read_module(&stream, env, options, interp_options,
+                                 error_handler));
+
+  const uint32_t num_function_passes = 1;
+  Result result =
+      read_binary(data, size, &stream.reader, num_function_passes, options);
+  return end_read_module(&stream, result, data, size, out_module);
+}
+
+InterpreterModuleStream* new_interpreter_module_stream(
+    InterpreterEnvironment* env,
+    const ReadBinaryOptions* options,
+    const ReadBinaryInterpreterOptions* interp_options,
+    BinaryErrorHandler* error_handler) {
+  assert(!interp_options->data_segment_file);
+  InterpreterModuleStream* stream = new InterpreterModuleStream();
+  if (WABT_FAILED(begin_read_module(stream, env, options, interp_options,
+                                    error_handler))) {
+    delete stream;
+    return nullptr;
+  }
+  stream->binary_stream = new_binary_reader_stream(&stream->reader, options);
+  return stream;
+}
+
+Result feed_interpreter_module_stream(InterpreterModuleStream* stream,
+                                      const void* data,
+                                      size_t size) {
+  return feed_binary_reader_stream(stream->binary_stream, data, size);
+}
+
+Result finish_interpreter_module_stream(
+    InterpreterModuleStream* stream,
+    DefinedInterpreterModule** out_module) {
+  Result result = finish_binary_reader_stream(stream->binary_stream);
+  size_t size;
+  const void* data =
+      get_binary_reader_stream_data(stream->binary_stream, &size);
+  result = end_read_module(stream, result, data, size, out_module);
+  delete_binary_reader_stream(stream->binary_stream);
+  stream->binary_stream = nullptr;
+  return result;
+}
+
+void delete_interpreter_module_stream(InterpreterModuleStream* stream) {
+  if (stream->binary_stream) {
+    /* never finished; drop the partially read module */
+    Context* ctx = &stream->ctx;
+    steal_mem_writer_output_buffer(&ctx->istream_writer, &ctx->env->istream);
+    reset_interpreter_environment_to_mark(ctx->env, stream->mark);
+    delete_binary_reader_stream(stream->binary_stream);
+  }
+  delete stream;
+}
+
 }  // namespace wabt
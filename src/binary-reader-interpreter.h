@@ -24,14 +24,52 @@ namespace wabt {
 struct DefinedInterpreterModule;
 struct InterpreterEnvironment;
 struct ReadBinaryOptions;
+enum class InterpreterIstreamEncoding;
+
+struct ReadBinaryInterpreterOptions {
+  InterpreterIstreamEncoding istream_encoding;
+  /* compile integer binops whose operands are locals or constants to
+   * I32RegBinop/I64RegBinop */
+  bool register_ops;
+  /* if non-zero, count calls and loop iterations of each function, and
+   * recompile it with the optimizing options once a count reaches this */
+  uint32_t tier_up_threshold;
+  /* if non-null, the data being read is this file's contents, and data
+   * segments are mapped from it copy-on-write where page alignment allows,
+   * rather than copied */
+  const MappedFile* data_segment_file;
+};
+
+#define WABT_READ_BINARY_INTERPRETER_OPTIONS_DEFAULT \
+  { InterpreterIstreamEncoding::Packed, false, 0, nullptr }
 
 Result read_binary_interpreter(struct InterpreterEnvironment* env,
                                const void* data,
                                size_t size,
                                const struct ReadBinaryOptions* options,
+                               const ReadBinaryInterpreterOptions*,
                                BinaryErrorHandler*,
                                DefinedInterpreterModule** out_module);
 
+/* Compiles a module as it arrives in chunks of any size; see
+ * BinaryReaderStream. Each function is compiled as soon as its body has been
+ * fed. |env| must not be used until the stream is finished (or deleted, which
+ * drops the partially read module). data_segment_file must be null. Returns
+ * null if the module can't be read into |env|. */
+struct InterpreterModuleStream;
+
+InterpreterModuleStream* new_interpreter_module_stream(
+    struct InterpreterEnvironment* env,
+    const struct ReadBinaryOptions* options,
+    const ReadBinaryInterpreterOptions*,
+    BinaryErrorHandler*);
+Result feed_interpreter_module_stream(InterpreterModuleStream*,
+                                      const void* data,
+                                      size_t size);
+Result finish_interpreter_module_stream(InterpreterModuleStream*,
+                                        DefinedInterpreterModule** out_module);
+void delete_interpreter_module_stream(InterpreterModuleStream*);
+
 }  // namespace wabt
 
 #endif /* WABT_BINARY_READER_INTERPRETER_H_ */
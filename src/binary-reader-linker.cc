@@ -338,6 +338,15 @@ Result read_binary_linker(LinkerInputBinary* input_info,
   ReadBinaryOptions read_options = WABT_READ_BINARY_OPTIONS_DEFAULT;
   read_options.read_debug_names = true;
   read_options.log_stream = options->log_stream;
+  /* The other sections are copied as they are, using the offsets from
+   * begin_section, so their contents needn't be decoded. */
+  read_options.sections = get_section_mask(BinarySection::Custom) |
+                          get_section_mask(BinarySection::Import) |
+                          get_section_mask(BinarySection::Table) |
+                          get_section_mask(BinarySection::Memory) |
+                          get_section_mask(BinarySection::Export) |
+                          get_section_mask(BinarySection::Elem) |
+                          get_section_mask(BinarySection::Data);
   return read_binary(input_info->data, input_info->size, &reader, 1,
                      &read_options);
 }
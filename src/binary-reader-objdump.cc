@@ -21,8 +21,11 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
+#include "binary.h"
 #include "binary-reader.h"
 #include "literal.h"
 
@@ -30,20 +33,42 @@ namespace wabt {
 
 namespace {
 
-typedef std::vector<uint32_t> Uint32Vector;
+struct ObjdumpSection {
+  BinarySection section;
+  size_t offset;
+  uint32_t size;
+  bool has_count;
+  uint32_t count;
+  StringSlice name;
+};
+
+/* Everything the views need from outside the code section, collected by one
+ * read of the other sections before anything is printed. It has to come
+ * first because the names and relocations used by the disassembly follow the
+ * code section. The details view is rendered into a buffer as it is read. */
+struct Model {
+  bool has_version;
+  uint32_t version;
+  bool section_found;
+  std::vector<ObjdumpSection> sections;
+  std::vector<std::string> function_names;
+  std::vector<Reloc> code_relocations;
+  MemoryWriter details_writer;
+  Stream details_stream;
+};
 
 struct Context {
   ObjdumpOptions* options;
+  Model* model;
   Stream* out_stream;
   const uint8_t* data;
   size_t size;
   Opcode current_opcode;
   size_t current_opcode_offset;
+  size_t current_opcode_size;
   size_t last_opcode_end;
   int indent_level;
   bool print_details;
-  bool header_printed;
-  int section_found;
 
   uint32_t section_starts[kBinarySectionCount];
   BinarySection reloc_section;
@@ -53,20 +78,16 @@ struct Context {
 
 }  // namespace
 
-static bool should_print_details(Context* ctx) {
-  if (ctx->options->mode != ObjdumpMode::Details)
-    return false;
-  return ctx->print_details;
-}
-
 static void WABT_PRINTF_FORMAT(2, 3)
     print_details(Context* ctx, const char* fmt, ...) {
-  if (!should_print_details(ctx))
+  if (!ctx->print_details)
     return;
-  va_list args;
-  va_start(args, fmt);
-  vprintf(fmt, args);
-  va_end(args);
+  WABT_SNPRINTF_ALLOCA(buffer, length, fmt);
+  write_data(&ctx->model->details_stream, buffer, length, nullptr);
+}
+
+static bool section_matches(ObjdumpOptions* options, const char* name) {
+  return !options->section_name || !strcasecmp(options->section_name, name);
 }
 
 static Result begin_section(BinaryReaderContext* ctx,
@@ -75,39 +96,27 @@ static Result begin_section(BinaryReaderContext* ctx,
   Context* context = static_cast<Context*>(ctx->user_data);
   context->section_starts[static_cast<size_t>(section_code)] = ctx->offset;
 
-  const char* name = get_section_name(section_code);
+  ObjdumpSection section;
+  WABT_ZERO_MEMORY(section);
+  section.section = section_code;
+  section.offset = ctx->offset;
+  section.size = size;
+  if (section_code != BinarySection::Custom &&
+      section_code != BinarySection::Start) {
+    /* The contents of all the other sections start with their count. */
+    const uint8_t* p = ctx->data + ctx->offset;
+    section.has_count = read_u32_leb128(p, p + size, &section.count) != 0;
+  }
+  context->model->sections.push_back(section);
 
-  bool section_match = !context->options->section_name ||
-                       !strcasecmp(context->options->section_name, name);
+  const char* name = get_section_name(section_code);
+  bool section_match = section_matches(context->options, name);
   if (section_match)
-    context->section_found = true;
-
-  switch (context->options->mode) {
-    case ObjdumpMode::Prepass:
-      break;
-    case ObjdumpMode::Headers:
-      printf("%9s start=%#010" PRIzx " end=%#010" PRIzx " (size=%#010x) ", name,
-             ctx->offset, ctx->offset + size, size);
-      break;
-    case ObjdumpMode::Details:
-      if (section_match) {
-        if (section_code != BinarySection::Code)
-          printf("%s:\n", name);
-        context->print_details = true;
-      } else {
-        context->print_details = false;
-      }
-      break;
-    case ObjdumpMode::RawData:
-      if (section_match) {
-        printf("\nContents of section %s:\n", name);
-        write_memory_dump(context->out_stream, context->data + ctx->offset,
-                          size, ctx->offset, PrintChars::Yes, nullptr, nullptr);
-      }
-      break;
-    case ObjdumpMode::Disassemble:
-      break;
-  }
+    context->model->section_found = true;
+
+  context->print_details = context->options->details && section_match;
+  if (section_code != BinarySection::Code)
+    print_details(context, "%s:\n", name);
   return Result::Ok;
 }
 
@@ -115,140 +124,124 @@ static Result begin_custom_section(BinaryReaderContext* ctx,
                                    uint32_t size,
                                    StringSlice section_name) {
   Context* context = static_cast<Context*>(ctx->user_data);
+  context->model->sections.back().name = section_name;
   print_details(context, " - name: \"" PRIstringslice "\"\n",
                 WABT_PRINTF_STRING_SLICE_ARG(section_name));
-  if (context->options->mode == ObjdumpMode::Headers) {
-    printf("\"" PRIstringslice "\"\n",
-           WABT_PRINTF_STRING_SLICE_ARG(section_name));
-  }
   return Result::Ok;
 }
 
-static Result on_count(uint32_t count, void* user_data) {
-  Context* ctx = static_cast<Context*>(user_data);
-  if (ctx->options->mode == ObjdumpMode::Headers) {
-    printf("count: %d\n", count);
-  }
-  return Result::Ok;
+static void print_file_header(ObjdumpOptions* options, uint32_t version) {
+  const char* basename = strrchr(options->infile, '/');
+  if (basename)
+    basename++;
+  else
+    basename = options->infile;
+  printf("%s:\tfile format wasm %#08x\n", basename, version);
 }
 
 static Result begin_module(uint32_t version, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  if (ctx->options->print_header) {
-    const char* basename = strrchr(ctx->options->infile, '/');
-    if (basename)
-      basename++;
-    else
-      basename = ctx->options->infile;
-    printf("%s:\tfile format wasm %#08x\n", basename, version);
-    ctx->header_printed = true;
-  }
-
-  switch (ctx->options->mode) {
-    case ObjdumpMode::Headers:
-      printf("\n");
-      printf("Sections:\n\n");
-      break;
-    case ObjdumpMode::Details:
-      printf("\n");
-      printf("Section Details:\n\n");
-      break;
-    case ObjdumpMode::Disassemble:
-      printf("\n");
-      printf("Code Disassembly:\n\n");
-      break;
-    case ObjdumpMode::RawData:
-    case ObjdumpMode::Prepass:
-      break;
-  }
-
+  ctx->model->has_version = true;
+  ctx->model->version = version;
   return Result::Ok;
 }
 
-static Result end_module(void* user_data) {
-  Context* ctx = static_cast<Context*>(user_data);
-  if (ctx->options->section_name) {
-    if (!ctx->section_found) {
-      printf("Section not found: %s\n", ctx->options->section_name);
-      return Result::Error;
-    }
+static Result check_section_found(Context* ctx) {
+  if (ctx->options->section_name && !ctx->model->section_found) {
+    printf("Section not found: %s\n", ctx->options->section_name);
+    return Result::Error;
   }
-
   return Result::Ok;
 }
 
-static Result on_opcode(BinaryReaderContext* ctx, Opcode opcode) {
-  Context* context = static_cast<Context*>(ctx->user_data);
+/* The number of bytes used by the opcode at |offset|. This is more than
+ * get_opcode_encoded_size when the code after a prefix byte is a LEB128 that
+ * isn't minimal. */
+static size_t read_opcode_size(const uint8_t* data,
+                               size_t offset,
+                               size_t end) {
+  if (offset >= end || data[offset] != WABT_BINARY_PREFIX_BULK_MEMORY)
+    return 1;
+  uint32_t code;
+  return 1 + read_u32_leb128(data + offset + 1, data + end, &code);
+}
 
-  if (context->options->debug) {
-    const char* opcode_name = get_opcode_name(opcode);
-    printf("on_opcode: %#" PRIzx ": %s\n", ctx->offset, opcode_name);
-  }
+#define IMMEDIATE_OCTET_COUNT 9
 
-  if (context->last_opcode_end) {
-    if (ctx->offset != context->last_opcode_end + 1) {
-      uint8_t missing_opcode = ctx->data[context->last_opcode_end];
-      const char* opcode_name =
-          get_opcode_name(static_cast<Opcode>(missing_opcode));
-      fprintf(stderr, "warning: %#" PRIzx " missing opcode callback at %#" PRIzx
-                      " (%#02x=%s)\n",
-              ctx->offset, context->last_opcode_end + 1,
-              ctx->data[context->last_opcode_end], opcode_name);
-      return Result::Error;
-    }
+static char* append_hex_byte(char* p, uint8_t byte) {
+  static const char s_hex_digits[] = "0123456789abcdef";
+  *p++ = ' ';
+  *p++ = s_hex_digits[byte >> 4];
+  *p++ = s_hex_digits[byte & 0xf];
+  return p;
+}
+
+static void write_indent(int indent_level) {
+  static const char s_spaces[] = "                                ";
+  size_t size = indent_level * 2;
+  while (size > 0) {
+    size_t chunk = std::min(size, sizeof(s_spaces) - 1);
+    fwrite(s_spaces, 1, chunk, stdout);
+    size -= chunk;
   }
-
-  context->current_opcode_offset = ctx->offset;
-  context->current_opcode = opcode;
-  return Result::Ok;
 }
 
-#define IMMEDIATE_OCTET_COUNT 9
-
+/* This runs for every instruction, so the line is formatted by hand and
+ * written with a few fwrite calls instead of a printf per byte. */
 static void log_opcode(Context* ctx,
                        const uint8_t* data,
                        size_t data_size,
                        const char* fmt,
                        ...) {
   size_t offset = ctx->current_opcode_offset;
+  size_t opcode_size = ctx->current_opcode_size;
 
   // Print binary data
-  printf(" %06" PRIzx ": %02x", offset - 1,
-         static_cast<unsigned>(ctx->current_opcode));
+  char line[128];
+  char* p = line;
+  p += wabt_snprintf(p, 32, " %06" PRIzx ":", offset - opcode_size);
+  if (opcode_size == 1) {
+    p = append_hex_byte(p, static_cast<uint8_t>(ctx->current_opcode));
+  } else {
+    /* prefixed opcodes always have immediates, so |data| is non-null */
+    for (size_t i = opcode_size; i > 0; i--)
+      p = append_hex_byte(p, data[offset - i]);
+  }
   for (size_t i = 0; i < data_size && i < IMMEDIATE_OCTET_COUNT;
        i++, offset++) {
-    printf(" %02x", data[offset]);
+    p = append_hex_byte(p, data[offset]);
   }
-  for (size_t i = data_size + 1; i < IMMEDIATE_OCTET_COUNT; i++) {
-    printf("   ");
+  for (size_t i = data_size + opcode_size; i < IMMEDIATE_OCTET_COUNT; i++) {
+    memcpy(p, "   ", 3);
+    p += 3;
   }
-  printf(" | ");
+  memcpy(p, " | ", 3);
+  p += 3;
+  fwrite(line, 1, p - line, stdout);
 
   // Print disassemble
   int indent_level = ctx->indent_level;
   if (ctx->current_opcode == Opcode::Else)
     indent_level--;
-  for (int j = 0; j < indent_level; j++) {
-    printf("  ");
-  }
+  write_indent(indent_level);
 
   const char* opcode_name = get_opcode_name(ctx->current_opcode);
-  printf("%s", opcode_name);
+  fputs(opcode_name, stdout);
   if (fmt) {
-    printf(" ");
     va_list args;
     va_start(args, fmt);
-    vprintf(fmt, args);
+    line[0] = ' ';
+    size_t length = wabt_vsnprintf(line + 1, sizeof(line) - 1, fmt, args);
     va_end(args);
+    fwrite(line, 1, std::min(length + 1, sizeof(line) - 1), stdout);
   }
-
-  printf("\n");
+  putchar('\n');
 
   ctx->last_opcode_end = ctx->current_opcode_offset + data_size;
 
   if (ctx->options->relocs) {
-    if (ctx->next_reloc < ctx->options->code_relocations.size()) {
-      Reloc* reloc = &ctx->options->code_relocations[ctx->next_reloc];
+    if (ctx->next_reloc < ctx->model->code_relocations.size()) {
+      Reloc* reloc = &ctx->model->code_relocations[ctx->next_reloc];
       size_t code_start =
           ctx->section_starts[static_cast<size_t>(BinarySection::Code)];
       size_t abs_offset = code_start + reloc->offset;
@@ -271,78 +264,6 @@ static void log_opcode(Context* ctx,
   }
 }
 
-static Result on_opcode_bare(BinaryReaderContext* ctx) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  log_opcode(context, ctx->data, 0, nullptr);
-  return Result::Ok;
-}
-
-static Result on_opcode_uint32(BinaryReaderContext* ctx, uint32_t value) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  log_opcode(context, ctx->data, immediate_len, "%#x", value);
-  return Result::Ok;
-}
-
-static Result on_opcode_uint32_uint32(BinaryReaderContext* ctx,
-                                      uint32_t value,
-                                      uint32_t value2) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  log_opcode(context, ctx->data, immediate_len, "%lu %lu", value, value2);
-  return Result::Ok;
-}
-
-static Result on_opcode_uint64(BinaryReaderContext* ctx, uint64_t value) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  log_opcode(context, ctx->data, immediate_len, "%d", value);
-  return Result::Ok;
-}
-
-static Result on_opcode_f32(BinaryReaderContext* ctx, uint32_t value) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  char buffer[WABT_MAX_FLOAT_HEX];
-  write_float_hex(buffer, sizeof(buffer), value);
-  log_opcode(context, ctx->data, immediate_len, buffer);
-  return Result::Ok;
-}
-
-static Result on_opcode_f64(BinaryReaderContext* ctx, uint64_t value) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  char buffer[WABT_MAX_DOUBLE_HEX];
-  write_double_hex(buffer, sizeof(buffer), value);
-  log_opcode(context, ctx->data, immediate_len, buffer);
-  return Result::Ok;
-}
-
-Result on_br_table_expr(BinaryReaderContext* ctx,
-                        uint32_t num_targets,
-                        uint32_t* target_depths,
-                        uint32_t default_target_depth) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  size_t immediate_len = ctx->offset - context->current_opcode_offset;
-  /* TODO(sbc): Print targets */
-  log_opcode(context, ctx->data, immediate_len, nullptr);
-  return Result::Ok;
-}
-
-static Result on_end_func(void* user_data) {
-  Context* context = static_cast<Context*>(user_data);
-  log_opcode(context, nullptr, 0, nullptr);
-  return Result::Ok;
-}
-
-static Result on_end_expr(void* user_data) {
-  Context* context = static_cast<Context*>(user_data);
-  context->indent_level--;
-  assert(context->indent_level >= 0);
-  log_opcode(context, nullptr, 0, nullptr);
-  return Result::Ok;
-}
-
 static const char* type_name(Type type) {
   switch (type) {
     case Type::I32:
@@ -363,15 +284,113 @@ static const char* type_name(Type type) {
   }
 }
 
-static Result on_opcode_block_sig(BinaryReaderContext* ctx,
-                                  uint32_t num_types,
-                                  Type* sig_types) {
-  Context* context = static_cast<Context*>(ctx->user_data);
-  if (num_types)
-    log_opcode(context, ctx->data, 1, "%s", type_name(*sig_types));
-  else
-    log_opcode(context, ctx->data, 1, nullptr);
-  context->indent_level++;
+/* The whole body has been decoded when this is called, so each instruction
+ * starts where the previous one ended; the first one starts after the local
+ * declarations, see begin_function_body. */
+static Result on_function_body_instructions(
+    const BinaryReaderFunctionBody* body,
+    void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  const uint8_t* data = body->data;
+  const std::vector<BinaryReaderInstruction>& instructions = body->instructions;
+  size_t start = ctx->last_opcode_end;
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const BinaryReaderInstruction& instr = instructions[i];
+    size_t opcode_size = read_opcode_size(data, start, instr.offset);
+    ctx->current_opcode = instr.opcode;
+    ctx->current_opcode_offset = start + opcode_size;
+    ctx->current_opcode_size = opcode_size;
+    start = instr.offset;
+
+    if (ctx->options->debug) {
+      printf("on_opcode: %#" PRIzx ": %s\n", ctx->current_opcode_offset,
+             get_opcode_name(instr.opcode));
+    }
+
+    /* the reserved immediates must be 0, so they aren't recorded */
+    size_t immediate_len = instr.offset - ctx->current_opcode_offset;
+    switch (instr.opcode) {
+      case Opcode::Block:
+      case Opcode::Loop:
+      case Opcode::If:
+        if (instr.sig_type != Type::Void)
+          log_opcode(ctx, data, 1, "%s", type_name(instr.sig_type));
+        else
+          log_opcode(ctx, data, 1, nullptr);
+        ctx->indent_level++;
+        break;
+
+      case Opcode::End:
+        /* the last one ends the function, and has no block of its own */
+        if (i + 1 < instructions.size()) {
+          ctx->indent_level--;
+          assert(ctx->indent_level >= 0);
+        }
+        log_opcode(ctx, nullptr, 0, nullptr);
+        break;
+
+      case Opcode::Br:
+      case Opcode::BrIf:
+      case Opcode::Call:
+      case Opcode::GetGlobal:
+      case Opcode::GetLocal:
+      case Opcode::SetGlobal:
+      case Opcode::SetLocal:
+      case Opcode::TeeLocal:
+        log_opcode(ctx, data, immediate_len, "%#x", instr.index);
+        break;
+
+      case Opcode::I32Const:
+        log_opcode(ctx, data, immediate_len, "%#x", instr.i32);
+        break;
+
+      case Opcode::CurrentMemory:
+      case Opcode::GrowMemory:
+      case Opcode::MemoryFill:
+        log_opcode(ctx, data, immediate_len, "%#x", 0u);
+        break;
+
+      case Opcode::CallIndirect:
+        log_opcode(ctx, data, immediate_len, "%lu %lu", instr.index, 0u);
+        break;
+
+      case Opcode::MemoryCopy:
+        log_opcode(ctx, data, immediate_len, "%lu %lu", 0u, 0u);
+        break;
+
+      case Opcode::I64Const:
+        log_opcode(ctx, data, immediate_len, "%d", instr.i64);
+        break;
+
+      case Opcode::F32Const: {
+        char buffer[WABT_MAX_FLOAT_HEX];
+        write_float_hex(buffer, sizeof(buffer), instr.f32_bits);
+        log_opcode(ctx, data, immediate_len, buffer);
+        break;
+      }
+
+      case Opcode::F64Const: {
+        char buffer[WABT_MAX_DOUBLE_HEX];
+        write_double_hex(buffer, sizeof(buffer), instr.f64_bits);
+        log_opcode(ctx, data, immediate_len, buffer);
+        break;
+      }
+
+      case Opcode::BrTable:
+        /* TODO(sbc): Print targets */
+        log_opcode(ctx, data, immediate_len, nullptr);
+        break;
+
+      default:
+        if (get_opcode_memory_size(instr.opcode)) {
+          log_opcode(ctx, data, immediate_len, "%lu %lu",
+                     instr.memory.alignment_log2, instr.memory.offset);
+        } else {
+          log_opcode(ctx, data, 0, nullptr);
+        }
+        break;
+    }
+  }
   return Result::Ok;
 }
 
@@ -383,21 +402,19 @@ static Result on_signature(uint32_t index,
                            void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
 
-  if (!should_print_details(ctx))
-    return Result::Ok;
-  printf(" - [%d] (", index);
+  print_details(ctx, " - [%d] (", index);
   for (uint32_t i = 0; i < param_count; i++) {
     if (i != 0) {
-      printf(", ");
+      print_details(ctx, ", ");
     }
-    printf("%s", type_name(param_types[i]));
+    print_details(ctx, "%s", type_name(param_types[i]));
   }
-  printf(") -> ");
+  print_details(ctx, ") -> ");
   if (result_count)
-    printf("%s", type_name(result_types[0]));
+    print_details(ctx, "%s", type_name(result_types[0]));
   else
-    printf("nil");
-  printf("\n");
+    print_details(ctx, "nil");
+  print_details(ctx, "\n");
   return Result::Ok;
 }
 
@@ -409,20 +426,44 @@ static Result on_function_signature(uint32_t index,
   return Result::Ok;
 }
 
+/* Skips the size and the local declarations of the function body at
+ * context->offset, so the first opcode's size can be read like the others.
+ * Returns 0 if they are malformed; the reader reports that. */
+static size_t get_instructions_offset(BinaryReaderContext* context) {
+  const uint8_t* p = context->data + context->offset;
+  const uint8_t* end = context->data + context->size;
+  uint32_t body_size, num_local_decls;
+  size_t bytes_read;
+  if (!(bytes_read = read_u32_leb128(p, end, &body_size)))
+    return 0;
+  p += bytes_read;
+  if (!(bytes_read = read_u32_leb128(p, end, &num_local_decls)))
+    return 0;
+  p += bytes_read;
+  for (uint32_t i = 0; i < num_local_decls; ++i) {
+    uint32_t num_local_types, local_type;
+    if (!(bytes_read = read_u32_leb128(p, end, &num_local_types)))
+      return 0;
+    p += bytes_read;
+    if (!(bytes_read = read_i32_leb128(p, end, &local_type)))
+      return 0;
+    p += bytes_read;
+  }
+  return p - context->data;
+}
+
 static Result begin_function_body(BinaryReaderContext* context,
                                   uint32_t index) {
   Context* ctx = static_cast<Context*>(context->user_data);
 
-  if (ctx->options->mode == ObjdumpMode::Disassemble) {
-    if (index < ctx->options->function_names.size() &&
-        !ctx->options->function_names[index].empty())
-      printf("%06" PRIzx " <%s>:\n", context->offset,
-             ctx->options->function_names[index].c_str());
-    else
-      printf("%06" PRIzx " func[%d]:\n", context->offset, index);
-  }
+  const std::vector<std::string>& function_names = ctx->model->function_names;
+  if (index < function_names.size() && !function_names[index].empty())
+    printf("%06" PRIzx " <%s>:\n", context->offset,
+           function_names[index].c_str());
+  else
+    printf("%06" PRIzx " func[%d]:\n", context->offset, index);
 
-  ctx->last_opcode_end = 0;
+  ctx->last_opcode_end = get_instructions_offset(context);
   return Result::Ok;
 }
 
@@ -598,13 +639,10 @@ static Result on_function_name(uint32_t index,
                                StringSlice name,
                                void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  if (ctx->options->mode == ObjdumpMode::Prepass) {
-    ctx->options->function_names.resize(index+1);
-    ctx->options->function_names[index] = string_slice_to_string(name);
-  } else {
-    print_details(ctx, " - func[%d] " PRIstringslice "\n", index,
-                  WABT_PRINTF_STRING_SLICE_ARG(name));
-  }
+  ctx->model->function_names.resize(index+1);
+  ctx->model->function_names[index] = string_slice_to_string(name);
+  print_details(ctx, " - func[%d] " PRIstringslice "\n", index,
+                WABT_PRINTF_STRING_SLICE_ARG(name));
   return Result::Ok;
 }
 
@@ -640,10 +678,8 @@ Result on_reloc(RelocType type,
       ctx->section_starts[static_cast<size_t>(ctx->reloc_section)] + offset;
   print_details(ctx, "   - %-18s idx=%#-4x addend=%#-4x offset=%#x(file=%#x)\n",
                 get_reloc_type_name(type), index, addend, offset, total_offset);
-  if (ctx->options->mode == ObjdumpMode::Prepass &&
-      ctx->reloc_section == BinarySection::Code) {
-    ctx->options->code_relocations.emplace_back(type, offset, index, addend);
-  }
+  if (ctx->reloc_section == BinarySection::Code)
+    ctx->model->code_relocations.emplace_back(type, offset, index, addend);
   return Result::Ok;
 }
 
@@ -660,121 +696,194 @@ static Result on_data_segment_data(uint32_t index,
                                    uint32_t size,
                                    void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  if (should_print_details(ctx)) {
-    write_memory_dump(ctx->out_stream, src_data, size, 0, PrintChars::Yes,
-                      "  - ", nullptr);
+  if (ctx->print_details) {
+    write_memory_dump(&ctx->model->details_stream, src_data, size, 0,
+                      PrintChars::Yes, "  - ", nullptr);
   }
   return Result::Ok;
 }
 
+/* The first read collects the model, so it needs the custom sections for the
+ * names and relocations, and the sections whose details are printed. */
+static uint32_t get_sections_to_read(ObjdumpOptions* options) {
+  uint32_t sections = get_section_mask(BinarySection::Custom);
+  if (options->details) {
+    for (int i = 0; i < kBinarySectionCount; ++i) {
+      BinarySection section = static_cast<BinarySection>(i);
+      if (section != BinarySection::Code &&
+          section_matches(options, get_section_name(section)))
+        sections |= get_section_mask(section);
+    }
+  }
+  return sections;
+}
+
+static Result read_model(Context* ctx) {
+  BinaryReader reader;
+  WABT_ZERO_MEMORY(reader);
+  reader.begin_module = begin_module;
+
+  reader.begin_section = begin_section;
+
+  // User section
+  reader.begin_custom_section = begin_custom_section;
+
+  // Signature section
+  reader.on_signature = on_signature;
+
+  // Import section
+  reader.on_import_func = on_import_func;
+  reader.on_import_table = on_import_table;
+  reader.on_import_memory = on_import_memory;
+  reader.on_import_global = on_import_global;
+
+  // Function sigs section
+  reader.on_function_signature = on_function_signature;
+
+  // Table section
+  reader.on_table = on_table;
+
+  // Memory section
+  reader.on_memory = on_memory;
+
+  // Globl seciont
+  reader.begin_global = begin_global;
+
+  // Export section
+  reader.on_export = on_export;
+
+  // Elems section
+  reader.begin_elem_segment = begin_elem_segment;
+  reader.on_elem_segment_function_index = on_elem_segment_function_index;
+
+  // Data section
+  reader.begin_data_segment = begin_data_segment;
+  reader.on_data_segment_data = on_data_segment_data;
+
+  // Known "User" sections:
+  // - Names section
+  reader.on_function_name = on_function_name;
+  reader.on_local_name = on_local_name;
+
+  reader.on_reloc_count = on_reloc_count;
+  reader.on_reloc = on_reloc;
+
+  reader.on_init_expr_i32_const_expr = on_init_expr_i32_const_expr;
+  reader.on_init_expr_i64_const_expr = on_init_expr_i64_const_expr;
+  reader.on_init_expr_f32_const_expr = on_init_expr_f32_const_expr;
+  reader.on_init_expr_f64_const_expr = on_init_expr_f64_const_expr;
+  reader.on_init_expr_get_global_expr = on_init_expr_get_global_expr;
+
+  reader.user_data = ctx;
+
+  ReadBinaryOptions read_options = WABT_READ_BINARY_OPTIONS_DEFAULT;
+  read_options.read_debug_names = true;
+  read_options.log_stream = ctx->options->log_stream;
+  read_options.sections = get_sections_to_read(ctx->options);
+  return read_binary(ctx->data, ctx->size, &reader, 1, &read_options);
+}
+
+static Result dump_headers(Context* ctx) {
+  printf("\n");
+  printf("Sections:\n\n");
+
+  for (const ObjdumpSection& section : ctx->model->sections) {
+    const char* name = get_section_name(section.section);
+    printf("%9s start=%#010" PRIzx " end=%#010" PRIzx " (size=%#010x) ", name,
+           section.offset, section.offset + section.size, section.size);
+    if (section.section == BinarySection::Custom) {
+      printf("\"" PRIstringslice "\"\n",
+             WABT_PRINTF_STRING_SLICE_ARG(section.name));
+    } else if (section.has_count) {
+      printf("count: %d\n", section.count);
+    } else {
+      printf("\n");
+    }
+  }
+  return check_section_found(ctx);
+}
+
+static Result dump_details(Context* ctx) {
+  printf("\n");
+  printf("Section Details:\n\n");
+  const OutputBuffer& details = ctx->model->details_writer.buf;
+  fwrite(details.start, 1, details.size, stdout);
+  return check_section_found(ctx);
+}
+
+/* The code section is decoded here, once the model has the names and
+ * relocations, and the disassembly is written as it is decoded. */
+static Result dump_disassembly(Context* ctx) {
+  printf("\n");
+  printf("Code Disassembly:\n\n");
+
+  BinaryReader reader;
+  WABT_ZERO_MEMORY(reader);
+  reader.begin_function_body = begin_function_body;
+  reader.on_function_body_instructions = on_function_body_instructions;
+  reader.user_data = ctx;
+
+  ReadBinaryOptions read_options = WABT_READ_BINARY_OPTIONS_DEFAULT;
+  read_options.sections = get_section_mask(BinarySection::Code);
+  Result result = read_binary(ctx->data, ctx->size, &reader, 1, &read_options);
+  if (WABT_FAILED(result))
+    return result;
+  return check_section_found(ctx);
+}
+
+static Result dump_raw_data(Context* ctx) {
+  for (const ObjdumpSection& section : ctx->model->sections) {
+    const char* name = get_section_name(section.section);
+    if (section_matches(ctx->options, name)) {
+      printf("\nContents of section %s:\n", name);
+      write_memory_dump(ctx->out_stream, ctx->data + section.offset,
+                        section.size, section.offset, PrintChars::Yes, nullptr,
+                        nullptr);
+    }
+  }
+  return check_section_found(ctx);
+}
+
 Result read_binary_objdump(const uint8_t* data,
                            size_t size,
                            ObjdumpOptions* options) {
+  Model model;
+  model.has_version = false;
+  model.version = 0;
+  model.section_found = false;
+  init_mem_writer(&model.details_writer);
+  init_stream(&model.details_stream, &model.details_writer.base, nullptr);
+
   Context context;
   WABT_ZERO_MEMORY(context);
-  context.header_printed = false;
-  context.print_details = false;
-  context.section_found = false;
-  context.data = data;
-  context.size = size;
   context.options = options;
+  context.model = &model;
   context.out_stream = init_stdout_stream();
+  context.data = data;
+  context.size = size;
 
-  BinaryReader reader;
-  WABT_ZERO_MEMORY(reader);
-  if (options->mode == ObjdumpMode::Prepass) {
-    reader.on_function_name = on_function_name;
-    reader.on_reloc_count = on_reloc_count;
-    reader.on_reloc = on_reloc;
-  } else {
-    reader.begin_module = begin_module;
-    reader.end_module = end_module;
-
-    reader.begin_section = begin_section;
-
-    // User section
-    reader.begin_custom_section = begin_custom_section;
-
-    // Signature section
-    reader.on_signature_count = on_count;
-    reader.on_signature = on_signature;
-
-    // Import section
-    reader.on_import_count = on_count;
-    reader.on_import_func = on_import_func;
-    reader.on_import_table = on_import_table;
-    reader.on_import_memory = on_import_memory;
-    reader.on_import_global = on_import_global;
-
-    // Function sigs section
-    reader.on_function_signatures_count = on_count;
-    reader.on_function_signature = on_function_signature;
-
-    // Table section
-    reader.on_table_count = on_count;
-    reader.on_table = on_table;
-
-    // Memory section
-    reader.on_memory_count = on_count;
-    reader.on_memory = on_memory;
-
-    // Globl seciont
-    reader.begin_global = begin_global;
-    reader.on_global_count = on_count;
-
-    // Export section
-    reader.on_export_count = on_count;
-    reader.on_export = on_export;
-
-    // Body section
-    reader.on_function_bodies_count = on_count;
-    reader.begin_function_body = begin_function_body;
-
-    // Elems section
-    reader.begin_elem_segment = begin_elem_segment;
-    reader.on_elem_segment_count = on_count;
-    reader.on_elem_segment_function_index = on_elem_segment_function_index;
-
-    // Data section
-    reader.begin_data_segment = begin_data_segment;
-    reader.on_data_segment_data = on_data_segment_data;
-    reader.on_data_segment_count = on_count;
-
-    // Known "User" sections:
-    // - Names section
-    reader.on_function_name = on_function_name;
-    reader.on_local_name = on_local_name;
-
-    reader.on_reloc_count = on_reloc_count;
-    reader.on_reloc = on_reloc;
-
-    reader.on_init_expr_i32_const_expr = on_init_expr_i32_const_expr;
-    reader.on_init_expr_i64_const_expr = on_init_expr_i64_const_expr;
-    reader.on_init_expr_f32_const_expr = on_init_expr_f32_const_expr;
-    reader.on_init_expr_f64_const_expr = on_init_expr_f64_const_expr;
-    reader.on_init_expr_get_global_expr = on_init_expr_get_global_expr;
-  }
-
-  if (options->mode == ObjdumpMode::Disassemble) {
-    reader.on_opcode = on_opcode;
-    reader.on_opcode_bare = on_opcode_bare;
-    reader.on_opcode_uint32 = on_opcode_uint32;
-    reader.on_opcode_uint32_uint32 = on_opcode_uint32_uint32;
-    reader.on_opcode_uint64 = on_opcode_uint64;
-    reader.on_opcode_f32 = on_opcode_f32;
-    reader.on_opcode_f64 = on_opcode_f64;
-    reader.on_opcode_block_sig = on_opcode_block_sig;
-    reader.on_end_expr = on_end_expr;
-    reader.on_end_func = on_end_func;
-    reader.on_br_table_expr = on_br_table_expr;
+  /* If the module is malformed, print the views of what was read before the
+   * error, as far as they go. */
+  Result result = read_model(&context);
+  if (model.has_version) {
+    print_file_header(options, model.version);
+    Result view_result = Result::Ok;
+    if (options->headers)
+      view_result = dump_headers(&context);
+    if (WABT_SUCCEEDED(view_result) && options->details)
+      view_result = dump_details(&context);
+    if (WABT_SUCCEEDED(result) && WABT_SUCCEEDED(view_result)) {
+      if (options->disassemble)
+        view_result = dump_disassembly(&context);
+      if (WABT_SUCCEEDED(view_result) && options->raw)
+        view_result = dump_raw_data(&context);
+    }
+    if (WABT_FAILED(view_result))
+      result = view_result;
   }
 
-  reader.user_data = &context;
-
-  ReadBinaryOptions read_options = WABT_READ_BINARY_OPTIONS_DEFAULT;
-  read_options.read_debug_names = true;
-  read_options.log_stream = options->log_stream;
-  return read_binary(data, size, &reader, 1, &read_options);
+  close_mem_writer(&model.details_writer);
+  return result;
 }
 
 }  // namespace wabt
@@ -17,25 +17,11 @@
 #ifndef WABT_BINARY_READER_OBJDUMP_H_
 #define WABT_BINARY_READER_OBJDUMP_H_
 
-#include <string>
-#include <vector>
-
 #include "common.h"
 #include "stream.h"
 
 namespace wabt {
 
-struct Module;
-struct ReadBinaryOptions;
-
-enum class ObjdumpMode {
-  Prepass,
-  Headers,
-  Details,
-  Disassemble,
-  RawData,
-};
-
 struct ObjdumpOptions {
   Stream* log_stream;
   bool headers;
@@ -44,14 +30,15 @@ struct ObjdumpOptions {
   bool disassemble;
   bool debug;
   bool relocs;
-  ObjdumpMode mode;
   const char* infile;
   const char* section_name;
-  bool print_header;
-  std::vector<std::string> function_names;
-  std::vector<Reloc> code_relocations;
 };
 
+/* Print the requested views of the binary to stdout. The sections the views
+ * need are read once, up front, and the code section is only decoded if the
+ * disassembly is printed. The headers alone only need the section headers
+ * and the custom sections, so with just |headers| the contents of the other
+ * sections are skipped without being validated. */
 Result read_binary_objdump(const uint8_t* data,
                            size_t size,
                            ObjdumpOptions* options);
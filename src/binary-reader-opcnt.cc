@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "binary-reader-delegate.h"
 #include "binary-reader.h"
 #include "common.h"
 
@@ -35,32 +36,22 @@ struct Context {
 
 }  // namespace
 
-static Result add_int_counter_value(IntCounterVector* vec, intmax_t value) {
-  for (IntCounter& counter : *vec) {
-    if (counter.value == value) {
-      ++counter.count;
-      return Result::Ok;
-    }
-  }
-  vec->emplace_back(value, 1);
+static Result add_int_counter_value(IntCounterMap* map,
+                                    intmax_t value,
+                                    size_t count = 1) {
+  (*map)[value] += count;
   return Result::Ok;
 }
 
-static Result add_int_pair_counter_value(IntPairCounterVector* vec,
+static Result add_int_pair_counter_value(IntPairCounterMap* map,
                                          intmax_t first,
-                                         intmax_t second) {
-  for (IntPairCounter& pair : *vec) {
-    if (pair.first == first && pair.second == second) {
-      ++pair.count;
-      return Result::Ok;
-    }
-  }
-  vec->emplace_back(first, second, 1);
+                                         intmax_t second,
+                                         size_t count = 1) {
+  (*map)[std::make_pair(first, second)] += count;
   return Result::Ok;
 }
 
-static Result on_opcode(BinaryReaderContext* context, Opcode opcode) {
-  Context* ctx = static_cast<Context*>(context->user_data);
+static Result count_opcode(Context* ctx, Opcode opcode) {
   IntCounterVector& opcnt_vec = ctx->opcnt_data->opcode_vec;
   while (static_cast<size_t>(opcode) >= opcnt_vec.size()) {
     opcnt_vec.emplace_back(opcnt_vec.size(), 0);
@@ -69,25 +60,29 @@ static Result on_opcode(BinaryReaderContext* context, Opcode opcode) {
   return Result::Ok;
 }
 
+static Result on_opcode(BinaryReaderContext* context, Opcode opcode) {
+  return count_opcode(static_cast<Context*>(context->user_data), opcode);
+}
+
 static Result on_i32_const_expr(uint32_t value, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  return add_int_counter_value(&ctx->opcnt_data->i32_const_vec,
+  return add_int_counter_value(&ctx->opcnt_data->i32_const_map,
                                static_cast<int32_t>(value));
 }
 
 static Result on_get_local_expr(uint32_t local_index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  return add_int_counter_value(&ctx->opcnt_data->get_local_vec, local_index);
+  return add_int_counter_value(&ctx->opcnt_data->get_local_map, local_index);
 }
 
 static Result on_set_local_expr(uint32_t local_index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  return add_int_counter_value(&ctx->opcnt_data->set_local_vec, local_index);
+  return add_int_counter_value(&ctx->opcnt_data->set_local_map, local_index);
 }
 
 static  Result on_tee_local_expr(uint32_t local_index, void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
-  return add_int_counter_value(&ctx->opcnt_data->tee_local_vec, local_index);
+  return add_int_counter_value(&ctx->opcnt_data->tee_local_map, local_index);
 }
 
 static  Result on_load_expr(Opcode opcode,
@@ -96,7 +91,7 @@ static  Result on_load_expr(Opcode opcode,
                                 void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   if (opcode == Opcode::I32Load)
-    return add_int_pair_counter_value(&ctx->opcnt_data->i32_load_vec,
+    return add_int_pair_counter_value(&ctx->opcnt_data->i32_load_map,
                                       alignment_log2, offset);
   return Result::Ok;
 }
@@ -107,11 +102,101 @@ static  Result on_store_expr(Opcode opcode,
                                  void* user_data) {
   Context* ctx = static_cast<Context*>(user_data);
   if (opcode == Opcode::I32Store)
-    return add_int_pair_counter_value(&ctx->opcnt_data->i32_store_vec,
+    return add_int_pair_counter_value(&ctx->opcnt_data->i32_store_map,
                                       alignment_log2, offset);
   return Result::Ok;
 }
 
+namespace {
+
+/* The same callbacks, called directly by read_function_body; see
+ * binary-reader-delegate.h. */
+struct OpcntDelegate : BinaryReaderDelegate {
+  explicit OpcntDelegate(Context* ctx) : ctx(ctx) {}
+
+  Result on_opcode(size_t offset, Opcode opcode) {
+    return count_opcode(ctx, opcode);
+  }
+  Result on_i32_const_expr(uint32_t value) {
+    return wabt::on_i32_const_expr(value, ctx);
+  }
+  Result on_get_local_expr(uint32_t local_index) {
+    return wabt::on_get_local_expr(local_index, ctx);
+  }
+  Result on_set_local_expr(uint32_t local_index) {
+    return wabt::on_set_local_expr(local_index, ctx);
+  }
+  Result on_tee_local_expr(uint32_t local_index) {
+    return wabt::on_tee_local_expr(local_index, ctx);
+  }
+  Result on_load_expr(Opcode opcode, uint32_t alignment_log2, uint32_t offset) {
+    return wabt::on_load_expr(opcode, alignment_log2, offset, ctx);
+  }
+  Result on_store_expr(Opcode opcode,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    return wabt::on_store_expr(opcode, alignment_log2, offset, ctx);
+  }
+
+  Context* ctx;
+};
+
+}  // namespace
+
+static Result read_function_body_callback(BinaryReaderFunctionBody* body,
+                                          void* user_data) {
+  OpcntDelegate delegate(static_cast<Context*>(user_data));
+  return read_function_body(body, &delegate);
+}
+
+static void* begin_function_bodies_thread(uint32_t thread_index,
+                                          void* user_data) {
+  Context* thread_ctx = new Context();
+  thread_ctx->opcnt_data = new OpcntData();
+  return thread_ctx;
+}
+
+static void merge_int_counters(IntCounterMap* map,
+                               const IntCounterMap& other) {
+  for (const auto& counter : other)
+    add_int_counter_value(map, counter.first, counter.second);
+}
+
+static void merge_int_pair_counters(IntPairCounterMap* map,
+                                    const IntPairCounterMap& other) {
+  for (const auto& pair : other) {
+    add_int_pair_counter_value(map, pair.first.first, pair.first.second,
+                               pair.second);
+  }
+}
+
+void merge_opcnt_data(OpcntData* data, const OpcntData& other) {
+  IntCounterVector& opcode_vec = data->opcode_vec;
+  const IntCounterVector& other_opcode_vec = other.opcode_vec;
+  while (opcode_vec.size() < other_opcode_vec.size())
+    opcode_vec.emplace_back(opcode_vec.size(), 0);
+  for (size_t i = 0; i < other_opcode_vec.size(); ++i)
+    opcode_vec[i].count += other_opcode_vec[i].count;
+
+  merge_int_counters(&data->i32_const_map, other.i32_const_map);
+  merge_int_counters(&data->get_local_map, other.get_local_map);
+  merge_int_counters(&data->set_local_map, other.set_local_map);
+  merge_int_counters(&data->tee_local_map, other.tee_local_map);
+  merge_int_pair_counters(&data->i32_load_map, other.i32_load_map);
+  merge_int_pair_counters(&data->i32_store_map, other.i32_store_map);
+}
+
+static Result end_function_bodies_thread(uint32_t thread_index,
+                                         void* thread_user_data,
+                                         void* user_data) {
+  Context* ctx = static_cast<Context*>(user_data);
+  Context* thread_ctx = static_cast<Context*>(thread_user_data);
+  merge_opcnt_data(ctx->opcnt_data, *thread_ctx->opcnt_data);
+  delete thread_ctx->opcnt_data;
+  delete thread_ctx;
+  return Result::Ok;
+}
+
 Result read_binary_opcnt(const void* data,
                                   size_t size,
                                   const struct ReadBinaryOptions* options,
@@ -130,6 +215,12 @@ Result read_binary_opcnt(const void* data,
   reader.on_tee_local_expr = on_tee_local_expr;
   reader.on_load_expr = on_load_expr;
   reader.on_store_expr = on_store_expr;
+  /* The function pointers above are only used when the reader logs. */
+  reader.read_function_body = read_function_body_callback;
+  /* Each thread counts into its own OpcntData, which are added up at the
+   * end. */
+  reader.begin_function_bodies_thread = begin_function_bodies_thread;
+  reader.end_function_bodies_thread = end_function_bodies_thread;
 
   return read_binary(data, size, &reader, 1, options);
 }
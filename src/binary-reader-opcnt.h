@@ -18,7 +18,10 @@
 #define WABT_BINARY_READER_OPCNT_H_
 
 #include "common.h"
+#include "hash-util.h"
 
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace wabt {
@@ -44,19 +47,32 @@ struct IntPairCounter {
 };
 typedef std::vector<IntPairCounter> IntPairCounterVector;
 
+/* Counts by value. The values are sparse, so these are hashed, unlike the
+ * opcode counts, which are indexed by opcode. */
+typedef std::unordered_map<intmax_t, size_t> IntCounterMap;
+
+struct IntPairHash {
+  size_t operator()(const std::pair<intmax_t, intmax_t>& pair) const {
+    return hash_combine(pair.first, pair.second);
+  }
+};
+typedef std::unordered_map<std::pair<intmax_t, intmax_t>, size_t, IntPairHash>
+    IntPairCounterMap;
+
 struct OpcntData {
   IntCounterVector opcode_vec;
-  IntCounterVector i32_const_vec;
-  IntCounterVector get_local_vec;
-  IntCounterVector set_local_vec;
-  IntCounterVector tee_local_vec;
-  IntPairCounterVector i32_load_vec;
-  IntPairCounterVector i32_store_vec;
+  IntCounterMap i32_const_map;
+  IntCounterMap get_local_map;
+  IntCounterMap set_local_map;
+  IntCounterMap tee_local_map;
+  IntPairCounterMap i32_load_map;
+  IntPairCounterMap i32_store_map;
 };
 
-void init_opcnt_data(OpcntData* data);
-void destroy_opcnt_data(OpcntData* data);
+/* Add the counts in |other| to |data|. */
+void merge_opcnt_data(OpcntData* data, const OpcntData& other);
 
+/* The counts are added to those already in |opcnt_data|. */
 Result read_binary_opcnt(const void* data,
                          size_t size,
                          const struct ReadBinaryOptions* options,
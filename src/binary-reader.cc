@@ -24,9 +24,14 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "binary.h"
+#include "binary-reader-delegate.h"
 #include "config.h"
 #include "stream.h"
 
@@ -34,6 +39,15 @@
 #include <alloca.h>
 #endif
 
+/* SSE2 is part of the x86-64 baseline, so it is used without any extra
+ * compiler flags. */
+#if defined(__SSE2__) || defined(_M_X64)
+#define HAVE_SSE2 1
+#include <emmintrin.h>
+#else
+#define HAVE_SSE2 0
+#endif
+
 #define INDENT_SIZE 2
 
 #define INITIAL_PARAM_TYPES_CAPACITY 128
@@ -105,6 +119,16 @@ namespace {
   if (!(cond))                        \
     RAISE_ERROR(__VA_ARGS__);
 
+/* The first error raised on a thread decoding function bodies. */
+struct FunctionBodyError {
+  bool failed = false;
+  size_t offset = 0;
+  /* if on_error didn't handle it, the message to print once the threads are
+   * done */
+  bool handled = false;
+  std::string message;
+};
+
 struct Context {
   const uint8_t* data = nullptr;
   size_t data_size = 0;
@@ -112,9 +136,13 @@ struct Context {
   size_t read_end = 0; /* Either the section end or data_size. */
   BinaryReaderContext user_ctx;
   BinaryReader* reader = nullptr;
+  BinaryReader skip_reader; /* only reports errors, see read_section */
   jmp_buf error_jmp_buf;
   TypeVector param_types;
-  std::vector<uint32_t> target_depths;
+  BinaryReaderFunctionBody function_body;
+  std::vector<uint32_t> u32_values;
+  /* only set on the threads decoding function bodies */
+  FunctionBodyError* function_body_error = nullptr;
   const ReadBinaryOptions* options = nullptr;
   BinarySection last_known_section = BinarySection::Invalid;
   uint32_t num_signatures = 0;
@@ -131,12 +159,337 @@ struct Context {
   uint32_t num_function_bodies = 0;
 };
 
+/* The function bodies of the code section, shared by the threads decoding
+ * them. */
+struct FunctionBodyWork {
+  const std::vector<size_t>* offsets;
+  size_t batch_size;
+  std::atomic<size_t> next_body;
+  std::atomic<bool> failed;
+};
+
 struct LoggingContext {
   Stream* stream;
   BinaryReader* reader;
   int indent;
 };
 
+struct IndexContext {
+  BinaryIndex* index;
+  BinaryErrorHandler* error_handler;
+};
+
+#define ADAPTER_FORWARD0(member) \
+  return reader->member ? reader->member(reader->user_data) : Result::Ok
+
+#define ADAPTER_FORWARD(member, ...)                                     \
+  return reader->member ? reader->member(__VA_ARGS__, reader->user_data) \
+                        : Result::Ok
+
+#define ADAPTER_FORWARD_CTX0(member) \
+  return reader->member ? reader->member(get_context(offset)) : Result::Ok
+
+#define ADAPTER_FORWARD_CTX(member, ...)                                   \
+  return reader->member ? reader->member(get_context(offset), __VA_ARGS__) \
+                        : Result::Ok
+
+/* Forwards the callbacks of read_function_body to the function pointers of a
+ * BinaryReader. */
+struct BinaryReaderAdapter : BinaryReaderDelegate {
+  BinaryReaderAdapter(BinaryReader* reader,
+                      const BinaryReaderFunctionBody* body)
+      : reader(reader), body(body) {}
+
+  BinaryReaderContext* get_context(size_t offset) {
+    context.data = body->data;
+    context.size = body->size;
+    context.offset = offset;
+    context.user_data = reader->user_data;
+    return &context;
+  }
+
+  bool on_error(size_t offset, const char* message) {
+    return reader->on_error && reader->on_error(get_context(offset), message);
+  }
+
+  Result on_opcode(size_t offset, Opcode opcode) {
+    ADAPTER_FORWARD_CTX(on_opcode, opcode);
+  }
+  Result on_opcode_bare(size_t offset) {
+    ADAPTER_FORWARD_CTX0(on_opcode_bare);
+  }
+  Result on_opcode_uint32(size_t offset, uint32_t value) {
+    ADAPTER_FORWARD_CTX(on_opcode_uint32, value);
+  }
+  Result on_opcode_uint32_uint32(size_t offset,
+                                 uint32_t value,
+                                 uint32_t value2) {
+    ADAPTER_FORWARD_CTX(on_opcode_uint32_uint32, value, value2);
+  }
+  Result on_opcode_uint64(size_t offset, uint64_t value) {
+    ADAPTER_FORWARD_CTX(on_opcode_uint64, value);
+  }
+  Result on_opcode_f32(size_t offset, uint32_t value) {
+    ADAPTER_FORWARD_CTX(on_opcode_f32, value);
+  }
+  Result on_opcode_f64(size_t offset, uint64_t value) {
+    ADAPTER_FORWARD_CTX(on_opcode_f64, value);
+  }
+  Result on_opcode_block_sig(size_t offset,
+                             uint32_t num_types,
+                             Type* sig_types) {
+    ADAPTER_FORWARD_CTX(on_opcode_block_sig, num_types, sig_types);
+  }
+  Result on_binary_expr(Opcode opcode) {
+    ADAPTER_FORWARD(on_binary_expr, opcode);
+  }
+  Result on_block_expr(uint32_t num_types, Type* sig_types) {
+    ADAPTER_FORWARD(on_block_expr, num_types, sig_types);
+  }
+  Result on_br_expr(uint32_t depth) { ADAPTER_FORWARD(on_br_expr, depth); }
+  Result on_br_if_expr(uint32_t depth) {
+    ADAPTER_FORWARD(on_br_if_expr, depth);
+  }
+  Result on_br_table_expr(size_t offset,
+                          uint32_t num_targets,
+                          uint32_t* target_depths,
+                          uint32_t default_target_depth) {
+    ADAPTER_FORWARD_CTX(on_br_table_expr, num_targets, target_depths,
+                        default_target_depth);
+  }
+  Result on_call_expr(uint32_t func_index) {
+    ADAPTER_FORWARD(on_call_expr, func_index);
+  }
+  Result on_call_indirect_expr(uint32_t sig_index) {
+    ADAPTER_FORWARD(on_call_indirect_expr, sig_index);
+  }
+  Result on_compare_expr(Opcode opcode) {
+    ADAPTER_FORWARD(on_compare_expr, opcode);
+  }
+  Result on_convert_expr(Opcode opcode) {
+    ADAPTER_FORWARD(on_convert_expr, opcode);
+  }
+  Result on_drop_expr() { ADAPTER_FORWARD0(on_drop_expr); }
+  Result on_else_expr() { ADAPTER_FORWARD0(on_else_expr); }
+  Result on_end_expr() { ADAPTER_FORWARD0(on_end_expr); }
+  Result on_end_func() { ADAPTER_FORWARD0(on_end_func); }
+  Result on_f32_const_expr(uint32_t value_bits) {
+    ADAPTER_FORWARD(on_f32_const_expr, value_bits);
+  }
+  Result on_f64_const_expr(uint64_t value_bits) {
+    ADAPTER_FORWARD(on_f64_const_expr, value_bits);
+  }
+  Result on_get_global_expr(uint32_t global_index) {
+    ADAPTER_FORWARD(on_get_global_expr, global_index);
+  }
+  Result on_get_local_expr(uint32_t local_index) {
+    ADAPTER_FORWARD(on_get_local_expr, local_index);
+  }
+  Result on_grow_memory_expr() { ADAPTER_FORWARD0(on_grow_memory_expr); }
+  Result on_i32_const_expr(uint32_t value) {
+    ADAPTER_FORWARD(on_i32_const_expr, value);
+  }
+  Result on_i64_const_expr(uint64_t value) {
+    ADAPTER_FORWARD(on_i64_const_expr, value);
+  }
+  Result on_if_expr(uint32_t num_types, Type* sig_types) {
+    ADAPTER_FORWARD(on_if_expr, num_types, sig_types);
+  }
+  Result on_load_expr(Opcode opcode, uint32_t alignment_log2, uint32_t offset) {
+    ADAPTER_FORWARD(on_load_expr, opcode, alignment_log2, offset);
+  }
+  Result on_loop_expr(uint32_t num_types, Type* sig_types) {
+    ADAPTER_FORWARD(on_loop_expr, num_types, sig_types);
+  }
+  Result on_current_memory_expr() { ADAPTER_FORWARD0(on_current_memory_expr); }
+  Result on_memory_copy_expr() { ADAPTER_FORWARD0(on_memory_copy_expr); }
+  Result on_memory_fill_expr() { ADAPTER_FORWARD0(on_memory_fill_expr); }
+  Result on_nop_expr() { ADAPTER_FORWARD0(on_nop_expr); }
+  Result on_return_expr() { ADAPTER_FORWARD0(on_return_expr); }
+  Result on_select_expr() { ADAPTER_FORWARD0(on_select_expr); }
+  Result on_set_global_expr(uint32_t global_index) {
+    ADAPTER_FORWARD(on_set_global_expr, global_index);
+  }
+  Result on_set_local_expr(uint32_t local_index) {
+    ADAPTER_FORWARD(on_set_local_expr, local_index);
+  }
+  Result on_store_expr(Opcode opcode,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    ADAPTER_FORWARD(on_store_expr, opcode, alignment_log2, offset);
+  }
+  Result on_tee_local_expr(uint32_t local_index) {
+    ADAPTER_FORWARD(on_tee_local_expr, local_index);
+  }
+  Result on_unary_expr(Opcode opcode) {
+    ADAPTER_FORWARD(on_unary_expr, opcode);
+  }
+  Result on_unreachable_expr() { ADAPTER_FORWARD0(on_unreachable_expr); }
+
+  BinaryReader* reader;
+  const BinaryReaderFunctionBody* body;
+  BinaryReaderContext context;
+};
+
+/* Decodes the instructions of a function body into body->instructions, for
+ * the on_function_body_instructions callback. The callbacks are still
+ * forwarded, which only matters when logging. */
+struct InstructionRecorder : BinaryReaderAdapter {
+  InstructionRecorder(BinaryReader* reader, BinaryReaderFunctionBody* body)
+      : BinaryReaderAdapter(reader, body),
+        instructions(&body->instructions),
+        br_targets(&body->br_targets) {}
+
+  /* Immediates are read before the callback, so this moves the offset of the
+   * last instruction past them. */
+  BinaryReaderInstruction& finish() {
+    BinaryReaderInstruction& instr = instructions->back();
+    instr.offset = body->offset;
+    return instr;
+  }
+
+  Result finish_index(Result result, uint32_t index) {
+    finish().index = index;
+    return result;
+  }
+
+  Result finish_sig_type(Result result, uint32_t num_types, Type* sig_types) {
+    finish().sig_type = num_types ? sig_types[0] : Type::Void;
+    return result;
+  }
+
+  Result finish_memory(Result result,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    BinaryReaderMemoryImmediate& memory = finish().memory;
+    memory.alignment_log2 = alignment_log2;
+    memory.offset = offset;
+    return result;
+  }
+
+  Result on_opcode(size_t offset, Opcode opcode) {
+    instructions->emplace_back();
+    BinaryReaderInstruction& instr = instructions->back();
+    instr.opcode = opcode;
+    instr.offset = offset;
+    return BinaryReaderAdapter::on_opcode(offset, opcode);
+  }
+  Result on_block_expr(uint32_t num_types, Type* sig_types) {
+    return finish_sig_type(
+        BinaryReaderAdapter::on_block_expr(num_types, sig_types), num_types,
+        sig_types);
+  }
+  Result on_loop_expr(uint32_t num_types, Type* sig_types) {
+    return finish_sig_type(
+        BinaryReaderAdapter::on_loop_expr(num_types, sig_types), num_types,
+        sig_types);
+  }
+  Result on_if_expr(uint32_t num_types, Type* sig_types) {
+    return finish_sig_type(
+        BinaryReaderAdapter::on_if_expr(num_types, sig_types), num_types,
+        sig_types);
+  }
+  Result on_br_expr(uint32_t depth) {
+    return finish_index(BinaryReaderAdapter::on_br_expr(depth), depth);
+  }
+  Result on_br_if_expr(uint32_t depth) {
+    return finish_index(BinaryReaderAdapter::on_br_if_expr(depth), depth);
+  }
+  Result on_br_table_expr(size_t offset,
+                          uint32_t num_targets,
+                          uint32_t* target_depths,
+                          uint32_t default_target_depth) {
+    BinaryReaderBrTableImmediate& br_table = finish().br_table;
+    br_table.first_target = br_targets->size();
+    br_table.num_targets = num_targets;
+    br_table.default_target = default_target_depth;
+    br_targets->insert(br_targets->end(), target_depths,
+                       target_depths + num_targets);
+    return BinaryReaderAdapter::on_br_table_expr(
+        offset, num_targets, target_depths, default_target_depth);
+  }
+  Result on_call_expr(uint32_t func_index) {
+    return finish_index(BinaryReaderAdapter::on_call_expr(func_index),
+                        func_index);
+  }
+  Result on_call_indirect_expr(uint32_t sig_index) {
+    return finish_index(BinaryReaderAdapter::on_call_indirect_expr(sig_index),
+                        sig_index);
+  }
+  Result on_current_memory_expr() {
+    finish();
+    return BinaryReaderAdapter::on_current_memory_expr();
+  }
+  Result on_get_global_expr(uint32_t global_index) {
+    return finish_index(BinaryReaderAdapter::on_get_global_expr(global_index),
+                        global_index);
+  }
+  Result on_get_local_expr(uint32_t local_index) {
+    return finish_index(BinaryReaderAdapter::on_get_local_expr(local_index),
+                        local_index);
+  }
+  Result on_grow_memory_expr() {
+    finish();
+    return BinaryReaderAdapter::on_grow_memory_expr();
+  }
+  Result on_memory_copy_expr() {
+    finish();
+    return BinaryReaderAdapter::on_memory_copy_expr();
+  }
+  Result on_memory_fill_expr() {
+    finish();
+    return BinaryReaderAdapter::on_memory_fill_expr();
+  }
+  Result on_set_global_expr(uint32_t global_index) {
+    return finish_index(BinaryReaderAdapter::on_set_global_expr(global_index),
+                        global_index);
+  }
+  Result on_set_local_expr(uint32_t local_index) {
+    return finish_index(BinaryReaderAdapter::on_set_local_expr(local_index),
+                        local_index);
+  }
+  Result on_tee_local_expr(uint32_t local_index) {
+    return finish_index(BinaryReaderAdapter::on_tee_local_expr(local_index),
+                        local_index);
+  }
+  Result on_i32_const_expr(uint32_t value) {
+    finish().i32 = value;
+    return BinaryReaderAdapter::on_i32_const_expr(value);
+  }
+  Result on_i64_const_expr(uint64_t value) {
+    finish().i64 = value;
+    return BinaryReaderAdapter::on_i64_const_expr(value);
+  }
+  Result on_f32_const_expr(uint32_t value_bits) {
+    finish().f32_bits = value_bits;
+    return BinaryReaderAdapter::on_f32_const_expr(value_bits);
+  }
+  Result on_f64_const_expr(uint64_t value_bits) {
+    finish().f64_bits = value_bits;
+    return BinaryReaderAdapter::on_f64_const_expr(value_bits);
+  }
+  Result on_load_expr(Opcode opcode, uint32_t alignment_log2, uint32_t offset) {
+    return finish_memory(
+        BinaryReaderAdapter::on_load_expr(opcode, alignment_log2, offset),
+        alignment_log2, offset);
+  }
+  Result on_store_expr(Opcode opcode,
+                       uint32_t alignment_log2,
+                       uint32_t offset) {
+    return finish_memory(
+        BinaryReaderAdapter::on_store_expr(opcode, alignment_log2, offset),
+        alignment_log2, offset);
+  }
+
+  std::vector<BinaryReaderInstruction>* instructions;
+  std::vector<uint32_t>* br_targets;
+};
+
+#undef ADAPTER_FORWARD0
+#undef ADAPTER_FORWARD
+#undef ADAPTER_FORWARD_CTX0
+#undef ADAPTER_FORWARD_CTX
+
 }  // namespace
 
 static BinaryReaderContext* get_user_context(Context* ctx) {
@@ -155,7 +508,14 @@ static void WABT_PRINTF_FORMAT(2, 3)
     handled = ctx->reader->on_error(get_user_context(ctx), buffer);
   }
 
-  if (!handled) {
+  if (ctx->function_body_error) {
+    FunctionBodyError* error = ctx->function_body_error;
+    error->failed = true;
+    error->offset = ctx->offset;
+    error->handled = handled;
+    if (!handled)
+      error->message = buffer;
+  } else if (!handled) {
     /* Not great to just print, but we don't want to eat the error either. */
     fprintf(stderr, "*ERROR*: @0x%08zx: %s\n", ctx->offset, buffer);
   }
@@ -242,6 +602,87 @@ static void in_u32_leb128(Context* ctx, uint32_t* out_value, const char* desc) {
   ctx->offset += bytes_read;
 }
 
+size_t read_u32_leb128s(const uint8_t* p,
+                        const uint8_t* end,
+                        uint32_t* out_values,
+                        size_t count,
+                        size_t* out_size) {
+  const uint8_t* start = p;
+  size_t i = 0;
+#if HAVE_SSE2
+  /* Check 16 bytes at a time for continuation bits. Runs of single-byte
+   * values (the common case for indexes and depths) are copied out without
+   * testing each byte; a multi-byte value is decoded by read_u32_leb128. */
+  const __m128i zero = _mm_setzero_si128();
+  while (count - i >= 16 && end - p >= 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    uint32_t mask = _mm_movemask_epi8(bytes);
+    if (mask == 0) {
+      __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+      __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+      __m128i* out = reinterpret_cast<__m128i*>(out_values + i);
+      _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+      i += 16;
+      p += 16;
+      continue;
+    }
+
+    uint32_t num_single_bytes = wabt_ctz_u32(mask);
+    for (uint32_t j = 0; j < num_single_bytes; ++j)
+      out_values[i++] = p[j];
+    p += num_single_bytes;
+    size_t bytes_read = read_u32_leb128(p, end, &out_values[i]);
+    if (!bytes_read)
+      goto done;
+    p += bytes_read;
+    i++;
+  }
+#endif
+  for (; i < count; ++i) {
+    size_t bytes_read = read_u32_leb128(p, end, &out_values[i]);
+    if (!bytes_read)
+      break;
+    p += bytes_read;
+  }
+#if HAVE_SSE2
+done:
+#endif
+  *out_size = p - start;
+  return i;
+}
+
+/* Decodes a vector of |count| u32 leb128 values into ctx->u32_values, without
+ * moving ctx->offset; next_u32_leb128 then steps through them, so errors and
+ * callbacks still see the offset of each value. Returns the number of values
+ * decoded, which is less than |count| if one of them is malformed. */
+static uint32_t in_u32_leb128s(Context* ctx, uint32_t count) {
+  /* each value is at least one byte, so a bogus count can't overallocate */
+  size_t max_count = std::min<size_t>(count, ctx->read_end - ctx->offset);
+  ctx->u32_values.resize(max_count);
+  size_t size;
+  return read_u32_leb128s(ctx->data + ctx->offset, ctx->data + ctx->read_end,
+                          ctx->u32_values.data(), max_count, &size);
+}
+
+static uint32_t next_u32_leb128(Context* ctx,
+                                uint32_t index,
+                                uint32_t num_decoded,
+                                const char* desc) {
+  uint32_t value;
+  if (index < num_decoded) {
+    value = ctx->u32_values[index];
+    while (ctx->data[ctx->offset++] & 0x80) {
+    }
+  } else {
+    /* raises the same error as reading the values one at a time */
+    in_u32_leb128(ctx, &value, desc);
+  }
+  return value;
+}
+
 size_t read_i32_leb128(const uint8_t* p,
                        const uint8_t* end,
                        uint32_t* out_value) {
@@ -287,63 +728,72 @@ static void in_i32_leb128(Context* ctx, uint32_t* out_value, const char* desc) {
   ctx->offset += bytes_read;
 }
 
-static void in_i64_leb128(Context* ctx, uint64_t* out_value, const char* desc) {
-  const uint8_t* p = ctx->data + ctx->offset;
-  const uint8_t* end = ctx->data + ctx->read_end;
+size_t read_i64_leb128(const uint8_t* p,
+                       const uint8_t* end,
+                       uint64_t* out_value) {
 
   if (p < end && (p[0] & 0x80) == 0) {
     uint64_t result = LEB128_1(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 6);
-    ctx->offset += 1;
+    return 1;
   } else if (p + 1 < end && (p[1] & 0x80) == 0) {
     uint64_t result = LEB128_2(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 13);
-    ctx->offset += 2;
+    return 2;
   } else if (p + 2 < end && (p[2] & 0x80) == 0) {
     uint64_t result = LEB128_3(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 20);
-    ctx->offset += 3;
+    return 3;
   } else if (p + 3 < end && (p[3] & 0x80) == 0) {
     uint64_t result = LEB128_4(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 27);
-    ctx->offset += 4;
+    return 4;
   } else if (p + 4 < end && (p[4] & 0x80) == 0) {
     uint64_t result = LEB128_5(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 34);
-    ctx->offset += 5;
+    return 5;
   } else if (p + 5 < end && (p[5] & 0x80) == 0) {
     uint64_t result = LEB128_6(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 41);
-    ctx->offset += 6;
+    return 6;
   } else if (p + 6 < end && (p[6] & 0x80) == 0) {
     uint64_t result = LEB128_7(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 48);
-    ctx->offset += 7;
+    return 7;
   } else if (p + 7 < end && (p[7] & 0x80) == 0) {
     uint64_t result = LEB128_8(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 55);
-    ctx->offset += 8;
+    return 8;
   } else if (p + 8 < end && (p[8] & 0x80) == 0) {
     uint64_t result = LEB128_9(uint64_t);
     *out_value = SIGN_EXTEND(int64_t, result, 62);
-    ctx->offset += 9;
+    return 9;
   } else if (p + 9 < end && (p[9] & 0x80) == 0) {
     /* the top bits should be a sign-extension of the sign bit */
     bool sign_bit_set = (p[9] & 0x1);
     int top_bits = p[9] & 0xfe;
     if ((sign_bit_set && top_bits != 0x7e) ||
         (!sign_bit_set && top_bits != 0)) {
-      RAISE_ERROR("invalid i64 leb128: %s", desc);
+      return 0;
     }
     uint64_t result = LEB128_10(uint64_t);
     *out_value = result;
-    ctx->offset += 10;
+    return 10;
   } else {
     /* past the end */
-    RAISE_ERROR("unable to read i64 leb128: %s", desc);
+    return 0;
   }
 }
 
+static void in_i64_leb128(Context* ctx, uint64_t* out_value, const char* desc) {
+  const uint8_t* p = ctx->data + ctx->offset;
+  const uint8_t* end = ctx->data + ctx->read_end;
+  size_t bytes_read = read_i64_leb128(p, end, out_value);
+  if (!bytes_read)
+    RAISE_ERROR("unable to read i64 leb128: %s", desc);
+  ctx->offset += bytes_read;
+}
+
 #undef BYTE_AT
 #undef LEB128_1
 #undef LEB128_2
@@ -398,23 +848,6 @@ static bool is_valid_external_kind(uint8_t kind) {
   return kind < kExternalKindCount;
 }
 
-static bool is_concrete_type(Type type) {
-  switch (type) {
-    case Type::I32:
-    case Type::I64:
-    case Type::F32:
-    case Type::F64:
-      return true;
-
-    default:
-      return false;
-  }
-}
-
-static bool is_inline_sig_type(Type type) {
-  return is_concrete_type(type) || type == Type::Void;
-}
-
 static uint32_t num_total_funcs(Context* ctx) {
   return ctx->num_func_imports + ctx->num_function_signatures;
 }
@@ -497,7 +930,7 @@ static Result logging_begin_custom_section(BinaryReaderContext* context,
   static Result logging_begin_##name(BinaryReaderContext* context,          \
                                      uint32_t size) {                       \
     LoggingContext* ctx = static_cast<LoggingContext*>(context->user_data); \
-    LOGF("begin_" #name "(%u)\n", size);                                              \
+    LOGF("begin_" #name "(%u)\n", size);                                    \
     indent(ctx);                                                            \
     FORWARD_CTX(begin_##name, size);                                        \
   }
@@ -611,6 +1044,8 @@ LOGGING0(on_end_expr)
 LOGGING_UINT32_DESC(on_get_global_expr, "index")
 LOGGING_UINT32_DESC(on_get_local_expr, "index")
 LOGGING0(on_grow_memory_expr)
+LOGGING0(on_memory_copy_expr)
+LOGGING0(on_memory_fill_expr)
 LOGGING0(on_nop_expr)
 LOGGING0(on_return_expr)
 LOGGING0(on_select_expr)
@@ -940,6 +1375,13 @@ static Result logging_end_function_body_pass(uint32_t index,
   FORWARD(end_function_body_pass, index, pass);
 }
 
+static Result logging_on_function_body_instructions(
+    const BinaryReaderFunctionBody* body,
+    void* user_data) {
+  LoggingContext* ctx = static_cast<LoggingContext*>(user_data);
+  FORWARD(on_function_body_instructions, body);
+}
+
 static Result logging_on_data_segment_data(uint32_t index,
                                            const void* data,
                                            uint32_t size,
@@ -1163,435 +1605,53 @@ static void read_global_header(Context* ctx,
 }
 
 static void read_function_body(Context* ctx, uint32_t end_offset) {
-  bool seen_end_opcode = false;
-  while (ctx->offset < end_offset) {
-    uint8_t opcode_u8;
-    in_u8(ctx, &opcode_u8, "opcode");
-    Opcode opcode = static_cast<Opcode>(opcode_u8);
-    CALLBACK_CTX(on_opcode, opcode);
-    switch (opcode) {
-      case Opcode::Unreachable:
-        CALLBACK0(on_unreachable_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::Block: {
-        Type sig_type;
-        in_type(ctx, &sig_type, "block signature type");
-        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
-                           "expected valid block signature type");
-        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
-        CALLBACK(on_block_expr, num_types, &sig_type);
-        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
-        break;
-      }
-
-      case Opcode::Loop: {
-        Type sig_type;
-        in_type(ctx, &sig_type, "loop signature type");
-        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
-                           "expected valid block signature type");
-        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
-        CALLBACK(on_loop_expr, num_types, &sig_type);
-        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
-        break;
-      }
-
-      case Opcode::If: {
-        Type sig_type;
-        in_type(ctx, &sig_type, "if signature type");
-        RAISE_ERROR_UNLESS(is_inline_sig_type(sig_type),
-                           "expected valid block signature type");
-        uint32_t num_types = sig_type == Type::Void ? 0 : 1;
-        CALLBACK(on_if_expr, num_types, &sig_type);
-        CALLBACK_CTX(on_opcode_block_sig, num_types, &sig_type);
-        break;
-      }
-
-      case Opcode::Else:
-        CALLBACK0(on_else_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::Select:
-        CALLBACK0(on_select_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::Br: {
-        uint32_t depth;
-        in_u32_leb128(ctx, &depth, "br depth");
-        CALLBACK(on_br_expr, depth);
-        CALLBACK_CTX(on_opcode_uint32, depth);
-        break;
-      }
-
-      case Opcode::BrIf: {
-        uint32_t depth;
-        in_u32_leb128(ctx, &depth, "br_if depth");
-        CALLBACK(on_br_if_expr, depth);
-        CALLBACK_CTX(on_opcode_uint32, depth);
-        break;
-      }
-
-      case Opcode::BrTable: {
-        uint32_t num_targets;
-        in_u32_leb128(ctx, &num_targets, "br_table target count");
-        ctx->target_depths.resize(num_targets);
-
-        for (uint32_t i = 0; i < num_targets; ++i) {
-          uint32_t target_depth;
-          in_u32_leb128(ctx, &target_depth, "br_table target depth");
-          ctx->target_depths[i] = target_depth;
-        }
-
-        uint32_t default_target_depth;
-        in_u32_leb128(ctx, &default_target_depth,
-                      "br_table default target depth");
-
-        uint32_t* target_depths =
-            num_targets ? ctx->target_depths.data() : nullptr;
-
-        CALLBACK_CTX(on_br_table_expr, num_targets, target_depths,
-                     default_target_depth);
-        break;
-      }
-
-      case Opcode::Return:
-        CALLBACK0(on_return_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::Nop:
-        CALLBACK0(on_nop_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::Drop:
-        CALLBACK0(on_drop_expr);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::End:
-        if (ctx->offset == end_offset) {
-          seen_end_opcode = true;
-          CALLBACK0(on_end_func);
-        } else {
-          CALLBACK0(on_end_expr);
-        }
-        break;
-
-      case Opcode::I32Const: {
-        uint32_t value = 0;
-        in_i32_leb128(ctx, &value, "i32.const value");
-        CALLBACK(on_i32_const_expr, value);
-        CALLBACK_CTX(on_opcode_uint32, value);
-        break;
-      }
-
-      case Opcode::I64Const: {
-        uint64_t value = 0;
-        in_i64_leb128(ctx, &value, "i64.const value");
-        CALLBACK(on_i64_const_expr, value);
-        CALLBACK_CTX(on_opcode_uint64, value);
-        break;
-      }
-
-      case Opcode::F32Const: {
-        uint32_t value_bits = 0;
-        in_f32(ctx, &value_bits, "f32.const value");
-        CALLBACK(on_f32_const_expr, value_bits);
-        CALLBACK_CTX(on_opcode_f32, value_bits);
-        break;
-      }
-
-      case Opcode::F64Const: {
-        uint64_t value_bits = 0;
-        in_f64(ctx, &value_bits, "f64.const value");
-        CALLBACK(on_f64_const_expr, value_bits);
-        CALLBACK_CTX(on_opcode_f64, value_bits);
-        break;
-      }
-
-      case Opcode::GetGlobal: {
-        uint32_t global_index;
-        in_u32_leb128(ctx, &global_index, "get_global global index");
-        CALLBACK(on_get_global_expr, global_index);
-        CALLBACK_CTX(on_opcode_uint32, global_index);
-        break;
-      }
-
-      case Opcode::GetLocal: {
-        uint32_t local_index;
-        in_u32_leb128(ctx, &local_index, "get_local local index");
-        CALLBACK(on_get_local_expr, local_index);
-        CALLBACK_CTX(on_opcode_uint32, local_index);
-        break;
-      }
-
-      case Opcode::SetGlobal: {
-        uint32_t global_index;
-        in_u32_leb128(ctx, &global_index, "set_global global index");
-        CALLBACK(on_set_global_expr, global_index);
-        CALLBACK_CTX(on_opcode_uint32, global_index);
-        break;
-      }
-
-      case Opcode::SetLocal: {
-        uint32_t local_index;
-        in_u32_leb128(ctx, &local_index, "set_local local index");
-        CALLBACK(on_set_local_expr, local_index);
-        CALLBACK_CTX(on_opcode_uint32, local_index);
-        break;
-      }
-
-      case Opcode::Call: {
-        uint32_t func_index;
-        in_u32_leb128(ctx, &func_index, "call function index");
-        RAISE_ERROR_UNLESS(func_index < num_total_funcs(ctx),
-                           "invalid call function index");
-        CALLBACK(on_call_expr, func_index);
-        CALLBACK_CTX(on_opcode_uint32, func_index);
-        break;
-      }
-
-      case Opcode::CallIndirect: {
-        uint32_t sig_index;
-        in_u32_leb128(ctx, &sig_index, "call_indirect signature index");
-        RAISE_ERROR_UNLESS(sig_index < ctx->num_signatures,
-                           "invalid call_indirect signature index");
-        uint32_t reserved;
-        in_u32_leb128(ctx, &reserved, "call_indirect reserved");
-        RAISE_ERROR_UNLESS(reserved == 0,
-                           "call_indirect reserved value must be 0");
-        CALLBACK(on_call_indirect_expr, sig_index);
-        CALLBACK_CTX(on_opcode_uint32_uint32, sig_index, reserved);
-        break;
-      }
-
-      case Opcode::TeeLocal: {
-        uint32_t local_index;
-        in_u32_leb128(ctx, &local_index, "tee_local local index");
-        CALLBACK(on_tee_local_expr, local_index);
-        CALLBACK_CTX(on_opcode_uint32, local_index);
-        break;
-      }
-
-      case Opcode::I32Load8S:
-      case Opcode::I32Load8U:
-      case Opcode::I32Load16S:
-      case Opcode::I32Load16U:
-      case Opcode::I64Load8S:
-      case Opcode::I64Load8U:
-      case Opcode::I64Load16S:
-      case Opcode::I64Load16U:
-      case Opcode::I64Load32S:
-      case Opcode::I64Load32U:
-      case Opcode::I32Load:
-      case Opcode::I64Load:
-      case Opcode::F32Load:
-      case Opcode::F64Load: {
-        uint32_t alignment_log2;
-        in_u32_leb128(ctx, &alignment_log2, "load alignment");
-        uint32_t offset;
-        in_u32_leb128(ctx, &offset, "load offset");
-
-        CALLBACK(on_load_expr, opcode, alignment_log2, offset);
-        CALLBACK_CTX(on_opcode_uint32_uint32, alignment_log2, offset);
-        break;
-      }
-
-      case Opcode::I32Store8:
-      case Opcode::I32Store16:
-      case Opcode::I64Store8:
-      case Opcode::I64Store16:
-      case Opcode::I64Store32:
-      case Opcode::I32Store:
-      case Opcode::I64Store:
-      case Opcode::F32Store:
-      case Opcode::F64Store: {
-        uint32_t alignment_log2;
-        in_u32_leb128(ctx, &alignment_log2, "store alignment");
-        uint32_t offset;
-        in_u32_leb128(ctx, &offset, "store offset");
-
-        CALLBACK(on_store_expr, opcode, alignment_log2, offset);
-        CALLBACK_CTX(on_opcode_uint32_uint32, alignment_log2, offset);
-        break;
-      }
-
-      case Opcode::CurrentMemory: {
-        uint32_t reserved;
-        in_u32_leb128(ctx, &reserved, "current_memory reserved");
-        RAISE_ERROR_UNLESS(reserved == 0,
-                           "current_memory reserved value must be 0");
-        CALLBACK0(on_current_memory_expr);
-        CALLBACK_CTX(on_opcode_uint32, reserved);
-        break;
-      }
-
-      case Opcode::GrowMemory: {
-        uint32_t reserved;
-        in_u32_leb128(ctx, &reserved, "grow_memory reserved");
-        RAISE_ERROR_UNLESS(reserved == 0,
-                           "grow_memory reserved value must be 0");
-        CALLBACK0(on_grow_memory_expr);
-        CALLBACK_CTX(on_opcode_uint32, reserved);
-        break;
-      }
-
-      case Opcode::I32Add:
-      case Opcode::I32Sub:
-      case Opcode::I32Mul:
-      case Opcode::I32DivS:
-      case Opcode::I32DivU:
-      case Opcode::I32RemS:
-      case Opcode::I32RemU:
-      case Opcode::I32And:
-      case Opcode::I32Or:
-      case Opcode::I32Xor:
-      case Opcode::I32Shl:
-      case Opcode::I32ShrU:
-      case Opcode::I32ShrS:
-      case Opcode::I32Rotr:
-      case Opcode::I32Rotl:
-      case Opcode::I64Add:
-      case Opcode::I64Sub:
-      case Opcode::I64Mul:
-      case Opcode::I64DivS:
-      case Opcode::I64DivU:
-      case Opcode::I64RemS:
-      case Opcode::I64RemU:
-      case Opcode::I64And:
-      case Opcode::I64Or:
-      case Opcode::I64Xor:
-      case Opcode::I64Shl:
-      case Opcode::I64ShrU:
-      case Opcode::I64ShrS:
-      case Opcode::I64Rotr:
-      case Opcode::I64Rotl:
-      case Opcode::F32Add:
-      case Opcode::F32Sub:
-      case Opcode::F32Mul:
-      case Opcode::F32Div:
-      case Opcode::F32Min:
-      case Opcode::F32Max:
-      case Opcode::F32Copysign:
-      case Opcode::F64Add:
-      case Opcode::F64Sub:
-      case Opcode::F64Mul:
-      case Opcode::F64Div:
-      case Opcode::F64Min:
-      case Opcode::F64Max:
-      case Opcode::F64Copysign:
-        CALLBACK(on_binary_expr, opcode);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::I32Eq:
-      case Opcode::I32Ne:
-      case Opcode::I32LtS:
-      case Opcode::I32LeS:
-      case Opcode::I32LtU:
-      case Opcode::I32LeU:
-      case Opcode::I32GtS:
-      case Opcode::I32GeS:
-      case Opcode::I32GtU:
-      case Opcode::I32GeU:
-      case Opcode::I64Eq:
-      case Opcode::I64Ne:
-      case Opcode::I64LtS:
-      case Opcode::I64LeS:
-      case Opcode::I64LtU:
-      case Opcode::I64LeU:
-      case Opcode::I64GtS:
-      case Opcode::I64GeS:
-      case Opcode::I64GtU:
-      case Opcode::I64GeU:
-      case Opcode::F32Eq:
-      case Opcode::F32Ne:
-      case Opcode::F32Lt:
-      case Opcode::F32Le:
-      case Opcode::F32Gt:
-      case Opcode::F32Ge:
-      case Opcode::F64Eq:
-      case Opcode::F64Ne:
-      case Opcode::F64Lt:
-      case Opcode::F64Le:
-      case Opcode::F64Gt:
-      case Opcode::F64Ge:
-        CALLBACK(on_compare_expr, opcode);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::I32Clz:
-      case Opcode::I32Ctz:
-      case Opcode::I32Popcnt:
-      case Opcode::I64Clz:
-      case Opcode::I64Ctz:
-      case Opcode::I64Popcnt:
-      case Opcode::F32Abs:
-      case Opcode::F32Neg:
-      case Opcode::F32Ceil:
-      case Opcode::F32Floor:
-      case Opcode::F32Trunc:
-      case Opcode::F32Nearest:
-      case Opcode::F32Sqrt:
-      case Opcode::F64Abs:
-      case Opcode::F64Neg:
-      case Opcode::F64Ceil:
-      case Opcode::F64Floor:
-      case Opcode::F64Trunc:
-      case Opcode::F64Nearest:
-      case Opcode::F64Sqrt:
-        CALLBACK(on_unary_expr, opcode);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      case Opcode::I32TruncSF32:
-      case Opcode::I32TruncSF64:
-      case Opcode::I32TruncUF32:
-      case Opcode::I32TruncUF64:
-      case Opcode::I32WrapI64:
-      case Opcode::I64TruncSF32:
-      case Opcode::I64TruncSF64:
-      case Opcode::I64TruncUF32:
-      case Opcode::I64TruncUF64:
-      case Opcode::I64ExtendSI32:
-      case Opcode::I64ExtendUI32:
-      case Opcode::F32ConvertSI32:
-      case Opcode::F32ConvertUI32:
-      case Opcode::F32ConvertSI64:
-      case Opcode::F32ConvertUI64:
-      case Opcode::F32DemoteF64:
-      case Opcode::F32ReinterpretI32:
-      case Opcode::F64ConvertSI32:
-      case Opcode::F64ConvertUI32:
-      case Opcode::F64ConvertSI64:
-      case Opcode::F64ConvertUI64:
-      case Opcode::F64PromoteF32:
-      case Opcode::F64ReinterpretI64:
-      case Opcode::I32ReinterpretF32:
-      case Opcode::I64ReinterpretF64:
-      case Opcode::I32Eqz:
-      case Opcode::I64Eqz:
-        CALLBACK(on_convert_expr, opcode);
-        CALLBACK_CTX0(on_opcode_bare);
-        break;
-
-      default:
-        RAISE_ERROR("unexpected opcode: %d (0x%x)", static_cast<int>(opcode),
-                    static_cast<unsigned>(opcode));
-    }
+  BinaryReaderFunctionBody* body = &ctx->function_body;
+  body->data = ctx->data;
+  body->size = ctx->data_size;
+  body->offset = ctx->offset;
+  body->end_offset = end_offset;
+  body->read_end = ctx->read_end;
+  body->num_funcs = num_total_funcs(ctx);
+  body->num_signatures = ctx->num_signatures;
+
+  Result result;
+  if (ctx->reader->read_function_body) {
+    result = ctx->reader->read_function_body(body, ctx->reader->user_data);
+  } else if (ctx->reader->on_function_body_instructions) {
+    body->instructions.clear();
+    body->br_targets.clear();
+    InstructionRecorder recorder(ctx->reader, body);
+    result = read_function_body(body, &recorder);
+  } else {
+    BinaryReaderAdapter adapter(ctx->reader, body);
+    result = read_function_body(body, &adapter);
+  }
+  ctx->offset = body->offset;
+  /* the error has already been reported */
+  if (WABT_FAILED(result))
+    longjmp(ctx->error_jmp_buf, 1);
+
+  /* as with read_function_body, the callback reports its own errors */
+  if (!ctx->reader->read_function_body &&
+      ctx->reader->on_function_body_instructions &&
+      WABT_FAILED(ctx->reader->on_function_body_instructions(
+          body, ctx->reader->user_data))) {
+    longjmp(ctx->error_jmp_buf, 1);
   }
-  RAISE_ERROR_UNLESS(ctx->offset == end_offset,
-                     "function body longer than given size");
-  RAISE_ERROR_UNLESS(seen_end_opcode, "function body must end with END opcode");
 }
 
 static void read_custom_section(Context* ctx, uint32_t section_size) {
   StringSlice section_name;
   in_str(ctx, &section_name, "section name");
+  const char* const* wanted_name = ctx->options->custom_sections;
+  if (wanted_name) {
+    while (*wanted_name && !string_slice_eq_cstr(&section_name, *wanted_name))
+      wanted_name++;
+    if (!*wanted_name) {
+      ctx->offset = ctx->read_end;
+      return;
+    }
+  }
   CALLBACK_CTX(begin_custom_section, section_size, section_name);
 
   bool name_section_ok = ctx->last_known_section >= BinarySection::Import;
@@ -1804,10 +1864,11 @@ static void read_function_section(Context* ctx, uint32_t section_size) {
   CALLBACK_SECTION(begin_function_signatures_section, section_size);
   in_u32_leb128(ctx, &ctx->num_function_signatures, "function signature count");
   CALLBACK(on_function_signatures_count, ctx->num_function_signatures);
+  uint32_t num_decoded = in_u32_leb128s(ctx, ctx->num_function_signatures);
   for (uint32_t i = 0; i < ctx->num_function_signatures; ++i) {
     uint32_t func_index = ctx->num_func_imports + i;
-    uint32_t sig_index;
-    in_u32_leb128(ctx, &sig_index, "function signature index");
+    uint32_t sig_index =
+        next_u32_leb128(ctx, i, num_decoded, "function signature index");
     RAISE_ERROR_UNLESS(sig_index < ctx->num_signatures,
                        "invalid function signature index: %d", sig_index);
     CALLBACK(on_function_signature, func_index, sig_index);
@@ -1932,9 +1993,10 @@ static void read_elem_section(Context* ctx, uint32_t section_size) {
     in_u32_leb128(ctx, &num_function_indexes,
                   "elem segment function index count");
     CALLBACK_CTX(on_elem_segment_function_index_count, i, num_function_indexes);
+    uint32_t num_decoded = in_u32_leb128s(ctx, num_function_indexes);
     for (uint32_t j = 0; j < num_function_indexes; ++j) {
-      uint32_t func_index;
-      in_u32_leb128(ctx, &func_index, "elem segment function index");
+      uint32_t func_index =
+          next_u32_leb128(ctx, j, num_decoded, "elem segment function index");
       CALLBACK(on_elem_segment_function_index, i, func_index);
     }
     CALLBACK(end_elem_segment, i);
@@ -1942,38 +2004,180 @@ static void read_elem_section(Context* ctx, uint32_t section_size) {
   CALLBACK_CTX0(end_elem_section);
 }
 
-static void read_code_section(Context* ctx, uint32_t section_size) {
+static void begin_code_section(Context* ctx, uint32_t section_size) {
   CALLBACK_SECTION(begin_function_bodies_section, section_size);
   in_u32_leb128(ctx, &ctx->num_function_bodies, "function body count");
   RAISE_ERROR_UNLESS(ctx->num_function_signatures == ctx->num_function_bodies,
                      "function signature count != function body count");
   CALLBACK(on_function_bodies_count, ctx->num_function_bodies);
-  for (uint32_t i = 0; i < ctx->num_function_bodies; ++i) {
-    uint32_t func_index = ctx->num_func_imports + i;
-    uint32_t func_offset = ctx->offset;
-    ctx->offset = func_offset;
-    CALLBACK_CTX(begin_function_body, func_index);
+}
+
+static void read_code_section_body(Context* ctx, uint32_t index) {
+  uint32_t func_index = ctx->num_func_imports + index;
+  uint32_t func_offset = ctx->offset;
+  ctx->offset = func_offset;
+  CALLBACK_CTX(begin_function_body, func_index);
+  uint32_t body_size;
+  in_u32_leb128(ctx, &body_size, "function body size");
+  uint32_t body_start_offset = ctx->offset;
+  uint32_t end_offset = body_start_offset + body_size;
+
+  uint32_t num_local_decls;
+  in_u32_leb128(ctx, &num_local_decls, "local declaration count");
+  CALLBACK(on_local_decl_count, num_local_decls);
+  for (uint32_t k = 0; k < num_local_decls; ++k) {
+    uint32_t num_local_types;
+    in_u32_leb128(ctx, &num_local_types, "local type count");
+    Type local_type;
+    in_type(ctx, &local_type, "local type");
+    RAISE_ERROR_UNLESS(is_concrete_type(local_type),
+                       "expected valid local type");
+    CALLBACK(on_local_decl, k, num_local_types, local_type);
+  }
+
+  read_function_body(ctx, end_offset);
+
+  CALLBACK(end_function_body, func_index);
+}
+
+/* Finds the offset of each function body, without reading them. Returns false
+ * if one of the sizes is bad; the bodies are then read serially, which
+ * reports the error. */
+static bool find_function_bodies(Context* ctx,
+                                 std::vector<size_t>* out_offsets,
+                                 size_t* out_end_offset) {
+  out_offsets->resize(ctx->num_function_bodies);
+  size_t offset = ctx->offset;
+  for (size_t& body_offset : *out_offsets) {
+    body_offset = offset;
     uint32_t body_size;
-    in_u32_leb128(ctx, &body_size, "function body size");
-    uint32_t body_start_offset = ctx->offset;
-    uint32_t end_offset = body_start_offset + body_size;
-
-    uint32_t num_local_decls;
-    in_u32_leb128(ctx, &num_local_decls, "local declaration count");
-    CALLBACK(on_local_decl_count, num_local_decls);
-    for (uint32_t k = 0; k < num_local_decls; ++k) {
-      uint32_t num_local_types;
-      in_u32_leb128(ctx, &num_local_types, "local type count");
-      Type local_type;
-      in_type(ctx, &local_type, "local type");
-      RAISE_ERROR_UNLESS(is_concrete_type(local_type),
-                         "expected valid local type");
-      CALLBACK(on_local_decl, k, num_local_types, local_type);
+    size_t bytes_read = read_u32_leb128(
+        ctx->data + offset, ctx->data + ctx->read_end, &body_size);
+    if (!bytes_read || body_size > ctx->read_end - offset - bytes_read)
+      return false;
+    offset += bytes_read + body_size;
+  }
+  *out_end_offset = offset;
+  return true;
+}
+
+static Result read_function_body_batches(Context* ctx, FunctionBodyWork* work) {
+  if (setjmp(ctx->error_jmp_buf) == 1)
+    return Result::Error;
+
+  size_t num_bodies = work->offsets->size();
+  while (!work->failed) {
+    size_t first = work->next_body.fetch_add(work->batch_size);
+    if (first >= num_bodies)
+      break;
+    size_t last = std::min(first + work->batch_size, num_bodies);
+    for (size_t i = first; i < last; ++i) {
+      ctx->offset = (*work->offsets)[i];
+      read_code_section_body(ctx, i);
+    }
+  }
+  return Result::Ok;
+}
+
+static void function_body_thread(const Context* ctx,
+                                 BinaryReader* reader,
+                                 FunctionBodyError* error,
+                                 FunctionBodyWork* work) {
+  /* a copy, so each thread has its own offset, scratch space and jmp_buf */
+  Context thread_context(*ctx);
+  thread_context.reader = reader;
+  thread_context.function_body_error = error;
+  if (WABT_FAILED(read_function_body_batches(&thread_context, work)))
+    work->failed = true;
+}
+
+/* Decodes the function bodies at |offsets| on |num_threads| threads, the
+ * calling thread being the first. Returns Result::Error if any of them
+ * failed, in which case the error has been reported already.
+ *
+ * The bodies are handed out in order, and a thread only stops between
+ * batches, so every body before the first bad one is still decoded. Of the
+ * threads' errors only the one with the lowest offset is printed, which is
+ * the one reading serially would print, whatever the timing. */
+static Result run_function_body_threads(Context* ctx,
+                                        const std::vector<size_t>* offsets,
+                                        uint32_t num_threads,
+                                        bool* out_merge_failed) {
+  FunctionBodyWork work;
+  work.offsets = offsets;
+  /* small batches balance the load, large ones share less */
+  work.batch_size = std::max<size_t>(
+      1, std::min<size_t>(64, ctx->num_function_bodies / (num_threads * 8)));
+  work.next_body = 0;
+  work.failed = false;
+
+  BinaryReader* reader = ctx->reader;
+  std::vector<BinaryReader> thread_readers(num_threads, *reader);
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    thread_readers[i].user_data =
+        reader->begin_function_bodies_thread(i, reader->user_data);
+  }
+
+  std::vector<FunctionBodyError> errors(num_threads);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(function_body_thread, ctx, &thread_readers[i],
+                         &errors[i], &work);
+  }
+  function_body_thread(ctx, &thread_readers[0], &errors[0], &work);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  const FunctionBodyError* first_error = nullptr;
+  for (const FunctionBodyError& error : errors) {
+    if (error.failed && (!first_error || error.offset < first_error->offset))
+      first_error = &error;
+  }
+  if (first_error && !first_error->handled) {
+    fprintf(stderr, "*ERROR*: @0x%08zx: %s\n", first_error->offset,
+            first_error->message.c_str());
+  }
+
+  *out_merge_failed = false;
+  if (reader->end_function_bodies_thread) {
+    for (uint32_t i = 0; i < num_threads; ++i) {
+      if (WABT_FAILED(reader->end_function_bodies_thread(
+              i, thread_readers[i].user_data, reader->user_data))) {
+        *out_merge_failed = true;
+      }
     }
+  }
+  return work.failed ? Result::Error : Result::Ok;
+}
 
-    read_function_body(ctx, end_offset);
+/* Returns false if the function bodies must be read serially instead. */
+static bool read_function_bodies_in_parallel(Context* ctx) {
+  uint32_t num_threads =
+      std::min(ctx->options->num_threads, ctx->num_function_bodies);
+  std::vector<size_t> offsets;
+  size_t end_offset;
+  if (num_threads < 2 || !ctx->reader->begin_function_bodies_thread ||
+      !find_function_bodies(ctx, &offsets, &end_offset)) {
+    return false;
+  }
 
-    CALLBACK(end_function_body, func_index);
+  bool merge_failed;
+  Result result =
+      run_function_body_threads(ctx, &offsets, num_threads, &merge_failed);
+  /* the error has already been reported */
+  if (WABT_FAILED(result))
+    longjmp(ctx->error_jmp_buf, 1);
+  if (merge_failed)
+    RAISE_ERROR("end_function_bodies_thread callback failed");
+  ctx->offset = end_offset;
+  return true;
+}
+
+static void read_code_section(Context* ctx, uint32_t section_size) {
+  begin_code_section(ctx, section_size);
+  if (!read_function_bodies_in_parallel(ctx)) {
+    for (uint32_t i = 0; i < ctx->num_function_bodies; ++i)
+      read_code_section_body(ctx, i);
   }
   CALLBACK_CTX0(end_function_bodies_section);
 }
@@ -2002,225 +2206,310 @@ static void read_data_section(Context* ctx, uint32_t section_size) {
   CALLBACK_CTX0(end_data_section);
 }
 
-static void read_sections(Context* ctx) {
-  while (ctx->offset < ctx->data_size) {
-    uint32_t section_code;
-    uint32_t section_size;
-    /* Temporarily reset read_end to the full data size so the next section
-     * can be read. */
-    ctx->read_end = ctx->data_size;
-    in_u32_leb128(ctx, &section_code, "section code");
-    in_u32_leb128(ctx, &section_size, "section size");
-    ctx->read_end = ctx->offset + section_size;
-    if (section_code >= kBinarySectionCount) {
-      RAISE_ERROR("invalid section code: %u; max is %u", section_code,
-                  kBinarySectionCount - 1);
-    }
+/* Reads the section code and size, and sets read_end to the end of the
+ * section. */
+static void read_section_header(Context* ctx,
+                                BinarySection* out_section,
+                                uint32_t* out_section_size) {
+  uint32_t section_code;
+  /* Temporarily reset read_end to the full data size so the next section can
+   * be read. */
+  ctx->read_end = ctx->data_size;
+  in_u32_leb128(ctx, &section_code, "section code");
+  in_u32_leb128(ctx, out_section_size, "section size");
+  ctx->read_end = ctx->offset + *out_section_size;
+  if (section_code >= kBinarySectionCount) {
+    RAISE_ERROR("invalid section code: %u; max is %u", section_code,
+                kBinarySectionCount - 1);
+  }
+  *out_section = static_cast<BinarySection>(section_code);
+}
 
-    BinarySection section = static_cast<BinarySection>(section_code);
+static void begin_section(Context* ctx,
+                          BinarySection section,
+                          uint32_t section_size) {
+  if (ctx->last_known_section != BinarySection::Invalid &&
+      section != BinarySection::Custom &&
+      section <= ctx->last_known_section) {
+    RAISE_ERROR("section %s out of order", get_section_name(section));
+  }
 
-    if (ctx->read_end > ctx->data_size)
-      RAISE_ERROR("invalid section size: extends past end");
+  CALLBACK_CTX(begin_section, section, section_size);
+}
 
-    if (ctx->last_known_section != BinarySection::Invalid &&
-        section != BinarySection::Custom &&
-        section <= ctx->last_known_section) {
-      RAISE_ERROR("section %s out of order", get_section_name(section));
-    }
+static void read_section(Context* ctx,
+                         BinarySection section,
+                         uint32_t section_size) {
+  BinaryReader* reader = ctx->reader;
+  if (!(ctx->options->sections & get_section_mask(section))) {
+    switch (section) {
+      case BinarySection::Type:
+      case BinarySection::Import:
+      case BinarySection::Function:
+      case BinarySection::Table:
+      case BinarySection::Memory:
+      case BinarySection::Global:
+        /* the counts of these sections are needed to check the later ones,
+         * so they are still read, but only errors are passed on */
+        WABT_ZERO_MEMORY(ctx->skip_reader);
+        ctx->skip_reader.user_data = reader->user_data;
+        ctx->skip_reader.on_error = reader->on_error;
+        ctx->reader = &ctx->skip_reader;
+        break;
 
-    CALLBACK_CTX(begin_section, section, section_size);
+      default:
+        ctx->offset = ctx->read_end;
+        return;
+    }
+  }
 
 #define V(Name, name, code)                   \
   case BinarySection::Name:                   \
     read_##name##_section(ctx, section_size); \
     break;
 
-    switch (section) {
-      WABT_FOREACH_BINARY_SECTION(V)
+  switch (section) {
+    WABT_FOREACH_BINARY_SECTION(V)
 
-      default:
-        assert(0);
-        break;
-    }
+    default:
+      assert(0);
+      break;
+  }
 
 #undef V
+  ctx->reader = reader;
+}
 
-    if (ctx->offset != ctx->read_end) {
-      RAISE_ERROR("unfinished section (expected end: 0x%" PRIzx ")",
-                  ctx->read_end);
-    }
+static void end_section(Context* ctx, BinarySection section) {
+  if (ctx->offset != ctx->read_end) {
+    RAISE_ERROR("unfinished section (expected end: 0x%" PRIzx ")",
+                ctx->read_end);
+  }
+
+  if (section != BinarySection::Custom)
+    ctx->last_known_section = section;
+}
+
+static void read_sections(Context* ctx) {
+  while (ctx->offset < ctx->data_size) {
+    BinarySection section;
+    uint32_t section_size;
+    read_section_header(ctx, &section, &section_size);
+    if (ctx->read_end > ctx->data_size)
+      RAISE_ERROR("invalid section size: extends past end");
 
-    if (section != BinarySection::Custom)
-      ctx->last_known_section = section;
+    begin_section(ctx, section, section_size);
+    read_section(ctx, section, section_size);
+    end_section(ctx, section);
   }
 }
 
-Result read_binary(const void* data,
-                   size_t size,
-                   BinaryReader* reader,
-                   uint32_t num_function_passes,
-                   const ReadBinaryOptions* options) {
-  LoggingContext logging_context;
-  WABT_ZERO_MEMORY(logging_context);
-  logging_context.reader = reader;
-  logging_context.stream = options->log_stream;
+static void read_module_header(Context* ctx) {
+  uint32_t magic;
+  in_u32(ctx, &magic, "magic");
+  RAISE_ERROR_UNLESS(magic == WABT_BINARY_MAGIC, "bad magic value");
+  uint32_t version;
+  in_u32(ctx, &version, "version");
+  RAISE_ERROR_UNLESS(version == WABT_BINARY_VERSION,
+                     "bad wasm file version: %#x (expected %#x)", version,
+                     WABT_BINARY_VERSION);
 
-  BinaryReader logging_reader;
-  WABT_ZERO_MEMORY(logging_reader);
-  logging_reader.user_data = &logging_context;
-
-  logging_reader.on_error = logging_on_error;
-  logging_reader.begin_section = logging_begin_section;
-  logging_reader.begin_module = logging_begin_module;
-  logging_reader.end_module = logging_end_module;
-
-  logging_reader.begin_custom_section = logging_begin_custom_section;
-  logging_reader.end_custom_section = logging_end_custom_section;
-
-  logging_reader.begin_signature_section = logging_begin_signature_section;
-  logging_reader.on_signature_count = logging_on_signature_count;
-  logging_reader.on_signature = logging_on_signature;
-  logging_reader.end_signature_section = logging_end_signature_section;
-
-  logging_reader.begin_import_section = logging_begin_import_section;
-  logging_reader.on_import_count = logging_on_import_count;
-  logging_reader.on_import = logging_on_import;
-  logging_reader.on_import_func = logging_on_import_func;
-  logging_reader.on_import_table = logging_on_import_table;
-  logging_reader.on_import_memory = logging_on_import_memory;
-  logging_reader.on_import_global = logging_on_import_global;
-  logging_reader.end_import_section = logging_end_import_section;
-
-  logging_reader.begin_function_signatures_section =
+  CALLBACK(begin_module, version);
+}
+
+static Result read_module(Context* ctx) {
+  ctx->last_known_section = BinarySection::Invalid;
+
+  if (setjmp(ctx->error_jmp_buf) == 1) {
+    return Result::Error;
+  }
+
+  read_module_header(ctx);
+  read_sections(ctx);
+  CALLBACK0(end_module);
+  return Result::Ok;
+}
+
+static void init_logging_reader(BinaryReader* logging_reader,
+                                LoggingContext* logging_context,
+                                BinaryReader* reader,
+                                Stream* stream) {
+  WABT_ZERO_MEMORY(*logging_context);
+  logging_context->reader = reader;
+  logging_context->stream = stream;
+
+  WABT_ZERO_MEMORY(*logging_reader);
+  logging_reader->user_data = logging_context;
+
+  logging_reader->on_error = logging_on_error;
+  logging_reader->begin_section = logging_begin_section;
+  logging_reader->begin_module = logging_begin_module;
+  logging_reader->end_module = logging_end_module;
+
+  logging_reader->begin_custom_section = logging_begin_custom_section;
+  logging_reader->end_custom_section = logging_end_custom_section;
+
+  logging_reader->begin_signature_section = logging_begin_signature_section;
+  logging_reader->on_signature_count = logging_on_signature_count;
+  logging_reader->on_signature = logging_on_signature;
+  logging_reader->end_signature_section = logging_end_signature_section;
+
+  logging_reader->begin_import_section = logging_begin_import_section;
+  logging_reader->on_import_count = logging_on_import_count;
+  logging_reader->on_import = logging_on_import;
+  logging_reader->on_import_func = logging_on_import_func;
+  logging_reader->on_import_table = logging_on_import_table;
+  logging_reader->on_import_memory = logging_on_import_memory;
+  logging_reader->on_import_global = logging_on_import_global;
+  logging_reader->end_import_section = logging_end_import_section;
+
+  logging_reader->begin_function_signatures_section =
       logging_begin_function_signatures_section;
-  logging_reader.on_function_signatures_count =
+  logging_reader->on_function_signatures_count =
       logging_on_function_signatures_count;
-  logging_reader.on_function_signature = logging_on_function_signature;
-  logging_reader.end_function_signatures_section =
+  logging_reader->on_function_signature = logging_on_function_signature;
+  logging_reader->end_function_signatures_section =
       logging_end_function_signatures_section;
 
-  logging_reader.begin_table_section = logging_begin_table_section;
-  logging_reader.on_table_count = logging_on_table_count;
-  logging_reader.on_table = logging_on_table;
-  logging_reader.end_table_section = logging_end_table_section;
-
-  logging_reader.begin_memory_section = logging_begin_memory_section;
-  logging_reader.on_memory_count = logging_on_memory_count;
-  logging_reader.on_memory = logging_on_memory;
-  logging_reader.end_memory_section = logging_end_memory_section;
-
-  logging_reader.begin_global_section = logging_begin_global_section;
-  logging_reader.on_global_count = logging_on_global_count;
-  logging_reader.begin_global = logging_begin_global;
-  logging_reader.begin_global_init_expr = logging_begin_global_init_expr;
-  logging_reader.end_global_init_expr = logging_end_global_init_expr;
-  logging_reader.end_global = logging_end_global;
-  logging_reader.end_global_section = logging_end_global_section;
-
-  logging_reader.begin_export_section = logging_begin_export_section;
-  logging_reader.on_export_count = logging_on_export_count;
-  logging_reader.on_export = logging_on_export;
-  logging_reader.end_export_section = logging_end_export_section;
-
-  logging_reader.begin_start_section = logging_begin_start_section;
-  logging_reader.on_start_function = logging_on_start_function;
-  logging_reader.end_start_section = logging_end_start_section;
-
-  logging_reader.begin_function_bodies_section =
+  logging_reader->begin_table_section = logging_begin_table_section;
+  logging_reader->on_table_count = logging_on_table_count;
+  logging_reader->on_table = logging_on_table;
+  logging_reader->end_table_section = logging_end_table_section;
+
+  logging_reader->begin_memory_section = logging_begin_memory_section;
+  logging_reader->on_memory_count = logging_on_memory_count;
+  logging_reader->on_memory = logging_on_memory;
+  logging_reader->end_memory_section = logging_end_memory_section;
+
+  logging_reader->begin_global_section = logging_begin_global_section;
+  logging_reader->on_global_count = logging_on_global_count;
+  logging_reader->begin_global = logging_begin_global;
+  logging_reader->begin_global_init_expr = logging_begin_global_init_expr;
+  logging_reader->end_global_init_expr = logging_end_global_init_expr;
+  logging_reader->end_global = logging_end_global;
+  logging_reader->end_global_section = logging_end_global_section;
+
+  logging_reader->begin_export_section = logging_begin_export_section;
+  logging_reader->on_export_count = logging_on_export_count;
+  logging_reader->on_export = logging_on_export;
+  logging_reader->end_export_section = logging_end_export_section;
+
+  logging_reader->begin_start_section = logging_begin_start_section;
+  logging_reader->on_start_function = logging_on_start_function;
+  logging_reader->end_start_section = logging_end_start_section;
+
+  logging_reader->begin_function_bodies_section =
       logging_begin_function_bodies_section;
-  logging_reader.on_function_bodies_count = logging_on_function_bodies_count;
-  logging_reader.begin_function_body_pass = logging_begin_function_body_pass;
-  logging_reader.begin_function_body = logging_begin_function_body;
-  logging_reader.on_local_decl_count = logging_on_local_decl_count;
-  logging_reader.on_local_decl = logging_on_local_decl;
-  logging_reader.on_binary_expr = logging_on_binary_expr;
-  logging_reader.on_block_expr = logging_on_block_expr;
-  logging_reader.on_br_expr = logging_on_br_expr;
-  logging_reader.on_br_if_expr = logging_on_br_if_expr;
-  logging_reader.on_br_table_expr = logging_on_br_table_expr;
-  logging_reader.on_call_expr = logging_on_call_expr;
-  logging_reader.on_call_import_expr = logging_on_call_import_expr;
-  logging_reader.on_call_indirect_expr = logging_on_call_indirect_expr;
-  logging_reader.on_compare_expr = logging_on_compare_expr;
-  logging_reader.on_convert_expr = logging_on_convert_expr;
-  logging_reader.on_drop_expr = logging_on_drop_expr;
-  logging_reader.on_else_expr = logging_on_else_expr;
-  logging_reader.on_end_expr = logging_on_end_expr;
-  logging_reader.on_f32_const_expr = logging_on_f32_const_expr;
-  logging_reader.on_f64_const_expr = logging_on_f64_const_expr;
-  logging_reader.on_get_global_expr = logging_on_get_global_expr;
-  logging_reader.on_get_local_expr = logging_on_get_local_expr;
-  logging_reader.on_grow_memory_expr = logging_on_grow_memory_expr;
-  logging_reader.on_i32_const_expr = logging_on_i32_const_expr;
-  logging_reader.on_i64_const_expr = logging_on_i64_const_expr;
-  logging_reader.on_if_expr = logging_on_if_expr;
-  logging_reader.on_load_expr = logging_on_load_expr;
-  logging_reader.on_loop_expr = logging_on_loop_expr;
-  logging_reader.on_current_memory_expr = logging_on_current_memory_expr;
-  logging_reader.on_nop_expr = logging_on_nop_expr;
-  logging_reader.on_return_expr = logging_on_return_expr;
-  logging_reader.on_select_expr = logging_on_select_expr;
-  logging_reader.on_set_global_expr = logging_on_set_global_expr;
-  logging_reader.on_set_local_expr = logging_on_set_local_expr;
-  logging_reader.on_store_expr = logging_on_store_expr;
-  logging_reader.on_tee_local_expr = logging_on_tee_local_expr;
-  logging_reader.on_unary_expr = logging_on_unary_expr;
-  logging_reader.on_unreachable_expr = logging_on_unreachable_expr;
-  logging_reader.end_function_body = logging_end_function_body;
-  logging_reader.end_function_body_pass = logging_end_function_body_pass;
-  logging_reader.end_function_bodies_section =
+  logging_reader->on_function_bodies_count = logging_on_function_bodies_count;
+  logging_reader->begin_function_body_pass = logging_begin_function_body_pass;
+  logging_reader->begin_function_body = logging_begin_function_body;
+  logging_reader->on_local_decl_count = logging_on_local_decl_count;
+  logging_reader->on_local_decl = logging_on_local_decl;
+  logging_reader->on_binary_expr = logging_on_binary_expr;
+  logging_reader->on_block_expr = logging_on_block_expr;
+  logging_reader->on_br_expr = logging_on_br_expr;
+  logging_reader->on_br_if_expr = logging_on_br_if_expr;
+  logging_reader->on_br_table_expr = logging_on_br_table_expr;
+  logging_reader->on_call_expr = logging_on_call_expr;
+  logging_reader->on_call_import_expr = logging_on_call_import_expr;
+  logging_reader->on_call_indirect_expr = logging_on_call_indirect_expr;
+  logging_reader->on_compare_expr = logging_on_compare_expr;
+  logging_reader->on_convert_expr = logging_on_convert_expr;
+  logging_reader->on_drop_expr = logging_on_drop_expr;
+  logging_reader->on_else_expr = logging_on_else_expr;
+  logging_reader->on_end_expr = logging_on_end_expr;
+  logging_reader->on_f32_const_expr = logging_on_f32_const_expr;
+  logging_reader->on_f64_const_expr = logging_on_f64_const_expr;
+  logging_reader->on_get_global_expr = logging_on_get_global_expr;
+  logging_reader->on_get_local_expr = logging_on_get_local_expr;
+  logging_reader->on_grow_memory_expr = logging_on_grow_memory_expr;
+  logging_reader->on_i32_const_expr = logging_on_i32_const_expr;
+  logging_reader->on_i64_const_expr = logging_on_i64_const_expr;
+  logging_reader->on_if_expr = logging_on_if_expr;
+  logging_reader->on_load_expr = logging_on_load_expr;
+  logging_reader->on_loop_expr = logging_on_loop_expr;
+  logging_reader->on_current_memory_expr = logging_on_current_memory_expr;
+  logging_reader->on_memory_copy_expr = logging_on_memory_copy_expr;
+  logging_reader->on_memory_fill_expr = logging_on_memory_fill_expr;
+  logging_reader->on_nop_expr = logging_on_nop_expr;
+  logging_reader->on_return_expr = logging_on_return_expr;
+  logging_reader->on_select_expr = logging_on_select_expr;
+  logging_reader->on_set_global_expr = logging_on_set_global_expr;
+  logging_reader->on_set_local_expr = logging_on_set_local_expr;
+  logging_reader->on_store_expr = logging_on_store_expr;
+  logging_reader->on_tee_local_expr = logging_on_tee_local_expr;
+  logging_reader->on_unary_expr = logging_on_unary_expr;
+  logging_reader->on_unreachable_expr = logging_on_unreachable_expr;
+  logging_reader->on_function_body_instructions =
+      logging_on_function_body_instructions;
+  logging_reader->end_function_body = logging_end_function_body;
+  logging_reader->end_function_body_pass = logging_end_function_body_pass;
+  logging_reader->end_function_bodies_section =
       logging_end_function_bodies_section;
 
-  logging_reader.begin_elem_section = logging_begin_elem_section;
-  logging_reader.on_elem_segment_count = logging_on_elem_segment_count;
-  logging_reader.begin_elem_segment = logging_begin_elem_segment;
-  logging_reader.begin_elem_segment_init_expr =
+  logging_reader->begin_elem_section = logging_begin_elem_section;
+  logging_reader->on_elem_segment_count = logging_on_elem_segment_count;
+  logging_reader->begin_elem_segment = logging_begin_elem_segment;
+  logging_reader->begin_elem_segment_init_expr =
       logging_begin_elem_segment_init_expr;
-  logging_reader.end_elem_segment_init_expr =
+  logging_reader->end_elem_segment_init_expr =
       logging_end_elem_segment_init_expr;
-  logging_reader.on_elem_segment_function_index_count =
+  logging_reader->on_elem_segment_function_index_count =
       logging_on_elem_segment_function_index_count;
-  logging_reader.on_elem_segment_function_index =
+  logging_reader->on_elem_segment_function_index =
       logging_on_elem_segment_function_index;
-  logging_reader.end_elem_segment = logging_end_elem_segment;
-  logging_reader.end_elem_section = logging_end_elem_section;
+  logging_reader->end_elem_segment = logging_end_elem_segment;
+  logging_reader->end_elem_section = logging_end_elem_section;
 
-  logging_reader.begin_data_section = logging_begin_data_section;
-  logging_reader.on_data_segment_count = logging_on_data_segment_count;
-  logging_reader.begin_data_segment = logging_begin_data_segment;
-  logging_reader.begin_data_segment_init_expr =
+  logging_reader->begin_data_section = logging_begin_data_section;
+  logging_reader->on_data_segment_count = logging_on_data_segment_count;
+  logging_reader->begin_data_segment = logging_begin_data_segment;
+  logging_reader->begin_data_segment_init_expr =
       logging_begin_data_segment_init_expr;
-  logging_reader.end_data_segment_init_expr =
+  logging_reader->end_data_segment_init_expr =
       logging_end_data_segment_init_expr;
-  logging_reader.on_data_segment_data = logging_on_data_segment_data;
-  logging_reader.end_data_segment = logging_end_data_segment;
-  logging_reader.end_data_section = logging_end_data_section;
-
-  logging_reader.begin_names_section = logging_begin_names_section;
-  logging_reader.on_function_name_subsection = logging_on_function_name_subsection;
-  logging_reader.on_function_names_count = logging_on_function_names_count;
-  logging_reader.on_function_name = logging_on_function_name;
-  logging_reader.on_local_name_subsection = logging_on_local_name_subsection;
-  logging_reader.on_local_name_function_count = logging_on_local_name_function_count;
-  logging_reader.on_local_name_local_count = logging_on_local_name_local_count;
-  logging_reader.on_local_name = logging_on_local_name;
-  logging_reader.end_names_section = logging_end_names_section;
-
-  logging_reader.begin_reloc_section = logging_begin_reloc_section;
-  logging_reader.on_reloc_count = logging_on_reloc_count;
-  logging_reader.on_reloc = logging_on_reloc;
-  logging_reader.end_reloc_section = logging_end_reloc_section;
-
-  logging_reader.on_init_expr_f32_const_expr =
+  logging_reader->on_data_segment_data = logging_on_data_segment_data;
+  logging_reader->end_data_segment = logging_end_data_segment;
+  logging_reader->end_data_section = logging_end_data_section;
+
+  logging_reader->begin_names_section = logging_begin_names_section;
+  logging_reader->on_function_name_subsection =
+      logging_on_function_name_subsection;
+  logging_reader->on_function_names_count = logging_on_function_names_count;
+  logging_reader->on_function_name = logging_on_function_name;
+  logging_reader->on_local_name_subsection = logging_on_local_name_subsection;
+  logging_reader->on_local_name_function_count =
+      logging_on_local_name_function_count;
+  logging_reader->on_local_name_local_count = logging_on_local_name_local_count;
+  logging_reader->on_local_name = logging_on_local_name;
+  logging_reader->end_names_section = logging_end_names_section;
+
+  logging_reader->begin_reloc_section = logging_begin_reloc_section;
+  logging_reader->on_reloc_count = logging_on_reloc_count;
+  logging_reader->on_reloc = logging_on_reloc;
+  logging_reader->end_reloc_section = logging_end_reloc_section;
+
+  logging_reader->on_init_expr_f32_const_expr =
       logging_on_init_expr_f32_const_expr;
-  logging_reader.on_init_expr_f64_const_expr =
+  logging_reader->on_init_expr_f64_const_expr =
       logging_on_init_expr_f64_const_expr;
-  logging_reader.on_init_expr_get_global_expr =
+  logging_reader->on_init_expr_get_global_expr =
       logging_on_init_expr_get_global_expr;
-  logging_reader.on_init_expr_i32_const_expr =
+  logging_reader->on_init_expr_i32_const_expr =
       logging_on_init_expr_i32_const_expr;
-  logging_reader.on_init_expr_i64_const_expr =
+  logging_reader->on_init_expr_i64_const_expr =
       logging_on_init_expr_i64_const_expr;
+}
+
+Result read_binary(const void* data,
+                   size_t size,
+                   BinaryReader* reader,
+                   uint32_t num_function_passes,
+                   const ReadBinaryOptions* options) {
+  LoggingContext logging_context;
+  BinaryReader logging_reader;
+  init_logging_reader(&logging_reader, &logging_context, reader,
+                      options->log_stream);
 
   Context context;
   /* all the macros assume a Context* named ctx */
@@ -2229,25 +2518,412 @@ Result read_binary(const void* data,
   ctx->data_size = ctx->read_end = size;
   ctx->reader = options->log_stream ? &logging_reader : reader;
   ctx->options = options;
-  ctx->last_known_section = BinarySection::Invalid;
+  return read_module(ctx);
+}
 
-  if (setjmp(ctx->error_jmp_buf) == 1) {
+static bool index_on_error(BinaryReaderContext* ctx, const char* message) {
+  IndexContext* index_ctx = static_cast<IndexContext*>(ctx->user_data);
+  if (index_ctx->error_handler && index_ctx->error_handler->on_error) {
+    return index_ctx->error_handler->on_error(
+        ctx->offset, message, index_ctx->error_handler->user_data);
+  }
+  return false;
+}
+
+static Result index_on_export(uint32_t index,
+                              ExternalKind kind,
+                              uint32_t item_index,
+                              StringSlice name,
+                              void* user_data) {
+  IndexContext* index_ctx = static_cast<IndexContext*>(user_data);
+  BinaryIndexExport export_;
+  export_.name = name;
+  export_.kind = kind;
+  export_.index = item_index;
+  index_ctx->index->exports.push_back(export_);
+  return Result::Ok;
+}
+
+static void read_index_code_section(Context* ctx, BinaryIndex* index) {
+  begin_code_section(ctx, ctx->read_end - ctx->offset);
+  index->function_bodies.resize(ctx->num_function_bodies);
+  for (BinaryIndexFunctionBody& body : index->function_bodies) {
+    body.size_offset = ctx->offset;
+    in_u32_leb128(ctx, &body.size, "function body size");
+    body.offset = ctx->offset;
+    RAISE_ERROR_UNLESS(body.size <= ctx->read_end - ctx->offset,
+                       "function body extends past end of section");
+    ctx->offset += body.size;
+  }
+}
+
+/* Reads the parts of the section that are needed for the index, and skips
+ * the rest. */
+static void read_index_section(Context* ctx,
+                               BinaryIndex* index,
+                               BinaryIndexSection* section) {
+  section->has_count = true;
+  switch (section->section) {
+    case BinarySection::Custom:
+      section->has_count = false;
+      in_str(ctx, &section->name, "section name");
+      break;
+
+    case BinarySection::Type:
+      in_u32_leb128(ctx, &ctx->num_signatures, "type count");
+      section->count = ctx->num_signatures;
+      break;
+
+    case BinarySection::Import:
+      read_import_section(ctx, section->size);
+      section->count = ctx->num_imports;
+      break;
+
+    case BinarySection::Function:
+      in_u32_leb128(ctx, &ctx->num_function_signatures,
+                    "function signature count");
+      section->count = ctx->num_function_signatures;
+      break;
+
+    case BinarySection::Table:
+      in_u32_leb128(ctx, &ctx->num_tables, "table count");
+      section->count = ctx->num_tables;
+      break;
+
+    case BinarySection::Memory:
+      in_u32_leb128(ctx, &ctx->num_memories, "memory count");
+      section->count = ctx->num_memories;
+      break;
+
+    case BinarySection::Global:
+      in_u32_leb128(ctx, &ctx->num_globals, "global count");
+      section->count = ctx->num_globals;
+      break;
+
+    case BinarySection::Export:
+      read_export_section(ctx, section->size);
+      section->count = ctx->num_exports;
+      break;
+
+    case BinarySection::Start:
+      section->has_count = false;
+      break;
+
+    case BinarySection::Elem:
+      in_u32_leb128(ctx, &section->count, "elem segment count");
+      break;
+
+    case BinarySection::Code:
+      read_index_code_section(ctx, index);
+      section->count = ctx->num_function_bodies;
+      break;
+
+    case BinarySection::Data:
+      in_u32_leb128(ctx, &section->count, "data segment count");
+      break;
+
+    default:
+      assert(0);
+      break;
+  }
+  ctx->offset = ctx->read_end;
+}
+
+Result read_binary_index(const void* data,
+                         size_t size,
+                         BinaryIndex* out_index,
+                         BinaryErrorHandler* error_handler) {
+  IndexContext index_context;
+  index_context.index = out_index;
+  index_context.error_handler = error_handler;
+
+  BinaryReader index_reader;
+  WABT_ZERO_MEMORY(index_reader);
+  index_reader.user_data = &index_context;
+  index_reader.on_error = index_on_error;
+  index_reader.on_export = index_on_export;
+
+  ReadBinaryOptions options = WABT_READ_BINARY_OPTIONS_DEFAULT;
+  Context context;
+  /* all the macros assume a Context* named ctx */
+  Context* ctx = &context;
+  ctx->data = static_cast<const uint8_t*>(data);
+  ctx->data_size = ctx->read_end = size;
+  ctx->reader = &index_reader;
+  ctx->options = &options;
+
+  if (setjmp(ctx->error_jmp_buf) == 1)
     return Result::Error;
+
+  read_module_header(ctx);
+  out_index->version = WABT_BINARY_VERSION;
+  while (ctx->offset < ctx->data_size) {
+    BinaryIndexSection section;
+    WABT_ZERO_MEMORY(section);
+    read_section_header(ctx, &section.section, &section.size);
+    if (ctx->read_end > ctx->data_size)
+      RAISE_ERROR("invalid section size: extends past end");
+
+    begin_section(ctx, section.section, section.size);
+    section.offset = ctx->offset;
+    read_index_section(ctx, out_index, &section);
+    end_section(ctx, section.section);
+    out_index->sections.push_back(section);
   }
 
-  uint32_t magic;
-  in_u32(ctx, &magic, "magic");
-  RAISE_ERROR_UNLESS(magic == WABT_BINARY_MAGIC, "bad magic value");
-  uint32_t version;
-  in_u32(ctx, &version, "version");
-  RAISE_ERROR_UNLESS(version == WABT_BINARY_VERSION,
-                     "bad wasm file version: %#x (expected %#x)", version,
-                     WABT_BINARY_VERSION);
+  out_index->num_signatures = ctx->num_signatures;
+  out_index->num_func_imports = ctx->num_func_imports;
+  out_index->num_table_imports = ctx->num_table_imports;
+  out_index->num_memory_imports = ctx->num_memory_imports;
+  out_index->num_global_imports = ctx->num_global_imports;
+  out_index->num_tables = ctx->num_tables;
+  out_index->num_memories = ctx->num_memories;
+  out_index->num_globals = ctx->num_globals;
+  return Result::Ok;
+}
 
-  CALLBACK(begin_module, version);
-  read_sections(ctx);
-  CALLBACK0(end_module);
+Result read_binary_indexed_function_body(const void* data,
+                                         size_t size,
+                                         const BinaryIndex* index,
+                                         uint32_t func_index,
+                                         BinaryReader* reader,
+                                         const ReadBinaryOptions* options) {
+  Context context;
+  /* all the macros assume a Context* named ctx */
+  Context* ctx = &context;
+  ctx->data = static_cast<const uint8_t*>(data);
+  ctx->data_size = size;
+  ctx->reader = reader;
+  ctx->options = options;
+  ctx->num_signatures = index->num_signatures;
+  ctx->num_func_imports = index->num_func_imports;
+  ctx->num_table_imports = index->num_table_imports;
+  ctx->num_memory_imports = index->num_memory_imports;
+  ctx->num_global_imports = index->num_global_imports;
+  ctx->num_function_signatures = index->function_bodies.size();
+  ctx->num_function_bodies = index->function_bodies.size();
+  ctx->num_tables = index->num_tables;
+  ctx->num_memories = index->num_memories;
+  ctx->num_globals = index->num_globals;
+
+  if (setjmp(ctx->error_jmp_buf) == 1)
+    return Result::Error;
+
+  RAISE_ERROR_UNLESS(func_index >= index->num_func_imports &&
+                         func_index - index->num_func_imports <
+                             index->function_bodies.size(),
+                     "invalid function body index: %u", func_index);
+  uint32_t body_index = func_index - index->num_func_imports;
+  const BinaryIndexFunctionBody& body = index->function_bodies[body_index];
+  ctx->offset = body.size_offset;
+  ctx->read_end = body.offset + body.size;
+  read_code_section_body(ctx, body_index);
+  return Result::Ok;
+}
+
+enum class BinaryReaderStreamState {
+  Header,
+  SectionHeader,
+  Section,
+  CodeSectionHeader,
+  FunctionBodies,
+  Done,
+  Error,
+};
+
+struct BinaryReaderStream {
+  Context ctx;
+  LoggingContext logging_context;
+  BinaryReader logging_reader;
+  std::vector<uint8_t> buffer;
+  BinaryReaderStreamState state = BinaryReaderStreamState::Header;
+  /* Set by finish_binary_reader_stream; no more data will be fed. */
+  bool finished = false;
+  BinarySection section = BinarySection::Invalid;
+  uint32_t section_size = 0;
+  size_t section_end = 0;
+  uint32_t function_body_index = 0;
+};
+
+/* Returns true if the data up to |end_offset| hasn't been fed yet. */
+static bool stream_needs_data(BinaryReaderStream* stream, size_t end_offset) {
+  return !stream->finished && end_offset > stream->ctx.data_size;
+}
+
+/* Returns true if the LEB128 at |offset| hasn't been fed completely yet. If
+ * it is malformed, it can be read now (and will fail). */
+static bool stream_needs_leb128(BinaryReaderStream* stream, size_t offset) {
+  if (stream->finished)
+    return false;
+  const size_t max_leb128_size = 5;
+  size_t available = stream->ctx.data_size - offset;
+  for (size_t i = 0; i < available && i < max_leb128_size; ++i) {
+    if (!(stream->ctx.data[offset + i] & 0x80))
+      return false;
+  }
+  return available < max_leb128_size;
+}
+
+/* Reads everything that has been fed completely: the header, whole sections,
+ * and single function bodies of the code section. */
+static void read_stream(BinaryReaderStream* stream) {
+  /* all the macros assume a Context* named ctx */
+  Context* ctx = &stream->ctx;
+  while (true) {
+    switch (stream->state) {
+      case BinaryReaderStreamState::Header: {
+        const size_t header_size = sizeof(uint32_t) * 2; /* magic, version */
+        if (stream_needs_data(stream, header_size))
+          return;
+        ctx->read_end = ctx->data_size;
+        read_module_header(ctx);
+        stream->state = BinaryReaderStreamState::SectionHeader;
+        break;
+      }
+
+      case BinaryReaderStreamState::SectionHeader: {
+        if (ctx->offset == ctx->data_size) {
+          if (!stream->finished)
+            return;
+          CALLBACK0(end_module);
+          stream->state = BinaryReaderStreamState::Done;
+          return;
+        }
+
+        if (stream_needs_leb128(stream, ctx->offset))
+          return;
+        uint32_t section_code;
+        size_t code_size =
+            read_u32_leb128(ctx->data + ctx->offset,
+                            ctx->data + ctx->data_size, &section_code);
+        if (code_size != 0 &&
+            stream_needs_leb128(stream, ctx->offset + code_size)) {
+          return;
+        }
+
+        read_section_header(ctx, &stream->section, &stream->section_size);
+        stream->section_end = ctx->read_end;
+        /* a skipped code section is skipped as a whole */
+        stream->state =
+            stream->section == BinarySection::Code &&
+                    (ctx->options->sections &
+                     get_section_mask(BinarySection::Code))
+                ? BinaryReaderStreamState::CodeSectionHeader
+                : BinaryReaderStreamState::Section;
+        break;
+      }
+
+      case BinaryReaderStreamState::Section:
+        if (stream_needs_data(stream, stream->section_end))
+          return;
+        if (ctx->read_end > ctx->data_size)
+          RAISE_ERROR("invalid section size: extends past end");
+
+        begin_section(ctx, stream->section, stream->section_size);
+        read_section(ctx, stream->section, stream->section_size);
+        end_section(ctx, stream->section);
+        stream->state = BinaryReaderStreamState::SectionHeader;
+        break;
+
+      case BinaryReaderStreamState::CodeSectionHeader:
+        if (stream_needs_leb128(stream, ctx->offset))
+          return;
+        if (stream->finished && ctx->read_end > ctx->data_size)
+          RAISE_ERROR("invalid section size: extends past end");
+
+        begin_section(ctx, stream->section, stream->section_size);
+        begin_code_section(ctx, stream->section_size);
+        stream->function_body_index = 0;
+        stream->state = BinaryReaderStreamState::FunctionBodies;
+        break;
+
+      case BinaryReaderStreamState::FunctionBodies: {
+        if (stream->function_body_index == ctx->num_function_bodies) {
+          CALLBACK_CTX0(end_function_bodies_section);
+          end_section(ctx, stream->section);
+          stream->state = BinaryReaderStreamState::SectionHeader;
+          break;
+        }
+
+        if (stream_needs_leb128(stream, ctx->offset))
+          return;
+        uint32_t body_size;
+        size_t body_size_size =
+            read_u32_leb128(ctx->data + ctx->offset,
+                            ctx->data + ctx->data_size, &body_size);
+        size_t body_end = ctx->offset + body_size_size + body_size;
+        if (body_size_size != 0 &&
+            stream_needs_data(stream,
+                              std::min(body_end, stream->section_end))) {
+          return;
+        }
+
+        /* The rest of the section may not have been fed yet, so don't let a
+         * malformed body read past the data. */
+        ctx->read_end = std::min(stream->section_end, ctx->data_size);
+        read_code_section_body(ctx, stream->function_body_index++);
+        ctx->read_end = stream->section_end;
+        break;
+      }
+
+      case BinaryReaderStreamState::Done:
+      case BinaryReaderStreamState::Error:
+        return;
+    }
+  }
+}
+
+static Result run_binary_reader_stream(BinaryReaderStream* stream) {
+  if (stream->state == BinaryReaderStreamState::Error)
+    return Result::Error;
+
+  Context* ctx = &stream->ctx;
+  ctx->data = stream->buffer.data();
+  ctx->data_size = stream->buffer.size();
+  if (setjmp(ctx->error_jmp_buf) == 1) {
+    stream->state = BinaryReaderStreamState::Error;
+    return Result::Error;
+  }
+
+  read_stream(stream);
   return Result::Ok;
 }
 
+BinaryReaderStream* new_binary_reader_stream(
+    BinaryReader* reader,
+    const ReadBinaryOptions* options) {
+  BinaryReaderStream* stream = new BinaryReaderStream();
+  init_logging_reader(&stream->logging_reader, &stream->logging_context,
+                      reader, options->log_stream);
+  Context* ctx = &stream->ctx;
+  ctx->reader = options->log_stream ? &stream->logging_reader : reader;
+  ctx->options = options;
+  return stream;
+}
+
+Result feed_binary_reader_stream(BinaryReaderStream* stream,
+                                 const void* data,
+                                 size_t size) {
+  assert(!stream->finished);
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  stream->buffer.insert(stream->buffer.end(), bytes, bytes + size);
+  return run_binary_reader_stream(stream);
+}
+
+Result finish_binary_reader_stream(BinaryReaderStream* stream) {
+  assert(!stream->finished);
+  stream->finished = true;
+  return run_binary_reader_stream(stream);
+}
+
+const void* get_binary_reader_stream_data(BinaryReaderStream* stream,
+                                          size_t* out_size) {
+  *out_size = stream->buffer.size();
+  return stream->buffer.data();
+}
+
+void delete_binary_reader_stream(BinaryReaderStream* stream) {
+  delete stream;
+}
+
 }  // namespace wabt
@@ -20,19 +20,39 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "binary.h"
 #include "common.h"
 
+#define WABT_READ_BINARY_ALL_SECTIONS 0xffffffffu
 #define WABT_READ_BINARY_OPTIONS_DEFAULT \
-  { nullptr, false }
+  { nullptr, false, 1, WABT_READ_BINARY_ALL_SECTIONS, nullptr }
 
 namespace wabt {
 
 struct ReadBinaryOptions {
   struct Stream* log_stream;
   bool read_debug_names;
+  /* The number of threads decoding the function bodies. It is only used if
+   * the reader sets begin_function_bodies_thread; 0 or 1 reads them on the
+   * calling thread. */
+  uint32_t num_threads;
+  /* The sections to read, as a mask of get_section_mask() bits. The contents
+   * of the other sections are skipped, though begin_section is still called
+   * for them. The type, import, function, table, memory and global sections
+   * are read without callbacks instead, since the later sections are checked
+   * against their counts. */
+  uint32_t sections;
+  /* If set, a null-terminated list of the custom sections to read; the others
+   * are skipped after their name is read. */
+  const char* const* custom_sections;
 };
 
+static WABT_INLINE uint32_t get_section_mask(BinarySection section) {
+  return 1u << static_cast<int>(section);
+}
+
 struct BinaryReaderContext {
   const uint8_t* data;
   size_t size;
@@ -40,6 +60,50 @@ struct BinaryReaderContext {
   void* user_data;
 };
 
+struct BinaryReaderMemoryImmediate {
+  uint32_t alignment_log2;
+  uint32_t offset;
+};
+
+struct BinaryReaderBrTableImmediate {
+  uint32_t first_target; /* index in BinaryReaderFunctionBody::br_targets */
+  uint32_t num_targets;
+  uint32_t default_target;
+};
+
+/* An instruction, as passed to the on_function_body_instructions callback. */
+struct BinaryReaderInstruction {
+  Opcode opcode;
+  uint32_t offset; /* just past the immediates, where errors are reported */
+  union {
+    Type sig_type;  /* block, loop and if */
+    uint32_t index; /* the other instructions with one u32 immediate */
+    uint32_t i32;
+    uint64_t i64;
+    uint32_t f32_bits;
+    uint64_t f64_bits;
+    BinaryReaderMemoryImmediate memory;
+    BinaryReaderBrTableImmediate br_table;
+  };
+};
+
+/* The instructions of a function body, passed to the read_function_body
+ * callback. */
+struct BinaryReaderFunctionBody {
+  const uint8_t* data;
+  size_t size;
+  size_t offset;     /* of the next instruction; updated while reading */
+  size_t end_offset; /* of the function body */
+  size_t read_end;   /* nothing past this may be read */
+  uint32_t num_funcs;
+  uint32_t num_signatures;
+  std::vector<uint32_t> target_depths; /* scratch space for br_table */
+  /* Filled for the on_function_body_instructions callback, and reused for
+   * the next function body. */
+  std::vector<BinaryReaderInstruction> instructions;
+  std::vector<uint32_t> br_targets;
+};
+
 struct BinaryReader {
   void* user_data;
 
@@ -173,6 +237,21 @@ struct BinaryReader {
                           Type type,
                           void* user_data);
 
+  /* If set, reads the instructions of each function body instead of the
+   * reader, so the callbacks below aren't called. This is how the delegates
+   * of binary-reader-delegate.h are plugged in. It is ignored when the
+   * log_stream option is set. */
+  Result (*read_function_body)(BinaryReaderFunctionBody* body,
+                               void* user_data);
+
+  /* If set, and read_function_body isn't, the instructions of each function
+   * body are also decoded into body->instructions and passed in one call,
+   * after on_local_decl and the callbacks below. The last instruction is the
+   * function's end. The callback must report its own errors, e.g. as
+   * "<callback> callback failed" at an instruction's offset. */
+  Result (*on_function_body_instructions)(const BinaryReaderFunctionBody* body,
+                                          void* user_data);
+
   /* function expressions; called between begin_function_body and
    end_function_body */
   Result (*on_opcode)(BinaryReaderContext* ctx, Opcode Opcode);
@@ -218,6 +297,8 @@ struct BinaryReader {
                          void* user_data);
   Result (*on_loop_expr)(uint32_t num_types, Type* sig_types, void* user_data);
   Result (*on_current_memory_expr)(void* user_data);
+  Result (*on_memory_copy_expr)(void* user_data);
+  Result (*on_memory_fill_expr)(void* user_data);
   Result (*on_nop_expr)(void* user_data);
   Result (*on_return_expr)(void* user_data);
   Result (*on_select_expr)(void* user_data);
@@ -236,6 +317,22 @@ struct BinaryReader {
                                    void* user_data);
   Result (*end_function_bodies_section)(BinaryReaderContext* ctx);
 
+  /* If set, and ReadBinaryOptions::num_threads is more than 1, the function
+   * bodies are decoded in parallel, after on_function_bodies_count. This is
+   * called on the reading thread for each decoding thread, and returns the
+   * user_data for the callbacks from begin_function_body to
+   * end_function_body on that thread, including on_error. So each thread
+   * gets its functions in order, but not the others'. Once every thread is
+   * done, end_function_bodies_thread is called for each of them, in order,
+   * on the reading thread, to merge their results. A thread stops at its
+   * first error; to report what reading serially would, only report the
+   * errors of the thread whose on_error had the lowest offset. */
+  void* (*begin_function_bodies_thread)(uint32_t thread_index,
+                                        void* user_data);
+  Result (*end_function_bodies_thread)(uint32_t thread_index,
+                                       void* thread_user_data,
+                                       void* user_data);
+
   /* elem section */
   Result (*begin_elem_section)(BinaryReaderContext* ctx, uint32_t size);
   Result (*on_elem_segment_count)(uint32_t count, void* user_data);
@@ -332,14 +429,113 @@ Result read_binary(const void* data,
                    uint32_t num_function_passes,
                    const ReadBinaryOptions* options);
 
+/* An index of a module's sections, exports and function bodies, for tools
+ * that only need to find things in a module. Reading it only skims the
+ * section headers and item counts, the import and export sections, and the
+ * size of each function body, so it is much faster than read_binary for
+ * large modules. Offsets are from the start of the module, and the
+ * StringSlices point into the module data. */
+struct BinaryIndexSection {
+  BinarySection section;
+  size_t offset; /* of the section contents, after the section size */
+  uint32_t size;
+  /* Whether the section starts with an item count; only the custom and start
+   * sections don't. */
+  bool has_count;
+  uint32_t count;
+  StringSlice name; /* custom sections only */
+};
+
+struct BinaryIndexExport {
+  StringSlice name;
+  ExternalKind kind;
+  uint32_t index;
+};
+
+struct BinaryIndexFunctionBody {
+  size_t size_offset; /* of the body size */
+  size_t offset;      /* of the local declarations, after the body size */
+  uint32_t size;
+};
+
+struct BinaryIndex {
+  uint32_t version = 0;
+  std::vector<BinaryIndexSection> sections;
+  std::vector<BinaryIndexExport> exports;
+  /* Indexed by defined function, so the body of function index |i| is
+   * function_bodies[i - num_func_imports]. */
+  std::vector<BinaryIndexFunctionBody> function_bodies;
+  uint32_t num_signatures = 0;
+  uint32_t num_func_imports = 0;
+  uint32_t num_table_imports = 0;
+  uint32_t num_memory_imports = 0;
+  uint32_t num_global_imports = 0;
+  uint32_t num_tables = 0;
+  uint32_t num_memories = 0;
+  uint32_t num_globals = 0;
+};
+
+/* The error handler may be null, in which case errors are printed to
+ * stderr. */
+Result read_binary_index(const void* data,
+                         size_t size,
+                         BinaryIndex* out_index,
+                         BinaryErrorHandler* error_handler);
+
+/* Read the body of function |func_index| (a module function index) using
+ * an index read from the same data. Only the function body callbacks of
+ * |reader| are called; the log_stream option is ignored. */
+Result read_binary_indexed_function_body(const void* data,
+                                         size_t size,
+                                         const BinaryIndex* index,
+                                         uint32_t func_index,
+                                         BinaryReader* reader,
+                                         const ReadBinaryOptions* options);
+
+/* Incremental reading, for modules that arrive in pieces. The module is
+ * passed to feed_binary_reader_stream in chunks of any size. The callbacks
+ * for each section are called as soon as the whole section has been fed,
+ * except in the code section, where each function body is read as soon as it
+ * has been fed. finish_binary_reader_stream reads whatever is left and calls
+ * end_module, or reports the module as truncated.
+ *
+ * Once any call fails, the rest fail too. The data passed to the callbacks is
+ * only valid until the next call to feed_binary_reader_stream. */
+struct BinaryReaderStream;
+
+BinaryReaderStream* new_binary_reader_stream(BinaryReader* reader,
+                                             const ReadBinaryOptions* options);
+Result feed_binary_reader_stream(BinaryReaderStream*,
+                                 const void* data,
+                                 size_t size);
+Result finish_binary_reader_stream(BinaryReaderStream*);
+/* All of the data fed so far. */
+const void* get_binary_reader_stream_data(BinaryReaderStream*,
+                                          size_t* out_size);
+void delete_binary_reader_stream(BinaryReaderStream*);
+
 size_t read_u32_leb128(const uint8_t* ptr,
                        const uint8_t* end,
                        uint32_t* out_value);
 
+/* Decodes up to |count| consecutive u32 leb128 values. Returns the number of
+ * values decoded, which is less than |count| only if the next value is
+ * malformed or truncated, and sets |*out_size| to the number of bytes they
+ * used. */
+size_t read_u32_leb128s(const uint8_t* ptr,
+                        const uint8_t* end,
+                        uint32_t* out_values,
+                        size_t count,
+                        size_t* out_size);
+
 size_t read_i32_leb128(const uint8_t* ptr,
                        const uint8_t* end,
                        uint32_t* out_value);
 
+size_t read_i64_leb128(const uint8_t* ptr,
+                       const uint8_t* end,
+                       uint64_t* out_value);
+
 }  // namespace wabt
 
 #endif /* WABT_BINARY_READER_H_ */
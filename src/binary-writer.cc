@@ -251,7 +251,21 @@ void write_str(Stream* stream,
 }
 
 void write_opcode(Stream* stream, Opcode opcode) {
-  write_u8_enum(stream, opcode, get_opcode_name(opcode));
+  switch (opcode) {
+    case Opcode::MemoryCopy:
+      write_u8(stream, WABT_BINARY_PREFIX_BULK_MEMORY, "bulk memory prefix");
+      write_u32_leb128(stream, WABT_BINARY_BULK_MEMORY_COPY,
+                       get_opcode_name(opcode));
+      break;
+    case Opcode::MemoryFill:
+      write_u8(stream, WABT_BINARY_PREFIX_BULK_MEMORY, "bulk memory prefix");
+      write_u32_leb128(stream, WABT_BINARY_BULK_MEMORY_FILL,
+                       get_opcode_name(opcode));
+      break;
+    default:
+      write_u8_enum(stream, opcode, get_opcode_name(opcode));
+      break;
+  }
 }
 
 void write_type(Stream* stream, Type type) {
@@ -472,6 +486,15 @@ static void write_expr(Context* ctx,
       write_opcode(&ctx->stream, Opcode::GrowMemory);
       write_u32_leb128(&ctx->stream, 0, "grow_memory reserved");
       break;
+    case ExprType::MemoryCopy:
+      write_opcode(&ctx->stream, Opcode::MemoryCopy);
+      write_u32_leb128(&ctx->stream, 0, "memory.copy dst memory index");
+      write_u32_leb128(&ctx->stream, 0, "memory.copy src memory index");
+      break;
+    case ExprType::MemoryFill:
+      write_opcode(&ctx->stream, Opcode::MemoryFill);
+      write_u32_leb128(&ctx->stream, 0, "memory.fill memory index");
+      break;
     case ExprType::If:
       write_opcode(&ctx->stream, Opcode::If);
       write_inline_signature_type(&ctx->stream, expr->if_.true_->sig);
@@ -23,6 +23,12 @@
 #define WABT_BINARY_VERSION 1
 #define WABT_BINARY_LIMITS_HAS_MAX_FLAG 0x1
 
+/* memory.copy and memory.fill are encoded as this prefix byte followed by a
+ * LEB128 sub-opcode */
+#define WABT_BINARY_PREFIX_BULK_MEMORY 0xfc
+#define WABT_BINARY_BULK_MEMORY_COPY 0x0a
+#define WABT_BINARY_BULK_MEMORY_FILL 0x0b
+
 #define WABT_BINARY_SECTION_NAME "name"
 #define WABT_BINARY_SECTION_RELOC "reloc"
 
@@ -62,6 +68,29 @@ static WABT_INLINE const char* get_section_name(BinarySection sec) {
   return g_section_name[static_cast<size_t>(sec)];
 }
 
+static WABT_INLINE bool is_concrete_type(Type type) {
+  switch (type) {
+    case Type::I32:
+    case Type::I64:
+    case Type::F32:
+    case Type::F64:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/* whether |type| can be the signature of a block, loop or if */
+static WABT_INLINE bool is_inline_sig_type(Type type) {
+  return is_concrete_type(type) || type == Type::Void;
+}
+
+/* number of bytes used to encode |opcode|, including any prefix byte */
+static WABT_INLINE size_t get_opcode_encoded_size(Opcode opcode) {
+  return opcode == Opcode::MemoryCopy || opcode == Opcode::MemoryFill ? 2 : 1;
+}
+
 }  // namespace wabt
 
 #endif /* WABT_BINARY_H_ */
@@ -17,11 +17,14 @@
 #ifndef WABT_BINDING_HASH_H_
 #define WABT_BINDING_HASH_H_
 
+#include <assert.h>
+
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "common.h"
+#include "string-view.h"
 
 namespace wabt {
 
@@ -35,10 +38,62 @@ struct Binding {
   int index;
 };
 
+// The key type of a BindingHash. A key stored in the hash owns its name, but a
+// key built with BindingKey::borrow only refers to the caller's name, so it
+// can be used to look up a binding without allocating. Both kinds hash and
+// compare by the name's contents.
+class BindingKey {
+ public:
+  BindingKey(const std::string& name)
+      : name_(name), view_(name_), owns_name_(true) {}
+  BindingKey(std::string&& name)
+      : name_(std::move(name)), view_(name_), owns_name_(true) {}
+  BindingKey(const BindingKey& other)
+      : name_(other.name_),
+        view_(other.owns_name_ ? string_view(name_) : other.view_),
+        owns_name_(other.owns_name_) {}
+  BindingKey(BindingKey&& other)
+      : name_(std::move(other.name_)),
+        view_(other.owns_name_ ? string_view(name_) : other.view_),
+        owns_name_(other.owns_name_) {}
+  BindingKey& operator=(const BindingKey&) = delete;
+
+  static BindingKey borrow(string_view name) { return BindingKey(name); }
+
+  string_view view() const { return view_; }
+  const std::string& str() const {
+    assert(owns_name_);
+    return name_;
+  }
+  const char* c_str() const { return str().c_str(); }
+
+ private:
+  explicit BindingKey(string_view name) : view_(name), owns_name_(false) {}
+
+  std::string name_;
+  string_view view_;
+  bool owns_name_;
+};
+
+inline bool operator==(const BindingKey& lhs, const BindingKey& rhs) {
+  return lhs.view() == rhs.view();
+}
+
+inline bool operator!=(const BindingKey& lhs, const BindingKey& rhs) {
+  return lhs.view() != rhs.view();
+}
+
+struct BindingKeyHash {
+  hash_code operator()(const BindingKey& key) const {
+    return std::hash<string_view>()(key.view());
+  }
+};
+
 // This class derives from a C++ container, which is usually not advisable
 // because they don't have virtual destructors. So don't delete a BindingHash
 // object through a pointer to std::unordered_multimap.
-class BindingHash : public std::unordered_multimap<std::string, Binding> {
+class BindingHash
+    : public std::unordered_multimap<BindingKey, Binding, BindingKeyHash> {
  public:
   typedef void (*DuplicateCallback)(const value_type& a,
                                     const value_type& b,
@@ -46,13 +101,25 @@ class BindingHash : public std::unordered_multimap<std::string, Binding> {
 
   void find_duplicates(DuplicateCallback callback, void* user_data) const;
 
-  int find_index(const StringSlice& name) const {
-    auto iter = find(string_slice_to_string(name));
+  const_iterator find_name(string_view name) const {
+    return find(BindingKey::borrow(name));
+  }
+
+  int find_index(string_view name) const {
+    auto iter = find_name(name);
     if (iter != end())
       return iter->second.index;
     return -1;
   }
 
+  int find_index(const StringSlice& name) const {
+    return find_index(string_view(name.start, name.length));
+  }
+
+  size_type erase_name(string_view name) {
+    return erase(BindingKey::borrow(name));
+  }
+
  private:
   typedef std::vector<const value_type*> ValueTypeVector;
 
@@ -22,6 +22,16 @@
 #include <string.h>
 #include <limits.h>
 
+#include <algorithm>
+#include <vector>
+
+#if HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #if COMPILER_IS_MSVC
 #include <fcntl.h>
 #include <io.h>
@@ -52,6 +62,7 @@ void init_opcode_info(void) {
     WABT_FOREACH_OPCODE(V)
 
 #undef V
+    s_initialized = true;
   }
 }
 
@@ -126,6 +137,32 @@ void destroy_string_slice(StringSlice* str) {
   delete [] str->start;
 }
 
+/* Pipes and terminals can't be seeked, so their size isn't known up front. */
+static Result read_unseekable_file(FILE* infile,
+                                   char** out_data,
+                                   size_t* out_size) {
+  std::vector<char> buffer;
+  size_t size = 0;
+  for (;;) {
+    buffer.resize(std::max<size_t>(buffer.size() * 2, 64 * 1024));
+    size_t bytes_read = fread(&buffer[size], 1, buffer.size() - size, infile);
+    size += bytes_read;
+    if (size < buffer.size())
+      break;
+  }
+  if (ferror(infile)) {
+    perror("fread failed");
+    return Result::Error;
+  }
+
+  char* data = new char[size];
+  if (size != 0)
+    memcpy(data, buffer.data(), size);
+  *out_data = data;
+  *out_size = size;
+  return Result::Ok;
+}
+
 Result read_file(const char* filename, char** out_data, size_t* out_size) {
   FILE* infile = fopen(filename, "rb");
   if (!infile) {
@@ -136,25 +173,21 @@ Result read_file(const char* filename, char** out_data, size_t* out_size) {
     return Result::Error;
   }
 
-  if (fseek(infile, 0, SEEK_END) < 0) {
-    perror("fseek to end failed");
-    return Result::Error;
-  }
-
-  long size = ftell(infile);
-  if (size < 0) {
-    perror("ftell failed");
-    return Result::Error;
-  }
-
-  if (fseek(infile, 0, SEEK_SET) < 0) {
-    perror("fseek to beginning failed");
-    return Result::Error;
+  long size = -1;
+  if (fseek(infile, 0, SEEK_END) == 0)
+    size = ftell(infile);
+  if (size < 0 || fseek(infile, 0, SEEK_SET) < 0) {
+    clearerr(infile);
+    Result result = read_unseekable_file(infile, out_data, out_size);
+    fclose(infile);
+    return result;
   }
 
   char* data = new char [size];
   if (size != 0 && fread(data, size, 1, infile) != 1) {
     perror("fread failed");
+    delete[] data;
+    fclose(infile);
     return Result::Error;
   }
 
@@ -164,6 +197,53 @@ Result read_file(const char* filename, char** out_data, size_t* out_size) {
   return Result::Ok;
 }
 
+MappedFile::MappedFile() : data(nullptr), size(0), fd(-1) {}
+
+Result map_file(const char* filename, MappedFile* out_file, bool writable) {
+#if HAVE_MMAP
+  int fd = open(filename, O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      size_t size = static_cast<size_t>(st.st_size);
+      int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+      void* data = mmap(nullptr, size, prot, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        /* The readers go through the file once from start to end, but may
+         * skip most of it (e.g. wasmdump -h), so only pages that are touched
+         * get read in. */
+        madvise(data, size, MADV_SEQUENTIAL);
+        out_file->data = static_cast<char*>(data);
+        out_file->size = size;
+        out_file->fd = fd;
+        return Result::Ok;
+      }
+    }
+    close(fd);
+  }
+  /* Fall back to reading it. This handles pipes, and also reports the error
+   * if there is one. */
+#endif
+  out_file->fd = -1;
+  return read_file(filename, &out_file->data, &out_file->size);
+}
+
+void unmap_file(MappedFile* file) {
+#if HAVE_MMAP
+  if (file->fd >= 0) {
+    munmap(file->data, file->size);
+    close(file->fd);
+    file->data = nullptr;
+    file->size = 0;
+    file->fd = -1;
+    return;
+  }
+#endif
+  delete[] file->data;
+  file->data = nullptr;
+  file->size = 0;
+}
+
 static void print_carets(FILE* out,
                          size_t num_spaces,
                          size_t num_carets,
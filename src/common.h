@@ -219,7 +219,8 @@ enum { WABT_USE_NATURAL_ALIGNMENT = 0xFFFFFFFF };
  *   t1: type of the 1st parameter
  *   t2: type of the 2nd parameter
  *    m: memory size of the operation, if any
- * code: opcode
+ * code: opcode; the prefixed bulk memory opcodes are given otherwise unused
+ *       codes here, see binary.h for their encoding
  * NAME: used to generate the opcode enum
  * text: a string of the opcode name in the AST format
  *
@@ -397,7 +398,9 @@ enum { WABT_USE_NATURAL_ALIGNMENT = 0xFFFFFFFF };
   V(I32, F32, ___, 0, 0xbc, I32ReinterpretF32, "i32.reinterpret/f32") \
   V(I64, F64, ___, 0, 0xbd, I64ReinterpretF64, "i64.reinterpret/f64") \
   V(F32, I32, ___, 0, 0xbe, F32ReinterpretI32, "f32.reinterpret/i32") \
-  V(F64, I64, ___, 0, 0xbf, F64ReinterpretI64, "f64.reinterpret/i64")
+  V(F64, I64, ___, 0, 0xbf, F64ReinterpretI64, "f64.reinterpret/i64") \
+  V(___, I32, I32, 0, 0xc0, MemoryCopy, "memory.copy")                \
+  V(___, I32, I32, 0, 0xc1, MemoryFill, "memory.fill")
 
 enum class Opcode {
 #define V(rtype, type1, type2, mem_size, code, Name, text) Name = code,
@@ -405,7 +408,7 @@ enum class Opcode {
 #undef V
 
       First = Unreachable,
-  Last = F64ReinterpretI64,
+  Last = MemoryFill,
 };
 static const int kOpcodeCount = WABT_ENUM_COUNT(Opcode);
 
@@ -473,6 +476,27 @@ bool string_slices_are_equal(const StringSlice*, const StringSlice*);
 void destroy_string_slice(StringSlice*);
 Result read_file(const char* filename, char** out_data, size_t* out_size);
 
+/* A file's contents, mapped when mmap is available and the file is a regular
+ * one, and read into a new[]'d buffer otherwise (e.g. for pipes). |fd| stays
+ * open while the file is mapped so that ranges of it can be mapped again
+ * elsewhere (see InterpreterMemoryData); it is -1 when the contents were read
+ * instead. Anything pointing into |data|, such as the StringSlices from the
+ * binary reader, is only valid until unmap_file. */
+struct MappedFile {
+  MappedFile();
+
+  char* data;
+  size_t size;
+  int fd;
+};
+
+/* The mapping is read-only unless |writable|, in which case writes go to
+ * private copies of the pages and never reach the file. */
+Result map_file(const char* filename,
+                MappedFile* out_file,
+                bool writable = false);
+void unmap_file(MappedFile*);
+
 inline std::string string_slice_to_string(const StringSlice& ss) {
   return std::string(ss.start, ss.length);
 }
@@ -0,0 +1,475 @@
+/*
+ * Copyright 2017 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter-host-log.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "binary.h"
+#include "binary-reader.h"
+#include "binary-writer.h"
+
+#define CHECK_RESULT(expr)  \
+  do {                      \
+    if (WABT_FAILED(expr))  \
+      return Result::Error; \
+  } while (0)
+
+namespace wabt {
+
+InterpreterHostLog::InterpreterHostLog()
+    : mode(InterpreterHostLogMode::Record),
+      data(nullptr),
+      size(0),
+      offset(0),
+      error(nullptr) {
+  WABT_ZERO_MEMORY(writer);
+  WABT_ZERO_MEMORY(stream);
+}
+
+static bool is_64_bit_type(Type type) {
+  return type == Type::I64 || type == Type::F64;
+}
+
+static void WABT_PRINTF_FORMAT(2, 3)
+    print_error(PrintErrorCallback callback, const char* format, ...) {
+  WABT_SNPRINTF_ALLOCA(buffer, length, format);
+  callback.print_error(buffer, callback.user_data);
+}
+
+static void write_types(Stream* stream, const std::vector<Type>& types) {
+  write_u32_leb128(stream, types.size(), "type count");
+  for (Type type : types)
+    write_type(stream, type);
+}
+
+static void write_values(Stream* stream,
+                         uint32_t num_values,
+                         const InterpreterTypedValue* values) {
+  for (uint32_t i = 0; i < num_values; ++i) {
+    if (is_64_bit_type(values[i].type))
+      write_u64(stream, values[i].value.i64, "value");
+    else
+      write_u32(stream, values[i].value.i32, "value");
+  }
+}
+
+static Result record_host_callback(InterpreterThread* thread,
+                                   const HostInterpreterFunc* func,
+                                   const InterpreterFuncSignature* sig,
+                                   uint32_t num_args,
+                                   InterpreterTypedValue* args,
+                                   uint32_t num_results,
+                                   InterpreterTypedValue* out_results,
+                                   void* user_data) {
+  InterpreterHostLogFunc* log_func =
+      static_cast<InterpreterHostLogFunc*>(user_data);
+  Result result =
+      log_func->callback(thread, func, sig, num_args, args, num_results,
+                         out_results, log_func->user_data);
+  Stream* stream = &log_func->log->stream;
+  write_str(stream, func->module_name.start, func->module_name.length,
+            PrintChars::Yes, "module name");
+  write_str(stream, func->field_name.start, func->field_name.length,
+            PrintChars::Yes, "field name");
+  write_types(stream, sig->param_types);
+  write_types(stream, sig->result_types);
+  write_u8(stream, WABT_SUCCEEDED(result) ? 0 : 1, "result");
+  write_values(stream, num_args, args);
+  if (WABT_SUCCEEDED(result))
+    write_values(stream, num_results, out_results);
+  return result;
+}
+
+static Result read_log_u8(InterpreterHostLog* log, uint8_t* out_value) {
+  if (log->offset >= log->size)
+    return Result::Error;
+  *out_value = static_cast<uint8_t>(log->data[log->offset++]);
+  return Result::Ok;
+}
+
+static Result read_log_u32_leb128(InterpreterHostLog* log,
+                                  uint32_t* out_value) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(log->data) + log->offset;
+  const uint8_t* end = reinterpret_cast<const uint8_t*>(log->data) + log->size;
+  size_t bytes_read = read_u32_leb128(p, end, out_value);
+  if (bytes_read == 0)
+    return Result::Error;
+  log->offset += bytes_read;
+  return Result::Ok;
+}
+
+static Result read_log_str(InterpreterHostLog* log, StringSlice* out_str) {
+  uint32_t length;
+  CHECK_RESULT(read_log_u32_leb128(log, &length));
+  if (length > log->size - log->offset)
+    return Result::Error;
+  out_str->start = log->data + log->offset;
+  out_str->length = length;
+  log->offset += length;
+  return Result::Ok;
+}
+
+static Result read_log_types(InterpreterHostLog* log,
+                             std::vector<Type>* out_types) {
+  uint32_t num_types;
+  CHECK_RESULT(read_log_u32_leb128(log, &num_types));
+  if (num_types > log->size - log->offset)
+    return Result::Error;
+  out_types->resize(num_types);
+  for (Type& type : *out_types) {
+    const uint8_t* p =
+        reinterpret_cast<const uint8_t*>(log->data) + log->offset;
+    const uint8_t* end =
+        reinterpret_cast<const uint8_t*>(log->data) + log->size;
+    uint32_t type_u32;
+    size_t bytes_read = read_i32_leb128(p, end, &type_u32);
+    type = static_cast<Type>(type_u32);
+    if (bytes_read == 0 || !is_concrete_type(type))
+      return Result::Error;
+    log->offset += bytes_read;
+  }
+  return Result::Ok;
+}
+
+static Result read_log_value(InterpreterHostLog* log,
+                             Type type,
+                             InterpreterValue* out_value) {
+  size_t value_size =
+      is_64_bit_type(type) ? sizeof(uint64_t) : sizeof(uint32_t);
+  if (value_size > log->size - log->offset)
+    return Result::Error;
+  out_value->i64 = 0;
+  memcpy(out_value, log->data + log->offset, value_size);
+  log->offset += value_size;
+  return Result::Ok;
+}
+
+/* Reads an entry up to its args. */
+static Result read_log_entry_header(InterpreterHostLog* log,
+                                    InterpreterHostLogImport* out_import,
+                                    uint8_t* out_result) {
+  CHECK_RESULT(read_log_str(log, &out_import->module_name));
+  CHECK_RESULT(read_log_str(log, &out_import->field_name));
+  CHECK_RESULT(read_log_types(log, &out_import->sig.param_types));
+  CHECK_RESULT(read_log_types(log, &out_import->sig.result_types));
+  CHECK_RESULT(read_log_u8(log, out_result));
+  return *out_result <= 1 ? Result::Ok : Result::Error;
+}
+
+static bool import_is_logged(const InterpreterHostLogImport* logged,
+                             const StringSlice* module_name,
+                             const StringSlice* field_name,
+                             const InterpreterFuncSignature* sig) {
+  return string_slices_are_equal(&logged->module_name, module_name) &&
+         string_slices_are_equal(&logged->field_name, field_name) &&
+         logged->sig.param_types == sig->param_types &&
+         logged->sig.result_types == sig->result_types;
+}
+
+static bool find_logged_import(InterpreterHostLog* log,
+                               const StringSlice* module_name,
+                               const StringSlice* field_name,
+                               const InterpreterFuncSignature* sig) {
+  for (const InterpreterHostLogImport& logged : log->imports) {
+    if (import_is_logged(&logged, module_name, field_name, sig))
+      return true;
+  }
+  return false;
+}
+
+static bool values_are_identical(Type type,
+                                 const InterpreterValue* v1,
+                                 const InterpreterValue* v2) {
+  if (is_64_bit_type(type))
+    return v1->i64 == v2->i64;
+  return v1->i32 == v2->i32;
+}
+
+#define REPLAY_ERROR_UNLESS(cond, message) \
+  do {                                     \
+    if (!(cond)) {                         \
+      log->error = message;                \
+      return Result::Error;                \
+    }                                      \
+  } while (0)
+
+static Result replay_host_callback(InterpreterThread* thread,
+                                   const HostInterpreterFunc* func,
+                                   const InterpreterFuncSignature* sig,
+                                   uint32_t num_args,
+                                   InterpreterTypedValue* args,
+                                   uint32_t num_results,
+                                   InterpreterTypedValue* out_results,
+                                   void* user_data) {
+  InterpreterHostLog* log = static_cast<InterpreterHostLog*>(user_data);
+  /* init_host_log_replayer has checked that every entry is complete */
+  const char* malformed = "host call log is malformed";
+  /* keep the first error; the log is out of step after it */
+  if (log->error)
+    return Result::Error;
+  REPLAY_ERROR_UNLESS(log->offset < log->size, "host call log is exhausted");
+
+  InterpreterHostLogImport logged;
+  uint8_t logged_result;
+  REPLAY_ERROR_UNLESS(
+      WABT_SUCCEEDED(read_log_entry_header(log, &logged, &logged_result)),
+      malformed);
+  REPLAY_ERROR_UNLESS(import_is_logged(&logged, &func->module_name,
+                                       &func->field_name, sig),
+                      "host call log expected a different function");
+
+  for (uint32_t i = 0; i < num_args; ++i) {
+    InterpreterValue logged_arg;
+    REPLAY_ERROR_UNLESS(
+        WABT_SUCCEEDED(read_log_value(log, args[i].type, &logged_arg)),
+        malformed);
+    REPLAY_ERROR_UNLESS(
+        values_are_identical(args[i].type, &logged_arg, &args[i].value),
+        "host call log argument mismatch");
+  }
+
+  if (logged_result != 0)
+    return Result::Error;
+
+  for (uint32_t i = 0; i < num_results; ++i) {
+    out_results[i].type = sig->result_types[i];
+    REPLAY_ERROR_UNLESS(WABT_SUCCEEDED(read_log_value(
+                            log, out_results[i].type, &out_results[i].value)),
+                        malformed);
+  }
+  return Result::Ok;
+}
+
+void init_host_log_recorder(InterpreterHostLog* log) {
+  log->mode = InterpreterHostLogMode::Record;
+  init_mem_writer(&log->writer);
+  init_stream(&log->stream, &log->writer.base, nullptr);
+  write_u32(&log->stream, WABT_HOST_LOG_MAGIC, "host log magic");
+  write_u32(&log->stream, WABT_HOST_LOG_VERSION, "host log version");
+}
+
+/* Skips the entry at log->offset, adding its function to log->imports if it
+ * isn't there yet. */
+static Result scan_log_entry(InterpreterHostLog* log) {
+  InterpreterHostLogImport import;
+  uint8_t result;
+  CHECK_RESULT(read_log_entry_header(log, &import, &result));
+  InterpreterValue value;
+  for (Type type : import.sig.param_types)
+    CHECK_RESULT(read_log_value(log, type, &value));
+  if (result == 0) {
+    for (Type type : import.sig.result_types)
+      CHECK_RESULT(read_log_value(log, type, &value));
+  }
+  if (!find_logged_import(log, &import.module_name, &import.field_name,
+                          &import.sig)) {
+    log->imports.push_back(import);
+  }
+  return Result::Ok;
+}
+
+Result init_host_log_replayer(InterpreterHostLog* log, const char* filename) {
+  log->mode = InterpreterHostLogMode::Replay;
+  CHECK_RESULT(read_file(filename, &log->data, &log->size));
+  uint32_t magic;
+  uint32_t version;
+  if (log->size < sizeof(magic) + sizeof(version)) {
+    fprintf(stderr, "%s: host call log is too short\n", filename);
+    return Result::Error;
+  }
+  memcpy(&magic, log->data, sizeof(magic));
+  memcpy(&version, log->data + sizeof(magic), sizeof(version));
+  if (magic != WABT_HOST_LOG_MAGIC || version != WABT_HOST_LOG_VERSION) {
+    fprintf(stderr, "%s: not a host call log, or unsupported version\n",
+            filename);
+    return Result::Error;
+  }
+  size_t entries_offset = sizeof(magic) + sizeof(version);
+  log->offset = entries_offset;
+  while (log->offset < log->size) {
+    size_t entry_offset = log->offset;
+    if (WABT_FAILED(scan_log_entry(log))) {
+      fprintf(stderr,
+              "%s:%#" PRIzx ": host call log is truncated or malformed\n",
+              filename, entry_offset);
+      return Result::Error;
+    }
+  }
+  log->offset = entries_offset;
+  return Result::Ok;
+}
+
+void destroy_host_log(InterpreterHostLog* log) {
+  if (log->mode == InterpreterHostLogMode::Record)
+    close_mem_writer(&log->writer);
+  else
+    delete[] log->data;
+}
+
+void wrap_host_funcs(InterpreterHostLog* log, InterpreterEnvironment* env) {
+  assert(log->mode == InterpreterHostLogMode::Record);
+  /* the wrapped callbacks point into log->funcs, so it can't grow later */
+  assert(log->funcs.empty());
+  size_t num_host_funcs = 0;
+  for (const std::unique_ptr<InterpreterFunc>& func : env->funcs) {
+    if (func->is_host)
+      num_host_funcs++;
+  }
+  log->funcs.resize(num_host_funcs);
+
+  size_t log_func_index = 0;
+  for (const std::unique_ptr<InterpreterFunc>& func : env->funcs) {
+    if (!func->is_host)
+      continue;
+    HostInterpreterFunc* host_func = func->as_host();
+    InterpreterHostLogFunc* log_func = &log->funcs[log_func_index++];
+    log_func->log = log;
+    log_func->callback = host_func->callback;
+    log_func->user_data = host_func->user_data;
+    host_func->callback = record_host_callback;
+    host_func->user_data = log_func;
+  }
+}
+
+static Result replay_import_func(InterpreterImport* import,
+                                 InterpreterFunc* func,
+                                 InterpreterFuncSignature* sig,
+                                 PrintErrorCallback callback,
+                                 void* user_data) {
+  InterpreterHostLogModule* log_module =
+      static_cast<InterpreterHostLogModule*>(user_data);
+  InterpreterHostImportDelegate* delegate = &log_module->delegate;
+  if (!find_logged_import(log_module->log, &import->module_name,
+                          &import->field_name, sig)) {
+    /* never called while recording; the host decides if it exists */
+    if (!delegate->import_func) {
+      print_error(callback,
+                  "unknown host function import \"" PRIstringslice
+                  "." PRIstringslice "\" (not in the host call log)",
+                  WABT_PRINTF_STRING_SLICE_ARG(import->module_name),
+                  WABT_PRINTF_STRING_SLICE_ARG(import->field_name));
+      return Result::Error;
+    }
+    CHECK_RESULT(delegate->import_func(import, func, sig, callback,
+                                       delegate->user_data));
+  }
+  func->as_host()->callback = replay_host_callback;
+  func->as_host()->user_data = log_module->log;
+  return Result::Ok;
+}
+
+static void print_unknown_import(InterpreterImport* import,
+                                 PrintErrorCallback callback) {
+  print_error(callback,
+              "unknown host import \"" PRIstringslice "." PRIstringslice
+              "\"; only functions are replayed from the host call log",
+              WABT_PRINTF_STRING_SLICE_ARG(import->module_name),
+              WABT_PRINTF_STRING_SLICE_ARG(import->field_name));
+}
+
+static Result replay_import_table(InterpreterImport* import,
+                                  InterpreterTable* table,
+                                  PrintErrorCallback callback,
+                                  void* user_data) {
+  InterpreterHostImportDelegate* delegate =
+      &static_cast<InterpreterHostLogModule*>(user_data)->delegate;
+  if (!delegate->import_table) {
+    print_unknown_import(import, callback);
+    return Result::Error;
+  }
+  return delegate->import_table(import, table, callback, delegate->user_data);
+}
+
+static Result replay_import_memory(InterpreterImport* import,
+                                   InterpreterMemory* memory,
+                                   PrintErrorCallback callback,
+                                   void* user_data) {
+  InterpreterHostImportDelegate* delegate =
+      &static_cast<InterpreterHostLogModule*>(user_data)->delegate;
+  if (!delegate->import_memory) {
+    print_unknown_import(import, callback);
+    return Result::Error;
+  }
+  return delegate->import_memory(import, memory, callback,
+                                 delegate->user_data);
+}
+
+static Result replay_import_global(InterpreterImport* import,
+                                   InterpreterGlobal* global,
+                                   PrintErrorCallback callback,
+                                   void* user_data) {
+  InterpreterHostImportDelegate* delegate =
+      &static_cast<InterpreterHostLogModule*>(user_data)->delegate;
+  if (!delegate->import_global) {
+    print_unknown_import(import, callback);
+    return Result::Error;
+  }
+  return delegate->import_global(import, global, callback,
+                                 delegate->user_data);
+}
+
+void add_host_log_imports(InterpreterHostLog* log,
+                          InterpreterEnvironment* env) {
+  assert(log->mode == InterpreterHostLogMode::Replay);
+  /* the delegates point into log->modules, so it can't grow later */
+  assert(log->modules.empty());
+  std::vector<const StringSlice*> module_names;
+  for (const InterpreterHostLogImport& import : log->imports) {
+    bool is_new = true;
+    for (const StringSlice* module_name : module_names) {
+      if (string_slices_are_equal(module_name, &import.module_name)) {
+        is_new = false;
+        break;
+      }
+    }
+    if (is_new)
+      module_names.push_back(&import.module_name);
+  }
+  log->modules.resize(module_names.size());
+
+  for (size_t i = 0; i < module_names.size(); ++i) {
+    int module_index =
+        env->registered_module_bindings.find_index(*module_names[i]);
+    HostInterpreterModule* module;
+    if (module_index < 0) {
+      module = append_host_module(env, *module_names[i]);
+      WABT_ZERO_MEMORY(module->import_delegate);
+    } else if (env->modules[module_index]->is_host) {
+      module = env->modules[module_index]->as_host();
+    } else {
+      /* a defined module; its functions aren't host calls */
+      continue;
+    }
+
+    InterpreterHostLogModule* log_module = &log->modules[i];
+    log_module->log = log;
+    log_module->delegate = module->import_delegate;
+    module->import_delegate.user_data = log_module;
+    module->import_delegate.import_func = replay_import_func;
+    module->import_delegate.import_table = replay_import_table;
+    module->import_delegate.import_memory = replay_import_memory;
+    module->import_delegate.import_global = replay_import_global;
+  }
+}
+
+Result write_host_log_to_file(InterpreterHostLog* log, const char* filename) {
+  assert(log->mode == InterpreterHostLogMode::Record);
+  return write_output_buffer_to_file(&log->writer.buf, filename);
+}
+
+}  // namespace wabt
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2017 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WABT_INTERPRETER_HOST_LOG_H_
+#define WABT_INTERPRETER_HOST_LOG_H_
+
+#include <vector>
+
+#include "common.h"
+#include "interpreter.h"
+#include "stream.h"
+#include "writer.h"
+
+#define WABT_HOST_LOG_MAGIC 0x6c636800 /* "\0hcl" */
+#define WABT_HOST_LOG_VERSION 2
+
+namespace wabt {
+
+/* The log is the magic and version as u32s, followed by one entry per host
+ * call:
+ *
+ *   module name, field name (each a u32 LEB128 length, then the bytes)
+ *   param count (u32 LEB128), then each param type as in a wasm binary
+ *   result count (u32 LEB128), then each result type as in a wasm binary
+ *   result (u8, 0 = Ok, 1 = Error)
+ *   the args, then the results if the call succeeded
+ *
+ * where i32 and f32 values are u32s and i64 and f64 values are u64s. Calls
+ * are matched by name and signature, so a log still replays after the
+ * functions of the environment are renumbered. */
+
+enum class InterpreterHostLogMode {
+  Record,
+  Replay,
+};
+
+struct InterpreterHostLog;
+
+/* The original callback of a wrapped host function. */
+struct InterpreterHostLogFunc {
+  InterpreterHostLog* log;
+  InterpreterHostFuncCallback callback;
+  void* user_data;
+};
+
+/* A function named in a log that is being replayed. */
+struct InterpreterHostLogImport {
+  StringSlice module_name; /* points into InterpreterHostLog::data */
+  StringSlice field_name;
+  InterpreterFuncSignature sig;
+};
+
+/* The original import delegate of a host module whose function imports are
+ * replayed. */
+struct InterpreterHostLogModule {
+  InterpreterHostLog* log;
+  InterpreterHostImportDelegate delegate;
+};
+
+struct InterpreterHostLog {
+  InterpreterHostLog();
+
+  InterpreterHostLogMode mode;
+  std::vector<InterpreterHostLogFunc> funcs;
+  /* Record */
+  MemoryWriter writer;
+  Stream stream;
+  /* Replay */
+  char* data;
+  size_t size;
+  size_t offset;
+  std::vector<InterpreterHostLogImport> imports;
+  std::vector<InterpreterHostLogModule> modules;
+  /* set when a replayed call fails */
+  const char* error;
+};
+
+void init_host_log_recorder(InterpreterHostLog* log);
+/* Reads the whole log, failing if it is truncated, and collects the
+ * functions it names in log->imports. */
+Result init_host_log_replayer(InterpreterHostLog* log, const char* filename);
+void destroy_host_log(InterpreterHostLog* log);
+
+/* Recording: wraps the callback of every host function currently in |env|,
+ * so each call is forwarded to the original callback and appended to the
+ * log. */
+void wrap_host_funcs(InterpreterHostLog* log, InterpreterEnvironment* env);
+
+/* Replaying: makes the function imports of every module named in the log
+ * replay from it, adding a host module for each name that |env| doesn't
+ * have, so no real host is needed for them. It must be called before the
+ * modules are read. The results of a call come from the log, and a call
+ * whose function or arguments differ from the logged one fails. Only
+ * functions are replayed; the other imports of an added module fail. */
+void add_host_log_imports(InterpreterHostLog* log,
+                          InterpreterEnvironment* env);
+
+Result write_host_log_to_file(InterpreterHostLog* log, const char* filename);
+
+}  // namespace wabt
+
+#endif /* WABT_INTERPRETER_HOST_LOG_H_ */
@@ -20,17 +20,25 @@
 #include <inttypes.h>
 #include <math.h>
 
+#if HAVE_MMAP
+#include <sys/mman.h>
+#endif
+#if HAVE_SYSCONF
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <vector>
 
 #include "stream.h"
 
 #define INITIAL_ISTREAM_CAPACITY (64 * 1024)
+#define INTERPRETER_HOST_INLINE_VALUES 8
+/* instructions run between checks for a finished call_interpreter_callable */
+#define INTERPRETER_CALLABLE_QUANTUM 1000
 
 namespace wabt {
 
-static const char* s_interpreter_opcode_name[256];
-
 #define CHECK_RESULT(expr)  \
   do {                      \
     if (WABT_FAILED(expr))  \
@@ -40,24 +48,27 @@ static const char* s_interpreter_opcode_name[256];
 /* TODO(binji): It's annoying to have to have an initializer function, but it
  * seems to be necessary as g++ doesn't allow non-trival designated
  * initializers (e.g. [314] = "blah") */
-static void init_interpreter_opcode_table(void) {
-  static bool s_initialized = false;
-  if (!s_initialized) {
-#define V(rtype, type1, type2, mem_size, code, NAME, text) \
-  s_interpreter_opcode_name[code] = text;
-
+struct InterpreterOpcodeNames {
+  InterpreterOpcodeNames() : names() {
+#define V(rtype, type1, type2, mem_size, code, NAME, text) names[code] = text;
     WABT_FOREACH_INTERPRETER_OPCODE(V)
-
 #undef V
   }
-}
+
+  const char* names[256];
+};
 
 static const char* get_interpreter_opcode_name(InterpreterOpcode opcode) {
-  init_interpreter_opcode_table();
-  return s_interpreter_opcode_name[static_cast<int>(opcode)];
+  /* a function-local static is initialized exactly once, even when several
+   * threads are tracing */
+  static const InterpreterOpcodeNames s_names;
+  return s_names.names[static_cast<int>(opcode)];
 }
 
-InterpreterEnvironment::InterpreterEnvironment() {
+InterpreterEnvironment::InterpreterEnvironment()
+    : istream_encoding(InterpreterIstreamEncoding::Packed),
+      tier_up_threshold(0),
+      recompile_func(nullptr) {
   WABT_ZERO_MEMORY(istream);
   init_output_buffer(&istream, INITIAL_ISTREAM_CAPACITY);
 }
@@ -68,7 +79,9 @@ InterpreterThread::InterpreterThread()
       value_stack_end(nullptr),
       call_stack_top(nullptr),
       call_stack_end(nullptr),
-      pc(0) {}
+      pc(0),
+      suspend_requested(false),
+      suspended_host_func(nullptr) {}
 
 InterpreterImport::InterpreterImport() 
   : kind(ExternalKind::Func) {
@@ -151,11 +164,140 @@ DefinedInterpreterModule::DefinedInterpreterModule(size_t istream_start)
     : InterpreterModule(false),
       start_func_index(WABT_INVALID_INDEX),
       istream_start(istream_start),
-      istream_end(istream_start) {}
+      istream_end(istream_start),
+      num_func_imports(0) {}
 
 HostInterpreterModule::HostInterpreterModule(const StringSlice& name)
     : InterpreterModule(name, true) {}
 
+#if HAVE_MMAP
+static size_t get_host_page_size() {
+#if HAVE_SYSCONF
+  static size_t s_page_size = sysconf(_SC_PAGESIZE);
+  return s_page_size;
+#else
+  return 4096;
+#endif
+}
+#endif
+
+InterpreterMemoryData::InterpreterMemoryData()
+    : data_(nullptr),
+      size_(0),
+      capacity_(0),
+      max_size_(static_cast<uint64_t>(WABT_MAX_PAGES) * WABT_PAGE_SIZE) {}
+
+InterpreterMemoryData::InterpreterMemoryData(size_t size, uint64_t max_size)
+    : data_(nullptr), size_(0), capacity_(0), max_size_(max_size) {
+  resize(size);
+}
+
+InterpreterMemoryData::InterpreterMemoryData(InterpreterMemoryData&& other)
+    : data_(other.data_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      max_size_(other.max_size_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
+}
+
+InterpreterMemoryData& InterpreterMemoryData::operator=(
+    InterpreterMemoryData&& other) {
+  if (this != &other) {
+    release();
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    max_size_ = other.max_size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+  }
+  return *this;
+}
+
+InterpreterMemoryData::~InterpreterMemoryData() {
+  release();
+}
+
+void InterpreterMemoryData::release() {
+#if HAVE_MMAP
+  if (capacity_ > 0) {
+    munmap(data_, capacity_);
+    capacity_ = 0;
+    data_ = nullptr;
+    return;
+  }
+#endif
+  free(data_);
+  data_ = nullptr;
+}
+
+void InterpreterMemoryData::resize(size_t new_size) {
+  if (new_size <= size_)
+    return;
+
+#if HAVE_MMAP
+  /* the address space is reserved the first time the memory is non-empty; if
+   * that fails (e.g. a 32-bit host or a ulimit -v) it stays a heap buffer */
+  if (!data_ && max_size_ <= SIZE_MAX) {
+    void* new_data = mmap(nullptr, max_size_, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (new_data != MAP_FAILED) {
+      data_ = static_cast<char*>(new_data);
+      capacity_ = max_size_;
+    }
+  }
+
+  if (capacity_ > 0) {
+    assert(new_size <= capacity_);
+    /* the newly usable pages are still zero, since they were never touched */
+    size_t start = size_ & ~(get_host_page_size() - 1);
+    if (mprotect(data_ + start, new_size - start, PROT_READ | PROT_WRITE) != 0)
+      WABT_FATAL("unable to allocate %" PRIzd " bytes of memory\n", new_size);
+    size_ = new_size;
+    return;
+  }
+#endif
+
+  char* new_data = static_cast<char*>(realloc(data_, new_size));
+  if (!new_data)
+    WABT_FATAL("unable to allocate %" PRIzd " bytes of memory\n", new_size);
+  memset(new_data + size_, 0, new_size - size_);
+  data_ = new_data;
+  size_ = new_size;
+}
+
+void InterpreterMemoryData::copy_from_file(size_t offset,
+                                           const MappedFile* file,
+                                           size_t file_offset,
+                                           size_t size) {
+  assert(offset + size <= size_);
+  assert(file_offset + size <= file->size);
+  const char* src = file->data + file_offset;
+#if HAVE_MMAP
+  size_t page_size = get_host_page_size();
+  if (capacity_ > 0 && file->fd >= 0 &&
+      offset % page_size == file_offset % page_size) {
+    size_t head = (page_size - offset % page_size) % page_size;
+    size_t pages_size = size > head ? (size - head) & ~(page_size - 1) : 0;
+    if (pages_size > 0) {
+      void* pages =
+          mmap(data_ + offset + head, pages_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_FIXED, file->fd, file_offset + head);
+      if (pages != MAP_FAILED) {
+        size_t tail = head + pages_size;
+        memcpy(data_ + offset, src, head);
+        memcpy(data_ + offset + tail, src + tail, size - tail);
+        return;
+      }
+    }
+  }
+#endif
+  memcpy(data_ + offset, src, size);
+}
+
 void destroy_interpreter_environment(InterpreterEnvironment* env) {
   destroy_output_buffer(&env->istream);
 }
@@ -174,13 +316,50 @@ InterpreterEnvironmentMark mark_interpreter_environment(
   return mark;
 }
 
+static void write_istream_word(InterpreterEnvironment* env,
+                               uint32_t* offset,
+                               uint32_t value,
+                               size_t packed_size) {
+  size_t size = env->istream_encoding == InterpreterIstreamEncoding::Aligned
+                    ? sizeof(uint32_t)
+                    : packed_size;
+  assert(*offset + size <= env->istream.size);
+  memcpy(env->istream.start + *offset, &value, size);
+  *offset += size;
+}
+
+/* Puts back the CountCall that tier-up overwrote with a br to the recompiled
+ * code, and points the table entries at the baseline code again. */
+static void revert_tier_up(InterpreterEnvironment* env,
+                           uint32_t func_index,
+                           DefinedInterpreterFunc* func) {
+  uint32_t offset = func->baseline_offset;
+  write_istream_word(env, &offset,
+                     static_cast<uint32_t>(InterpreterOpcode::CountCall),
+                     sizeof(uint8_t));
+  write_istream_word(env, &offset, func_index, sizeof(uint32_t));
+
+  for (InterpreterTable& table : env->tables) {
+    for (InterpreterTableEntry& entry : table.entries) {
+      if (!entry.is_host && entry.offset == func->offset)
+        entry.offset = func->baseline_offset;
+    }
+  }
+  func->offset = func->baseline_offset;
+  func->baseline_offset = WABT_INVALID_INDEX;
+  func->is_tiered_up = false;
+  func->call_count = 0;
+  func->backedge_count = 0;
+  func->loop_offsets.clear();
+}
+
 void reset_interpreter_environment_to_mark(InterpreterEnvironment* env,
                                            InterpreterEnvironmentMark mark) {
   /* Destroy entries in the binding hash. */
   for (size_t i = mark.modules_size; i < env->modules.size(); ++i) {
     const StringSlice* name = &env->modules[i]->name;
     if (!string_slice_is_empty(name))
-      env->module_bindings.erase(string_slice_to_string(*name));
+      env->module_bindings.erase_name(string_view(name->start, name->length));
   }
 
   /* registered_module_bindings maps from an arbitrary name to a module index,
@@ -203,6 +382,17 @@ void reset_interpreter_environment_to_mark(InterpreterEnvironment* env,
   env->tables.erase(env->tables.begin() + mark.tables_size, env->tables.end());
   env->globals.erase(env->globals.begin() + mark.globals_size,
                      env->globals.end());
+
+  /* Functions below the mark may have been recompiled into the istream above
+   * it by tier-up; they go back to their baseline code, which is below the
+   * mark, so the istream can be truncated. */
+  for (uint32_t i = 0; i < env->funcs.size(); ++i) {
+    if (env->funcs[i]->is_host)
+      continue;
+    DefinedInterpreterFunc* func = env->funcs[i]->as_defined();
+    if (func->is_tiered_up && func->offset >= mark.istream_size)
+      revert_tier_up(env, i, func);
+  }
   env->istream.size = mark.istream_size;
 }
 
@@ -545,13 +735,56 @@ DEFINE_BITCAST(bitcast_u64_to_f64, uint64_t, double)
     thread->value_stack_top -= (drop); \
   } while (0)
 
-#define GOTO(offset) pc = &istream[offset]
+#define GOTO(offset) pc = get_istream_pc<Word>(istream, offset)
+
+/* Recompiling appends to the istream, which may move it; func->is_tiered_up
+ * is set if it succeeded. */
+#define TIER_UP(func_index)                                         \
+  do {                                                              \
+    uint32_t tier_up_offset = get_istream_offset(istream, pc);      \
+    env->recompile_func(env, thread, func_index);                   \
+    istream = reinterpret_cast<const uint8_t*>(env->istream.start); \
+    GOTO(tier_up_offset);                                           \
+  } while (0)
+
+#define READ_IMMEDIATE_I32(pc) read_u32(pc)
+#define READ_IMMEDIATE_I64(pc) read_u64(istream, pc)
+
+#define READ_REG_OPERAND(type, kind, var)                  \
+  do {                                                     \
+    if ((kind) == WABT_REG_OPERAND_STACK)                  \
+      var = POP_##type();                                  \
+    else if ((kind) == WABT_REG_OPERAND_LOCAL)             \
+      var = PICK(read_u32(&pc)).TYPE_FIELD_NAME_##type;    \
+    else                                                   \
+      var = READ_IMMEDIATE_##type(&pc);                    \
+  } while (0)
+
+#define REG_BINOP(type, eval)                                            \
+  do {                                                                   \
+    Opcode binop = static_cast<Opcode>(*pc++);                           \
+    uint32_t mode = *pc++;                                               \
+    VALUE_TYPE_##type lhs, rhs;                                          \
+    READ_REG_OPERAND(type, (mode >> WABT_REG_BINOP_LHS_SHIFT) &          \
+                               WABT_REG_OPERAND_MASK,                    \
+                     lhs);                                               \
+    READ_REG_OPERAND(type, (mode >> WABT_REG_BINOP_RHS_SHIFT) &          \
+                               WABT_REG_OPERAND_MASK,                    \
+                     rhs);                                               \
+    VALUE_TYPE_##type result = eval(binop, lhs, rhs);                    \
+    if (((mode >> WABT_REG_BINOP_DST_SHIFT) & WABT_REG_OPERAND_MASK) ==  \
+        WABT_REG_OPERAND_LOCAL) {                                        \
+      PICK(read_u32(&pc)).TYPE_FIELD_NAME_##type = result;               \
+    } else {                                                             \
+      PUSH_##type(result);                                               \
+    }                                                                    \
+  } while (0)
 
 #define PUSH_CALL()                                           \
   do {                                                        \
     TRAP_IF(thread->call_stack_top >= thread->call_stack_end, \
             CallStackExhausted);                              \
-    (*thread->call_stack_top++) = (pc - istream);             \
+    (*thread->call_stack_top++) = get_istream_offset(istream, pc); \
   } while (0)
 
 #define POP_CALL() (*--thread->call_stack_top)
@@ -560,30 +793,63 @@ DEFINE_BITCAST(bitcast_u64_to_f64, uint64_t, double)
   uint32_t memory_index = read_u32(&pc); \
   InterpreterMemory* var = &env->memories[memory_index]
 
-#define LOAD(type, mem_type)                                              \
-  do {                                                                    \
-    GET_MEMORY(memory);                                                   \
-    uint64_t offset = static_cast<uint64_t>(POP_I32()) + read_u32(&pc);   \
-    MEM_TYPE_##mem_type value;                                            \
-    TRAP_IF(offset + sizeof(value) > memory->data.size(),                 \
-            MemoryAccessOutOfBounds);                                     \
-    void* src = static_cast<void*>(memory->data.data() +                  \
-                                   static_cast<uint32_t>(offset));        \
-    memcpy(&value, src, sizeof(MEM_TYPE_##mem_type));                     \
-    PUSH_##type(static_cast<MEM_TYPE_EXTEND_##type##_##mem_type>(value)); \
+#define LOAD_FROM(type, mem_type, mem_data, mem_size)                      \
+  do {                                                                     \
+    uint64_t offset = static_cast<uint64_t>(POP_I32()) + read_u32(&pc);    \
+    MEM_TYPE_##mem_type value;                                             \
+    TRAP_IF(offset + sizeof(value) > (mem_size), MemoryAccessOutOfBounds); \
+    void* src =                                                            \
+        static_cast<void*>((mem_data) + static_cast<uint32_t>(offset));    \
+    memcpy(&value, src, sizeof(MEM_TYPE_##mem_type));                      \
+    PUSH_##type(static_cast<MEM_TYPE_EXTEND_##type##_##mem_type>(value));  \
+  } while (0)
+
+#define STORE_TO(type, mem_type, mem_data, mem_size)                     \
+  do {                                                                   \
+    VALUE_TYPE_##type value = POP_##type();                              \
+    uint64_t offset = static_cast<uint64_t>(POP_I32()) + read_u32(&pc);  \
+    MEM_TYPE_##mem_type src = static_cast<MEM_TYPE_##mem_type>(value);   \
+    TRAP_IF(offset + sizeof(src) > (mem_size), MemoryAccessOutOfBounds); \
+    void* dst =                                                          \
+        static_cast<void*>((mem_data) + static_cast<uint32_t>(offset));  \
+    memcpy(dst, &src, sizeof(MEM_TYPE_##mem_type));                      \
+  } while (0)
+
+#define LOAD(type, mem_type)                                             \
+  do {                                                                   \
+    GET_MEMORY(memory);                                                  \
+    LOAD_FROM(type, mem_type, memory->data.data(), memory->data.size()); \
   } while (0)
 
 #define STORE(type, mem_type)                                           \
   do {                                                                  \
     GET_MEMORY(memory);                                                 \
-    VALUE_TYPE_##type value = POP_##type();                             \
-    uint64_t offset = static_cast<uint64_t>(POP_I32()) + read_u32(&pc); \
-    MEM_TYPE_##mem_type src = static_cast<MEM_TYPE_##mem_type>(value);  \
-    TRAP_IF(offset + sizeof(src) > memory->data.size(),                 \
-            MemoryAccessOutOfBounds);                                   \
-    void* dst = static_cast<void*>(memory->data.data() +                \
-                                   static_cast<uint32_t>(offset));      \
-    memcpy(dst, &src, sizeof(MEM_TYPE_##mem_type));                     \
+    STORE_TO(type, mem_type, memory->data.data(), memory->data.size()); \
+  } while (0)
+
+#define LOAD_MEM0(type, mem_type) \
+  LOAD_FROM(type, mem_type, mem0_data, mem0_size)
+#define STORE_MEM0(type, mem_type) \
+  STORE_TO(type, mem_type, mem0_data, mem0_size)
+
+#define LOAD_ABS(type, mem_type)                                            \
+  do {                                                                      \
+    uint32_t address = read_u32(&pc);                                       \
+    MEM_TYPE_##mem_type value;                                              \
+    TRAP_IF(static_cast<uint64_t>(address) + sizeof(value) > mem0_size,     \
+            MemoryAccessOutOfBounds);                                       \
+    memcpy(&value, mem0_data + address, sizeof(MEM_TYPE_##mem_type));       \
+    PUSH_##type(static_cast<MEM_TYPE_EXTEND_##type##_##mem_type>(value));   \
+  } while (0)
+
+/* env->memories[0] is cached in locals for the *Mem0 loads and stores. Its
+ * data can only move when it grows, which a host function may also do. */
+#define RELOAD_MEM0()                           \
+  do {                                          \
+    if (!env->memories.empty()) {               \
+      mem0_data = env->memories[0].data.data(); \
+      mem0_size = env->memories[0].data.size(); \
+    }                                           \
   } while (0)
 
 #define BINOP(rtype, type, op)            \
@@ -735,37 +1001,225 @@ DEFINE_BITCAST(bitcast_u64_to_f64, uint64_t, double)
     PUSH_##type(result);                                                       \
   } while (0)
 
-static WABT_INLINE uint32_t read_u32_at(const uint8_t* pc) {
+/* The istream is read through a pointer to its word type: uint8_t for the
+ * packed encoding, uint32_t for the aligned encoding. Opcodes and u8
+ * immediates take one word; u32 and u64 immediates take 4 and 8 bytes. */
+typedef uint8_t PackedWord;
+typedef uint32_t AlignedWord;
+
+static WABT_INLINE uint32_t read_u32_at(const PackedWord* pc) {
   uint32_t result;
   memcpy(&result, pc, sizeof(uint32_t));
   return result;
 }
 
-static WABT_INLINE uint32_t read_u32(const uint8_t** pc) {
+static WABT_INLINE uint32_t read_u32_at(const AlignedWord* pc) {
+  return *pc;
+}
+
+template <typename Word>
+static WABT_INLINE uint32_t read_u32(const Word** pc) {
   uint32_t result = read_u32_at(*pc);
-  *pc += sizeof(uint32_t);
+  *pc += sizeof(uint32_t) / sizeof(Word);
   return result;
 }
 
-static WABT_INLINE uint64_t read_u64_at(const uint8_t* pc) {
+static bool is_mem0_opcode(InterpreterOpcode opcode) {
+  return opcode >= InterpreterOpcode::I32LoadMem0 &&
+         opcode <= InterpreterOpcode::I64Store32Mem0;
+}
+
+/* Reads the memory index of a load or store; the *Mem0 opcodes don't have
+ * one. */
+template <typename Word>
+static uint32_t read_memory_index(InterpreterOpcode opcode, const Word** pc) {
+  return is_mem0_opcode(opcode) ? 0 : read_u32(pc);
+}
+
+static WABT_INLINE const PackedWord* align_u64(const uint8_t* istream,
+                                               const PackedWord* pc) {
+  return pc;
+}
+
+static WABT_INLINE const AlignedWord* align_u64(const uint8_t* istream,
+                                                const AlignedWord* pc) {
+  /* the emitter pads u64 immediates to an 8-byte offset from the start of
+   * the istream, whatever the address of its buffer */
+  size_t offset = reinterpret_cast<const uint8_t*>(pc) - istream;
+  return (offset & sizeof(uint32_t)) ? pc + 1 : pc;
+}
+
+template <typename Word>
+static WABT_INLINE uint64_t read_u64_at(const uint8_t* istream,
+                                        const Word* pc) {
   uint64_t result;
-  memcpy(&result, pc, sizeof(uint64_t));
+  memcpy(&result, align_u64(istream, pc), sizeof(uint64_t));
   return result;
 }
 
-static WABT_INLINE uint64_t read_u64(const uint8_t** pc) {
-  uint64_t result = read_u64_at(*pc);
-  *pc += sizeof(uint64_t);
+template <typename Word>
+static WABT_INLINE uint64_t read_u64(const uint8_t* istream, const Word** pc) {
+  *pc = align_u64(istream, *pc);
+  uint64_t result = read_u64_at(istream, *pc);
+  *pc += sizeof(uint64_t) / sizeof(Word);
   return result;
 }
 
+template <typename Word>
+static WABT_INLINE size_t get_table_entry_size() {
+  return sizeof(uint32_t) * 2 + sizeof(Word);
+}
+
+template <typename Word>
+static WABT_INLINE const Word* get_istream_pc(const uint8_t* istream,
+                                              uint32_t offset) {
+  return reinterpret_cast<const Word*>(&istream[offset]);
+}
+
+template <typename Word>
 static WABT_INLINE void read_table_entry_at(const uint8_t* pc,
                                             uint32_t* out_offset,
                                             uint32_t* out_drop,
                                             uint8_t* out_keep) {
-  *out_offset = read_u32_at(pc + WABT_TABLE_ENTRY_OFFSET_OFFSET);
-  *out_drop = read_u32_at(pc + WABT_TABLE_ENTRY_DROP_OFFSET);
-  *out_keep = *(pc + WABT_TABLE_ENTRY_KEEP_OFFSET);
+  *out_offset =
+      read_u32_at(get_istream_pc<Word>(pc, WABT_TABLE_ENTRY_OFFSET_OFFSET));
+  *out_drop =
+      read_u32_at(get_istream_pc<Word>(pc, WABT_TABLE_ENTRY_DROP_OFFSET));
+  *out_keep = *get_istream_pc<Word>(pc, WABT_TABLE_ENTRY_KEEP_OFFSET);
+}
+
+template <typename Word>
+static WABT_INLINE uint32_t get_istream_offset(const uint8_t* istream,
+                                               const Word* pc) {
+  return reinterpret_cast<const uint8_t*>(pc) - istream;
+}
+
+bool is_interpreter_reg_binop(Opcode opcode) {
+  switch (opcode) {
+    case Opcode::I32Add:
+    case Opcode::I32Sub:
+    case Opcode::I32Mul:
+    case Opcode::I32And:
+    case Opcode::I32Or:
+    case Opcode::I32Xor:
+    case Opcode::I32Shl:
+    case Opcode::I32ShrS:
+    case Opcode::I32ShrU:
+    case Opcode::I32Eq:
+    case Opcode::I32Ne:
+    case Opcode::I32LtS:
+    case Opcode::I32LtU:
+    case Opcode::I32LeS:
+    case Opcode::I32LeU:
+    case Opcode::I32GtS:
+    case Opcode::I32GtU:
+    case Opcode::I32GeS:
+    case Opcode::I32GeU:
+    case Opcode::I64Add:
+    case Opcode::I64Sub:
+    case Opcode::I64Mul:
+    case Opcode::I64And:
+    case Opcode::I64Or:
+    case Opcode::I64Xor:
+    case Opcode::I64Shl:
+    case Opcode::I64ShrS:
+    case Opcode::I64ShrU:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+static WABT_INLINE uint32_t eval_i32_reg_binop(Opcode opcode,
+                                               uint32_t lhs,
+                                               uint32_t rhs) {
+  switch (opcode) {
+    case Opcode::I32Add:
+      return lhs + rhs;
+    case Opcode::I32Sub:
+      return lhs - rhs;
+    case Opcode::I32Mul:
+      return lhs * rhs;
+    case Opcode::I32And:
+      return lhs & rhs;
+    case Opcode::I32Or:
+      return lhs | rhs;
+    case Opcode::I32Xor:
+      return lhs ^ rhs;
+    case Opcode::I32Shl:
+      return lhs << (rhs & SHIFT_MASK_I32);
+    case Opcode::I32ShrU:
+      return lhs >> (rhs & SHIFT_MASK_I32);
+    case Opcode::I32ShrS:
+      return bitcast_u32_to_i32(lhs) >> (rhs & SHIFT_MASK_I32);
+    case Opcode::I32Eq:
+      return lhs == rhs;
+    case Opcode::I32Ne:
+      return lhs != rhs;
+    case Opcode::I32LtS:
+      return bitcast_u32_to_i32(lhs) <
+             bitcast_u32_to_i32(rhs);
+    case Opcode::I32LtU:
+      return lhs < rhs;
+    case Opcode::I32LeS:
+      return bitcast_u32_to_i32(lhs) <=
+             bitcast_u32_to_i32(rhs);
+    case Opcode::I32LeU:
+      return lhs <= rhs;
+    case Opcode::I32GtS:
+      return bitcast_u32_to_i32(lhs) >
+             bitcast_u32_to_i32(rhs);
+    case Opcode::I32GtU:
+      return lhs > rhs;
+    case Opcode::I32GeS:
+      return bitcast_u32_to_i32(lhs) >=
+             bitcast_u32_to_i32(rhs);
+    case Opcode::I32GeU:
+      return lhs >= rhs;
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+static WABT_INLINE uint64_t eval_i64_reg_binop(Opcode opcode,
+                                               uint64_t lhs,
+                                               uint64_t rhs) {
+  switch (opcode) {
+    case Opcode::I64Add:
+      return lhs + rhs;
+    case Opcode::I64Sub:
+      return lhs - rhs;
+    case Opcode::I64Mul:
+      return lhs * rhs;
+    case Opcode::I64And:
+      return lhs & rhs;
+    case Opcode::I64Or:
+      return lhs | rhs;
+    case Opcode::I64Xor:
+      return lhs ^ rhs;
+    case Opcode::I64Shl:
+      return lhs << (rhs & SHIFT_MASK_I64);
+    case Opcode::I64ShrU:
+      return lhs >> (rhs & SHIFT_MASK_I64);
+    case Opcode::I64ShrS:
+      return bitcast_u64_to_i64(lhs) >> (rhs & SHIFT_MASK_I64);
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+uint64_t eval_interpreter_reg_binop(Opcode opcode,
+                                    uint64_t lhs,
+                                    uint64_t rhs) {
+  assert(is_interpreter_reg_binop(opcode));
+  if (get_opcode_param_type_1(opcode) == Type::I32) {
+    return eval_i32_reg_binop(opcode, static_cast<uint32_t>(lhs),
+                              static_cast<uint32_t>(rhs));
+  }
+  return eval_i64_reg_binop(opcode, lhs, rhs);
 }
 
 bool func_signatures_are_equal(InterpreterEnvironment* env,
@@ -779,16 +1233,75 @@ bool func_signatures_are_equal(InterpreterEnvironment* env,
          sig_0->result_types == sig_1->result_types;
 }
 
+uint32_t get_canonical_sig_index(InterpreterEnvironment* env,
+                                 uint32_t sig_index) {
+  InterpreterFuncSignature* sig = &env->sigs[sig_index];
+  if (sig->canonical_index == WABT_INVALID_INDEX) {
+    /* Equality is transitive, so the first equal signature is canonical. */
+    uint32_t i = 0;
+    while (!func_signatures_are_equal(env, i, sig_index))
+      ++i;
+    sig->canonical_index = i;
+  }
+  return sig->canonical_index;
+}
+
+void set_interpreter_table_element(InterpreterEnvironment* env,
+                                   InterpreterTable* table,
+                                   uint32_t index,
+                                   uint32_t func_index) {
+  assert(index < table->func_indexes.size());
+  table->func_indexes[index] = func_index;
+
+  InterpreterTableEntry* entry = &table->entries[index];
+  if (func_index == WABT_INVALID_INDEX) {
+    *entry = InterpreterTableEntry();
+    return;
+  }
+
+  InterpreterFunc* func = env->funcs[func_index].get();
+  entry->sig_index = get_canonical_sig_index(env, func->sig_index);
+  entry->is_host = func->is_host;
+  if (func->is_host)
+    entry->host_func = func->as_host();
+  else
+    entry->offset = func->as_defined()->offset;
+}
+
+static InterpreterResult push_host_results(
+    InterpreterThread* thread,
+    const InterpreterFuncSignature* sig,
+    uint32_t num_results,
+    const InterpreterTypedValue* results) {
+  for (size_t i = 0; i < num_results; ++i) {
+    TRAP_IF(results[i].type != sig->result_types[i], HostResultTypeMismatch);
+    PUSH(results[i].value);
+  }
+  return InterpreterResult::Ok;
+}
+
 InterpreterResult call_host(InterpreterThread* thread,
                             HostInterpreterFunc* func) {
   InterpreterFuncSignature* sig = &thread->env->sigs[func->sig_index];
 
   size_t num_params = sig->param_types.size();
   size_t num_results = sig->result_types.size();
-  // + 1 is a workaround for using data() below; UBSAN doesn't like calling
-  // data() with an empty vector.
-  std::vector<InterpreterTypedValue> params(num_params + 1);
-  std::vector<InterpreterTypedValue> results(num_results + 1);
+  /* most host functions have few params and results, so avoid allocating for
+   * them */
+  InterpreterTypedValue params_buffer[INTERPRETER_HOST_INLINE_VALUES];
+  InterpreterTypedValue results_buffer[INTERPRETER_HOST_INLINE_VALUES];
+  std::vector<InterpreterTypedValue> params_vec;
+  std::vector<InterpreterTypedValue> results_vec;
+  InterpreterTypedValue* params = params_buffer;
+  InterpreterTypedValue* results = results_buffer;
+  if (num_params > INTERPRETER_HOST_INLINE_VALUES) {
+    params_vec.resize(num_params);
+    params = params_vec.data();
+  }
+  if (num_results > INTERPRETER_HOST_INLINE_VALUES) {
+    results_vec.resize(num_results);
+    results = results_vec.data();
+  }
 
   for (size_t i = num_params; i > 0; --i) {
     params[i - 1].value = POP();
@@ -796,28 +1309,50 @@ InterpreterResult call_host(InterpreterThread* thread,
   }
 
   Result call_result =
-      func->callback(func, sig, num_params, params.data(), num_results,
-                     results.data(), func->user_data);
+      func->callback(thread, func, sig, num_params, params, num_results,
+                     results, func->user_data);
+  bool suspend_requested = thread->suspend_requested;
+  thread->suspend_requested = false;
   TRAP_IF(call_result != Result::Ok, HostTrapped);
 
-  for (size_t i = 0; i < num_results; ++i) {
-    TRAP_IF(results[i].type != sig->result_types[i], HostResultTypeMismatch);
-    PUSH(results[i].value);
+  if (suspend_requested) {
+    thread->suspended_host_func = func;
+    return InterpreterResult::Suspended;
   }
 
-  return InterpreterResult::Ok;
+  return push_host_results(thread, sig, num_results, results);
 }
 
-InterpreterResult run_interpreter(InterpreterThread* thread,
-                                  uint32_t num_instructions,
-                                  uint32_t* call_stack_return_top) {
+void suspend_interpreter_thread(InterpreterThread* thread) {
+  thread->suspend_requested = true;
+}
+
+InterpreterResult resume_interpreter_thread(
+    InterpreterThread* thread,
+    uint32_t num_results,
+    const InterpreterTypedValue* results) {
+  assert(thread->suspended_host_func);
+  InterpreterFuncSignature* sig =
+      &thread->env->sigs[thread->suspended_host_func->sig_index];
+  thread->suspended_host_func = nullptr;
+  TRAP_IF(num_results != sig->result_types.size(), HostResultTypeMismatch);
+  return push_host_results(thread, sig, num_results, results);
+}
+
+template <typename Word>
+static InterpreterResult run_interpreter(InterpreterThread* thread,
+                                         uint32_t num_instructions,
+                                         uint32_t* call_stack_return_top) {
   InterpreterResult result = InterpreterResult::Ok;
   assert(call_stack_return_top < thread->call_stack_end);
 
   InterpreterEnvironment* env = thread->env;
 
   const uint8_t* istream = reinterpret_cast<const uint8_t*>(env->istream.start);
-  const uint8_t* pc = &istream[thread->pc];
+  const Word* pc = get_istream_pc<Word>(istream, thread->pc);
+  char* mem0_data = nullptr;
+  uint64_t mem0_size = 0;
+  RELOAD_MEM0();
   for (uint32_t i = 0; i < num_instructions; ++i) {
     InterpreterOpcode opcode = static_cast<InterpreterOpcode>(*pc++);
     switch (opcode) {
@@ -844,13 +1379,13 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         uint32_t num_targets = read_u32(&pc);
         uint32_t table_offset = read_u32(&pc);
         VALUE_TYPE_I32 key = POP_I32();
-        uint32_t key_offset =
-            (key >= num_targets ? num_targets : key) * WABT_TABLE_ENTRY_SIZE;
+        uint32_t key_offset = (key >= num_targets ? num_targets : key) *
+                              get_table_entry_size<Word>();
         const uint8_t* entry = istream + table_offset + key_offset;
         uint32_t new_pc;
         uint32_t drop_count;
         uint8_t keep_count;
-        read_table_entry_at(entry, &new_pc, &drop_count, &keep_count);
+        read_table_entry_at<Word>(entry, &new_pc, &drop_count, &keep_count);
         DROP_KEEP(drop_count, keep_count);
         GOTO(new_pc);
         break;
@@ -873,7 +1408,7 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         break;
 
       case InterpreterOpcode::I64Const:
-        PUSH_I64(read_u64(&pc));
+        PUSH_I64(read_u64(istream, &pc));
         break;
 
       case InterpreterOpcode::F32Const:
@@ -881,7 +1416,7 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         break;
 
       case InterpreterOpcode::F64Const:
-        PUSH_F64(read_u64(&pc));
+        PUSH_F64(read_u64(istream, &pc));
         break;
 
       case InterpreterOpcode::GetGlobal: {
@@ -926,24 +1461,31 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         InterpreterTable* table = &env->tables[table_index];
         uint32_t sig_index = read_u32(&pc);
         VALUE_TYPE_I32 entry_index = POP_I32();
-        TRAP_IF(entry_index >= table->func_indexes.size(), UndefinedTableIndex);
-        uint32_t func_index = table->func_indexes[entry_index];
-        TRAP_IF(func_index == WABT_INVALID_INDEX, UninitializedTableElement);
-        InterpreterFunc* func = env->funcs[func_index].get();
-        TRAP_UNLESS(func_signatures_are_equal(env, func->sig_index, sig_index),
+        TRAP_IF(entry_index >= table->entries.size(), UndefinedTableIndex);
+        const InterpreterTableEntry* entry = &table->entries[entry_index];
+        TRAP_IF(entry->sig_index == WABT_INVALID_INDEX,
+                UninitializedTableElement);
+        /* sig_index is canonical, see on_call_indirect_expr. */
+        TRAP_UNLESS(entry->sig_index == sig_index,
                     IndirectCallSignatureMismatch);
-        if (func->is_host) {
-          call_host(thread, func->as_host());
+        if (entry->is_host) {
+          result = call_host(thread, entry->host_func);
+          if (result != InterpreterResult::Ok)
+            goto exit_loop;
+          RELOAD_MEM0();
         } else {
           PUSH_CALL();
-          GOTO(func->as_defined()->offset);
+          GOTO(entry->offset);
         }
         break;
       }
 
       case InterpreterOpcode::CallHost: {
         uint32_t func_index = read_u32(&pc);
-        call_host(thread, env->funcs[func_index]->as_host());
+        result = call_host(thread, env->funcs[func_index]->as_host());
+        if (result != InterpreterResult::Ok)
+          goto exit_loop;
+        RELOAD_MEM0();
         break;
       }
 
@@ -1039,6 +1581,154 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         STORE(F64, F64);
         break;
 
+      case InterpreterOpcode::I32Load8SMem0:
+        LOAD_MEM0(I32, I8);
+        break;
+
+      case InterpreterOpcode::I32Load8UMem0:
+        LOAD_MEM0(I32, U8);
+        break;
+
+      case InterpreterOpcode::I32Load16SMem0:
+        LOAD_MEM0(I32, I16);
+        break;
+
+      case InterpreterOpcode::I32Load16UMem0:
+        LOAD_MEM0(I32, U16);
+        break;
+
+      case InterpreterOpcode::I64Load8SMem0:
+        LOAD_MEM0(I64, I8);
+        break;
+
+      case InterpreterOpcode::I64Load8UMem0:
+        LOAD_MEM0(I64, U8);
+        break;
+
+      case InterpreterOpcode::I64Load16SMem0:
+        LOAD_MEM0(I64, I16);
+        break;
+
+      case InterpreterOpcode::I64Load16UMem0:
+        LOAD_MEM0(I64, U16);
+        break;
+
+      case InterpreterOpcode::I64Load32SMem0:
+        LOAD_MEM0(I64, I32);
+        break;
+
+      case InterpreterOpcode::I64Load32UMem0:
+        LOAD_MEM0(I64, U32);
+        break;
+
+      case InterpreterOpcode::I32LoadMem0:
+        LOAD_MEM0(I32, U32);
+        break;
+
+      case InterpreterOpcode::I64LoadMem0:
+        LOAD_MEM0(I64, U64);
+        break;
+
+      case InterpreterOpcode::F32LoadMem0:
+        LOAD_MEM0(F32, F32);
+        break;
+
+      case InterpreterOpcode::F64LoadMem0:
+        LOAD_MEM0(F64, F64);
+        break;
+
+      case InterpreterOpcode::I32Store8Mem0:
+        STORE_MEM0(I32, U8);
+        break;
+
+      case InterpreterOpcode::I32Store16Mem0:
+        STORE_MEM0(I32, U16);
+        break;
+
+      case InterpreterOpcode::I64Store8Mem0:
+        STORE_MEM0(I64, U8);
+        break;
+
+      case InterpreterOpcode::I64Store16Mem0:
+        STORE_MEM0(I64, U16);
+        break;
+
+      case InterpreterOpcode::I64Store32Mem0:
+        STORE_MEM0(I64, U32);
+        break;
+
+      case InterpreterOpcode::I32StoreMem0:
+        STORE_MEM0(I32, U32);
+        break;
+
+      case InterpreterOpcode::I64StoreMem0:
+        STORE_MEM0(I64, U64);
+        break;
+
+      case InterpreterOpcode::F32StoreMem0:
+        STORE_MEM0(F32, F32);
+        break;
+
+      case InterpreterOpcode::F64StoreMem0:
+        STORE_MEM0(F64, F64);
+        break;
+
+      case InterpreterOpcode::I32Load8SAbs:
+        LOAD_ABS(I32, I8);
+        break;
+
+      case InterpreterOpcode::I32Load8UAbs:
+        LOAD_ABS(I32, U8);
+        break;
+
+      case InterpreterOpcode::I32Load16SAbs:
+        LOAD_ABS(I32, I16);
+        break;
+
+      case InterpreterOpcode::I32Load16UAbs:
+        LOAD_ABS(I32, U16);
+        break;
+
+      case InterpreterOpcode::I64Load8SAbs:
+        LOAD_ABS(I64, I8);
+        break;
+
+      case InterpreterOpcode::I64Load8UAbs:
+        LOAD_ABS(I64, U8);
+        break;
+
+      case InterpreterOpcode::I64Load16SAbs:
+        LOAD_ABS(I64, I16);
+        break;
+
+      case InterpreterOpcode::I64Load16UAbs:
+        LOAD_ABS(I64, U16);
+        break;
+
+      case InterpreterOpcode::I64Load32SAbs:
+        LOAD_ABS(I64, I32);
+        break;
+
+      case InterpreterOpcode::I64Load32UAbs:
+        LOAD_ABS(I64, U32);
+        break;
+
+      case InterpreterOpcode::I32LoadAbs:
+        LOAD_ABS(I32, U32);
+        break;
+
+      case InterpreterOpcode::I64LoadAbs:
+        LOAD_ABS(I64, U64);
+        break;
+
+      case InterpreterOpcode::F32LoadAbs:
+        LOAD_ABS(F32, F32);
+        break;
+
+      case InterpreterOpcode::F64LoadAbs:
+        LOAD_ABS(F64, F64);
+        break;
+
       case InterpreterOpcode::CurrentMemory: {
         GET_MEMORY(memory);
         PUSH_I32(memory->page_limits.initial);
@@ -1058,10 +1748,36 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
             static_cast<uint64_t>(new_page_size) * WABT_PAGE_SIZE > UINT32_MAX);
         memory->data.resize(new_page_size * WABT_PAGE_SIZE);
         memory->page_limits.initial = new_page_size;
+        RELOAD_MEM0();
         PUSH_I32(old_page_size);
         break;
       }
 
+      case InterpreterOpcode::MemoryCopy: {
+        GET_MEMORY(memory);
+        uint32_t size = POP_I32();
+        uint32_t src = POP_I32();
+        uint32_t dst = POP_I32();
+        TRAP_IF(static_cast<uint64_t>(src) + size > memory->data.size() ||
+                    static_cast<uint64_t>(dst) + size > memory->data.size(),
+                MemoryAccessOutOfBounds);
+        if (size != 0)
+          memmove(memory->data.data() + dst, memory->data.data() + src, size);
+        break;
+      }
+
+      case InterpreterOpcode::MemoryFill: {
+        GET_MEMORY(memory);
+        uint32_t size = POP_I32();
+        uint8_t value = static_cast<uint8_t>(POP_I32());
+        uint32_t dst = POP_I32();
+        TRAP_IF(static_cast<uint64_t>(dst) + size > memory->data.size(),
+                MemoryAccessOutOfBounds);
+        if (size != 0)
+          memset(memory->data.data() + dst, value, size);
+        break;
+      }
+
       case InterpreterOpcode::I32Add:
         BINOP(I32, I32, +);
         break;
@@ -1688,6 +2404,47 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
         break;
       }
 
+      case InterpreterOpcode::DropKeep1: {
+        uint32_t drop_count = read_u32(&pc);
+        PICK(drop_count + 1) = TOP();
+        thread->value_stack_top -= drop_count;
+        break;
+      }
+
+      case InterpreterOpcode::CountCall: {
+        uint32_t func_index = read_u32(&pc);
+        DefinedInterpreterFunc* func = env->funcs[func_index]->as_defined();
+        if (++func->call_count == env->tier_up_threshold) {
+          TIER_UP(func_index);
+          if (func->is_tiered_up)
+            GOTO(func->offset);
+        }
+        break;
+      }
+
+      case InterpreterOpcode::CountLoop: {
+        uint32_t func_index = read_u32(&pc);
+        uint32_t loop_index = read_u32(&pc);
+        DefinedInterpreterFunc* func = env->funcs[func_index]->as_defined();
+        if (!func->is_tiered_up &&
+            ++func->backedge_count == env->tier_up_threshold) {
+          TIER_UP(func_index);
+        }
+        /* The value stack is the same at a loop header in both versions, so
+         * the running frame can continue in the recompiled code. */
+        if (func->is_tiered_up)
+          GOTO(func->loop_offsets[loop_index]);
+        break;
+      }
+
+      case InterpreterOpcode::I32RegBinop:
+        REG_BINOP(I32, eval_i32_reg_binop);
+        break;
+
+      case InterpreterOpcode::I64RegBinop:
+        REG_BINOP(I64, eval_i64_reg_binop);
+        break;
+
       case InterpreterOpcode::Data:
         /* shouldn't ever execute this */
         assert(0);
@@ -1703,21 +2460,165 @@ InterpreterResult run_interpreter(InterpreterThread* thread,
   }
 
 exit_loop:
-  thread->pc = pc - istream;
+  thread->pc = get_istream_offset(istream, pc);
   return result;
 }
 
-void trace_pc(InterpreterThread* thread, Stream* stream) {
+InterpreterResult run_interpreter(InterpreterThread* thread,
+                                  uint32_t num_instructions,
+                                  uint32_t* call_stack_return_top) {
+  if (thread->env->istream_encoding == InterpreterIstreamEncoding::Aligned) {
+    return run_interpreter<AlignedWord>(thread, num_instructions,
+                                        call_stack_return_top);
+  }
+  return run_interpreter<PackedWord>(thread, num_instructions,
+                                     call_stack_return_top);
+}
+
+void init_interpreter_callable(InterpreterEnvironment* env,
+                               uint32_t func_index,
+                               InterpreterCallable* out_callable) {
+  assert(func_index < env->funcs.size());
+  InterpreterFunc* func = env->funcs[func_index].get();
+  const InterpreterFuncSignature* sig = &env->sigs[func->sig_index];
+  out_callable->func = func;
+  out_callable->num_params = sig->param_types.size();
+  out_callable->num_results = sig->result_types.size();
+}
+
+InterpreterResult get_interpreter_callable_by_name(
+    InterpreterEnvironment* env,
+    InterpreterModule* module,
+    const StringSlice* name,
+    InterpreterCallable* out_callable) {
+  InterpreterExport* export_ = get_interpreter_export_by_name(module, name);
+  if (!export_)
+    return InterpreterResult::UnknownExport;
+  if (export_->kind != ExternalKind::Func)
+    return InterpreterResult::ExportKindMismatch;
+  init_interpreter_callable(env, export_->index, out_callable);
+  return InterpreterResult::Ok;
+}
+
+static InterpreterResult finish_interpreter_callable(
+    InterpreterThread* thread,
+    const InterpreterCallable* callable,
+    InterpreterResult iresult,
+    InterpreterValue* out_results) {
+  if (!callable->func->is_host) {
+    uint32_t* call_stack_return_top = thread->call_stack.data();
+    while (iresult == InterpreterResult::Ok) {
+      iresult = run_interpreter(thread, INTERPRETER_CALLABLE_QUANTUM,
+                                call_stack_return_top);
+    }
+    if (iresult == InterpreterResult::Returned)
+      iresult = InterpreterResult::Ok;
+  }
+
+  /* keep the stacks, resume_interpreter_callable continues from them */
+  if (iresult == InterpreterResult::Suspended)
+    return iresult;
+
+  if (iresult == InterpreterResult::Ok) {
+    assert(thread->value_stack_top - thread->value_stack.data() ==
+           static_cast<ptrdiff_t>(callable->num_results));
+    memcpy(out_results, thread->value_stack.data(),
+           callable->num_results * sizeof(InterpreterValue));
+  }
+  thread->value_stack_top = thread->value_stack.data();
+  thread->call_stack_top = thread->call_stack.data();
+  return iresult;
+}
+
+InterpreterResult call_interpreter_callable(InterpreterThread* thread,
+                                            const InterpreterCallable* callable,
+                                            const InterpreterValue* args,
+                                            InterpreterValue* out_results) {
+  assert(thread->value_stack_top == thread->value_stack.data());
+  assert(thread->call_stack_top == thread->call_stack.data());
+  TRAP_IF(callable->num_params > thread->value_stack.size(),
+          ValueStackExhausted);
+  memcpy(thread->value_stack_top, args,
+         callable->num_params * sizeof(InterpreterValue));
+  thread->value_stack_top += callable->num_params;
+
+  InterpreterResult iresult;
+  if (callable->func->is_host) {
+    iresult = call_host(thread, callable->func->as_host());
+  } else {
+    thread->pc = callable->func->as_defined()->offset;
+    iresult = InterpreterResult::Ok;
+  }
+  return finish_interpreter_callable(thread, callable, iresult, out_results);
+}
+
+InterpreterResult resume_interpreter_callable(
+    InterpreterThread* thread,
+    const InterpreterCallable* callable,
+    InterpreterValue* out_results) {
+  return finish_interpreter_callable(thread, callable, InterpreterResult::Ok,
+                                     out_results);
+}
+
+/* Writes an I32RegBinop or I64RegBinop and advances |*pc_ptr| past its
+ * immediates. If |thread| is non-null, the operand values are written,
+ * otherwise the operand locations are. */
+template <typename Word>
+static void write_reg_binop(Stream* stream,
+                            InterpreterThread* thread,
+                            const uint8_t* istream,
+                            InterpreterOpcode opcode,
+                            const Word** pc_ptr) {
+  const Word* pc = *pc_ptr;
+  bool is_i64 = opcode == InterpreterOpcode::I64RegBinop;
+  Opcode binop = static_cast<Opcode>(*pc++);
+  uint32_t mode = *pc++;
+  uint32_t lhs_kind =
+      (mode >> WABT_REG_BINOP_LHS_SHIFT) & WABT_REG_OPERAND_MASK;
+  /* local depths don't include the lhs, if it's on the stack */
+  uint32_t adjust = lhs_kind == WABT_REG_OPERAND_STACK ? 1 : 0;
+  writef(stream, "%s %s ", get_interpreter_opcode_name(opcode),
+         get_opcode_name(binop));
+  for (int i = 0; i < 2; ++i) {
+    uint32_t shift =
+        i == 0 ? WABT_REG_BINOP_LHS_SHIFT : WABT_REG_BINOP_RHS_SHIFT;
+    uint32_t kind = (mode >> shift) & WABT_REG_OPERAND_MASK;
+    if (i != 0)
+      writef(stream, ", ");
+    if (kind == WABT_REG_OPERAND_CONST) {
+      uint64_t value = is_i64 ? read_u64(istream, &pc) : read_u32(&pc);
+      writef(stream, "$%" PRIu64, value);
+    } else {
+      uint32_t depth = 1;
+      if (kind == WABT_REG_OPERAND_LOCAL)
+        depth = read_u32(&pc) + adjust;
+      if (thread) {
+        InterpreterValue value = PICK(depth);
+        writef(stream, "%" PRIu64, is_i64 ? value.i64 : value.i32);
+      } else {
+        writef(stream, "%%[-%u]", depth);
+      }
+    }
+  }
+  if (((mode >> WABT_REG_BINOP_DST_SHIFT) & WABT_REG_OPERAND_MASK) ==
+      WABT_REG_OPERAND_LOCAL) {
+    writef(stream, " => %%[-%u]", read_u32(&pc) + adjust);
+  }
+  writef(stream, "\n");
+  *pc_ptr = pc;
+}
+
+template <typename Word>
+static void trace_pc(InterpreterThread* thread, Stream* stream) {
   const uint8_t* istream =
       reinterpret_cast<const uint8_t*>(thread->env->istream.start);
-  const uint8_t* pc = &istream[thread->pc];
+  const Word* pc = get_istream_pc<Word>(istream, thread->pc);
   size_t value_stack_depth =
       thread->value_stack_top - thread->value_stack.data();
   size_t call_stack_depth = thread->call_stack_top - thread->call_stack.data();
 
-  writef(stream, "#%" PRIzd ". %4" PRIzd ": V:%-3" PRIzd "| ", call_stack_depth,
-         pc - reinterpret_cast<uint8_t*>(thread->env->istream.start),
-         value_stack_depth);
+  writef(stream, "#%" PRIzd ". %4u: V:%-3" PRIzd "| ", call_stack_depth,
+         get_istream_offset(istream, pc), value_stack_depth);
 
   InterpreterOpcode opcode = static_cast<InterpreterOpcode>(*pc++);
   switch (opcode) {
@@ -1738,8 +2639,8 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
       break;
 
     case InterpreterOpcode::BrTable: {
-      uint32_t num_targets = read_u32_at(pc);
-      uint32_t table_offset = read_u32_at(pc + 4);
+      uint32_t num_targets = read_u32(&pc);
+      uint32_t table_offset = read_u32(&pc);
       VALUE_TYPE_I32 key = TOP().i32;
       writef(stream, "%s %u, $#%u, table:$%u\n",
              get_interpreter_opcode_name(opcode), key, num_targets,
@@ -1768,7 +2669,7 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
 
     case InterpreterOpcode::I64Const:
       writef(stream, "%s $%" PRIu64 "\n", get_interpreter_opcode_name(opcode),
-             read_u64_at(pc));
+             read_u64_at(istream, pc));
       break;
 
     case InterpreterOpcode::F32Const:
@@ -1778,7 +2679,7 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
 
     case InterpreterOpcode::F64Const:
       writef(stream, "%s $%g\n", get_interpreter_opcode_name(opcode),
-             bitcast_u64_to_f64(read_u64_at(pc)));
+             bitcast_u64_to_f64(read_u64_at(istream, pc)));
       break;
 
     case InterpreterOpcode::GetLocal:
@@ -1810,55 +2711,96 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
       break;
 
     case InterpreterOpcode::I32Load8S:
+    case InterpreterOpcode::I32Load8SMem0:
     case InterpreterOpcode::I32Load8U:
+    case InterpreterOpcode::I32Load8UMem0:
     case InterpreterOpcode::I32Load16S:
+    case InterpreterOpcode::I32Load16SMem0:
     case InterpreterOpcode::I32Load16U:
+    case InterpreterOpcode::I32Load16UMem0:
     case InterpreterOpcode::I64Load8S:
+    case InterpreterOpcode::I64Load8SMem0:
     case InterpreterOpcode::I64Load8U:
+    case InterpreterOpcode::I64Load8UMem0:
     case InterpreterOpcode::I64Load16S:
+    case InterpreterOpcode::I64Load16SMem0:
     case InterpreterOpcode::I64Load16U:
+    case InterpreterOpcode::I64Load16UMem0:
     case InterpreterOpcode::I64Load32S:
+    case InterpreterOpcode::I64Load32SMem0:
     case InterpreterOpcode::I64Load32U:
+    case InterpreterOpcode::I64Load32UMem0:
     case InterpreterOpcode::I32Load:
+    case InterpreterOpcode::I32LoadMem0:
     case InterpreterOpcode::I64Load:
+    case InterpreterOpcode::I64LoadMem0:
     case InterpreterOpcode::F32Load:
-    case InterpreterOpcode::F64Load: {
-      uint32_t memory_index = read_u32(&pc);
+    case InterpreterOpcode::F32LoadMem0:
+    case InterpreterOpcode::F64Load:
+    case InterpreterOpcode::F64LoadMem0: {
+      uint32_t memory_index = read_memory_index(opcode, &pc);
       writef(stream, "%s $%u:%u+$%u\n", get_interpreter_opcode_name(opcode),
              memory_index, TOP().i32, read_u32_at(pc));
       break;
     }
 
+    case InterpreterOpcode::I32Load8SAbs:
+    case InterpreterOpcode::I32Load8UAbs:
+    case InterpreterOpcode::I32Load16SAbs:
+    case InterpreterOpcode::I32Load16UAbs:
+    case InterpreterOpcode::I64Load8SAbs:
+    case InterpreterOpcode::I64Load8UAbs:
+    case InterpreterOpcode::I64Load16SAbs:
+    case InterpreterOpcode::I64Load16UAbs:
+    case InterpreterOpcode::I64Load32SAbs:
+    case InterpreterOpcode::I64Load32UAbs:
+    case InterpreterOpcode::I32LoadAbs:
+    case InterpreterOpcode::I64LoadAbs:
+    case InterpreterOpcode::F32LoadAbs:
+    case InterpreterOpcode::F64LoadAbs:
+      writef(stream, "%s $0:$%u\n", get_interpreter_opcode_name(opcode),
+             read_u32_at(pc));
+      break;
+
     case InterpreterOpcode::I32Store8:
+    case InterpreterOpcode::I32Store8Mem0:
     case InterpreterOpcode::I32Store16:
-    case InterpreterOpcode::I32Store: {
-      uint32_t memory_index = read_u32(&pc);
+    case InterpreterOpcode::I32Store16Mem0:
+    case InterpreterOpcode::I32Store:
+    case InterpreterOpcode::I32StoreMem0: {
+      uint32_t memory_index = read_memory_index(opcode, &pc);
       writef(stream, "%s $%u:%u+$%u, %u\n", get_interpreter_opcode_name(opcode),
              memory_index, PICK(2).i32, read_u32_at(pc), PICK(1).i32);
       break;
     }
 
     case InterpreterOpcode::I64Store8:
+    case InterpreterOpcode::I64Store8Mem0:
     case InterpreterOpcode::I64Store16:
+    case InterpreterOpcode::I64Store16Mem0:
     case InterpreterOpcode::I64Store32:
-    case InterpreterOpcode::I64Store: {
-      uint32_t memory_index = read_u32(&pc);
+    case InterpreterOpcode::I64Store32Mem0:
+    case InterpreterOpcode::I64Store:
+    case InterpreterOpcode::I64StoreMem0: {
+      uint32_t memory_index = read_memory_index(opcode, &pc);
       writef(stream, "%s $%u:%u+$%u, %" PRIu64 "\n",
              get_interpreter_opcode_name(opcode), memory_index, PICK(2).i32,
              read_u32_at(pc), PICK(1).i64);
       break;
     }
 
-    case InterpreterOpcode::F32Store: {
-      uint32_t memory_index = read_u32(&pc);
+    case InterpreterOpcode::F32Store:
+    case InterpreterOpcode::F32StoreMem0: {
+      uint32_t memory_index = read_memory_index(opcode, &pc);
       writef(stream, "%s $%u:%u+$%u, %g\n", get_interpreter_opcode_name(opcode),
              memory_index, PICK(2).i32, read_u32_at(pc),
              bitcast_u32_to_f32(PICK(1).f32_bits));
       break;
     }
 
-    case InterpreterOpcode::F64Store: {
-      uint32_t memory_index = read_u32(&pc);
+    case InterpreterOpcode::F64Store:
+    case InterpreterOpcode::F64StoreMem0: {
+      uint32_t memory_index = read_memory_index(opcode, &pc);
       writef(stream, "%s $%u:%u+$%u, %g\n", get_interpreter_opcode_name(opcode),
              memory_index, PICK(2).i32, read_u32_at(pc),
              bitcast_u64_to_f64(PICK(1).f64_bits));
@@ -1872,6 +2814,15 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
       break;
     }
 
+    case InterpreterOpcode::MemoryCopy:
+    case InterpreterOpcode::MemoryFill: {
+      uint32_t memory_index = read_u32(&pc);
+      writef(stream, "%s $%u:%u, %u, %u\n",
+             get_interpreter_opcode_name(opcode), memory_index, PICK(3).i32,
+             PICK(2).i32, PICK(1).i32);
+      break;
+    }
+
     case InterpreterOpcode::I32Add:
     case InterpreterOpcode::I32Sub:
     case InterpreterOpcode::I32Mul:
@@ -2051,9 +3002,33 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
              read_u32_at(pc), TOP().i32);
       break;
 
-    case InterpreterOpcode::DropKeep:
-      writef(stream, "%s $%u $%u\n", get_interpreter_opcode_name(opcode),
-             read_u32_at(pc), *(pc + 4));
+    case InterpreterOpcode::DropKeep: {
+      uint32_t drop = read_u32(&pc);
+      writef(stream, "%s $%u $%u\n", get_interpreter_opcode_name(opcode), drop,
+             *pc);
+      break;
+    }
+
+    case InterpreterOpcode::DropKeep1:
+      writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
+             read_u32_at(pc));
+      break;
+
+    case InterpreterOpcode::CountCall:
+      writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
+             read_u32_at(pc));
+      break;
+
+    case InterpreterOpcode::CountLoop: {
+      uint32_t func_index = read_u32(&pc);
+      writef(stream, "%s $%u, $%u\n", get_interpreter_opcode_name(opcode),
+             func_index, read_u32_at(pc));
+      break;
+    }
+
+    case InterpreterOpcode::I32RegBinop:
+    case InterpreterOpcode::I64RegBinop:
+      write_reg_binop(stream, thread, istream, opcode, &pc);
       break;
 
     case InterpreterOpcode::Data:
@@ -2067,10 +3042,18 @@ void trace_pc(InterpreterThread* thread, Stream* stream) {
   }
 }
 
-void disassemble(InterpreterEnvironment* env,
-                 Stream* stream,
-                 uint32_t from,
-                 uint32_t to) {
+void trace_pc(InterpreterThread* thread, Stream* stream) {
+  if (thread->env->istream_encoding == InterpreterIstreamEncoding::Aligned)
+    trace_pc<AlignedWord>(thread, stream);
+  else
+    trace_pc<PackedWord>(thread, stream);
+}
+
+template <typename Word>
+static void disassemble(InterpreterEnvironment* env,
+                        Stream* stream,
+                        uint32_t from,
+                        uint32_t to) {
   /* TODO(binji): mark function entries */
   /* TODO(binji): track value stack size */
   if (from >= env->istream.size)
@@ -2078,10 +3061,10 @@ void disassemble(InterpreterEnvironment* env,
   if (to > env->istream.size)
     to = env->istream.size;
   const uint8_t* istream = reinterpret_cast<const uint8_t*>(env->istream.start);
-  const uint8_t* pc = &istream[from];
+  const Word* pc = get_istream_pc<Word>(istream, from);
 
-  while (static_cast<uint32_t>(pc - istream) < to) {
-    writef(stream, "%4" PRIzd "| ", pc - istream);
+  while (get_istream_offset(istream, pc) < to) {
+    writef(stream, "%4u| ", get_istream_offset(istream, pc));
 
     InterpreterOpcode opcode = static_cast<InterpreterOpcode>(*pc++);
     switch (opcode) {
@@ -2129,7 +3112,7 @@ void disassemble(InterpreterEnvironment* env,
 
       case InterpreterOpcode::I64Const:
         writef(stream, "%s $%" PRIu64 "\n", get_interpreter_opcode_name(opcode),
-               read_u64(&pc));
+               read_u64(istream, &pc));
         break;
 
       case InterpreterOpcode::F32Const:
@@ -2139,7 +3122,7 @@ void disassemble(InterpreterEnvironment* env,
 
       case InterpreterOpcode::F64Const:
         writef(stream, "%s $%g\n", get_interpreter_opcode_name(opcode),
-               bitcast_u64_to_f64(read_u64(&pc)));
+               bitcast_u64_to_f64(read_u64(istream, &pc)));
         break;
 
       case InterpreterOpcode::GetLocal:
@@ -2173,36 +3156,77 @@ void disassemble(InterpreterEnvironment* env,
         break;
 
       case InterpreterOpcode::I32Load8S:
+      case InterpreterOpcode::I32Load8SMem0:
       case InterpreterOpcode::I32Load8U:
+      case InterpreterOpcode::I32Load8UMem0:
       case InterpreterOpcode::I32Load16S:
+      case InterpreterOpcode::I32Load16SMem0:
       case InterpreterOpcode::I32Load16U:
+      case InterpreterOpcode::I32Load16UMem0:
       case InterpreterOpcode::I64Load8S:
+      case InterpreterOpcode::I64Load8SMem0:
       case InterpreterOpcode::I64Load8U:
+      case InterpreterOpcode::I64Load8UMem0:
       case InterpreterOpcode::I64Load16S:
+      case InterpreterOpcode::I64Load16SMem0:
       case InterpreterOpcode::I64Load16U:
+      case InterpreterOpcode::I64Load16UMem0:
       case InterpreterOpcode::I64Load32S:
+      case InterpreterOpcode::I64Load32SMem0:
       case InterpreterOpcode::I64Load32U:
+      case InterpreterOpcode::I64Load32UMem0:
       case InterpreterOpcode::I32Load:
+      case InterpreterOpcode::I32LoadMem0:
       case InterpreterOpcode::I64Load:
+      case InterpreterOpcode::I64LoadMem0:
       case InterpreterOpcode::F32Load:
-      case InterpreterOpcode::F64Load: {
-        uint32_t memory_index = read_u32(&pc);
+      case InterpreterOpcode::F32LoadMem0:
+      case InterpreterOpcode::F64Load:
+      case InterpreterOpcode::F64LoadMem0: {
+        uint32_t memory_index = read_memory_index(opcode, &pc);
         writef(stream, "%s $%u:%%[-1]+$%u\n",
                get_interpreter_opcode_name(opcode), memory_index,
                read_u32(&pc));
         break;
       }
 
+      case InterpreterOpcode::I32Load8SAbs:
+      case InterpreterOpcode::I32Load8UAbs:
+      case InterpreterOpcode::I32Load16SAbs:
+      case InterpreterOpcode::I32Load16UAbs:
+      case InterpreterOpcode::I64Load8SAbs:
+      case InterpreterOpcode::I64Load8UAbs:
+      case InterpreterOpcode::I64Load16SAbs:
+      case InterpreterOpcode::I64Load16UAbs:
+      case InterpreterOpcode::I64Load32SAbs:
+      case InterpreterOpcode::I64Load32UAbs:
+      case InterpreterOpcode::I32LoadAbs:
+      case InterpreterOpcode::I64LoadAbs:
+      case InterpreterOpcode::F32LoadAbs:
+      case InterpreterOpcode::F64LoadAbs:
+        writef(stream, "%s $0:$%u\n", get_interpreter_opcode_name(opcode),
+               read_u32(&pc));
+        break;
+
       case InterpreterOpcode::I32Store8:
+      case InterpreterOpcode::I32Store8Mem0:
       case InterpreterOpcode::I32Store16:
+      case InterpreterOpcode::I32Store16Mem0:
       case InterpreterOpcode::I32Store:
+      case InterpreterOpcode::I32StoreMem0:
       case InterpreterOpcode::I64Store8:
+      case InterpreterOpcode::I64Store8Mem0:
       case InterpreterOpcode::I64Store16:
+      case InterpreterOpcode::I64Store16Mem0:
       case InterpreterOpcode::I64Store32:
+      case InterpreterOpcode::I64Store32Mem0:
       case InterpreterOpcode::I64Store:
+      case InterpreterOpcode::I64StoreMem0:
       case InterpreterOpcode::F32Store:
-      case InterpreterOpcode::F64Store: {
-        uint32_t memory_index = read_u32(&pc);
+      case InterpreterOpcode::F32StoreMem0:
+      case InterpreterOpcode::F64Store:
+      case InterpreterOpcode::F64StoreMem0: {
+        uint32_t memory_index = read_memory_index(opcode, &pc);
         writef(stream, "%s %%[-2]+$%u, $%u:%%[-1]\n",
                get_interpreter_opcode_name(opcode), memory_index,
                read_u32(&pc));
@@ -2346,6 +3370,14 @@ void disassemble(InterpreterEnvironment* env,
         break;
       }
 
+      case InterpreterOpcode::MemoryCopy:
+      case InterpreterOpcode::MemoryFill: {
+        uint32_t memory_index = read_u32(&pc);
+        writef(stream, "%s $%u:%%[-3], %%[-2], %%[-1]\n",
+               get_interpreter_opcode_name(opcode), memory_index);
+        break;
+      }
+
       case InterpreterOpcode::Alloca:
         writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
                read_u32(&pc));
@@ -2364,27 +3396,53 @@ void disassemble(InterpreterEnvironment* env,
         break;
       }
 
+      case InterpreterOpcode::DropKeep1:
+        writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
+               read_u32(&pc));
+        break;
+
+      case InterpreterOpcode::CountCall:
+        writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
+               read_u32(&pc));
+        break;
+
+      case InterpreterOpcode::CountLoop: {
+        uint32_t func_index = read_u32(&pc);
+        uint32_t loop_index = read_u32(&pc);
+        writef(stream, "%s $%u, $%u\n", get_interpreter_opcode_name(opcode),
+               func_index, loop_index);
+        break;
+      }
+
+      case InterpreterOpcode::I32RegBinop:
+      case InterpreterOpcode::I64RegBinop:
+        write_reg_binop(stream, nullptr, istream, opcode, &pc);
+        break;
+
       case InterpreterOpcode::Data: {
         uint32_t num_bytes = read_u32(&pc);
         writef(stream, "%s $%u\n", get_interpreter_opcode_name(opcode),
                num_bytes);
         /* for now, the only reason this is emitted is for br_table, so display
          * it as a list of table entries */
-        if (num_bytes % WABT_TABLE_ENTRY_SIZE == 0) {
-          uint32_t num_entries = num_bytes / WABT_TABLE_ENTRY_SIZE;
+        size_t entry_size = get_table_entry_size<Word>();
+        if (num_bytes % entry_size == 0) {
+          uint32_t num_entries = num_bytes / entry_size;
           for (uint32_t i = 0; i < num_entries; ++i) {
-            writef(stream, "%4" PRIzd "| ", pc - istream);
+            uint32_t entry_offset = get_istream_offset(istream, pc);
+            writef(stream, "%4u| ", entry_offset);
             uint32_t offset;
             uint32_t drop;
             uint8_t keep;
-            read_table_entry_at(pc, &offset, &drop, &keep);
+            read_table_entry_at<Word>(&istream[entry_offset], &offset, &drop,
+                                      &keep);
             writef(stream, "  entry %d: offset: %u drop: %u keep: %u\n", i,
                    offset, drop, keep);
-            pc += WABT_TABLE_ENTRY_SIZE;
+            pc += entry_size / sizeof(Word);
           }
         } else {
           /* just skip those data bytes */
-          pc += num_bytes;
+          pc += num_bytes / sizeof(Word);
         }
 
         break;
@@ -2397,6 +3455,16 @@ void disassemble(InterpreterEnvironment* env,
   }
 }
 
+void disassemble(InterpreterEnvironment* env,
+                 Stream* stream,
+                 uint32_t from,
+                 uint32_t to) {
+  if (env->istream_encoding == InterpreterIstreamEncoding::Aligned)
+    disassemble<AlignedWord>(env, stream, from, to);
+  else
+    disassemble<PackedWord>(env, stream, from, to);
+}
+
 void disassemble_module(InterpreterEnvironment* env,
                         Stream* stream,
                         InterpreterModule* module) {
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "common.h"
+#include "binary-reader.h"
 #include "binding-hash.h"
 #include "writer.h"
 
@@ -34,6 +35,8 @@ struct Stream;
   V(Ok, "ok")                                                               \
   /* returned from the top-most function */                                 \
   V(Returned, "returned")                                                   \
+  /* a host function suspended the thread, see suspend_interpreter_thread */ \
+  V(Suspended, "suspended in host call")                                    \
   /* memory access is out of bounds */                                      \
   V(TrapMemoryAccessOutOfBounds, "out of bounds memory access")             \
   /* converting from float -> int would overflow int */                     \
@@ -79,13 +82,92 @@ enum class InterpreterResult {
 #define WABT_TABLE_ENTRY_OFFSET_OFFSET 0
 #define WABT_TABLE_ENTRY_DROP_OFFSET sizeof(uint32_t)
 #define WABT_TABLE_ENTRY_KEEP_OFFSET (sizeof(uint32_t) * 2)
+#define WABT_ALIGNED_TABLE_ENTRY_SIZE (sizeof(uint32_t) * 3)
+
+/* I32RegBinop and I64RegBinop are three-address forms of the binops for which
+ * is_interpreter_reg_binop is true. They are followed by the binop's opcode,
+ * a mode byte that says where each operand comes from, then an immediate for
+ * each operand that isn't on the stack: a local's depth or a constant. The
+ * lhs is popped if it is on the stack; local depths are relative to the
+ * stack after that pop. The result is pushed or stored to a local. */
+#define WABT_REG_OPERAND_STACK 0
+#define WABT_REG_OPERAND_LOCAL 1
+#define WABT_REG_OPERAND_CONST 2
+#define WABT_REG_OPERAND_MASK 3
+#define WABT_REG_BINOP_LHS_SHIFT 0
+#define WABT_REG_BINOP_RHS_SHIFT 2
+#define WABT_REG_BINOP_DST_SHIFT 4
+#define WABT_REG_BINOP_MODE(lhs, rhs, dst) \
+  (((lhs) << WABT_REG_BINOP_LHS_SHIFT) |   \
+   ((rhs) << WABT_REG_BINOP_RHS_SHIFT) |   \
+   ((dst) << WABT_REG_BINOP_DST_SHIFT))
+
+/* Packed: opcodes and u8 immediates are one byte, other immediates are
+ * unaligned. This is the smallest encoding.
+ * Aligned: opcodes and all immediates are 4-byte words, and u64 immediates
+ * are 8-byte aligned, so each one can be decoded with one aligned load.
+ * All modules in an environment must use the same encoding. */
+enum class InterpreterIstreamEncoding {
+  Packed,
+  Aligned,
+};
 
-#define WABT_FOREACH_INTERPRETER_OPCODE(V)         \
-  WABT_FOREACH_OPCODE(V)                           \
-  V(___, ___, ___, 0, 0xfb, Alloca, "alloca")      \
-  V(___, ___, ___, 0, 0xfc, BrUnless, "br_unless") \
-  V(___, ___, ___, 0, 0xfd, CallHost, "call_host") \
-  V(___, ___, ___, 0, 0xfe, Data, "data")          \
+/* The *Mem0 loads and stores access env->memories[0], so they are followed
+ * by the offset immediate but no memory index. Their codes are in the same
+ * order as the codes of the loads and stores, starting at I32LoadMem0.
+ *
+ * The *Abs loads also access env->memories[0], at a constant address: they
+ * replace an i32.const followed by a load, and their only immediate is the
+ * sum of the constant and the offset. Their codes are in the same order as
+ * the loads, starting at I32LoadAbs. */
+#define WABT_FOREACH_INTERPRETER_OPCODE(V)                       \
+  WABT_FOREACH_OPCODE(V)                                         \
+  V(I32, I32, ___, 4, 0xc2, I32LoadMem0, "i32.load_mem0")        \
+  V(I64, I32, ___, 8, 0xc3, I64LoadMem0, "i64.load_mem0")        \
+  V(F32, I32, ___, 4, 0xc4, F32LoadMem0, "f32.load_mem0")        \
+  V(F64, I32, ___, 8, 0xc5, F64LoadMem0, "f64.load_mem0")        \
+  V(I32, I32, ___, 1, 0xc6, I32Load8SMem0, "i32.load8_s_mem0")   \
+  V(I32, I32, ___, 1, 0xc7, I32Load8UMem0, "i32.load8_u_mem0")   \
+  V(I32, I32, ___, 2, 0xc8, I32Load16SMem0, "i32.load16_s_mem0") \
+  V(I32, I32, ___, 2, 0xc9, I32Load16UMem0, "i32.load16_u_mem0") \
+  V(I64, I32, ___, 1, 0xca, I64Load8SMem0, "i64.load8_s_mem0")   \
+  V(I64, I32, ___, 1, 0xcb, I64Load8UMem0, "i64.load8_u_mem0")   \
+  V(I64, I32, ___, 2, 0xcc, I64Load16SMem0, "i64.load16_s_mem0") \
+  V(I64, I32, ___, 2, 0xcd, I64Load16UMem0, "i64.load16_u_mem0") \
+  V(I64, I32, ___, 4, 0xce, I64Load32SMem0, "i64.load32_s_mem0") \
+  V(I64, I32, ___, 4, 0xcf, I64Load32UMem0, "i64.load32_u_mem0") \
+  V(___, I32, I32, 4, 0xd0, I32StoreMem0, "i32.store_mem0")      \
+  V(___, I32, I64, 8, 0xd1, I64StoreMem0, "i64.store_mem0")      \
+  V(___, I32, F32, 4, 0xd2, F32StoreMem0, "f32.store_mem0")      \
+  V(___, I32, F64, 8, 0xd3, F64StoreMem0, "f64.store_mem0")      \
+  V(___, I32, I32, 1, 0xd4, I32Store8Mem0, "i32.store8_mem0")    \
+  V(___, I32, I32, 2, 0xd5, I32Store16Mem0, "i32.store16_mem0")  \
+  V(___, I32, I64, 1, 0xd6, I64Store8Mem0, "i64.store8_mem0")    \
+  V(___, I32, I64, 2, 0xd7, I64Store16Mem0, "i64.store16_mem0")  \
+  V(___, I32, I64, 4, 0xd8, I64Store32Mem0, "i64.store32_mem0")  \
+  V(I32, ___, ___, 4, 0xd9, I32LoadAbs, "i32.load_abs")          \
+  V(I64, ___, ___, 8, 0xda, I64LoadAbs, "i64.load_abs")          \
+  V(F32, ___, ___, 4, 0xdb, F32LoadAbs, "f32.load_abs")          \
+  V(F64, ___, ___, 8, 0xdc, F64LoadAbs, "f64.load_abs")          \
+  V(I32, ___, ___, 1, 0xdd, I32Load8SAbs, "i32.load8_s_abs")     \
+  V(I32, ___, ___, 1, 0xde, I32Load8UAbs, "i32.load8_u_abs")     \
+  V(I32, ___, ___, 2, 0xdf, I32Load16SAbs, "i32.load16_s_abs")   \
+  V(I32, ___, ___, 2, 0xe0, I32Load16UAbs, "i32.load16_u_abs")   \
+  V(I64, ___, ___, 1, 0xe1, I64Load8SAbs, "i64.load8_s_abs")     \
+  V(I64, ___, ___, 1, 0xe2, I64Load8UAbs, "i64.load8_u_abs")     \
+  V(I64, ___, ___, 2, 0xe3, I64Load16SAbs, "i64.load16_s_abs")   \
+  V(I64, ___, ___, 2, 0xe4, I64Load16UAbs, "i64.load16_u_abs")   \
+  V(I64, ___, ___, 4, 0xe5, I64Load32SAbs, "i64.load32_s_abs")   \
+  V(I64, ___, ___, 4, 0xe6, I64Load32UAbs, "i64.load32_u_abs")   \
+  V(___, ___, ___, 0, 0xf6, CountCall, "count_call")             \
+  V(___, ___, ___, 0, 0xf7, CountLoop, "count_loop")             \
+  V(___, ___, ___, 0, 0xf8, I32RegBinop, "i32.reg_binop")        \
+  V(___, ___, ___, 0, 0xf9, I64RegBinop, "i64.reg_binop")        \
+  V(___, ___, ___, 0, 0xfa, DropKeep1, "drop_keep1")             \
+  V(___, ___, ___, 0, 0xfb, Alloca, "alloca")                    \
+  V(___, ___, ___, 0, 0xfc, BrUnless, "br_unless")               \
+  V(___, ___, ___, 0, 0xfd, CallHost, "call_host")               \
+  V(___, ___, ___, 0, 0xfe, Data, "data")                        \
   V(___, ___, ___, 0, 0xff, DropKeep, "drop_keep")
 
 enum class InterpreterOpcode {
@@ -100,16 +182,90 @@ enum class InterpreterOpcode {
 static const int kInterpreterOpcodeCount = WABT_ENUM_COUNT(InterpreterOpcode);
 
 struct InterpreterFuncSignature {
+  InterpreterFuncSignature() : canonical_index(WABT_INVALID_INDEX) {}
+
   std::vector<Type> param_types;
   std::vector<Type> result_types;
+  /* index of the first signature in the environment with the same param and
+   * result types, or INVALID_INDEX if not yet computed. See
+   * get_canonical_sig_index. */
+  uint32_t canonical_index;
+};
+
+/* A pre-resolved table element, so call_indirect doesn't have to go through
+ * env->funcs. */
+struct InterpreterTableEntry {
+  InterpreterTableEntry() : sig_index(WABT_INVALID_INDEX), is_host(false) {
+    offset = WABT_INVALID_OFFSET;
+  }
+
+  /* canonical signature index, or INVALID_INDEX if uninitialized */
+  uint32_t sig_index;
+  bool is_host;
+  union {
+    uint32_t offset; /* istream offset, if !is_host */
+    struct HostInterpreterFunc* host_func;
+  };
 };
 
 struct InterpreterTable {
   explicit InterpreterTable(const Limits& limits)
-      : limits(limits), func_indexes(limits.initial, WABT_INVALID_INDEX) {}
+      : limits(limits),
+        func_indexes(limits.initial, WABT_INVALID_INDEX),
+        entries(limits.initial) {}
 
   Limits limits;
+  /* env function indexes. Use set_interpreter_table_element to modify, so
+   * |entries| stays in sync. */
   std::vector<uint32_t> func_indexes;
+  std::vector<InterpreterTableEntry> entries;
+};
+
+/* The bytes of a linear memory. When mmap is available, PROT_NONE address
+ * space for the memory's maximum size (4GiB when it has none) is reserved the
+ * first time it is non-empty, so growing it only commits more zeroed pages and
+ * never moves the data. If mmap is unavailable or the reservation fails, it is
+ * a plain heap buffer. */
+class InterpreterMemoryData {
+ public:
+  InterpreterMemoryData();
+  InterpreterMemoryData(size_t size, uint64_t max_size);
+  InterpreterMemoryData(InterpreterMemoryData&&);
+  InterpreterMemoryData& operator=(InterpreterMemoryData&&);
+  ~InterpreterMemoryData();
+
+  char* data() { return data_; }
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  char& operator[](size_t index) { return data_[index]; }
+
+  /* The memory only grows; the new bytes are zero. */
+  void resize(size_t new_size);
+
+  /* Copies |size| bytes of |file| at |file_offset| to |offset|. When the
+   * address space is reserved, |file->fd| is valid and |offset| and
+   * |file_offset| are equally aligned within a host page, the whole pages in
+   * between are mapped copy-on-write from the file instead, so they are only
+   * read in when first touched. The partial pages at either end, and segments
+   * that are not equally aligned, are still copied eagerly. Mapped pages that
+   * have not been written to read the file, so truncating it while they are
+   * in use raises SIGBUS. */
+  void copy_from_file(size_t offset,
+                      const MappedFile* file,
+                      size_t file_offset,
+                      size_t size);
+
+ private:
+  WABT_DISALLOW_COPY_AND_ASSIGN(InterpreterMemoryData);
+
+  void release();
+
+  char* data_;
+  size_t size_;
+  /* bytes of address space reserved at |data_|, only |size_| of which are
+   * usable; 0 when |data_| is a heap buffer */
+  size_t capacity_;
+  uint64_t max_size_;
 };
 
 struct InterpreterMemory {
@@ -117,10 +273,13 @@ struct InterpreterMemory {
     WABT_ZERO_MEMORY(page_limits);
   }
   explicit InterpreterMemory(const Limits& limits)
-      : page_limits(limits), data(limits.initial * WABT_PAGE_SIZE) {}
+      : page_limits(limits),
+        data(limits.initial * WABT_PAGE_SIZE,
+             (limits.has_max ? limits.max : WABT_MAX_PAGES) * WABT_PAGE_SIZE) {
+  }
 
   Limits page_limits;
-  std::vector<char> data;
+  InterpreterMemoryData data;
 };
 
 union InterpreterValue {
@@ -174,8 +333,12 @@ struct InterpreterImport {
 };
 
 struct InterpreterFunc;
+struct InterpreterThread;
 
+/* |thread| is the thread making the call; it can be suspended with
+ * suspend_interpreter_thread. */
 typedef Result (*InterpreterHostFuncCallback)(
+    InterpreterThread* thread,
     const struct HostInterpreterFunc* func,
     const InterpreterFuncSignature* sig,
     uint32_t num_args,
@@ -202,12 +365,29 @@ struct DefinedInterpreterFunc : InterpreterFunc {
       : InterpreterFunc(sig_index, false),
         offset(WABT_INVALID_INDEX),
         local_decl_count(0),
-        local_count(0) {}
+        local_count(0),
+        module_index(WABT_INVALID_INDEX),
+        module_func_index(WABT_INVALID_INDEX),
+        call_count(0),
+        backedge_count(0),
+        is_tiered_up(false),
+        baseline_offset(WABT_INVALID_INDEX) {}
 
   uint32_t offset;
   uint32_t local_decl_count;
   uint32_t local_count;
   std::vector<Type> param_and_local_types;
+
+  /* Tier-up: only counted by functions compiled with a tier-up threshold,
+   * see InterpreterEnvironment::tier_up_threshold */
+  uint32_t module_index;      /* env index of the defining module */
+  uint32_t module_func_index; /* function index in the defining module */
+  uint32_t call_count;
+  uint32_t backedge_count; /* loop header executions */
+  bool is_tiered_up;
+  uint32_t baseline_offset; /* the baseline code, once tiered up */
+  /* loop header offsets of the recompiled code, in loop order */
+  std::vector<uint32_t> loop_offsets;
 };
 
 struct HostInterpreterFunc : InterpreterFunc {
@@ -296,6 +476,16 @@ struct DefinedInterpreterModule : InterpreterModule {
   uint32_t start_func_index; /* INVALID_INDEX if not defined */
   size_t istream_start;
   size_t istream_end;
+
+  /* The binary, its index and its module to env index mappings, kept so hot
+   * functions can be recompiled; only set when the module is compiled for
+   * tier-up. */
+  std::vector<uint8_t> binary;
+  BinaryIndex binary_index;
+  std::vector<uint32_t> sig_index_mapping;
+  std::vector<uint32_t> func_index_mapping;
+  std::vector<uint32_t> global_index_mapping;
+  uint32_t num_func_imports;
 };
 
 struct HostInterpreterModule : InterpreterModule {
@@ -325,6 +515,16 @@ struct InterpreterEnvironmentMark {
   size_t istream_size;
 };
 
+struct InterpreterEnvironment;
+
+/* Recompiles the defined function |func_index| with the optimizing compiler,
+ * and redirects its callers to the new code. |thread| is the thread whose
+ * counts made the function hot. */
+typedef Result (*InterpreterRecompileFuncCallback)(
+    InterpreterEnvironment* env,
+    InterpreterThread* thread,
+    uint32_t func_index);
+
 struct InterpreterEnvironment {
   InterpreterEnvironment();
 
@@ -335,6 +535,11 @@ struct InterpreterEnvironment {
   std::vector<InterpreterTable> tables;
   std::vector<InterpreterGlobal> globals;
   OutputBuffer istream;
+  InterpreterIstreamEncoding istream_encoding;
+  /* A function is recompiled when its call_count or backedge_count reaches
+   * tier_up_threshold; 0 if tier-up is disabled. */
+  uint32_t tier_up_threshold;
+  InterpreterRecompileFuncCallback recompile_func;
   BindingHash module_bindings;
   BindingHash registered_module_bindings;
 };
@@ -350,6 +555,10 @@ struct InterpreterThread {
   uint32_t* call_stack_top;
   uint32_t* call_stack_end;
   uint32_t pc;
+  /* set by suspend_interpreter_thread during a host call */
+  bool suspend_requested;
+  /* the host function whose results resume_interpreter_thread delivers */
+  HostInterpreterFunc* suspended_host_func;
 };
 
 #define WABT_INTERPRETER_THREAD_OPTIONS_DEFAULT \
@@ -368,6 +577,16 @@ bool is_arithmetic_nan_f64(uint64_t f64_bits);
 bool func_signatures_are_equal(InterpreterEnvironment* env,
                                uint32_t sig_index_0,
                                uint32_t sig_index_1);
+bool is_interpreter_reg_binop(Opcode opcode);
+/* Evaluates a binop for which is_interpreter_reg_binop is true, as the
+ * interpreter would. i32 values are in the low 32 bits. */
+uint64_t eval_interpreter_reg_binop(Opcode opcode, uint64_t lhs, uint64_t rhs);
+uint32_t get_canonical_sig_index(InterpreterEnvironment* env,
+                                 uint32_t sig_index);
+void set_interpreter_table_element(InterpreterEnvironment* env,
+                                   InterpreterTable* table,
+                                   uint32_t index,
+                                   uint32_t func_index);
 
 void destroy_interpreter_environment(InterpreterEnvironment* env);
 InterpreterEnvironmentMark mark_interpreter_environment(
@@ -384,9 +603,54 @@ InterpreterResult push_thread_value(InterpreterThread* thread,
 void destroy_interpreter_thread(InterpreterThread* thread);
 InterpreterResult call_host(InterpreterThread* thread,
                             HostInterpreterFunc* func);
+/* Called by a host callback that can't produce its results yet (e.g. it is
+ * waiting on I/O). The callback returns Result::Ok without results, and the
+ * thread stops with InterpreterResult::Suspended; its pc and stacks are kept
+ * until resume_interpreter_thread delivers the results. */
+void suspend_interpreter_thread(InterpreterThread* thread);
+/* Pushes the results of the suspended host call. After that the thread can be
+ * run again with run_interpreter, using the same call_stack_return_top. */
+InterpreterResult resume_interpreter_thread(
+    InterpreterThread* thread,
+    uint32_t num_results,
+    const InterpreterTypedValue* results);
 InterpreterResult run_interpreter(InterpreterThread* thread,
                                   uint32_t num_instructions,
                                   uint32_t* call_stack_return_top);
+
+/* A function resolved ahead of time, so an embedder can call it repeatedly
+ * without looking it up again. It stays valid until the environment is reset
+ * to a mark taken before the function was added. */
+struct InterpreterCallable {
+  InterpreterFunc* func;
+  uint32_t num_params;
+  uint32_t num_results;
+};
+
+/* Resolves the function at |func_index| in env->funcs, which must exist. */
+void init_interpreter_callable(InterpreterEnvironment* env,
+                               uint32_t func_index,
+                               InterpreterCallable* out_callable);
+/* Returns UnknownExport or ExportKindMismatch if |name| isn't an exported
+ * function of |module|. */
+InterpreterResult get_interpreter_callable_by_name(
+    InterpreterEnvironment* env,
+    InterpreterModule* module,
+    const StringSlice* name,
+    InterpreterCallable* out_callable);
+/* Calls |callable| on |thread|, whose stacks must be empty. |args| holds
+ * num_params values and |out_results| has room for num_results values, both
+ * in signature order; they are not type-checked, and nothing is allocated.
+ * If a host call suspends the thread, Suspended is returned, and the call is
+ * finished by resume_interpreter_callable after resume_interpreter_thread. */
+InterpreterResult call_interpreter_callable(InterpreterThread* thread,
+                                            const InterpreterCallable* callable,
+                                            const InterpreterValue* args,
+                                            InterpreterValue* out_results);
+InterpreterResult resume_interpreter_callable(
+    InterpreterThread* thread,
+    const InterpreterCallable* callable,
+    InterpreterValue* out_results);
 void trace_pc(InterpreterThread* thread, struct Stream* stream);
 void disassemble(InterpreterEnvironment* env,
                  struct Stream* stream,
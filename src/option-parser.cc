@@ -96,8 +96,9 @@ void parse_options(OptionParser* parser, int argc, char** argv) {
         Option* best_option = &parser->options[best_index];
         const char* option_argument = nullptr;
         if (best_option->has_argument == HasArgument::Yes) {
-          if (arg[best_length] == '=') {
-            option_argument = &arg[best_length + 1];
+          /* best_length doesn't include the leading "--" */
+          if (arg[2 + best_length] == '=') {
+            option_argument = &arg[2 + best_length + 1];
           } else {
             if (i + 1 == argc || argv[i + 1][0] == '-') {
               error(parser, "option \"--%s\" requires argument",
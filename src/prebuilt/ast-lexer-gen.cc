@@ -315,18 +315,18 @@ YYCOND_BLOCK_COMMENT:
 	}
 yy19:
 	++lexer->cursor;
-#line 464 "src/ast-lexer.cc"
+#line 466 "src/ast-lexer.cc"
 	{ ERROR("unexpected EOF"); RETURN(EOF); }
 #line 321 "src/prebuilt/ast-lexer-gen.cc"
 yy21:
 	++lexer->cursor;
 yy22:
-#line 465 "src/ast-lexer.cc"
+#line 467 "src/ast-lexer.cc"
 	{ continue; }
 #line 327 "src/prebuilt/ast-lexer-gen.cc"
 yy23:
 	++lexer->cursor;
-#line 463 "src/ast-lexer.cc"
+#line 465 "src/ast-lexer.cc"
 	{ NEWLINE; continue; }
 #line 332 "src/prebuilt/ast-lexer-gen.cc"
 yy25:
@@ -339,12 +339,12 @@ yy26:
 	goto yy22;
 yy27:
 	++lexer->cursor;
-#line 459 "src/ast-lexer.cc"
+#line 461 "src/ast-lexer.cc"
 	{ COMMENT_NESTING++; continue; }
 #line 345 "src/prebuilt/ast-lexer-gen.cc"
 yy29:
 	++lexer->cursor;
-#line 460 "src/ast-lexer.cc"
+#line 462 "src/ast-lexer.cc"
 	{ if (--COMMENT_NESTING == 0)
                                     BEGIN(YYCOND_INIT);
                                   continue; }
@@ -393,7 +393,7 @@ YYCOND_LINE_COMMENT:
 		}
 		goto yy36;
 yy33:
-#line 457 "src/ast-lexer.cc"
+#line 459 "src/ast-lexer.cc"
 		{ continue; }
 #line 399 "src/prebuilt/ast-lexer-gen.cc"
 yy34:
@@ -407,7 +407,7 @@ yy34:
 yy36:
 		++lexer->cursor;
 		BEGIN(YYCOND_i);
-#line 456 "src/ast-lexer.cc"
+#line 458 "src/ast-lexer.cc"
 		{ NEWLINE; continue; }
 #line 413 "src/prebuilt/ast-lexer-gen.cc"
 	}
@@ -551,13 +551,13 @@ YYCOND_i:
 		}
 yy40:
 		++lexer->cursor;
-#line 471 "src/ast-lexer.cc"
+#line 473 "src/ast-lexer.cc"
 		{ RETURN(EOF); }
 #line 557 "src/prebuilt/ast-lexer-gen.cc"
 yy42:
 		++lexer->cursor;
 yy43:
-#line 472 "src/ast-lexer.cc"
+#line 474 "src/ast-lexer.cc"
 		{ ERROR("unexpected char"); continue; }
 #line 563 "src/prebuilt/ast-lexer-gen.cc"
 yy44:
@@ -567,12 +567,12 @@ yy44:
 		if (yybm[0+yych] & 8) {
 			goto yy44;
 		}
-#line 467 "src/ast-lexer.cc"
+#line 469 "src/ast-lexer.cc"
 		{ continue; }
 #line 573 "src/prebuilt/ast-lexer-gen.cc"
 yy47:
 		++lexer->cursor;
-#line 466 "src/ast-lexer.cc"
+#line 468 "src/ast-lexer.cc"
 		{ NEWLINE; continue; }
 #line 578 "src/prebuilt/ast-lexer-gen.cc"
 yy49:
@@ -584,7 +584,7 @@ yy50:
 			goto yy49;
 		}
 yy51:
-#line 468 "src/ast-lexer.cc"
+#line 470 "src/ast-lexer.cc"
 		{ ERROR("unexpected token \"%.*s\"",
                                         static_cast<int>(yyleng), yytext);
                                   continue; }
@@ -969,13 +969,13 @@ yy88:
 			}
 		}
 yy90:
-#line 453 "src/ast-lexer.cc"
+#line 455 "src/ast-lexer.cc"
 		{ TEXT; RETURN(VAR); }
 #line 975 "src/prebuilt/ast-lexer-gen.cc"
 yy91:
 		++lexer->cursor;
 		BEGIN(YYCOND_BLOCK_COMMENT);
-#line 458 "src/ast-lexer.cc"
+#line 460 "src/ast-lexer.cc"
 		{ COMMENT_NESTING = 1; continue; }
 #line 981 "src/prebuilt/ast-lexer-gen.cc"
 yy93:
@@ -1141,7 +1141,7 @@ yy103:
 yy104:
 		++lexer->cursor;
 		BEGIN(YYCOND_LINE_COMMENT);
-#line 455 "src/ast-lexer.cc"
+#line 457 "src/ast-lexer.cc"
 		{ continue; }
 #line 1147 "src/prebuilt/ast-lexer-gen.cc"
 yy106:
@@ -1681,7 +1681,7 @@ yy175:
 			}
 		}
 yy176:
-#line 440 "src/ast-lexer.cc"
+#line 442 "src/ast-lexer.cc"
 		{ RETURN(GET); }
 #line 1687 "src/prebuilt/ast-lexer-gen.cc"
 yy177:
@@ -2122,7 +2122,7 @@ yy227:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 434 "src/ast-lexer.cc"
+#line 436 "src/ast-lexer.cc"
 		{ RETURN(DATA); }
 #line 2128 "src/prebuilt/ast-lexer-gen.cc"
 yy229:
@@ -2138,7 +2138,7 @@ yy231:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 433 "src/ast-lexer.cc"
+#line 435 "src/ast-lexer.cc"
 		{ RETURN(ELEM); }
 #line 2144 "src/prebuilt/ast-lexer-gen.cc"
 yy233:
@@ -2780,7 +2780,7 @@ yy348:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 451 "src/ast-lexer.cc"
+#line 453 "src/ast-lexer.cc"
 		{ RETURN(INPUT); }
 #line 2786 "src/prebuilt/ast-lexer-gen.cc"
 yy350:
@@ -2852,7 +2852,7 @@ yy366:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 432 "src/ast-lexer.cc"
+#line 434 "src/ast-lexer.cc"
 		{ RETURN(START); }
 #line 2858 "src/prebuilt/ast-lexer-gen.cc"
 yy368:
@@ -2904,7 +2904,7 @@ yy378:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 437 "src/ast-lexer.cc"
+#line 439 "src/ast-lexer.cc"
 		{ RETURN(EXPORT); }
 #line 2910 "src/prebuilt/ast-lexer-gen.cc"
 yy380:
@@ -3504,7 +3504,7 @@ yy496:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 436 "src/ast-lexer.cc"
+#line 438 "src/ast-lexer.cc"
 		{ RETURN(IMPORT); }
 #line 3510 "src/prebuilt/ast-lexer-gen.cc"
 yy498:
@@ -3516,17 +3516,46 @@ yy499:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 439 "src/ast-lexer.cc"
+#line 441 "src/ast-lexer.cc"
 		{ RETURN(INVOKE); }
 #line 3522 "src/prebuilt/ast-lexer-gen.cc"
 yy501:
 		++lexer->cursor;
-		if (yybm[0+(yych = *lexer->cursor)] & 16) {
-			goto yy49;
+		if ((yych = *lexer->cursor) <= ':') {
+			if (yych <= ')') {
+				if (yych <= '!') {
+					if (yych >= '!') goto yy49;
+				} else {
+					if (yych <= '"') goto yy502;
+					if (yych <= '\'') goto yy49;
+				}
+			} else {
+				if (yych <= ',') {
+					if (yych <= '+') goto yy49;
+				} else {
+					if (yych == '.') goto yy1186;
+					goto yy49;
+				}
+			}
+		} else {
+			if (yych <= ']') {
+				if (yych <= 'Z') {
+					if (yych >= '<') goto yy49;
+				} else {
+					if (yych == '\\') goto yy49;
+				}
+			} else {
+				if (yych <= '|') {
+					if (yych != '{') goto yy49;
+				} else {
+					if (yych == '~') goto yy49;
+				}
+			}
 		}
+yy502:
 #line 431 "src/ast-lexer.cc"
 		{ RETURN(MEMORY); }
-#line 3530 "src/prebuilt/ast-lexer-gen.cc"
+#line 3559 "src/prebuilt/ast-lexer-gen.cc"
 yy503:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3534,7 +3563,7 @@ yy503:
 		}
 #line 429 "src/ast-lexer.cc"
 		{ RETURN(MODULE); }
-#line 3538 "src/prebuilt/ast-lexer-gen.cc"
+#line 3567 "src/prebuilt/ast-lexer-gen.cc"
 yy505:
 		yych = *++lexer->cursor;
 		if (yych <= '@') {
@@ -3581,17 +3610,17 @@ yy506:
 			}
 		}
 yy507:
-#line 435 "src/ast-lexer.cc"
+#line 437 "src/ast-lexer.cc"
 		{ RETURN(OFFSET); }
-#line 3587 "src/prebuilt/ast-lexer-gen.cc"
+#line 3616 "src/prebuilt/ast-lexer-gen.cc"
 yy508:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 452 "src/ast-lexer.cc"
+#line 454 "src/ast-lexer.cc"
 		{ RETURN(OUTPUT); }
-#line 3595 "src/prebuilt/ast-lexer-gen.cc"
+#line 3624 "src/prebuilt/ast-lexer-gen.cc"
 yy510:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy661;
@@ -3603,7 +3632,7 @@ yy511:
 		}
 #line 426 "src/ast-lexer.cc"
 		{ RETURN(RESULT); }
-#line 3607 "src/prebuilt/ast-lexer-gen.cc"
+#line 3636 "src/prebuilt/ast-lexer-gen.cc"
 yy513:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3611,7 +3640,7 @@ yy513:
 		}
 #line 261 "src/ast-lexer.cc"
 		{ RETURN(RETURN); }
-#line 3615 "src/prebuilt/ast-lexer-gen.cc"
+#line 3644 "src/prebuilt/ast-lexer-gen.cc"
 yy515:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3619,7 +3648,7 @@ yy515:
 		}
 #line 419 "src/ast-lexer.cc"
 		{ RETURN(SELECT); }
-#line 3623 "src/prebuilt/ast-lexer-gen.cc"
+#line 3652 "src/prebuilt/ast-lexer-gen.cc"
 yy517:
 		yych = *++lexer->cursor;
 		if (yych == 'o') goto yy662;
@@ -3674,7 +3703,7 @@ yy521:
 yy522:
 #line 291 "src/ast-lexer.cc"
 		{ TEXT_AT(6); RETURN(ALIGN_EQ_NAT); }
-#line 3678 "src/prebuilt/ast-lexer-gen.cc"
+#line 3707 "src/prebuilt/ast-lexer-gen.cc"
 yy523:
 		++lexer->cursor;
 		if (lexer->limit <= lexer->cursor) FILL(1);
@@ -3725,7 +3754,7 @@ yy525:
 		}
 #line 244 "src/ast-lexer.cc"
 		{ RETURN(ANYFUNC); }
-#line 3729 "src/prebuilt/ast-lexer-gen.cc"
+#line 3758 "src/prebuilt/ast-lexer-gen.cc"
 yy527:
 		yych = *++lexer->cursor;
 		switch (yych) {
@@ -3760,7 +3789,7 @@ yy532:
 		}
 #line 306 "src/ast-lexer.cc"
 		{ OPCODE(F32Abs); RETURN(UNARY); }
-#line 3764 "src/prebuilt/ast-lexer-gen.cc"
+#line 3793 "src/prebuilt/ast-lexer-gen.cc"
 yy534:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3768,7 +3797,7 @@ yy534:
 		}
 #line 348 "src/ast-lexer.cc"
 		{ OPCODE(F32Add); RETURN(BINARY); }
-#line 3772 "src/prebuilt/ast-lexer-gen.cc"
+#line 3801 "src/prebuilt/ast-lexer-gen.cc"
 yy536:
 		yych = *++lexer->cursor;
 		if (yych == 'l') goto yy678;
@@ -3793,7 +3822,7 @@ yy540:
 		}
 #line 354 "src/ast-lexer.cc"
 		{ OPCODE(F32Div); RETURN(BINARY); }
-#line 3797 "src/prebuilt/ast-lexer-gen.cc"
+#line 3826 "src/prebuilt/ast-lexer-gen.cc"
 yy542:
 		yych = *++lexer->cursor;
 		if (yych == 'o') goto yy684;
@@ -3809,7 +3838,7 @@ yy544:
 		}
 #line 358 "src/ast-lexer.cc"
 		{ OPCODE(F32Max); RETURN(BINARY); }
-#line 3813 "src/prebuilt/ast-lexer-gen.cc"
+#line 3842 "src/prebuilt/ast-lexer-gen.cc"
 yy546:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3817,7 +3846,7 @@ yy546:
 		}
 #line 356 "src/ast-lexer.cc"
 		{ OPCODE(F32Min); RETURN(BINARY); }
-#line 3821 "src/prebuilt/ast-lexer-gen.cc"
+#line 3850 "src/prebuilt/ast-lexer-gen.cc"
 yy548:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3825,7 +3854,7 @@ yy548:
 		}
 #line 352 "src/ast-lexer.cc"
 		{ OPCODE(F32Mul); RETURN(BINARY); }
-#line 3829 "src/prebuilt/ast-lexer-gen.cc"
+#line 3858 "src/prebuilt/ast-lexer-gen.cc"
 yy550:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy687;
@@ -3837,7 +3866,7 @@ yy551:
 		}
 #line 304 "src/ast-lexer.cc"
 		{ OPCODE(F32Neg); RETURN(UNARY); }
-#line 3841 "src/prebuilt/ast-lexer-gen.cc"
+#line 3870 "src/prebuilt/ast-lexer-gen.cc"
 yy553:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy688;
@@ -3857,7 +3886,7 @@ yy556:
 		}
 #line 350 "src/ast-lexer.cc"
 		{ OPCODE(F32Sub); RETURN(BINARY); }
-#line 3861 "src/prebuilt/ast-lexer-gen.cc"
+#line 3890 "src/prebuilt/ast-lexer-gen.cc"
 yy558:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy692;
@@ -3869,7 +3898,7 @@ yy559:
 		}
 #line 307 "src/ast-lexer.cc"
 		{ OPCODE(F64Abs); RETURN(UNARY); }
-#line 3873 "src/prebuilt/ast-lexer-gen.cc"
+#line 3902 "src/prebuilt/ast-lexer-gen.cc"
 yy561:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3877,7 +3906,7 @@ yy561:
 		}
 #line 349 "src/ast-lexer.cc"
 		{ OPCODE(F64Add); RETURN(BINARY); }
-#line 3881 "src/prebuilt/ast-lexer-gen.cc"
+#line 3910 "src/prebuilt/ast-lexer-gen.cc"
 yy563:
 		yych = *++lexer->cursor;
 		if (yych == 'l') goto yy693;
@@ -3898,7 +3927,7 @@ yy566:
 		}
 #line 355 "src/ast-lexer.cc"
 		{ OPCODE(F64Div); RETURN(BINARY); }
-#line 3902 "src/prebuilt/ast-lexer-gen.cc"
+#line 3931 "src/prebuilt/ast-lexer-gen.cc"
 yy568:
 		yych = *++lexer->cursor;
 		if (yych == 'o') goto yy698;
@@ -3914,7 +3943,7 @@ yy570:
 		}
 #line 359 "src/ast-lexer.cc"
 		{ OPCODE(F64Max); RETURN(BINARY); }
-#line 3918 "src/prebuilt/ast-lexer-gen.cc"
+#line 3947 "src/prebuilt/ast-lexer-gen.cc"
 yy572:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3922,7 +3951,7 @@ yy572:
 		}
 #line 357 "src/ast-lexer.cc"
 		{ OPCODE(F64Min); RETURN(BINARY); }
-#line 3926 "src/prebuilt/ast-lexer-gen.cc"
+#line 3955 "src/prebuilt/ast-lexer-gen.cc"
 yy574:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3930,7 +3959,7 @@ yy574:
 		}
 #line 353 "src/ast-lexer.cc"
 		{ OPCODE(F64Mul); RETURN(BINARY); }
-#line 3934 "src/prebuilt/ast-lexer-gen.cc"
+#line 3963 "src/prebuilt/ast-lexer-gen.cc"
 yy576:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy701;
@@ -3942,7 +3971,7 @@ yy577:
 		}
 #line 305 "src/ast-lexer.cc"
 		{ OPCODE(F64Neg); RETURN(UNARY); }
-#line 3946 "src/prebuilt/ast-lexer-gen.cc"
+#line 3975 "src/prebuilt/ast-lexer-gen.cc"
 yy579:
 		yych = *++lexer->cursor;
 		if (yych == 'm') goto yy702;
@@ -3966,7 +3995,7 @@ yy583:
 		}
 #line 351 "src/ast-lexer.cc"
 		{ OPCODE(F64Sub); RETURN(BINARY); }
-#line 3970 "src/prebuilt/ast-lexer-gen.cc"
+#line 3999 "src/prebuilt/ast-lexer-gen.cc"
 yy585:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy707;
@@ -3990,7 +4019,7 @@ yy589:
 		}
 #line 318 "src/ast-lexer.cc"
 		{ OPCODE(I32Add); RETURN(BINARY); }
-#line 3994 "src/prebuilt/ast-lexer-gen.cc"
+#line 4023 "src/prebuilt/ast-lexer-gen.cc"
 yy591:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -3998,7 +4027,7 @@ yy591:
 		}
 #line 332 "src/ast-lexer.cc"
 		{ OPCODE(I32And); RETURN(BINARY); }
-#line 4002 "src/prebuilt/ast-lexer-gen.cc"
+#line 4031 "src/prebuilt/ast-lexer-gen.cc"
 yy593:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4006,7 +4035,7 @@ yy593:
 		}
 #line 298 "src/ast-lexer.cc"
 		{ OPCODE(I32Clz); RETURN(UNARY); }
-#line 4010 "src/prebuilt/ast-lexer-gen.cc"
+#line 4039 "src/prebuilt/ast-lexer-gen.cc"
 yy595:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy711;
@@ -4018,7 +4047,7 @@ yy596:
 		}
 #line 300 "src/ast-lexer.cc"
 		{ OPCODE(I32Ctz); RETURN(UNARY); }
-#line 4022 "src/prebuilt/ast-lexer-gen.cc"
+#line 4051 "src/prebuilt/ast-lexer-gen.cc"
 yy598:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy712;
@@ -4030,7 +4059,7 @@ yy599:
 		}
 #line 296 "src/ast-lexer.cc"
 		{ OPCODE(I32Eqz); RETURN(CONVERT); }
-#line 4034 "src/prebuilt/ast-lexer-gen.cc"
+#line 4063 "src/prebuilt/ast-lexer-gen.cc"
 yy601:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy713;
@@ -4062,7 +4091,7 @@ yy606:
 		}
 #line 322 "src/ast-lexer.cc"
 		{ OPCODE(I32Mul); RETURN(BINARY); }
-#line 4066 "src/prebuilt/ast-lexer-gen.cc"
+#line 4095 "src/prebuilt/ast-lexer-gen.cc"
 yy608:
 		yych = *++lexer->cursor;
 		if (yych == 'c') goto yy731;
@@ -4087,7 +4116,7 @@ yy612:
 		}
 #line 338 "src/ast-lexer.cc"
 		{ OPCODE(I32Shl); RETURN(BINARY); }
-#line 4091 "src/prebuilt/ast-lexer-gen.cc"
+#line 4120 "src/prebuilt/ast-lexer-gen.cc"
 yy614:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy738;
@@ -4103,7 +4132,7 @@ yy616:
 		}
 #line 320 "src/ast-lexer.cc"
 		{ OPCODE(I32Sub); RETURN(BINARY); }
-#line 4107 "src/prebuilt/ast-lexer-gen.cc"
+#line 4136 "src/prebuilt/ast-lexer-gen.cc"
 yy618:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy740;
@@ -4119,7 +4148,7 @@ yy620:
 		}
 #line 336 "src/ast-lexer.cc"
 		{ OPCODE(I32Xor); RETURN(BINARY); }
-#line 4123 "src/prebuilt/ast-lexer-gen.cc"
+#line 4152 "src/prebuilt/ast-lexer-gen.cc"
 yy622:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4127,7 +4156,7 @@ yy622:
 		}
 #line 319 "src/ast-lexer.cc"
 		{ OPCODE(I64Add); RETURN(BINARY); }
-#line 4131 "src/prebuilt/ast-lexer-gen.cc"
+#line 4160 "src/prebuilt/ast-lexer-gen.cc"
 yy624:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4135,7 +4164,7 @@ yy624:
 		}
 #line 333 "src/ast-lexer.cc"
 		{ OPCODE(I64And); RETURN(BINARY); }
-#line 4139 "src/prebuilt/ast-lexer-gen.cc"
+#line 4168 "src/prebuilt/ast-lexer-gen.cc"
 yy626:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4143,7 +4172,7 @@ yy626:
 		}
 #line 299 "src/ast-lexer.cc"
 		{ OPCODE(I64Clz); RETURN(UNARY); }
-#line 4147 "src/prebuilt/ast-lexer-gen.cc"
+#line 4176 "src/prebuilt/ast-lexer-gen.cc"
 yy628:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy742;
@@ -4155,7 +4184,7 @@ yy629:
 		}
 #line 301 "src/ast-lexer.cc"
 		{ OPCODE(I64Ctz); RETURN(UNARY); }
-#line 4159 "src/prebuilt/ast-lexer-gen.cc"
+#line 4188 "src/prebuilt/ast-lexer-gen.cc"
 yy631:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy743;
@@ -4167,7 +4196,7 @@ yy632:
 		}
 #line 297 "src/ast-lexer.cc"
 		{ OPCODE(I64Eqz); RETURN(CONVERT); }
-#line 4171 "src/prebuilt/ast-lexer-gen.cc"
+#line 4200 "src/prebuilt/ast-lexer-gen.cc"
 yy634:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy744;
@@ -4203,7 +4232,7 @@ yy640:
 		}
 #line 323 "src/ast-lexer.cc"
 		{ OPCODE(I64Mul); RETURN(BINARY); }
-#line 4207 "src/prebuilt/ast-lexer-gen.cc"
+#line 4236 "src/prebuilt/ast-lexer-gen.cc"
 yy642:
 		yych = *++lexer->cursor;
 		if (yych == 'c') goto yy763;
@@ -4228,7 +4257,7 @@ yy646:
 		}
 #line 339 "src/ast-lexer.cc"
 		{ OPCODE(I64Shl); RETURN(BINARY); }
-#line 4232 "src/prebuilt/ast-lexer-gen.cc"
+#line 4261 "src/prebuilt/ast-lexer-gen.cc"
 yy648:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy770;
@@ -4244,7 +4273,7 @@ yy650:
 		}
 #line 321 "src/ast-lexer.cc"
 		{ OPCODE(I64Sub); RETURN(BINARY); }
-#line 4248 "src/prebuilt/ast-lexer-gen.cc"
+#line 4277 "src/prebuilt/ast-lexer-gen.cc"
 yy652:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy772;
@@ -4256,7 +4285,7 @@ yy653:
 		}
 #line 337 "src/ast-lexer.cc"
 		{ OPCODE(I64Xor); RETURN(BINARY); }
-#line 4260 "src/prebuilt/ast-lexer-gen.cc"
+#line 4289 "src/prebuilt/ast-lexer-gen.cc"
 yy655:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4264,7 +4293,7 @@ yy655:
 		}
 #line 249 "src/ast-lexer.cc"
 		{ RETURN(IF); }
-#line 4268 "src/prebuilt/ast-lexer-gen.cc"
+#line 4297 "src/prebuilt/ast-lexer-gen.cc"
 yy657:
 		yych = *++lexer->cursor;
 		if (yych == 'y') goto yy773;
@@ -4384,7 +4413,7 @@ yy673:
 		}
 #line 255 "src/ast-lexer.cc"
 		{ RETURN(BR_TABLE); }
-#line 4388 "src/prebuilt/ast-lexer-gen.cc"
+#line 4417 "src/prebuilt/ast-lexer-gen.cc"
 yy675:
 		yych = *++lexer->cursor;
 		if (yych == 'o') goto yy792;
@@ -4404,7 +4433,7 @@ yy678:
 		}
 #line 310 "src/ast-lexer.cc"
 		{ OPCODE(F32Ceil); RETURN(UNARY); }
-#line 4408 "src/prebuilt/ast-lexer-gen.cc"
+#line 4437 "src/prebuilt/ast-lexer-gen.cc"
 yy680:
 		yych = *++lexer->cursor;
 		if (yych == 't') goto yy795;
@@ -4432,7 +4461,7 @@ yy685:
 		}
 #line 269 "src/ast-lexer.cc"
 		{ OPCODE(F32Load); RETURN(LOAD); }
-#line 4436 "src/prebuilt/ast-lexer-gen.cc"
+#line 4465 "src/prebuilt/ast-lexer-gen.cc"
 yy687:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy802;
@@ -4448,7 +4477,7 @@ yy689:
 		}
 #line 308 "src/ast-lexer.cc"
 		{ OPCODE(F32Sqrt); RETURN(UNARY); }
-#line 4452 "src/prebuilt/ast-lexer-gen.cc"
+#line 4481 "src/prebuilt/ast-lexer-gen.cc"
 yy691:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy804;
@@ -4464,7 +4493,7 @@ yy693:
 		}
 #line 311 "src/ast-lexer.cc"
 		{ OPCODE(F64Ceil); RETURN(UNARY); }
-#line 4468 "src/prebuilt/ast-lexer-gen.cc"
+#line 4497 "src/prebuilt/ast-lexer-gen.cc"
 yy695:
 		yych = *++lexer->cursor;
 		if (yych == 't') goto yy808;
@@ -4488,7 +4517,7 @@ yy699:
 		}
 #line 270 "src/ast-lexer.cc"
 		{ OPCODE(F64Load); RETURN(LOAD); }
-#line 4492 "src/prebuilt/ast-lexer-gen.cc"
+#line 4521 "src/prebuilt/ast-lexer-gen.cc"
 yy701:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy814;
@@ -4508,7 +4537,7 @@ yy704:
 		}
 #line 309 "src/ast-lexer.cc"
 		{ OPCODE(F64Sqrt); RETURN(UNARY); }
-#line 4512 "src/prebuilt/ast-lexer-gen.cc"
+#line 4541 "src/prebuilt/ast-lexer-gen.cc"
 yy706:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy817;
@@ -4545,7 +4574,7 @@ yy713:
 		}
 #line 378 "src/ast-lexer.cc"
 		{ OPCODE(I32GeS); RETURN(COMPARE); }
-#line 4549 "src/prebuilt/ast-lexer-gen.cc"
+#line 4578 "src/prebuilt/ast-lexer-gen.cc"
 yy715:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4553,7 +4582,7 @@ yy715:
 		}
 #line 380 "src/ast-lexer.cc"
 		{ OPCODE(I32GeU); RETURN(COMPARE); }
-#line 4557 "src/prebuilt/ast-lexer-gen.cc"
+#line 4586 "src/prebuilt/ast-lexer-gen.cc"
 yy717:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4561,7 +4590,7 @@ yy717:
 		}
 #line 374 "src/ast-lexer.cc"
 		{ OPCODE(I32GtS); RETURN(COMPARE); }
-#line 4565 "src/prebuilt/ast-lexer-gen.cc"
+#line 4594 "src/prebuilt/ast-lexer-gen.cc"
 yy719:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4569,7 +4598,7 @@ yy719:
 		}
 #line 376 "src/ast-lexer.cc"
 		{ OPCODE(I32GtU); RETURN(COMPARE); }
-#line 4573 "src/prebuilt/ast-lexer-gen.cc"
+#line 4602 "src/prebuilt/ast-lexer-gen.cc"
 yy721:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4577,7 +4606,7 @@ yy721:
 		}
 #line 370 "src/ast-lexer.cc"
 		{ OPCODE(I32LeS); RETURN(COMPARE); }
-#line 4581 "src/prebuilt/ast-lexer-gen.cc"
+#line 4610 "src/prebuilt/ast-lexer-gen.cc"
 yy723:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4585,7 +4614,7 @@ yy723:
 		}
 #line 372 "src/ast-lexer.cc"
 		{ OPCODE(I32LeU); RETURN(COMPARE); }
-#line 4589 "src/prebuilt/ast-lexer-gen.cc"
+#line 4618 "src/prebuilt/ast-lexer-gen.cc"
 yy725:
 		++lexer->cursor;
 		if ((yych = *lexer->cursor) <= '8') {
@@ -4623,7 +4652,7 @@ yy725:
 yy726:
 #line 267 "src/ast-lexer.cc"
 		{ OPCODE(I32Load); RETURN(LOAD); }
-#line 4627 "src/prebuilt/ast-lexer-gen.cc"
+#line 4656 "src/prebuilt/ast-lexer-gen.cc"
 yy727:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4631,7 +4660,7 @@ yy727:
 		}
 #line 366 "src/ast-lexer.cc"
 		{ OPCODE(I32LtS); RETURN(COMPARE); }
-#line 4635 "src/prebuilt/ast-lexer-gen.cc"
+#line 4664 "src/prebuilt/ast-lexer-gen.cc"
 yy729:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4639,7 +4668,7 @@ yy729:
 		}
 #line 368 "src/ast-lexer.cc"
 		{ OPCODE(I32LtU); RETURN(COMPARE); }
-#line 4643 "src/prebuilt/ast-lexer-gen.cc"
+#line 4672 "src/prebuilt/ast-lexer-gen.cc"
 yy731:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy833;
@@ -4660,7 +4689,7 @@ yy734:
 		}
 #line 344 "src/ast-lexer.cc"
 		{ OPCODE(I32Rotl); RETURN(BINARY); }
-#line 4664 "src/prebuilt/ast-lexer-gen.cc"
+#line 4693 "src/prebuilt/ast-lexer-gen.cc"
 yy736:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4668,7 +4697,7 @@ yy736:
 		}
 #line 346 "src/ast-lexer.cc"
 		{ OPCODE(I32Rotr); RETURN(BINARY); }
-#line 4672 "src/prebuilt/ast-lexer-gen.cc"
+#line 4701 "src/prebuilt/ast-lexer-gen.cc"
 yy738:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy839;
@@ -4706,7 +4735,7 @@ yy745:
 		}
 #line 379 "src/ast-lexer.cc"
 		{ OPCODE(I64GeS); RETURN(COMPARE); }
-#line 4710 "src/prebuilt/ast-lexer-gen.cc"
+#line 4739 "src/prebuilt/ast-lexer-gen.cc"
 yy747:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4714,7 +4743,7 @@ yy747:
 		}
 #line 381 "src/ast-lexer.cc"
 		{ OPCODE(I64GeU); RETURN(COMPARE); }
-#line 4718 "src/prebuilt/ast-lexer-gen.cc"
+#line 4747 "src/prebuilt/ast-lexer-gen.cc"
 yy749:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4722,7 +4751,7 @@ yy749:
 		}
 #line 375 "src/ast-lexer.cc"
 		{ OPCODE(I64GtS); RETURN(COMPARE); }
-#line 4726 "src/prebuilt/ast-lexer-gen.cc"
+#line 4755 "src/prebuilt/ast-lexer-gen.cc"
 yy751:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4730,7 +4759,7 @@ yy751:
 		}
 #line 377 "src/ast-lexer.cc"
 		{ OPCODE(I64GtU); RETURN(COMPARE); }
-#line 4734 "src/prebuilt/ast-lexer-gen.cc"
+#line 4763 "src/prebuilt/ast-lexer-gen.cc"
 yy753:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4738,7 +4767,7 @@ yy753:
 		}
 #line 371 "src/ast-lexer.cc"
 		{ OPCODE(I64LeS); RETURN(COMPARE); }
-#line 4742 "src/prebuilt/ast-lexer-gen.cc"
+#line 4771 "src/prebuilt/ast-lexer-gen.cc"
 yy755:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4746,7 +4775,7 @@ yy755:
 		}
 #line 373 "src/ast-lexer.cc"
 		{ OPCODE(I64LeU); RETURN(COMPARE); }
-#line 4750 "src/prebuilt/ast-lexer-gen.cc"
+#line 4779 "src/prebuilt/ast-lexer-gen.cc"
 yy757:
 		++lexer->cursor;
 		if ((yych = *lexer->cursor) <= '7') {
@@ -4788,7 +4817,7 @@ yy757:
 yy758:
 #line 268 "src/ast-lexer.cc"
 		{ OPCODE(I64Load); RETURN(LOAD); }
-#line 4792 "src/prebuilt/ast-lexer-gen.cc"
+#line 4821 "src/prebuilt/ast-lexer-gen.cc"
 yy759:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4796,7 +4825,7 @@ yy759:
 		}
 #line 367 "src/ast-lexer.cc"
 		{ OPCODE(I64LtS); RETURN(COMPARE); }
-#line 4800 "src/prebuilt/ast-lexer-gen.cc"
+#line 4829 "src/prebuilt/ast-lexer-gen.cc"
 yy761:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4804,7 +4833,7 @@ yy761:
 		}
 #line 369 "src/ast-lexer.cc"
 		{ OPCODE(I64LtU); RETURN(COMPARE); }
-#line 4808 "src/prebuilt/ast-lexer-gen.cc"
+#line 4837 "src/prebuilt/ast-lexer-gen.cc"
 yy763:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy857;
@@ -4825,7 +4854,7 @@ yy766:
 		}
 #line 345 "src/ast-lexer.cc"
 		{ OPCODE(I64Rotl); RETURN(BINARY); }
-#line 4829 "src/prebuilt/ast-lexer-gen.cc"
+#line 4858 "src/prebuilt/ast-lexer-gen.cc"
 yy768:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -4833,7 +4862,7 @@ yy768:
 		}
 #line 347 "src/ast-lexer.cc"
 		{ OPCODE(I64Rotr); RETURN(BINARY); }
-#line 4837 "src/prebuilt/ast-lexer-gen.cc"
+#line 4866 "src/prebuilt/ast-lexer-gen.cc"
 yy770:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy863;
@@ -4891,7 +4920,7 @@ yy774:
 yy775:
 #line 290 "src/ast-lexer.cc"
 		{ TEXT_AT(7); RETURN(OFFSET_EQ_NAT); }
-#line 4895 "src/prebuilt/ast-lexer-gen.cc"
+#line 4924 "src/prebuilt/ast-lexer-gen.cc"
 yy776:
 		++lexer->cursor;
 		if (lexer->limit <= lexer->cursor) FILL(1);
@@ -4940,9 +4969,9 @@ yy778:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 438 "src/ast-lexer.cc"
+#line 440 "src/ast-lexer.cc"
 		{ RETURN(REGISTER); }
-#line 4946 "src/prebuilt/ast-lexer-gen.cc"
+#line 4975 "src/prebuilt/ast-lexer-gen.cc"
 yy780:
 		yych = *++lexer->cursor;
 		if (yych == 'a') goto yy871;
@@ -5048,7 +5077,7 @@ yy795:
 		}
 #line 294 "src/ast-lexer.cc"
 		{ TYPE(F32); RETURN(CONST); }
-#line 5052 "src/prebuilt/ast-lexer-gen.cc"
+#line 5081 "src/prebuilt/ast-lexer-gen.cc"
 yy797:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy886;
@@ -5068,7 +5097,7 @@ yy800:
 		}
 #line 312 "src/ast-lexer.cc"
 		{ OPCODE(F32Floor); RETURN(UNARY); }
-#line 5072 "src/prebuilt/ast-lexer-gen.cc"
+#line 5101 "src/prebuilt/ast-lexer-gen.cc"
 yy802:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy889;
@@ -5084,7 +5113,7 @@ yy804:
 		}
 #line 273 "src/ast-lexer.cc"
 		{ OPCODE(F32Store); RETURN(STORE); }
-#line 5088 "src/prebuilt/ast-lexer-gen.cc"
+#line 5117 "src/prebuilt/ast-lexer-gen.cc"
 yy806:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5092,7 +5121,7 @@ yy806:
 		}
 #line 314 "src/ast-lexer.cc"
 		{ OPCODE(F32Trunc); RETURN(UNARY); }
-#line 5096 "src/prebuilt/ast-lexer-gen.cc"
+#line 5125 "src/prebuilt/ast-lexer-gen.cc"
 yy808:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5100,7 +5129,7 @@ yy808:
 		}
 #line 295 "src/ast-lexer.cc"
 		{ TYPE(F64); RETURN(CONST); }
-#line 5104 "src/prebuilt/ast-lexer-gen.cc"
+#line 5133 "src/prebuilt/ast-lexer-gen.cc"
 yy810:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy891;
@@ -5116,7 +5145,7 @@ yy812:
 		}
 #line 313 "src/ast-lexer.cc"
 		{ OPCODE(F64Floor); RETURN(UNARY); }
-#line 5120 "src/prebuilt/ast-lexer-gen.cc"
+#line 5149 "src/prebuilt/ast-lexer-gen.cc"
 yy814:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy893;
@@ -5136,7 +5165,7 @@ yy817:
 		}
 #line 274 "src/ast-lexer.cc"
 		{ OPCODE(F64Store); RETURN(STORE); }
-#line 5140 "src/prebuilt/ast-lexer-gen.cc"
+#line 5169 "src/prebuilt/ast-lexer-gen.cc"
 yy819:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5144,7 +5173,7 @@ yy819:
 		}
 #line 315 "src/ast-lexer.cc"
 		{ OPCODE(F64Trunc); RETURN(UNARY); }
-#line 5148 "src/prebuilt/ast-lexer-gen.cc"
+#line 5177 "src/prebuilt/ast-lexer-gen.cc"
 yy821:
 		yych = *++lexer->cursor;
 		if (yych == 'l') goto yy896;
@@ -5156,7 +5185,7 @@ yy822:
 		}
 #line 262 "src/ast-lexer.cc"
 		{ RETURN(GET_LOCAL); }
-#line 5160 "src/prebuilt/ast-lexer-gen.cc"
+#line 5189 "src/prebuilt/ast-lexer-gen.cc"
 yy824:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy898;
@@ -5168,7 +5197,7 @@ yy825:
 		}
 #line 292 "src/ast-lexer.cc"
 		{ TYPE(I32); RETURN(CONST); }
-#line 5172 "src/prebuilt/ast-lexer-gen.cc"
+#line 5201 "src/prebuilt/ast-lexer-gen.cc"
 yy827:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5176,7 +5205,7 @@ yy827:
 		}
 #line 324 "src/ast-lexer.cc"
 		{ OPCODE(I32DivS); RETURN(BINARY); }
-#line 5180 "src/prebuilt/ast-lexer-gen.cc"
+#line 5209 "src/prebuilt/ast-lexer-gen.cc"
 yy829:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5184,7 +5213,7 @@ yy829:
 		}
 #line 326 "src/ast-lexer.cc"
 		{ OPCODE(I32DivU); RETURN(BINARY); }
-#line 5188 "src/prebuilt/ast-lexer-gen.cc"
+#line 5217 "src/prebuilt/ast-lexer-gen.cc"
 yy831:
 		yych = *++lexer->cursor;
 		if (yych == '6') goto yy899;
@@ -5208,7 +5237,7 @@ yy835:
 		}
 #line 328 "src/ast-lexer.cc"
 		{ OPCODE(I32RemS); RETURN(BINARY); }
-#line 5212 "src/prebuilt/ast-lexer-gen.cc"
+#line 5241 "src/prebuilt/ast-lexer-gen.cc"
 yy837:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5216,7 +5245,7 @@ yy837:
 		}
 #line 330 "src/ast-lexer.cc"
 		{ OPCODE(I32RemU); RETURN(BINARY); }
-#line 5220 "src/prebuilt/ast-lexer-gen.cc"
+#line 5249 "src/prebuilt/ast-lexer-gen.cc"
 yy839:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5224,7 +5253,7 @@ yy839:
 		}
 #line 340 "src/ast-lexer.cc"
 		{ OPCODE(I32ShrS); RETURN(BINARY); }
-#line 5228 "src/prebuilt/ast-lexer-gen.cc"
+#line 5257 "src/prebuilt/ast-lexer-gen.cc"
 yy841:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5232,7 +5261,7 @@ yy841:
 		}
 #line 342 "src/ast-lexer.cc"
 		{ OPCODE(I32ShrU); RETURN(BINARY); }
-#line 5236 "src/prebuilt/ast-lexer-gen.cc"
+#line 5265 "src/prebuilt/ast-lexer-gen.cc"
 yy843:
 		++lexer->cursor;
 		if ((yych = *lexer->cursor) <= '8') {
@@ -5270,7 +5299,7 @@ yy843:
 yy844:
 #line 271 "src/ast-lexer.cc"
 		{ OPCODE(I32Store); RETURN(STORE); }
-#line 5274 "src/prebuilt/ast-lexer-gen.cc"
+#line 5303 "src/prebuilt/ast-lexer-gen.cc"
 yy845:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy907;
@@ -5286,7 +5315,7 @@ yy847:
 		}
 #line 293 "src/ast-lexer.cc"
 		{ TYPE(I64); RETURN(CONST); }
-#line 5290 "src/prebuilt/ast-lexer-gen.cc"
+#line 5319 "src/prebuilt/ast-lexer-gen.cc"
 yy849:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5294,7 +5323,7 @@ yy849:
 		}
 #line 325 "src/ast-lexer.cc"
 		{ OPCODE(I64DivS); RETURN(BINARY); }
-#line 5298 "src/prebuilt/ast-lexer-gen.cc"
+#line 5327 "src/prebuilt/ast-lexer-gen.cc"
 yy851:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5302,7 +5331,7 @@ yy851:
 		}
 #line 327 "src/ast-lexer.cc"
 		{ OPCODE(I64DivU); RETURN(BINARY); }
-#line 5306 "src/prebuilt/ast-lexer-gen.cc"
+#line 5335 "src/prebuilt/ast-lexer-gen.cc"
 yy853:
 		yych = *++lexer->cursor;
 		if (yych == 'd') goto yy909;
@@ -5334,7 +5363,7 @@ yy859:
 		}
 #line 329 "src/ast-lexer.cc"
 		{ OPCODE(I64RemS); RETURN(BINARY); }
-#line 5338 "src/prebuilt/ast-lexer-gen.cc"
+#line 5367 "src/prebuilt/ast-lexer-gen.cc"
 yy861:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5342,7 +5371,7 @@ yy861:
 		}
 #line 331 "src/ast-lexer.cc"
 		{ OPCODE(I64RemU); RETURN(BINARY); }
-#line 5346 "src/prebuilt/ast-lexer-gen.cc"
+#line 5375 "src/prebuilt/ast-lexer-gen.cc"
 yy863:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5350,7 +5379,7 @@ yy863:
 		}
 #line 341 "src/ast-lexer.cc"
 		{ OPCODE(I64ShrS); RETURN(BINARY); }
-#line 5354 "src/prebuilt/ast-lexer-gen.cc"
+#line 5383 "src/prebuilt/ast-lexer-gen.cc"
 yy865:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5358,7 +5387,7 @@ yy865:
 		}
 #line 343 "src/ast-lexer.cc"
 		{ OPCODE(I64ShrU); RETURN(BINARY); }
-#line 5362 "src/prebuilt/ast-lexer-gen.cc"
+#line 5391 "src/prebuilt/ast-lexer-gen.cc"
 yy867:
 		++lexer->cursor;
 		if ((yych = *lexer->cursor) <= '7') {
@@ -5400,7 +5429,7 @@ yy867:
 yy868:
 #line 272 "src/ast-lexer.cc"
 		{ OPCODE(I64Store); RETURN(STORE); }
-#line 5404 "src/prebuilt/ast-lexer-gen.cc"
+#line 5433 "src/prebuilt/ast-lexer-gen.cc"
 yy869:
 		yych = *++lexer->cursor;
 		if (yych == '_') goto yy920;
@@ -5428,7 +5457,7 @@ yy872:
 		}
 #line 263 "src/ast-lexer.cc"
 		{ RETURN(SET_LOCAL); }
-#line 5432 "src/prebuilt/ast-lexer-gen.cc"
+#line 5461 "src/prebuilt/ast-lexer-gen.cc"
 yy874:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5436,7 +5465,7 @@ yy874:
 		}
 #line 264 "src/ast-lexer.cc"
 		{ RETURN(TEE_LOCAL); }
-#line 5440 "src/prebuilt/ast-lexer-gen.cc"
+#line 5469 "src/prebuilt/ast-lexer-gen.cc"
 yy876:
 		yych = *++lexer->cursor;
 		if (yych == 'l') goto yy925;
@@ -5524,7 +5553,7 @@ yy896:
 		}
 #line 265 "src/ast-lexer.cc"
 		{ RETURN(GET_GLOBAL); }
-#line 5528 "src/prebuilt/ast-lexer-gen.cc"
+#line 5557 "src/prebuilt/ast-lexer-gen.cc"
 yy898:
 		yych = *++lexer->cursor;
 		if (yych == 'y') goto yy949;
@@ -5545,7 +5574,7 @@ yy901:
 		}
 #line 302 "src/ast-lexer.cc"
 		{ OPCODE(I32Popcnt); RETURN(UNARY); }
-#line 5549 "src/prebuilt/ast-lexer-gen.cc"
+#line 5578 "src/prebuilt/ast-lexer-gen.cc"
 yy903:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy956;
@@ -5561,7 +5590,7 @@ yy905:
 		}
 #line 285 "src/ast-lexer.cc"
 		{ OPCODE(I32Store8); RETURN(STORE); }
-#line 5565 "src/prebuilt/ast-lexer-gen.cc"
+#line 5594 "src/prebuilt/ast-lexer-gen.cc"
 yy907:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy959;
@@ -5595,7 +5624,7 @@ yy913:
 		}
 #line 303 "src/ast-lexer.cc"
 		{ OPCODE(I64Popcnt); RETURN(UNARY); }
-#line 5599 "src/prebuilt/ast-lexer-gen.cc"
+#line 5628 "src/prebuilt/ast-lexer-gen.cc"
 yy915:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy969;
@@ -5615,7 +5644,7 @@ yy918:
 		}
 #line 286 "src/ast-lexer.cc"
 		{ OPCODE(I64Store8); RETURN(STORE); }
-#line 5619 "src/prebuilt/ast-lexer-gen.cc"
+#line 5648 "src/prebuilt/ast-lexer-gen.cc"
 yy920:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy974;
@@ -5674,7 +5703,7 @@ yy923:
 		}
 #line 266 "src/ast-lexer.cc"
 		{ RETURN(SET_GLOBAL); }
-#line 5678 "src/prebuilt/ast-lexer-gen.cc"
+#line 5707 "src/prebuilt/ast-lexer-gen.cc"
 yy925:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy976;
@@ -5700,9 +5729,9 @@ yy930:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 449 "src/ast-lexer.cc"
+#line 451 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_TRAP); }
-#line 5706 "src/prebuilt/ast-lexer-gen.cc"
+#line 5735 "src/prebuilt/ast-lexer-gen.cc"
 yy932:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy982;
@@ -5714,7 +5743,7 @@ yy933:
 		}
 #line 257 "src/ast-lexer.cc"
 		{ RETURN(CALL_IMPORT); }
-#line 5718 "src/prebuilt/ast-lexer-gen.cc"
+#line 5747 "src/prebuilt/ast-lexer-gen.cc"
 yy935:
 		yych = *++lexer->cursor;
 		if (yych == 'c') goto yy983;
@@ -5742,7 +5771,7 @@ yy940:
 		}
 #line 316 "src/ast-lexer.cc"
 		{ OPCODE(F32Nearest); RETURN(UNARY); }
-#line 5746 "src/prebuilt/ast-lexer-gen.cc"
+#line 5775 "src/prebuilt/ast-lexer-gen.cc"
 yy942:
 		yych = *++lexer->cursor;
 		if (yych == 'p') goto yy989;
@@ -5762,7 +5791,7 @@ yy945:
 		}
 #line 317 "src/ast-lexer.cc"
 		{ OPCODE(F64Nearest); RETURN(UNARY); }
-#line 5766 "src/prebuilt/ast-lexer-gen.cc"
+#line 5795 "src/prebuilt/ast-lexer-gen.cc"
 yy947:
 		yych = *++lexer->cursor;
 		if (yych == '/') goto yy993;
@@ -5778,7 +5807,7 @@ yy949:
 		}
 #line 422 "src/ast-lexer.cc"
 		{ RETURN(GROW_MEMORY); }
-#line 5782 "src/prebuilt/ast-lexer-gen.cc"
+#line 5811 "src/prebuilt/ast-lexer-gen.cc"
 yy951:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy995;
@@ -5791,7 +5820,7 @@ yy952:
 		}
 #line 275 "src/ast-lexer.cc"
 		{ OPCODE(I32Load8S); RETURN(LOAD); }
-#line 5795 "src/prebuilt/ast-lexer-gen.cc"
+#line 5824 "src/prebuilt/ast-lexer-gen.cc"
 yy954:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5799,7 +5828,7 @@ yy954:
 		}
 #line 277 "src/ast-lexer.cc"
 		{ OPCODE(I32Load8U); RETURN(LOAD); }
-#line 5803 "src/prebuilt/ast-lexer-gen.cc"
+#line 5832 "src/prebuilt/ast-lexer-gen.cc"
 yy956:
 		yych = *++lexer->cursor;
 		if (yych == 'p') goto yy999;
@@ -5811,7 +5840,7 @@ yy957:
 		}
 #line 287 "src/ast-lexer.cc"
 		{ OPCODE(I32Store16); RETURN(STORE); }
-#line 5815 "src/prebuilt/ast-lexer-gen.cc"
+#line 5844 "src/prebuilt/ast-lexer-gen.cc"
 yy959:
 		yych = *++lexer->cursor;
 		if (yych == '/') goto yy1000;
@@ -5846,7 +5875,7 @@ yy965:
 		}
 #line 276 "src/ast-lexer.cc"
 		{ OPCODE(I64Load8S); RETURN(LOAD); }
-#line 5850 "src/prebuilt/ast-lexer-gen.cc"
+#line 5879 "src/prebuilt/ast-lexer-gen.cc"
 yy967:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5854,7 +5883,7 @@ yy967:
 		}
 #line 278 "src/ast-lexer.cc"
 		{ OPCODE(I64Load8U); RETURN(LOAD); }
-#line 5858 "src/prebuilt/ast-lexer-gen.cc"
+#line 5887 "src/prebuilt/ast-lexer-gen.cc"
 yy969:
 		yych = *++lexer->cursor;
 		if (yych == 'p') goto yy1014;
@@ -5866,7 +5895,7 @@ yy970:
 		}
 #line 288 "src/ast-lexer.cc"
 		{ OPCODE(I64Store16); RETURN(STORE); }
-#line 5870 "src/prebuilt/ast-lexer-gen.cc"
+#line 5899 "src/prebuilt/ast-lexer-gen.cc"
 yy972:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5874,7 +5903,7 @@ yy972:
 		}
 #line 289 "src/ast-lexer.cc"
 		{ OPCODE(I64Store32); RETURN(STORE); }
-#line 5878 "src/prebuilt/ast-lexer-gen.cc"
+#line 5907 "src/prebuilt/ast-lexer-gen.cc"
 yy974:
 		yych = *++lexer->cursor;
 		if (yych == '/') goto yy1015;
@@ -5890,7 +5919,7 @@ yy976:
 		}
 #line 420 "src/ast-lexer.cc"
 		{ RETURN(UNREACHABLE); }
-#line 5894 "src/prebuilt/ast-lexer-gen.cc"
+#line 5923 "src/prebuilt/ast-lexer-gen.cc"
 yy978:
 		yych = *++lexer->cursor;
 		if (yych == 's') goto yy1017;
@@ -5931,7 +5960,7 @@ yy986:
 		}
 #line 360 "src/ast-lexer.cc"
 		{ OPCODE(F32Copysign); RETURN(BINARY); }
-#line 5935 "src/prebuilt/ast-lexer-gen.cc"
+#line 5964 "src/prebuilt/ast-lexer-gen.cc"
 yy988:
 		yych = *++lexer->cursor;
 		if (yych == '6') goto yy1028;
@@ -5952,7 +5981,7 @@ yy991:
 		}
 #line 361 "src/ast-lexer.cc"
 		{ OPCODE(F64Copysign); RETURN(BINARY); }
-#line 5956 "src/prebuilt/ast-lexer-gen.cc"
+#line 5985 "src/prebuilt/ast-lexer-gen.cc"
 yy993:
 		yych = *++lexer->cursor;
 		if (yych == 'f') goto yy1032;
@@ -5968,7 +5997,7 @@ yy995:
 		}
 #line 279 "src/ast-lexer.cc"
 		{ OPCODE(I32Load16S); RETURN(LOAD); }
-#line 5972 "src/prebuilt/ast-lexer-gen.cc"
+#line 6001 "src/prebuilt/ast-lexer-gen.cc"
 yy997:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -5976,7 +6005,7 @@ yy997:
 		}
 #line 281 "src/ast-lexer.cc"
 		{ OPCODE(I32Load16U); RETURN(LOAD); }
-#line 5980 "src/prebuilt/ast-lexer-gen.cc"
+#line 6009 "src/prebuilt/ast-lexer-gen.cc"
 yy999:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy1034;
@@ -5996,7 +6025,7 @@ yy1002:
 		}
 #line 396 "src/ast-lexer.cc"
 		{ OPCODE(I32WrapI64); RETURN(CONVERT); }
-#line 6000 "src/prebuilt/ast-lexer-gen.cc"
+#line 6029 "src/prebuilt/ast-lexer-gen.cc"
 yy1004:
 		yych = *++lexer->cursor;
 		if (yych == '/') goto yy1037;
@@ -6012,7 +6041,7 @@ yy1006:
 		}
 #line 280 "src/ast-lexer.cc"
 		{ OPCODE(I64Load16S); RETURN(LOAD); }
-#line 6016 "src/prebuilt/ast-lexer-gen.cc"
+#line 6045 "src/prebuilt/ast-lexer-gen.cc"
 yy1008:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6020,7 +6049,7 @@ yy1008:
 		}
 #line 282 "src/ast-lexer.cc"
 		{ OPCODE(I64Load16U); RETURN(LOAD); }
-#line 6024 "src/prebuilt/ast-lexer-gen.cc"
+#line 6053 "src/prebuilt/ast-lexer-gen.cc"
 yy1010:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6028,7 +6057,7 @@ yy1010:
 		}
 #line 283 "src/ast-lexer.cc"
 		{ OPCODE(I64Load32S); RETURN(LOAD); }
-#line 6032 "src/prebuilt/ast-lexer-gen.cc"
+#line 6061 "src/prebuilt/ast-lexer-gen.cc"
 yy1012:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6036,7 +6065,7 @@ yy1012:
 		}
 #line 284 "src/ast-lexer.cc"
 		{ OPCODE(I64Load32U); RETURN(LOAD); }
-#line 6040 "src/prebuilt/ast-lexer-gen.cc"
+#line 6069 "src/prebuilt/ast-lexer-gen.cc"
 yy1014:
 		yych = *++lexer->cursor;
 		if (yych == 'r') goto yy1039;
@@ -6096,9 +6125,9 @@ yy1020:
 			}
 		}
 yy1021:
-#line 444 "src/ast-lexer.cc"
+#line 446 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_RETURN); }
-#line 6102 "src/prebuilt/ast-lexer-gen.cc"
+#line 6131 "src/prebuilt/ast-lexer-gen.cc"
 yy1022:
 		yych = *++lexer->cursor;
 		if (yych == 'a') goto yy1047;
@@ -6110,7 +6139,7 @@ yy1023:
 		}
 #line 258 "src/ast-lexer.cc"
 		{ RETURN(CALL_INDIRECT); }
-#line 6114 "src/prebuilt/ast-lexer-gen.cc"
+#line 6143 "src/prebuilt/ast-lexer-gen.cc"
 yy1025:
 		yych = *++lexer->cursor;
 		if (yych == 'y') goto yy1048;
@@ -6192,9 +6221,9 @@ yy1043:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 442 "src/ast-lexer.cc"
+#line 444 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_INVALID); }
-#line 6198 "src/prebuilt/ast-lexer-gen.cc"
+#line 6227 "src/prebuilt/ast-lexer-gen.cc"
 yy1045:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy1072;
@@ -6215,7 +6244,7 @@ yy1048:
 		}
 #line 421 "src/ast-lexer.cc"
 		{ RETURN(CURRENT_MEMORY); }
-#line 6219 "src/prebuilt/ast-lexer-gen.cc"
+#line 6248 "src/prebuilt/ast-lexer-gen.cc"
 yy1050:
 		yych = *++lexer->cursor;
 		if (yych == 'i') goto yy1076;
@@ -6231,7 +6260,7 @@ yy1052:
 		}
 #line 414 "src/ast-lexer.cc"
 		{ OPCODE(F32DemoteF64); RETURN(CONVERT); }
-#line 6235 "src/prebuilt/ast-lexer-gen.cc"
+#line 6264 "src/prebuilt/ast-lexer-gen.cc"
 yy1054:
 		yych = *++lexer->cursor;
 		if (yych == 't') goto yy1078;
@@ -6351,7 +6380,7 @@ yy1081:
 		}
 #line 413 "src/ast-lexer.cc"
 		{ OPCODE(F64PromoteF32); RETURN(CONVERT); }
-#line 6355 "src/prebuilt/ast-lexer-gen.cc"
+#line 6384 "src/prebuilt/ast-lexer-gen.cc"
 yy1083:
 		yych = *++lexer->cursor;
 		if (yych == '/') goto yy1119;
@@ -6367,7 +6396,7 @@ yy1085:
 		}
 #line 397 "src/ast-lexer.cc"
 		{ OPCODE(I32TruncSF32); RETURN(CONVERT); }
-#line 6371 "src/prebuilt/ast-lexer-gen.cc"
+#line 6400 "src/prebuilt/ast-lexer-gen.cc"
 yy1087:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6375,7 +6404,7 @@ yy1087:
 		}
 #line 399 "src/ast-lexer.cc"
 		{ OPCODE(I32TruncSF64); RETURN(CONVERT); }
-#line 6379 "src/prebuilt/ast-lexer-gen.cc"
+#line 6408 "src/prebuilt/ast-lexer-gen.cc"
 yy1089:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6383,7 +6412,7 @@ yy1089:
 		}
 #line 401 "src/ast-lexer.cc"
 		{ OPCODE(I32TruncUF32); RETURN(CONVERT); }
-#line 6387 "src/prebuilt/ast-lexer-gen.cc"
+#line 6416 "src/prebuilt/ast-lexer-gen.cc"
 yy1091:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6391,7 +6420,7 @@ yy1091:
 		}
 #line 403 "src/ast-lexer.cc"
 		{ OPCODE(I32TruncUF64); RETURN(CONVERT); }
-#line 6395 "src/prebuilt/ast-lexer-gen.cc"
+#line 6424 "src/prebuilt/ast-lexer-gen.cc"
 yy1093:
 		yych = *++lexer->cursor;
 		if (yych == '2') goto yy1121;
@@ -6411,7 +6440,7 @@ yy1096:
 		}
 #line 398 "src/ast-lexer.cc"
 		{ OPCODE(I64TruncSF32); RETURN(CONVERT); }
-#line 6415 "src/prebuilt/ast-lexer-gen.cc"
+#line 6444 "src/prebuilt/ast-lexer-gen.cc"
 yy1098:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6419,7 +6448,7 @@ yy1098:
 		}
 #line 400 "src/ast-lexer.cc"
 		{ OPCODE(I64TruncSF64); RETURN(CONVERT); }
-#line 6423 "src/prebuilt/ast-lexer-gen.cc"
+#line 6452 "src/prebuilt/ast-lexer-gen.cc"
 yy1100:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6427,7 +6456,7 @@ yy1100:
 		}
 #line 402 "src/ast-lexer.cc"
 		{ OPCODE(I64TruncUF32); RETURN(CONVERT); }
-#line 6431 "src/prebuilt/ast-lexer-gen.cc"
+#line 6460 "src/prebuilt/ast-lexer-gen.cc"
 yy1102:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6435,7 +6464,7 @@ yy1102:
 		}
 #line 404 "src/ast-lexer.cc"
 		{ OPCODE(I64TruncUF64); RETURN(CONVERT); }
-#line 6439 "src/prebuilt/ast-lexer-gen.cc"
+#line 6468 "src/prebuilt/ast-lexer-gen.cc"
 yy1104:
 		yych = *++lexer->cursor;
 		if (yych == 'n') goto yy1126;
@@ -6445,9 +6474,9 @@ yy1105:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 441 "src/ast-lexer.cc"
+#line 443 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_MALFORMED); }
-#line 6451 "src/prebuilt/ast-lexer-gen.cc"
+#line 6480 "src/prebuilt/ast-lexer-gen.cc"
 yy1107:
 		yych = *++lexer->cursor;
 		if (yych == 'i') goto yy1128;
@@ -6511,7 +6540,7 @@ yy1121:
 		}
 #line 394 "src/ast-lexer.cc"
 		{ OPCODE(I64ExtendSI32); RETURN(CONVERT); }
-#line 6515 "src/prebuilt/ast-lexer-gen.cc"
+#line 6544 "src/prebuilt/ast-lexer-gen.cc"
 yy1123:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6519,7 +6548,7 @@ yy1123:
 		}
 #line 395 "src/ast-lexer.cc"
 		{ OPCODE(I64ExtendUI32); RETURN(CONVERT); }
-#line 6523 "src/prebuilt/ast-lexer-gen.cc"
+#line 6552 "src/prebuilt/ast-lexer-gen.cc"
 yy1125:
 		yych = *++lexer->cursor;
 		if (yych == 'f') goto yy1151;
@@ -6529,9 +6558,9 @@ yy1126:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 450 "src/ast-lexer.cc"
+#line 452 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_EXHAUSTION); }
-#line 6535 "src/prebuilt/ast-lexer-gen.cc"
+#line 6564 "src/prebuilt/ast-lexer-gen.cc"
 yy1128:
 		yych = *++lexer->cursor;
 		if (yych == 't') goto yy1152;
@@ -6545,9 +6574,9 @@ yy1130:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 443 "src/ast-lexer.cc"
+#line 445 "src/ast-lexer.cc"
 		{ RETURN(ASSERT_UNLINKABLE); }
-#line 6551 "src/prebuilt/ast-lexer-gen.cc"
+#line 6580 "src/prebuilt/ast-lexer-gen.cc"
 yy1132:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6555,7 +6584,7 @@ yy1132:
 		}
 #line 405 "src/ast-lexer.cc"
 		{ OPCODE(F32ConvertSI32); RETURN(CONVERT); }
-#line 6559 "src/prebuilt/ast-lexer-gen.cc"
+#line 6588 "src/prebuilt/ast-lexer-gen.cc"
 yy1134:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6563,7 +6592,7 @@ yy1134:
 		}
 #line 407 "src/ast-lexer.cc"
 		{ OPCODE(F32ConvertSI64); RETURN(CONVERT); }
-#line 6567 "src/prebuilt/ast-lexer-gen.cc"
+#line 6596 "src/prebuilt/ast-lexer-gen.cc"
 yy1136:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6571,7 +6600,7 @@ yy1136:
 		}
 #line 409 "src/ast-lexer.cc"
 		{ OPCODE(F32ConvertUI32); RETURN(CONVERT); }
-#line 6575 "src/prebuilt/ast-lexer-gen.cc"
+#line 6604 "src/prebuilt/ast-lexer-gen.cc"
 yy1138:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6579,7 +6608,7 @@ yy1138:
 		}
 #line 411 "src/ast-lexer.cc"
 		{ OPCODE(F32ConvertUI64); RETURN(CONVERT); }
-#line 6583 "src/prebuilt/ast-lexer-gen.cc"
+#line 6612 "src/prebuilt/ast-lexer-gen.cc"
 yy1140:
 		yych = *++lexer->cursor;
 		if (yych == '3') goto yy1154;
@@ -6591,7 +6620,7 @@ yy1141:
 		}
 #line 406 "src/ast-lexer.cc"
 		{ OPCODE(F64ConvertSI32); RETURN(CONVERT); }
-#line 6595 "src/prebuilt/ast-lexer-gen.cc"
+#line 6624 "src/prebuilt/ast-lexer-gen.cc"
 yy1143:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6599,7 +6628,7 @@ yy1143:
 		}
 #line 408 "src/ast-lexer.cc"
 		{ OPCODE(F64ConvertSI64); RETURN(CONVERT); }
-#line 6603 "src/prebuilt/ast-lexer-gen.cc"
+#line 6632 "src/prebuilt/ast-lexer-gen.cc"
 yy1145:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6607,7 +6636,7 @@ yy1145:
 		}
 #line 410 "src/ast-lexer.cc"
 		{ OPCODE(F64ConvertUI32); RETURN(CONVERT); }
-#line 6611 "src/prebuilt/ast-lexer-gen.cc"
+#line 6640 "src/prebuilt/ast-lexer-gen.cc"
 yy1147:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6615,7 +6644,7 @@ yy1147:
 		}
 #line 412 "src/ast-lexer.cc"
 		{ OPCODE(F64ConvertUI64); RETURN(CONVERT); }
-#line 6619 "src/prebuilt/ast-lexer-gen.cc"
+#line 6648 "src/prebuilt/ast-lexer-gen.cc"
 yy1149:
 		yych = *++lexer->cursor;
 		if (yych == '6') goto yy1155;
@@ -6667,7 +6696,7 @@ yy1160:
 		}
 #line 415 "src/ast-lexer.cc"
 		{ OPCODE(F32ReinterpretI32); RETURN(CONVERT); }
-#line 6671 "src/prebuilt/ast-lexer-gen.cc"
+#line 6700 "src/prebuilt/ast-lexer-gen.cc"
 yy1162:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6675,7 +6704,7 @@ yy1162:
 		}
 #line 417 "src/ast-lexer.cc"
 		{ OPCODE(F64ReinterpretI64); RETURN(CONVERT); }
-#line 6679 "src/prebuilt/ast-lexer-gen.cc"
+#line 6708 "src/prebuilt/ast-lexer-gen.cc"
 yy1164:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6683,7 +6712,7 @@ yy1164:
 		}
 #line 416 "src/ast-lexer.cc"
 		{ OPCODE(I32ReinterpretF32); RETURN(CONVERT); }
-#line 6687 "src/prebuilt/ast-lexer-gen.cc"
+#line 6716 "src/prebuilt/ast-lexer-gen.cc"
 yy1166:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
@@ -6691,7 +6720,7 @@ yy1166:
 		}
 #line 418 "src/ast-lexer.cc"
 		{ OPCODE(I64ReinterpretF64); RETURN(CONVERT); }
-#line 6695 "src/prebuilt/ast-lexer-gen.cc"
+#line 6724 "src/prebuilt/ast-lexer-gen.cc"
 yy1168:
 		yych = *++lexer->cursor;
 		if (yych == 'e') goto yy1170;
@@ -6757,22 +6786,67 @@ yy1183:
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 445 "src/ast-lexer.cc"
+#line 447 "src/ast-lexer.cc"
 		{
                                   RETURN(ASSERT_RETURN_CANONICAL_NAN); }
-#line 6764 "src/prebuilt/ast-lexer-gen.cc"
+#line 6793 "src/prebuilt/ast-lexer-gen.cc"
 yy1185:
 		++lexer->cursor;
 		if (yybm[0+(yych = *lexer->cursor)] & 16) {
 			goto yy49;
 		}
-#line 447 "src/ast-lexer.cc"
+#line 449 "src/ast-lexer.cc"
 		{
                                   RETURN(ASSERT_RETURN_ARITHMETIC_NAN); }
-#line 6773 "src/prebuilt/ast-lexer-gen.cc"
+#line 6802 "src/prebuilt/ast-lexer-gen.cc"
+yy1186:
+		yych = *++lexer->cursor;
+		if (yych == 'c') goto yy1187;
+		if (yych == 'f') goto yy1188;
+		goto yy50;
+yy1187:
+		yych = *++lexer->cursor;
+		if (yych == 'o') goto yy1189;
+		goto yy50;
+yy1188:
+		yych = *++lexer->cursor;
+		if (yych == 'i') goto yy1190;
+		goto yy50;
+yy1189:
+		yych = *++lexer->cursor;
+		if (yych == 'p') goto yy1191;
+		goto yy50;
+yy1190:
+		yych = *++lexer->cursor;
+		if (yych == 'l') goto yy1192;
+		goto yy50;
+yy1191:
+		yych = *++lexer->cursor;
+		if (yych == 'y') goto yy1193;
+		goto yy50;
+yy1192:
+		yych = *++lexer->cursor;
+		if (yych == 'l') goto yy1194;
+		goto yy50;
+yy1193:
+		++lexer->cursor;
+		if (yybm[0+(yych = *lexer->cursor)] & 16) {
+			goto yy49;
+		}
+#line 432 "src/ast-lexer.cc"
+		{ RETURN(MEMORY_COPY); }
+#line 6839 "src/prebuilt/ast-lexer-gen.cc"
+yy1194:
+		++lexer->cursor;
+		if (yybm[0+(yych = *lexer->cursor)] & 16) {
+			goto yy49;
+		}
+#line 433 "src/ast-lexer.cc"
+		{ RETURN(MEMORY_FILL); }
+#line 6847 "src/prebuilt/ast-lexer-gen.cc"
 	}
 }
-#line 473 "src/ast-lexer.cc"
+#line 475 "src/ast-lexer.cc"
 
   }
 }
@@ -318,35 +318,37 @@ extern int wabt_ast_parser_debug;
     WABT_TOKEN_TYPE_UNREACHABLE = 298,
     WABT_TOKEN_TYPE_CURRENT_MEMORY = 299,
     WABT_TOKEN_TYPE_GROW_MEMORY = 300,
-    WABT_TOKEN_TYPE_FUNC = 301,
-    WABT_TOKEN_TYPE_START = 302,
-    WABT_TOKEN_TYPE_TYPE = 303,
-    WABT_TOKEN_TYPE_PARAM = 304,
-    WABT_TOKEN_TYPE_RESULT = 305,
-    WABT_TOKEN_TYPE_LOCAL = 306,
-    WABT_TOKEN_TYPE_GLOBAL = 307,
-    WABT_TOKEN_TYPE_MODULE = 308,
-    WABT_TOKEN_TYPE_TABLE = 309,
-    WABT_TOKEN_TYPE_ELEM = 310,
-    WABT_TOKEN_TYPE_MEMORY = 311,
-    WABT_TOKEN_TYPE_DATA = 312,
-    WABT_TOKEN_TYPE_OFFSET = 313,
-    WABT_TOKEN_TYPE_IMPORT = 314,
-    WABT_TOKEN_TYPE_EXPORT = 315,
-    WABT_TOKEN_TYPE_REGISTER = 316,
-    WABT_TOKEN_TYPE_INVOKE = 317,
-    WABT_TOKEN_TYPE_GET = 318,
-    WABT_TOKEN_TYPE_ASSERT_MALFORMED = 319,
-    WABT_TOKEN_TYPE_ASSERT_INVALID = 320,
-    WABT_TOKEN_TYPE_ASSERT_UNLINKABLE = 321,
-    WABT_TOKEN_TYPE_ASSERT_RETURN = 322,
-    WABT_TOKEN_TYPE_ASSERT_RETURN_CANONICAL_NAN = 323,
-    WABT_TOKEN_TYPE_ASSERT_RETURN_ARITHMETIC_NAN = 324,
-    WABT_TOKEN_TYPE_ASSERT_TRAP = 325,
-    WABT_TOKEN_TYPE_ASSERT_EXHAUSTION = 326,
-    WABT_TOKEN_TYPE_INPUT = 327,
-    WABT_TOKEN_TYPE_OUTPUT = 328,
-    WABT_TOKEN_TYPE_LOW = 329
+    WABT_TOKEN_TYPE_MEMORY_COPY = 301,
+    WABT_TOKEN_TYPE_MEMORY_FILL = 302,
+    WABT_TOKEN_TYPE_FUNC = 303,
+    WABT_TOKEN_TYPE_START = 304,
+    WABT_TOKEN_TYPE_TYPE = 305,
+    WABT_TOKEN_TYPE_PARAM = 306,
+    WABT_TOKEN_TYPE_RESULT = 307,
+    WABT_TOKEN_TYPE_LOCAL = 308,
+    WABT_TOKEN_TYPE_GLOBAL = 309,
+    WABT_TOKEN_TYPE_MODULE = 310,
+    WABT_TOKEN_TYPE_TABLE = 311,
+    WABT_TOKEN_TYPE_ELEM = 312,
+    WABT_TOKEN_TYPE_MEMORY = 313,
+    WABT_TOKEN_TYPE_DATA = 314,
+    WABT_TOKEN_TYPE_OFFSET = 315,
+    WABT_TOKEN_TYPE_IMPORT = 316,
+    WABT_TOKEN_TYPE_EXPORT = 317,
+    WABT_TOKEN_TYPE_REGISTER = 318,
+    WABT_TOKEN_TYPE_INVOKE = 319,
+    WABT_TOKEN_TYPE_GET = 320,
+    WABT_TOKEN_TYPE_ASSERT_MALFORMED = 321,
+    WABT_TOKEN_TYPE_ASSERT_INVALID = 322,
+    WABT_TOKEN_TYPE_ASSERT_UNLINKABLE = 323,
+    WABT_TOKEN_TYPE_ASSERT_RETURN = 324,
+    WABT_TOKEN_TYPE_ASSERT_RETURN_CANONICAL_NAN = 325,
+    WABT_TOKEN_TYPE_ASSERT_RETURN_ARITHMETIC_NAN = 326,
+    WABT_TOKEN_TYPE_ASSERT_TRAP = 327,
+    WABT_TOKEN_TYPE_ASSERT_EXHAUSTION = 328,
+    WABT_TOKEN_TYPE_INPUT = 329,
+    WABT_TOKEN_TYPE_OUTPUT = 330,
+    WABT_TOKEN_TYPE_LOW = 331
   };
 #endif
 
@@ -379,7 +381,7 @@ int wabt_ast_parser_parse (::wabt::AstLexer* lexer, ::wabt::AstParser* parser);
 
 /* Copy the second part of user declarations.  */
 
-#line 383 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:358  */
+#line 385 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -623,21 +625,21 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  10
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   797
+#define YYLAST   877
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  75
+#define YYNTOKENS  77
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  63
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  172
+#define YYNRULES  174
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  405
+#define YYNSTATES  407
 
 /* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
    by yylex, with out-of-bounds checking.  */
 #define YYUNDEFTOK  2
-#define YYMAXUTOK   329
+#define YYMAXUTOK   331
 
 #define YYTRANSLATE(YYX)                                                \
   ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
@@ -678,7 +680,8 @@ static const yytype_uint8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76
 };
 
 #if WABT_AST_PARSER_DEBUG
@@ -691,18 +694,18 @@ static const yytype_uint16 yyrline[] =
      453,   454,   457,   461,   462,   466,   467,   477,   478,   489,
      490,   491,   494,   497,   500,   503,   506,   509,   512,   515,
      518,   521,   524,   527,   530,   533,   536,   539,   542,   545,
-     558,   561,   564,   567,   570,   573,   578,   583,   588,   593,
-     601,   610,   614,   617,   622,   627,   637,   641,   645,   649,
-     653,   657,   664,   665,   673,   674,   682,   687,   688,   694,
-     700,   710,   716,   722,   732,   784,   794,   801,   809,   819,
-     822,   826,   833,   845,   853,   875,   882,   894,   902,   923,
-     945,   953,   966,   974,   982,   988,   994,  1002,  1007,  1015,
-    1023,  1029,  1035,  1044,  1052,  1057,  1062,  1067,  1074,  1081,
-    1085,  1088,  1100,  1105,  1114,  1118,  1121,  1128,  1137,  1154,
-    1171,  1181,  1187,  1193,  1199,  1232,  1242,  1262,  1273,  1301,
-    1306,  1314,  1324,  1334,  1340,  1346,  1352,  1358,  1364,  1369,
-    1374,  1380,  1389,  1394,  1395,  1400,  1409,  1410,  1417,  1429,
-    1430,  1437,  1503
+     558,   561,   564,   567,   570,   573,   576,   579,   584,   589,
+     594,   599,   607,   616,   620,   623,   628,   633,   643,   647,
+     651,   655,   659,   663,   670,   671,   679,   680,   688,   693,
+     694,   700,   706,   716,   722,   728,   738,   790,   800,   807,
+     815,   825,   828,   832,   839,   851,   859,   881,   888,   900,
+     908,   929,   951,   959,   972,   980,   988,   994,  1000,  1008,
+    1013,  1021,  1029,  1035,  1041,  1050,  1058,  1063,  1068,  1073,
+    1080,  1087,  1091,  1094,  1106,  1111,  1120,  1124,  1127,  1134,
+    1143,  1160,  1177,  1187,  1193,  1199,  1205,  1238,  1248,  1268,
+    1279,  1307,  1312,  1320,  1330,  1340,  1346,  1352,  1358,  1364,
+    1370,  1375,  1380,  1386,  1395,  1400,  1401,  1406,  1415,  1416,
+    1423,  1435,  1436,  1443,  1509
 };
 #endif
 
@@ -718,21 +721,21 @@ static const char *const yytname[] =
   "SET_LOCAL", "TEE_LOCAL", "GET_GLOBAL", "SET_GLOBAL", "LOAD", "STORE",
   "OFFSET_EQ_NAT", "ALIGN_EQ_NAT", "CONST", "UNARY", "BINARY", "COMPARE",
   "CONVERT", "SELECT", "UNREACHABLE", "CURRENT_MEMORY", "GROW_MEMORY",
-  "FUNC", "START", "TYPE", "PARAM", "RESULT", "LOCAL", "GLOBAL", "MODULE",
-  "TABLE", "ELEM", "MEMORY", "DATA", "OFFSET", "IMPORT", "EXPORT",
-  "REGISTER", "INVOKE", "GET", "ASSERT_MALFORMED", "ASSERT_INVALID",
-  "ASSERT_UNLINKABLE", "ASSERT_RETURN", "ASSERT_RETURN_CANONICAL_NAN",
-  "ASSERT_RETURN_ARITHMETIC_NAN", "ASSERT_TRAP", "ASSERT_EXHAUSTION",
-  "INPUT", "OUTPUT", "LOW", "$accept", "non_empty_text_list", "text_list",
-  "quoted_text", "value_type_list", "elem_type", "global_type",
-  "func_type", "func_sig", "table_sig", "memory_sig", "limits", "type_use",
-  "nat", "literal", "var", "var_list", "bind_var_opt", "bind_var",
-  "labeling_opt", "offset_opt", "align_opt", "instr", "plain_instr",
-  "block_instr", "block", "expr", "expr1", "if_", "instr_list",
-  "expr_list", "const_expr", "func_fields", "func_body", "func_info",
-  "func", "offset", "elem", "table", "data", "memory", "global",
-  "import_kind", "import", "inline_import", "export_kind", "export",
-  "inline_export_opt", "inline_export", "type_def", "start",
+  "MEMORY_COPY", "MEMORY_FILL", "FUNC", "START", "TYPE", "PARAM", "RESULT",
+  "LOCAL", "GLOBAL", "MODULE", "TABLE", "ELEM", "MEMORY", "DATA", "OFFSET",
+  "IMPORT", "EXPORT", "REGISTER", "INVOKE", "GET", "ASSERT_MALFORMED",
+  "ASSERT_INVALID", "ASSERT_UNLINKABLE", "ASSERT_RETURN",
+  "ASSERT_RETURN_CANONICAL_NAN", "ASSERT_RETURN_ARITHMETIC_NAN",
+  "ASSERT_TRAP", "ASSERT_EXHAUSTION", "INPUT", "OUTPUT", "LOW", "$accept",
+  "non_empty_text_list", "text_list", "quoted_text", "value_type_list",
+  "elem_type", "global_type", "func_type", "func_sig", "table_sig",
+  "memory_sig", "limits", "type_use", "nat", "literal", "var", "var_list",
+  "bind_var_opt", "bind_var", "labeling_opt", "offset_opt", "align_opt",
+  "instr", "plain_instr", "block_instr", "block", "expr", "expr1", "if_",
+  "instr_list", "expr_list", "const_expr", "func_fields", "func_body",
+  "func_info", "func", "offset", "elem", "table", "data", "memory",
+  "global", "import_kind", "import", "inline_import", "export_kind",
+  "export", "inline_export_opt", "inline_export", "type_def", "start",
   "module_fields", "raw_module", "module", "script_var_opt", "action",
   "assertion", "cmd", "cmd_list", "const", "const_list", "script",
   "script_start", YY_NULLPTR
@@ -751,14 +754,14 @@ static const yytype_uint16 yytoknum[] =
      295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
      305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
      315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327,   328,   329
+     325,   326,   327,   328,   329,   330,   331
 };
 # endif
 
-#define YYPACT_NINF -274
+#define YYPACT_NINF -282
 
 #define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-274)))
+  (!!((Yystate) == (-282)))
 
 #define YYTABLE_NINF -30
 
@@ -769,47 +772,47 @@ static const yytype_uint16 yytoknum[] =
      STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-    -274,    41,  -274,    46,    68,  -274,  -274,  -274,  -274,  -274,
-    -274,    60,    73,    82,    82,   121,   121,   121,   123,   123,
-     123,   142,   123,  -274,   166,  -274,  -274,    82,  -274,    73,
-      73,   128,    73,    73,    73,   104,  -274,   184,   205,     0,
-      73,    73,    73,  -274,   161,   221,   213,  -274,   243,   245,
-     254,   255,   228,  -274,  -274,   256,   263,   264,  -274,  -274,
-     116,  -274,  -274,  -274,  -274,  -274,  -274,  -274,  -274,  -274,
-    -274,  -274,  -274,   231,  -274,  -274,  -274,  -274,   153,  -274,
-    -274,  -274,  -274,  -274,    60,    98,    69,    60,    60,   111,
-      60,   111,    73,    73,  -274,   237,   408,  -274,  -274,  -274,
-     265,   224,   267,   204,    58,   270,   329,   271,  -274,  -274,
-     272,   271,   166,    73,   273,  -274,  -274,  -274,   275,   288,
-    -274,  -274,    60,    60,    60,    98,    98,  -274,    98,    98,
-    -274,    98,    98,    98,    98,    98,   242,   242,   237,  -274,
-    -274,  -274,  -274,  -274,  -274,  -274,  -274,   441,   474,  -274,
-    -274,  -274,  -274,  -274,  -274,   276,   278,   507,  -274,   279,
-    -274,   280,     6,  -274,   474,    89,    89,   186,   284,   114,
-    -274,    60,    60,    60,   474,   287,   289,  -274,   118,   170,
-     284,   284,   291,   166,   283,   292,   301,    34,   302,  -274,
-      98,    60,  -274,    60,    73,    73,  -274,  -274,  -274,  -274,
-    -274,  -274,    98,  -274,  -274,  -274,  -274,  -274,  -274,  -274,
-    -274,   247,   247,  -274,   612,   303,   752,  -274,  -274,   203,
-     309,   319,   573,   441,   320,   206,   330,  -274,   282,  -274,
-     331,   328,   337,   474,   341,   343,   284,  -274,   361,   371,
-    -274,  -274,  -274,   372,   287,  -274,  -274,   197,  -274,  -274,
-     166,   373,  -274,   376,   238,   377,  -274,    52,   378,    98,
-      98,    98,    98,  -274,   379,   173,   355,   174,   175,   369,
-      73,   380,   375,   370,    48,   384,   214,  -274,  -274,  -274,
-    -274,  -274,  -274,  -274,  -274,   387,  -274,  -274,   389,  -274,
-    -274,   390,  -274,  -274,  -274,   388,  -274,  -274,    99,  -274,
-    -274,  -274,  -274,   406,  -274,  -274,   166,  -274,    60,    60,
-      60,    60,  -274,   420,   422,   423,   429,  -274,   441,  -274,
-     453,   540,   540,   455,   456,  -274,  -274,    60,    60,    60,
-      60,   188,   189,  -274,  -274,  -274,  -274,   686,   463,  -274,
-     472,   486,   278,    89,   284,   284,  -274,  -274,  -274,  -274,
-    -274,   441,   651,  -274,  -274,   540,  -274,  -274,  -274,   474,
-    -274,   489,  -274,   217,   474,   719,   287,  -274,   495,   505,
-     519,   521,   522,   528,  -274,  -274,   477,   492,   552,   554,
-     474,  -274,  -274,  -274,  -274,  -274,  -274,  -274,    60,  -274,
-    -274,   556,   561,  -274,   193,   557,   572,  -274,   474,   570,
-     587,   474,  -274,   588,  -274
+    -282,    42,  -282,    70,    82,  -282,  -282,  -282,  -282,  -282,
+    -282,    46,    60,    69,    69,   116,   116,   116,   119,   119,
+     119,   131,   119,  -282,   151,  -282,  -282,    69,  -282,    60,
+      60,   121,    60,    60,    60,    79,  -282,   170,   182,    30,
+      60,    60,    60,  -282,    98,   153,   185,  -282,   189,   196,
+     198,   205,   233,  -282,  -282,   215,   235,   245,  -282,  -282,
+      67,  -282,  -282,  -282,  -282,  -282,  -282,  -282,  -282,  -282,
+    -282,  -282,  -282,   254,  -282,  -282,  -282,  -282,   218,  -282,
+    -282,  -282,  -282,  -282,    46,   122,    90,    46,    46,   162,
+      46,   162,    60,    60,  -282,   255,   426,  -282,  -282,  -282,
+     262,   159,   271,   273,    61,   274,   333,   275,  -282,  -282,
+     276,   275,   151,    60,   278,  -282,  -282,  -282,   279,   290,
+    -282,  -282,    46,    46,    46,   122,   122,  -282,   122,   122,
+    -282,   122,   122,   122,   122,   122,   247,   247,   255,  -282,
+    -282,  -282,  -282,  -282,  -282,  -282,  -282,  -282,  -282,   471,
+     516,  -282,  -282,  -282,  -282,  -282,  -282,   280,   282,   561,
+    -282,   283,  -282,   284,    21,  -282,   516,    64,    64,   203,
+     285,   155,  -282,    46,    46,    46,   516,   286,   287,  -282,
+     201,   192,   285,   285,   289,   151,   288,   291,   294,    -2,
+     302,  -282,   122,    46,  -282,    46,    60,    60,  -282,  -282,
+    -282,  -282,  -282,  -282,   122,  -282,  -282,  -282,  -282,  -282,
+    -282,  -282,  -282,   251,   251,  -282,   682,   304,   830,  -282,
+    -282,   181,   305,   311,   641,   471,   321,   221,   322,  -282,
+     328,  -282,   335,   281,   340,   516,   341,   338,   285,  -282,
+     295,   354,  -282,  -282,  -282,   364,   286,  -282,  -282,   219,
+    -282,  -282,   151,   365,  -282,   377,   323,   379,  -282,    55,
+     382,   122,   122,   122,   122,  -282,   383,   173,   375,   175,
+     177,   378,    60,   385,   381,   374,    88,   376,   216,  -282,
+    -282,  -282,  -282,  -282,  -282,  -282,  -282,   393,  -282,  -282,
+     395,  -282,  -282,   396,  -282,  -282,  -282,   237,  -282,  -282,
+      87,  -282,  -282,  -282,  -282,   402,  -282,  -282,   151,  -282,
+      46,    46,    46,    46,  -282,   412,   413,   427,   428,  -282,
+     471,  -282,   429,   606,   606,   430,   431,  -282,  -282,    46,
+      46,    46,    46,   184,   193,  -282,  -282,  -282,  -282,   760,
+     433,  -282,   434,   438,   282,    64,   285,   285,  -282,  -282,
+    -282,  -282,  -282,   471,   723,  -282,  -282,   606,  -282,  -282,
+    -282,   516,  -282,   441,  -282,   225,   516,   795,   286,  -282,
+     447,   457,   458,   472,   473,   474,  -282,  -282,   414,   423,
+     475,   476,   516,  -282,  -282,  -282,  -282,  -282,  -282,  -282,
+      46,  -282,  -282,   442,   477,  -282,   194,   418,   479,  -282,
+     516,   464,   483,   516,  -282,   485,  -282
 };
 
   /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -817,69 +820,69 @@ static const yytype_int16 yypact[] =
      means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-     166,   171,   172,     0,     0,   148,   164,   162,   163,   167,
-       1,    30,     0,   149,   149,     0,     0,     0,     0,     0,
-       0,     0,     0,    32,   135,    31,     6,   149,   150,     0,
-       0,     0,     0,     0,     0,     0,   169,     0,     0,     0,
-       0,     0,     0,     2,     0,     0,     0,   169,     0,     0,
-       0,     0,     0,   158,   159,     0,     0,     0,   147,     3,
-       0,   146,   140,   141,   138,   142,   139,   137,   144,   145,
-     136,   143,   165,     0,   152,   153,   154,   155,     0,   157,
-     170,   156,   160,   161,    30,     0,     0,    30,    30,     0,
-      30,     0,     0,     0,   151,     0,    82,    22,    27,    26,
-       0,     0,     0,     0,     0,   129,     0,     0,   100,    28,
-     129,     0,     4,     0,     0,    23,    24,    25,     0,     0,
+     168,   173,   174,     0,     0,   150,   166,   164,   165,   169,
+       1,    30,     0,   151,   151,     0,     0,     0,     0,     0,
+       0,     0,     0,    32,   137,    31,     6,   151,   152,     0,
+       0,     0,     0,     0,     0,     0,   171,     0,     0,     0,
+       0,     0,     0,     2,     0,     0,     0,   171,     0,     0,
+       0,     0,     0,   160,   161,     0,     0,     0,   149,     3,
+       0,   148,   142,   143,   140,   144,   141,   139,   146,   147,
+     138,   145,   167,     0,   154,   155,   156,   157,     0,   159,
+     172,   158,   162,   163,    30,     0,     0,    30,    30,     0,
+      30,     0,     0,     0,   153,     0,    84,    22,    27,    26,
+       0,     0,     0,     0,     0,   131,     0,     0,   102,    28,
+     131,     0,     4,     0,     0,    23,    24,    25,     0,     0,
       43,    44,    33,    33,    33,     0,     0,    28,     0,     0,
       49,     0,     0,     0,     0,     0,    35,    35,     0,    60,
-      61,    62,    63,    45,    42,    64,    65,    82,    82,    39,
-      40,    41,    91,    94,    87,     0,    13,    82,   134,    13,
-     132,     0,     0,    10,    82,     0,     0,     0,     0,     0,
-     130,    33,    33,    33,    82,    84,     0,    28,     0,     0,
-       0,     0,   130,     4,     5,     0,     0,     0,     0,   168,
-       0,     7,     7,     7,     0,     0,    34,     7,     7,     7,
-      46,    47,     0,    50,    51,    52,    53,    54,    55,    56,
-      36,    37,    37,    59,     0,     0,     0,    83,    98,     0,
-       0,     0,     0,    82,     0,     0,     0,   133,     0,    86,
-       0,     0,     0,    82,     0,     0,    19,     9,     0,     0,
-       7,     7,     7,     0,    84,    72,    71,     0,   102,    29,
-       4,     0,    18,     0,     0,     0,   106,     0,     0,     0,
-       0,     0,     0,   128,     0,     0,     0,     0,     0,     0,
-       0,     0,    82,     0,     0,     0,    48,    38,    57,    58,
-      96,     7,     7,   119,   118,     0,    97,    12,     0,   111,
-     122,     0,   120,    17,    20,     0,   103,    73,     0,    74,
-      99,    85,   101,     0,   121,   107,     4,   105,    30,    30,
-      30,    30,   117,     0,     0,     0,     0,    21,    82,     8,
-       0,    82,    82,     0,     0,   131,    70,    33,    33,    33,
-      33,     0,     0,    95,    11,   110,    28,     0,     0,    75,
-       0,     0,    13,     0,     0,     0,   124,   127,   125,   126,
-      89,    82,     0,    88,    92,    82,   123,    66,    68,    82,
-      67,    14,    16,     0,    82,     0,    81,   109,     0,     0,
-       0,     0,     0,     0,    90,    93,     0,     0,     0,     0,
-      82,    80,   108,   113,   112,   116,   114,   115,    33,     7,
-     104,    77,     0,    69,     0,     0,    79,    15,    82,     0,
-       0,    82,    76,     0,    78
+      61,    62,    63,    45,    42,    64,    65,    66,    67,    84,
+      84,    39,    40,    41,    93,    96,    89,     0,    13,    84,
+     136,    13,   134,     0,     0,    10,    84,     0,     0,     0,
+       0,     0,   132,    33,    33,    33,    84,    86,     0,    28,
+       0,     0,     0,     0,   132,     4,     5,     0,     0,     0,
+       0,   170,     0,     7,     7,     7,     0,     0,    34,     7,
+       7,     7,    46,    47,     0,    50,    51,    52,    53,    54,
+      55,    56,    36,    37,    37,    59,     0,     0,     0,    85,
+     100,     0,     0,     0,     0,    84,     0,     0,     0,   135,
+       0,    88,     0,     0,     0,    84,     0,     0,    19,     9,
+       0,     0,     7,     7,     7,     0,    86,    74,    73,     0,
+     104,    29,     4,     0,    18,     0,     0,     0,   108,     0,
+       0,     0,     0,     0,     0,   130,     0,     0,     0,     0,
+       0,     0,     0,     0,    84,     0,     0,     0,    48,    38,
+      57,    58,    98,     7,     7,   121,   120,     0,    99,    12,
+       0,   113,   124,     0,   122,    17,    20,     0,   105,    75,
+       0,    76,   101,    87,   103,     0,   123,   109,     4,   107,
+      30,    30,    30,    30,   119,     0,     0,     0,     0,    21,
+      84,     8,     0,    84,    84,     0,     0,   133,    72,    33,
+      33,    33,    33,     0,     0,    97,    11,   112,    28,     0,
+       0,    77,     0,     0,    13,     0,     0,     0,   126,   129,
+     127,   128,    91,    84,     0,    90,    94,    84,   125,    68,
+      70,    84,    69,    14,    16,     0,    84,     0,    83,   111,
+       0,     0,     0,     0,     0,     0,    92,    95,     0,     0,
+       0,     0,    84,    82,   110,   115,   114,   118,   116,   117,
+      33,     7,   106,    79,     0,    71,     0,     0,    81,    15,
+      84,     0,     0,    84,    78,     0,    80
 };
 
   /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -274,   574,  -156,    -8,  -181,   374,  -149,   516,  -146,  -155,
-    -150,  -145,  -151,  -140,   470,    26,  -118,   -45,   -11,  -116,
-     483,   416,  -274,  -104,  -274,  -147,   -88,  -274,  -274,  -144,
-     386,  -136,  -268,  -273,  -110,  -274,   -37,  -274,  -274,  -274,
-    -274,  -274,  -274,  -274,    39,  -274,  -274,   527,    43,  -274,
-    -274,  -274,   125,  -274,    44,   219,  -274,  -274,  -274,  -274,
-     584,  -274,  -274
+    -282,   466,  -147,    -5,  -183,   259,  -127,   403,  -148,  -145,
+    -167,  -152,  -154,  -120,   369,     7,  -118,   -70,   -11,  -116,
+     384,   306,  -282,  -104,  -282,  -158,   -88,  -282,  -282,  -144,
+     277,  -155,  -281,  -276,  -115,  -282,   -42,  -282,  -282,  -282,
+    -282,  -282,  -282,  -282,    65,  -282,  -282,   415,    68,  -282,
+    -282,  -282,   147,  -282,    39,   226,  -282,  -282,  -282,  -282,
+     480,  -282,  -282
 };
 
   /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,   184,   185,    27,   272,   238,   164,   102,   220,   234,
-     251,   235,   147,    99,   118,   249,   178,    24,   196,   197,
-     211,   278,   148,   149,   150,   273,   151,   176,   339,   152,
-     245,   230,   153,   154,   155,    62,   109,    63,    64,    65,
-      66,    67,   258,    68,   156,   188,    69,   169,   157,    70,
+      -1,   186,   187,    27,   274,   240,   166,   102,   222,   236,
+     253,   237,   149,    99,   118,   251,   180,    24,   198,   199,
+     213,   280,   150,   151,   152,   275,   153,   178,   341,   154,
+     247,   232,   155,   156,   157,    62,   109,    63,    64,    65,
+      66,    67,   260,    68,   158,   190,    69,   171,   159,    70,
       71,    45,     5,     6,    29,     7,     8,     9,     1,    80,
       52,     2,     3
 };
@@ -889,240 +892,256 @@ static const yytype_int16 yydefgoto[] =
      number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      25,   108,   175,   108,   217,   221,   223,   198,   199,   202,
-     265,   267,   268,   226,   239,   175,   232,   233,   228,   108,
-     229,    47,    48,   108,    49,    50,    51,   255,   236,   236,
-     229,   253,    55,    56,    57,   252,   252,   215,   243,    96,
-     236,   236,   104,   105,     4,   110,    10,   224,   353,   354,
-     350,   274,   275,    11,   112,   240,   241,   242,    30,   247,
-     298,   162,    13,    14,   328,   194,   195,   329,   163,    23,
-     177,    46,   101,    25,   183,   103,    25,    25,    23,    25,
-     259,    26,   375,   374,   113,   114,   260,   244,   261,   229,
-     262,    28,   231,   297,   303,   299,   294,   291,   308,   163,
-     331,   332,   337,    97,   309,   186,   310,    98,   311,   319,
-     175,   100,   175,   285,   106,   107,    97,   111,   175,    97,
-      98,    11,   248,    97,    31,   237,    35,    98,   326,    12,
-      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
-      32,    33,    34,   165,   168,    39,    40,   166,   170,   180,
-     341,   200,   201,   182,   203,   204,   244,   205,   206,   207,
-     208,   209,    84,    85,    86,    58,    13,    14,    87,    59,
-      88,    89,    90,    91,    43,    92,    93,   318,   321,   322,
-     266,    11,   269,   319,   319,   319,   270,   271,    53,   372,
-      95,   370,   361,   362,   371,   373,   369,   397,   319,   319,
-     252,   302,    97,   319,   236,   236,    98,   101,   394,    54,
-     338,   357,   358,   359,   360,   376,   264,    72,   363,   -29,
-     379,   378,    97,   -29,    60,    61,    98,   250,   276,   194,
-     195,    78,    79,   175,    78,    94,   392,    36,    37,    38,
-      41,    42,   115,   116,   117,   194,   195,    74,   175,    75,
-     366,   190,   281,   282,   400,   281,   282,   403,    76,    77,
-      81,   175,   324,   342,   343,   344,   345,    82,    83,   158,
-     159,   160,   393,   167,   106,   179,   187,   210,   381,   189,
-     218,   219,   225,   277,   227,   313,   314,   315,   316,    97,
-     216,    59,   288,   246,   254,   306,   256,    25,    25,    25,
-      25,   120,   121,   171,   257,   172,   263,   280,   173,   125,
-     126,   127,   128,   283,   129,   130,   131,   132,   133,   134,
-     135,   136,   137,   284,   286,   138,   139,   140,   141,   142,
-     143,   144,   145,   146,   287,   289,   190,   191,   192,   193,
-     228,   290,   120,   121,   171,   292,   172,   194,   195,   173,
-     125,   126,   127,   128,   237,   129,   130,   131,   132,   133,
-     134,   135,   136,   137,   295,   320,   138,   139,   140,   141,
-     142,   143,   144,   145,   146,   296,   300,   304,   216,   323,
-     305,   307,   312,   317,   325,   319,   327,   174,   120,   121,
-     122,   333,   123,   334,   335,   124,   125,   126,   127,   128,
-     330,   129,   130,   131,   132,   133,   134,   135,   136,   137,
-     340,   119,   138,   139,   140,   141,   142,   143,   144,   145,
-     146,   120,   121,   122,   346,   123,   347,   348,   124,   125,
-     126,   127,   128,   349,   129,   130,   131,   132,   133,   134,
-     135,   136,   137,   336,   214,   138,   139,   140,   141,   142,
-     143,   144,   145,   146,   120,   121,   122,   351,   123,   355,
-     356,   124,   125,   126,   127,   128,   365,   129,   130,   131,
-     132,   133,   134,   135,   136,   137,   367,   216,   138,   139,
-     140,   141,   142,   143,   144,   145,   146,   120,   121,   122,
-     368,   123,   377,   388,   124,   125,   126,   127,   128,   382,
-     129,   130,   131,   132,   133,   134,   135,   136,   137,   383,
-     222,   138,   139,   140,   141,   142,   143,   144,   145,   146,
-     120,   121,   122,   384,   123,   385,   386,   124,   125,   126,
-     127,   128,   387,   129,   130,   131,   132,   133,   134,   135,
-     136,   137,   389,   352,   138,   139,   140,   141,   142,   143,
-     144,   145,   146,   120,   121,   122,   390,   123,   391,   395,
-     124,   125,   126,   127,   128,   396,   129,   130,   131,   132,
-     133,   134,   135,   136,   137,   399,   398,   138,   139,   140,
-     141,   142,   143,   144,   145,   146,   120,   121,   171,   401,
-     172,   402,   404,   173,   125,   126,   127,   128,    44,   129,
-     130,   131,   132,   133,   134,   135,   136,   137,   213,   293,
-     138,   139,   140,   141,   142,   143,   144,   145,   146,   161,
-     212,   190,   191,   192,   193,   120,   121,   171,   279,   172,
-     301,    73,   173,   125,   126,   127,   128,   181,   129,   130,
-     131,   132,   133,   134,   135,   136,   137,     0,     0,   138,
-     139,   140,   141,   142,   143,   144,   145,   146,     0,     0,
-       0,   191,   192,   193,   120,   121,   171,     0,   172,     0,
-       0,   173,   125,   126,   127,   128,     0,   129,   130,   131,
+      25,   108,   177,   108,   223,   225,   219,   200,   201,   204,
+     267,   269,   270,   228,    96,   177,   255,   104,   105,   108,
+     110,   245,   231,   108,    47,    48,   241,    49,    50,    51,
+     254,   254,   231,   230,   217,    55,    56,    57,   257,   352,
+     234,   235,   276,   277,   226,     4,   261,   355,   356,   112,
+     238,   238,   262,    30,   263,    23,   264,   242,   243,   244,
+     300,   249,   238,   238,   164,   179,    46,   233,    26,   185,
+      10,   165,   376,    25,   165,   103,    25,    25,    28,    25,
+     293,   377,   196,   197,   299,    11,   301,   113,   114,   246,
+     339,   231,   100,   101,    13,    14,   107,   321,   111,    23,
+     333,   334,    58,   310,   330,   305,    59,   331,   188,   311,
+     287,   312,   177,   313,   177,    84,    85,    86,   296,    31,
+     177,    87,    35,    88,    89,    90,    91,    97,    92,    93,
+     328,    98,   202,   203,    39,   205,   206,    11,   207,   208,
+     209,   210,   211,    13,    14,    12,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    60,    61,   246,    43,
+      97,   343,    32,    33,    34,   106,   239,    97,    40,   167,
+     170,    98,   168,   172,    53,   182,    11,   320,   184,   323,
+     375,   324,   268,   321,   271,   321,    54,   321,   363,    72,
+     372,   272,   273,    74,   321,   254,   371,   364,   399,   266,
+      75,   374,    76,   321,   321,   250,    97,   161,   396,    77,
+      98,   278,   340,   359,   360,   361,   362,   378,   373,    81,
+     365,   -29,   381,   304,    97,   -29,   238,   238,    98,   380,
+      97,   192,   283,   284,    98,   177,    78,    79,   394,    82,
+     344,   345,   346,   347,    36,    37,    38,    41,    42,    83,
+     177,   252,   368,   196,   197,    95,   402,    78,    94,   405,
+     115,   116,   117,   177,   196,   197,   160,   326,   315,   316,
+     317,   318,   283,   284,   395,   162,   101,   169,   106,   181,
+     383,   189,   212,   191,   220,   221,   227,   279,   229,   218,
+      97,   248,   256,   230,   338,   258,    59,   259,   297,    25,
+      25,    25,    25,   120,   121,   173,   265,   174,   282,   285,
+     175,   125,   126,   127,   128,   286,   129,   130,   131,   132,
+     133,   134,   135,   136,   137,   288,   289,   138,   139,   140,
+     141,   142,   143,   144,   145,   146,   147,   148,   290,   291,
+     192,   193,   194,   195,   292,   294,   120,   121,   173,   239,
+     174,   196,   197,   175,   125,   126,   127,   128,   298,   129,
+     130,   131,   132,   133,   134,   135,   136,   137,   302,   306,
+     138,   139,   140,   141,   142,   143,   144,   145,   146,   147,
+     148,   307,   308,   309,   218,   322,   314,   319,   325,   327,
+     329,   321,   332,   176,   120,   121,   122,   335,   123,   336,
+     337,   124,   125,   126,   127,   128,   342,   129,   130,   131,
+     132,   133,   134,   135,   136,   137,   348,   349,   138,   139,
+     140,   141,   142,   143,   144,   145,   146,   147,   148,   119,
+     390,   350,   351,   353,   357,   358,   367,   400,   369,   120,
+     121,   122,   370,   123,   379,   397,   124,   125,   126,   127,
+     128,   384,   129,   130,   131,   132,   133,   134,   135,   136,
+     137,   385,   386,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,   147,   148,   216,   391,   387,   388,   389,   392,
+     393,   398,   401,   403,   120,   121,   122,   404,   123,   406,
+      44,   124,   125,   126,   127,   128,   295,   129,   130,   131,
+     132,   133,   134,   135,   136,   137,   163,   215,   138,   139,
+     140,   141,   142,   143,   144,   145,   146,   147,   148,   218,
+     281,   214,     0,   303,     0,   183,     0,    73,     0,   120,
+     121,   122,     0,   123,     0,     0,   124,   125,   126,   127,
+     128,     0,   129,   130,   131,   132,   133,   134,   135,   136,
+     137,     0,     0,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,   147,   148,   224,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   120,   121,   122,     0,   123,     0,
+       0,   124,   125,   126,   127,   128,     0,   129,   130,   131,
      132,   133,   134,   135,   136,   137,     0,     0,   138,   139,
-     140,   141,   142,   143,   144,   145,   146,     0,     0,   120,
-     121,   171,   193,   172,   364,     0,   173,   125,   126,   127,
+     140,   141,   142,   143,   144,   145,   146,   147,   148,   354,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   120,
+     121,   122,     0,   123,     0,     0,   124,   125,   126,   127,
      128,     0,   129,   130,   131,   132,   133,   134,   135,   136,
      137,     0,     0,   138,   139,   140,   141,   142,   143,   144,
-     145,   146,   120,   121,   171,     0,   172,   380,     0,   173,
-     125,   126,   127,   128,     0,   129,   130,   131,   132,   133,
-     134,   135,   136,   137,     0,     0,   138,   139,   140,   141,
-     142,   143,   144,   145,   146,   120,   121,   171,     0,   172,
-       0,     0,   173,   125,   126,   127,   128,     0,   129,   130,
+     145,   146,   147,   148,   120,   121,   173,     0,   174,     0,
+       0,   175,   125,   126,   127,   128,     0,   129,   130,   131,
+     132,   133,   134,   135,   136,   137,     0,     0,   138,   139,
+     140,   141,   142,   143,   144,   145,   146,   147,   148,     0,
+       0,   192,   193,   194,   195,   120,   121,   173,     0,   174,
+       0,     0,   175,   125,   126,   127,   128,     0,   129,   130,
      131,   132,   133,   134,   135,   136,   137,     0,     0,   138,
-     139,   140,   141,   142,   143,   144,   145,   146
+     139,   140,   141,   142,   143,   144,   145,   146,   147,   148,
+       0,     0,     0,   193,   194,   195,   120,   121,   173,     0,
+     174,     0,     0,   175,   125,   126,   127,   128,     0,   129,
+     130,   131,   132,   133,   134,   135,   136,   137,     0,     0,
+     138,   139,   140,   141,   142,   143,   144,   145,   146,   147,
+     148,     0,     0,   120,   121,   173,   195,   174,   366,     0,
+     175,   125,   126,   127,   128,     0,   129,   130,   131,   132,
+     133,   134,   135,   136,   137,     0,     0,   138,   139,   140,
+     141,   142,   143,   144,   145,   146,   147,   148,   120,   121,
+     173,     0,   174,   382,     0,   175,   125,   126,   127,   128,
+       0,   129,   130,   131,   132,   133,   134,   135,   136,   137,
+       0,     0,   138,   139,   140,   141,   142,   143,   144,   145,
+     146,   147,   148,   120,   121,   173,     0,   174,     0,     0,
+     175,   125,   126,   127,   128,     0,   129,   130,   131,   132,
+     133,   134,   135,   136,   137,     0,     0,   138,   139,   140,
+     141,   142,   143,   144,   145,   146,   147,   148
 };
 
 static const yytype_int16 yycheck[] =
 {
-      11,    89,   106,    91,   148,   156,   157,   123,   124,   127,
-     191,   192,   193,   159,   169,   119,   165,   166,    12,   107,
-     164,    29,    30,   111,    32,    33,    34,   183,   168,   169,
-     174,   181,    40,    41,    42,   180,   181,   147,   174,    84,
-     180,   181,    87,    88,     3,    90,     0,   157,   321,   322,
-     318,   198,   199,    53,    91,   171,   172,   173,    14,   177,
-     241,     3,    62,    63,    16,    59,    60,    19,    10,     9,
-     107,    27,     3,    84,   111,    86,    87,    88,     9,    90,
-      46,     8,   355,   351,    92,    93,    52,   175,    54,   233,
-      56,     9,     3,   240,   250,   242,   236,   233,    46,    10,
-     281,   282,     3,     5,    52,   113,    54,     9,    56,    10,
-     214,    85,   216,   223,     3,    89,     5,    91,   222,     5,
-       9,    53,     4,     5,     3,    11,     3,     9,   272,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
-      15,    16,    17,   104,   105,     3,    21,   104,   105,   110,
-     306,   125,   126,   110,   128,   129,   244,   131,   132,   133,
-     134,   135,    46,    47,    48,     4,    62,    63,    52,     8,
-      54,    55,    56,    57,     8,    59,    60,     4,     4,     4,
-     191,    53,   193,    10,    10,    10,   194,   195,     4,   344,
-      37,   342,     4,     4,   343,   345,   342,     4,    10,    10,
-     345,     4,     5,    10,   344,   345,     9,     3,   389,     4,
-     298,   327,   328,   329,   330,   359,   190,     4,   336,     5,
-     364,     4,     5,     9,     3,     4,     9,    57,   202,    59,
-      60,     3,     4,   337,     3,     4,   380,    18,    19,    20,
-      21,    22,     5,     6,     7,    59,    60,     4,   352,     4,
-     338,    48,    49,    50,   398,    49,    50,   401,     4,     4,
-       4,   365,   270,   308,   309,   310,   311,     4,     4,     4,
-      46,     4,   388,     3,     3,     3,     3,    35,   366,     4,
-       4,     3,     3,    36,     4,   259,   260,   261,   262,     5,
-       3,     8,    10,     4,     3,    57,     4,   308,   309,   310,
-     311,    13,    14,    15,     3,    17,     4,     4,    20,    21,
-      22,    23,    24,     4,    26,    27,    28,    29,    30,    31,
-      32,    33,    34,     4,     4,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,     4,     4,    48,    49,    50,    51,
-      12,     4,    13,    14,    15,     4,    17,    59,    60,    20,
-      21,    22,    23,    24,    11,    26,    27,    28,    29,    30,
-      31,    32,    33,    34,     3,    10,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,     4,     4,     4,     3,    10,
-       4,     4,     4,     4,     4,    10,    16,    58,    13,    14,
-      15,     4,    17,     4,     4,    20,    21,    22,    23,    24,
-      16,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-       4,     3,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    13,    14,    15,     4,    17,     4,     4,    20,    21,
-      22,    23,    24,     4,    26,    27,    28,    29,    30,    31,
-      32,    33,    34,    55,     3,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,    13,    14,    15,     4,    17,     4,
-       4,    20,    21,    22,    23,    24,     3,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,     4,     3,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    13,    14,    15,
-       4,    17,     3,    16,    20,    21,    22,    23,    24,     4,
-      26,    27,    28,    29,    30,    31,    32,    33,    34,     4,
-       3,    37,    38,    39,    40,    41,    42,    43,    44,    45,
-      13,    14,    15,     4,    17,     4,     4,    20,    21,    22,
-      23,    24,     4,    26,    27,    28,    29,    30,    31,    32,
-      33,    34,    50,     3,    37,    38,    39,    40,    41,    42,
-      43,    44,    45,    13,    14,    15,     4,    17,     4,     3,
+      11,    89,   106,    91,   158,   159,   150,   123,   124,   127,
+     193,   194,   195,   161,    84,   119,   183,    87,    88,   107,
+      90,   176,   166,   111,    29,    30,   171,    32,    33,    34,
+     182,   183,   176,    12,   149,    40,    41,    42,   185,   320,
+     167,   168,   200,   201,   159,     3,    48,   323,   324,    91,
+     170,   171,    54,    14,    56,     9,    58,   173,   174,   175,
+     243,   179,   182,   183,     3,   107,    27,     3,     8,   111,
+       0,    10,   353,    84,    10,    86,    87,    88,     9,    90,
+     235,   357,    61,    62,   242,    55,   244,    92,    93,   177,
+       3,   235,    85,     3,    64,    65,    89,    10,    91,     9,
+     283,   284,     4,    48,    16,   252,     8,    19,   113,    54,
+     225,    56,   216,    58,   218,    48,    49,    50,   238,     3,
+     224,    54,     3,    56,    57,    58,    59,     5,    61,    62,
+     274,     9,   125,   126,     3,   128,   129,    55,   131,   132,
+     133,   134,   135,    64,    65,    63,    64,    65,    66,    67,
+      68,    69,    70,    71,    72,    73,     3,     4,   246,     8,
+       5,   308,    15,    16,    17,     3,    11,     5,    21,   104,
+     105,     9,   104,   105,     4,   110,    55,     4,   110,     4,
+     347,     4,   193,    10,   195,    10,     4,    10,     4,     4,
+     344,   196,   197,     4,    10,   347,   344,     4,     4,   192,
+       4,   346,     4,    10,    10,     4,     5,    48,   391,     4,
+       9,   204,   300,   329,   330,   331,   332,   361,   345,     4,
+     338,     5,   366,     4,     5,     9,   346,   347,     9,     4,
+       5,    50,    51,    52,     9,   339,     3,     4,   382,     4,
+     310,   311,   312,   313,    18,    19,    20,    21,    22,     4,
+     354,    59,   340,    61,    62,    37,   400,     3,     4,   403,
+       5,     6,     7,   367,    61,    62,     4,   272,   261,   262,
+     263,   264,    51,    52,   390,     4,     3,     3,     3,     3,
+     368,     3,    35,     4,     4,     3,     3,    36,     4,     3,
+       5,     4,     3,    12,    57,     4,     8,     3,     3,   310,
+     311,   312,   313,    13,    14,    15,     4,    17,     4,     4,
       20,    21,    22,    23,    24,     4,    26,    27,    28,    29,
-      30,    31,    32,    33,    34,     3,    19,    37,    38,    39,
-      40,    41,    42,    43,    44,    45,    13,    14,    15,    19,
-      17,     4,     4,    20,    21,    22,    23,    24,    24,    26,
-      27,    28,    29,    30,    31,    32,    33,    34,   138,   235,
-      37,    38,    39,    40,    41,    42,    43,    44,    45,   103,
-     137,    48,    49,    50,    51,    13,    14,    15,   212,    17,
-     244,    47,    20,    21,    22,    23,    24,   110,    26,    27,
-      28,    29,    30,    31,    32,    33,    34,    -1,    -1,    37,
-      38,    39,    40,    41,    42,    43,    44,    45,    -1,    -1,
-      -1,    49,    50,    51,    13,    14,    15,    -1,    17,    -1,
+      30,    31,    32,    33,    34,     4,     4,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    10,     4,
+      50,    51,    52,    53,     4,     4,    13,    14,    15,    11,
+      17,    61,    62,    20,    21,    22,    23,    24,     4,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,     4,     4,
+      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
+      47,     4,    59,     4,     3,    10,     4,     4,    10,     4,
+      16,    10,    16,    60,    13,    14,    15,     4,    17,     4,
+       4,    20,    21,    22,    23,    24,     4,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,     4,     4,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,     3,
+      16,     4,     4,     4,     4,     4,     3,    19,     4,    13,
+      14,    15,     4,    17,     3,     3,    20,    21,    22,    23,
+      24,     4,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,     4,     4,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,     3,    52,     4,     4,     4,     4,
+       4,     4,     3,    19,    13,    14,    15,     4,    17,     4,
+      24,    20,    21,    22,    23,    24,   237,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,   103,   138,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,     3,
+     214,   137,    -1,   246,    -1,   110,    -1,    47,    -1,    13,
+      14,    15,    -1,    17,    -1,    -1,    20,    21,    22,    23,
+      24,    -1,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,    -1,    -1,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,     3,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    13,    14,    15,    -1,    17,    -1,
       -1,    20,    21,    22,    23,    24,    -1,    26,    27,    28,
       29,    30,    31,    32,    33,    34,    -1,    -1,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    -1,    -1,    13,
-      14,    15,    51,    17,    18,    -1,    20,    21,    22,    23,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,     3,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    13,
+      14,    15,    -1,    17,    -1,    -1,    20,    21,    22,    23,
       24,    -1,    26,    27,    28,    29,    30,    31,    32,    33,
       34,    -1,    -1,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    13,    14,    15,    -1,    17,    18,    -1,    20,
-      21,    22,    23,    24,    -1,    26,    27,    28,    29,    30,
-      31,    32,    33,    34,    -1,    -1,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,    13,    14,    15,    -1,    17,
+      44,    45,    46,    47,    13,    14,    15,    -1,    17,    -1,
+      -1,    20,    21,    22,    23,    24,    -1,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    -1,    -1,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    -1,
+      -1,    50,    51,    52,    53,    13,    14,    15,    -1,    17,
       -1,    -1,    20,    21,    22,    23,    24,    -1,    26,    27,
       28,    29,    30,    31,    32,    33,    34,    -1,    -1,    37,
-      38,    39,    40,    41,    42,    43,    44,    45
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
+      -1,    -1,    -1,    51,    52,    53,    13,    14,    15,    -1,
+      17,    -1,    -1,    20,    21,    22,    23,    24,    -1,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,    -1,    -1,
+      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
+      47,    -1,    -1,    13,    14,    15,    53,    17,    18,    -1,
+      20,    21,    22,    23,    24,    -1,    26,    27,    28,    29,
+      30,    31,    32,    33,    34,    -1,    -1,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    13,    14,
+      15,    -1,    17,    18,    -1,    20,    21,    22,    23,    24,
+      -1,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      -1,    -1,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    13,    14,    15,    -1,    17,    -1,    -1,
+      20,    21,    22,    23,    24,    -1,    26,    27,    28,    29,
+      30,    31,    32,    33,    34,    -1,    -1,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47
 };
 
   /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
      symbol of state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
-       0,   133,   136,   137,     3,   127,   128,   130,   131,   132,
-       0,    53,    61,    62,    63,    64,    65,    66,    67,    68,
-      69,    70,    71,     9,    92,    93,     8,    78,     9,   129,
-     129,     3,   127,   127,   127,     3,   130,   130,   130,     3,
-     127,   130,   130,     8,    76,   126,   129,    78,    78,    78,
-      78,    78,   135,     4,     4,    78,    78,    78,     4,     8,
-       3,     4,   110,   112,   113,   114,   115,   116,   118,   121,
-     124,   125,     4,   135,     4,     4,     4,     4,     3,     4,
-     134,     4,     4,     4,    46,    47,    48,    52,    54,    55,
-      56,    57,    59,    60,     4,    37,    92,     5,     9,    88,
-      90,     3,    82,    93,    92,    92,     3,    90,   101,   111,
-      92,    90,   111,    78,    78,     5,     6,     7,    89,     3,
+       0,   135,   138,   139,     3,   129,   130,   132,   133,   134,
+       0,    55,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,     9,    94,    95,     8,    80,     9,   131,
+     131,     3,   129,   129,   129,     3,   132,   132,   132,     3,
+     129,   132,   132,     8,    78,   128,   131,    80,    80,    80,
+      80,    80,   137,     4,     4,    80,    80,    80,     4,     8,
+       3,     4,   112,   114,   115,   116,   117,   118,   120,   123,
+     126,   127,     4,   137,     4,     4,     4,     4,     3,     4,
+     136,     4,     4,     4,    48,    49,    50,    54,    56,    57,
+      58,    59,    61,    62,     4,    37,    94,     5,     9,    90,
+      92,     3,    84,    95,    94,    94,     3,    92,   103,   113,
+      94,    92,   113,    80,    80,     5,     6,     7,    91,     3,
       13,    14,    15,    17,    20,    21,    22,    23,    24,    26,
       27,    28,    29,    30,    31,    32,    33,    34,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    87,    97,    98,
-      99,   101,   104,   107,   108,   109,   119,   123,     4,    46,
-       4,    82,     3,    10,    81,   119,   123,     3,   119,   122,
-     123,    15,    17,    20,    58,    98,   102,   111,    91,     3,
-     119,   122,   123,   111,    76,    77,    78,     3,   120,     4,
-      48,    49,    50,    51,    59,    60,    93,    94,    94,    94,
-      90,    90,    91,    90,    90,    90,    90,    90,    90,    90,
-      35,    95,    95,    89,     3,   109,     3,   104,     4,     3,
-      83,    87,     3,    87,   109,     3,    83,     4,    12,   104,
-     106,     3,    81,    81,    84,    86,    88,    11,    80,    84,
-      94,    94,    94,   106,   101,   105,     4,    91,     4,    90,
-      57,    85,    86,    85,     3,    77,     4,     3,   117,    46,
-      52,    54,    56,     4,    90,    79,    93,    79,    79,    93,
-      78,    78,    79,   100,   100,   100,    90,    36,    96,    96,
-       4,    49,    50,     4,     4,   109,     4,     4,    10,     4,
-       4,   106,     4,    80,    88,     3,     4,   100,    79,   100,
-       4,   105,     4,    77,     4,     4,    57,     4,    46,    52,
-      54,    56,     4,    90,    90,    90,    90,     4,     4,    10,
-      10,     4,     4,    10,    78,     4,   104,    16,    16,    19,
-      16,    79,    79,     4,     4,     4,    55,     3,   101,   103,
-       4,    77,    92,    92,    92,    92,     4,     4,     4,     4,
-     107,     4,     3,   108,   108,     4,     4,    94,    94,    94,
-      94,     4,     4,    91,    18,     3,   101,     4,     4,    83,
-      87,    81,    84,    85,   107,   108,   104,     3,     4,   104,
-      18,   101,     4,     4,     4,     4,     4,     4,    16,    50,
-       4,     4,   104,    94,    79,     3,     4,     4,    19,     3,
-     104,    19,     4,   104,     4
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    89,
+      99,   100,   101,   103,   106,   109,   110,   111,   121,   125,
+       4,    48,     4,    84,     3,    10,    83,   121,   125,     3,
+     121,   124,   125,    15,    17,    20,    60,   100,   104,   113,
+      93,     3,   121,   124,   125,   113,    78,    79,    80,     3,
+     122,     4,    50,    51,    52,    53,    61,    62,    95,    96,
+      96,    96,    92,    92,    93,    92,    92,    92,    92,    92,
+      92,    92,    35,    97,    97,    91,     3,   111,     3,   106,
+       4,     3,    85,    89,     3,    89,   111,     3,    85,     4,
+      12,   106,   108,     3,    83,    83,    86,    88,    90,    11,
+      82,    86,    96,    96,    96,   108,   103,   107,     4,    93,
+       4,    92,    59,    87,    88,    87,     3,    79,     4,     3,
+     119,    48,    54,    56,    58,     4,    92,    81,    95,    81,
+      81,    95,    80,    80,    81,   102,   102,   102,    92,    36,
+      98,    98,     4,    51,    52,     4,     4,   111,     4,     4,
+      10,     4,     4,   108,     4,    82,    90,     3,     4,   102,
+      81,   102,     4,   107,     4,    79,     4,     4,    59,     4,
+      48,    54,    56,    58,     4,    92,    92,    92,    92,     4,
+       4,    10,    10,     4,     4,    10,    80,     4,   106,    16,
+      16,    19,    16,    81,    81,     4,     4,     4,    57,     3,
+     103,   105,     4,    79,    94,    94,    94,    94,     4,     4,
+       4,     4,   109,     4,     3,   110,   110,     4,     4,    96,
+      96,    96,    96,     4,     4,    93,    18,     3,   103,     4,
+       4,    85,    89,    83,    86,    87,   109,   110,   106,     3,
+       4,   106,    18,   103,     4,     4,     4,     4,     4,     4,
+      16,    52,     4,     4,   106,    96,    81,     3,     4,     4,
+      19,     3,   106,    19,     4,   106,     4
 };
 
   /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    75,    76,    76,    77,    77,    78,    79,    79,    80,
-      81,    81,    82,    83,    83,    83,    83,    84,    85,    86,
-      86,    87,    88,    89,    89,    89,    90,    90,    91,    91,
-      92,    92,    93,    94,    94,    95,    95,    96,    96,    97,
-      97,    97,    98,    98,    98,    98,    98,    98,    98,    98,
-      98,    98,    98,    98,    98,    98,    98,    98,    98,    98,
-      98,    98,    98,    98,    98,    98,    99,    99,    99,    99,
-     100,   101,   102,   102,   102,   102,   103,   103,   103,   103,
-     103,   103,   104,   104,   105,   105,   106,   107,   107,   107,
-     107,   108,   108,   108,   109,   110,   110,   110,   110,   111,
-     111,   112,   112,   113,   113,   114,   114,   115,   115,   115,
-     116,   116,   117,   117,   117,   117,   117,   118,   118,   118,
-     118,   118,   118,   119,   120,   120,   120,   120,   121,   122,
-     122,   123,   124,   124,   125,   126,   126,   126,   126,   126,
-     126,   126,   126,   126,   126,   126,   127,   127,   128,   129,
-     129,   130,   130,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   132,   132,   132,   132,   133,   133,   134,   135,
-     135,   136,   137
+       0,    77,    78,    78,    79,    79,    80,    81,    81,    82,
+      83,    83,    84,    85,    85,    85,    85,    86,    87,    88,
+      88,    89,    90,    91,    91,    91,    92,    92,    93,    93,
+      94,    94,    95,    96,    96,    97,    97,    98,    98,    99,
+      99,    99,   100,   100,   100,   100,   100,   100,   100,   100,
+     100,   100,   100,   100,   100,   100,   100,   100,   100,   100,
+     100,   100,   100,   100,   100,   100,   100,   100,   101,   101,
+     101,   101,   102,   103,   104,   104,   104,   104,   105,   105,
+     105,   105,   105,   105,   106,   106,   107,   107,   108,   109,
+     109,   109,   109,   110,   110,   110,   111,   112,   112,   112,
+     112,   113,   113,   114,   114,   115,   115,   116,   116,   117,
+     117,   117,   118,   118,   119,   119,   119,   119,   119,   120,
+     120,   120,   120,   120,   120,   121,   122,   122,   122,   122,
+     123,   124,   124,   125,   126,   126,   127,   128,   128,   128,
+     128,   128,   128,   128,   128,   128,   128,   128,   129,   129,
+     130,   131,   131,   132,   132,   133,   133,   133,   133,   133,
+     133,   133,   133,   133,   134,   134,   134,   134,   135,   135,
+     136,   137,   137,   138,   139
 };
 
   /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
@@ -1134,18 +1153,18 @@ static const yytype_uint8 yyr2[] =
        0,     1,     1,     0,     1,     0,     1,     0,     1,     1,
        1,     1,     1,     1,     1,     1,     2,     2,     3,     1,
        2,     2,     2,     2,     2,     2,     2,     3,     3,     2,
-       1,     1,     1,     1,     1,     1,     5,     5,     5,     8,
-       2,     3,     2,     3,     3,     4,     8,     4,     9,     5,
-       3,     2,     0,     2,     0,     2,     1,     1,     5,     5,
-       6,     1,     5,     6,     1,     7,     6,     6,     5,     4,
-       1,     6,     5,     6,    10,     6,     5,     6,     9,     8,
-       7,     6,     5,     5,     5,     5,     5,     6,     6,     6,
-       6,     6,     6,     5,     4,     4,     4,     4,     5,     0,
-       1,     4,     4,     5,     4,     0,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     5,     5,     1,     0,
-       1,     6,     5,     5,     5,     5,     5,     5,     4,     4,
-       5,     5,     1,     1,     1,     5,     0,     2,     4,     0,
-       2,     1,     1
+       1,     1,     1,     1,     1,     1,     1,     1,     5,     5,
+       5,     8,     2,     3,     2,     3,     3,     4,     8,     4,
+       9,     5,     3,     2,     0,     2,     0,     2,     1,     1,
+       5,     5,     6,     1,     5,     6,     1,     7,     6,     6,
+       5,     4,     1,     6,     5,     6,    10,     6,     5,     6,
+       9,     8,     7,     6,     5,     5,     5,     5,     5,     6,
+       6,     6,     6,     6,     6,     5,     4,     4,     4,     4,
+       5,     0,     1,     4,     4,     5,     4,     0,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     5,     5,
+       1,     0,     1,     6,     5,     5,     5,     5,     5,     5,
+       4,     4,     5,     5,     1,     1,     1,     5,     0,     2,
+       4,     0,     2,     1,     1
 };
 
 
@@ -1644,361 +1663,361 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
           case 5: /* NAT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1648 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1667 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 6: /* INT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1654 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1673 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 7: /* FLOAT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1660 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1679 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 8: /* TEXT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1666 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1685 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 9: /* VAR  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1672 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1691 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 35: /* OFFSET_EQ_NAT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1678 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1697 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
     case 36: /* ALIGN_EQ_NAT  */
 #line 250 "src/ast-parser.y" /* yacc.c:1257  */
       {}
-#line 1684 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1703 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 76: /* non_empty_text_list  */
+    case 78: /* non_empty_text_list  */
 #line 277 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_text_list(&((*yyvaluep).text_list)); }
-#line 1690 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1709 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 77: /* text_list  */
+    case 79: /* text_list  */
 #line 277 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_text_list(&((*yyvaluep).text_list)); }
-#line 1696 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1715 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 78: /* quoted_text  */
+    case 80: /* quoted_text  */
 #line 251 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_string_slice(&((*yyvaluep).text)); }
-#line 1702 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1721 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 79: /* value_type_list  */
+    case 81: /* value_type_list  */
 #line 278 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).types); }
-#line 1708 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1727 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 81: /* global_type  */
+    case 83: /* global_type  */
 #line 270 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).global); }
-#line 1714 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1733 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 82: /* func_type  */
+    case 84: /* func_type  */
 #line 268 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).func_sig); }
-#line 1720 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1739 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 83: /* func_sig  */
+    case 85: /* func_sig  */
 #line 268 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).func_sig); }
-#line 1726 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1745 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 85: /* memory_sig  */
+    case 87: /* memory_sig  */
 #line 273 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).memory); }
-#line 1732 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1751 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 87: /* type_use  */
+    case 89: /* type_use  */
 #line 279 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_var(&((*yyvaluep).var)); }
-#line 1738 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1757 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 89: /* literal  */
+    case 91: /* literal  */
 #line 252 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_string_slice(&((*yyvaluep).literal).text); }
-#line 1744 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1763 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 90: /* var  */
+    case 92: /* var  */
 #line 279 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_var(&((*yyvaluep).var)); }
-#line 1750 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1769 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 91: /* var_list  */
+    case 93: /* var_list  */
 #line 280 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).vars); }
-#line 1756 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1775 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 92: /* bind_var_opt  */
+    case 94: /* bind_var_opt  */
 #line 251 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_string_slice(&((*yyvaluep).text)); }
-#line 1762 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1781 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 93: /* bind_var  */
+    case 95: /* bind_var  */
 #line 251 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_string_slice(&((*yyvaluep).text)); }
-#line 1768 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1787 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 94: /* labeling_opt  */
+    case 96: /* labeling_opt  */
 #line 251 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_string_slice(&((*yyvaluep).text)); }
-#line 1774 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1793 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 97: /* instr  */
+    case 99: /* instr  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1780 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1799 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 98: /* plain_instr  */
+    case 100: /* plain_instr  */
 #line 264 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).expr); }
-#line 1786 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1805 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 99: /* block_instr  */
+    case 101: /* block_instr  */
 #line 264 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).expr); }
-#line 1792 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1811 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 100: /* block  */
+    case 102: /* block  */
 #line 254 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).block); }
-#line 1798 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1817 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 101: /* expr  */
+    case 103: /* expr  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1804 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1823 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 102: /* expr1  */
+    case 104: /* expr1  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1810 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1829 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 103: /* if_  */
+    case 105: /* if_  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1816 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1835 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 104: /* instr_list  */
+    case 106: /* instr_list  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1822 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1841 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 105: /* expr_list  */
+    case 107: /* expr_list  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1828 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1847 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 106: /* const_expr  */
+    case 108: /* const_expr  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1834 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1853 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 107: /* func_fields  */
+    case 109: /* func_fields  */
 #line 266 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_func_fields(((*yyvaluep).func_fields)); }
-#line 1840 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1859 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 108: /* func_body  */
+    case 110: /* func_body  */
 #line 266 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_func_fields(((*yyvaluep).func_fields)); }
-#line 1846 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1865 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 109: /* func_info  */
+    case 111: /* func_info  */
 #line 267 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).func); }
-#line 1852 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1871 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 110: /* func  */
+    case 112: /* func  */
 #line 261 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).exported_func); }
-#line 1858 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1877 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 111: /* offset  */
+    case 113: /* offset  */
 #line 265 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_expr_list(((*yyvaluep).expr_list).first); }
-#line 1864 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1883 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 112: /* elem  */
+    case 114: /* elem  */
 #line 259 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).elem_segment); }
-#line 1870 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1889 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 113: /* table  */
+    case 115: /* table  */
 #line 263 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).exported_table); }
-#line 1876 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1895 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 114: /* data  */
+    case 116: /* data  */
 #line 258 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).data_segment); }
-#line 1882 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1901 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 115: /* memory  */
+    case 117: /* memory  */
 #line 262 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).exported_memory); }
-#line 1888 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1907 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 117: /* import_kind  */
+    case 119: /* import_kind  */
 #line 271 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).import); }
-#line 1894 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1913 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 118: /* import  */
+    case 120: /* import  */
 #line 271 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).import); }
-#line 1900 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1919 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 119: /* inline_import  */
+    case 121: /* inline_import  */
 #line 271 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).import); }
-#line 1906 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1925 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 120: /* export_kind  */
+    case 122: /* export_kind  */
 #line 260 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).export_); }
-#line 1912 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1931 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 121: /* export  */
+    case 123: /* export  */
 #line 260 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).export_); }
-#line 1918 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1937 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 122: /* inline_export_opt  */
+    case 124: /* inline_export_opt  */
 #line 272 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).optional_export); }
-#line 1924 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1943 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 123: /* inline_export  */
+    case 125: /* inline_export  */
 #line 272 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).optional_export); }
-#line 1930 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1949 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 124: /* type_def  */
+    case 126: /* type_def  */
 #line 269 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).func_type); }
-#line 1936 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1955 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 125: /* start  */
+    case 127: /* start  */
 #line 279 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_var(&((*yyvaluep).var)); }
-#line 1942 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1961 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 126: /* module_fields  */
+    case 128: /* module_fields  */
 #line 274 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).module); }
-#line 1948 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1967 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 127: /* raw_module  */
+    case 129: /* raw_module  */
 #line 275 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).raw_module); }
-#line 1954 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1973 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 128: /* module  */
+    case 130: /* module  */
 #line 274 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).module); }
-#line 1960 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1979 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 129: /* script_var_opt  */
+    case 131: /* script_var_opt  */
 #line 279 "src/ast-parser.y" /* yacc.c:1257  */
       { destroy_var(&((*yyvaluep).var)); }
-#line 1966 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1985 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 130: /* action  */
+    case 132: /* action  */
 #line 253 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).action); }
-#line 1972 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1991 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 131: /* assertion  */
+    case 133: /* assertion  */
 #line 255 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).command); }
-#line 1978 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 1997 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 132: /* cmd  */
+    case 134: /* cmd  */
 #line 255 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).command); }
-#line 1984 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 2003 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 133: /* cmd_list  */
+    case 135: /* cmd_list  */
 #line 256 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).commands); }
-#line 1990 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 2009 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 135: /* const_list  */
+    case 137: /* const_list  */
 #line 257 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).consts); }
-#line 1996 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 2015 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
-    case 136: /* script  */
+    case 138: /* script  */
 #line 276 "src/ast-parser.y" /* yacc.c:1257  */
       { delete ((*yyvaluep).script); }
-#line 2002 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
+#line 2021 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1257  */
         break;
 
 
@@ -2297,7 +2316,7 @@ yyreduce:
       node->next = nullptr;
       (yyval.text_list).first = (yyval.text_list).last = node;
     }
-#line 2301 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2320 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 3:
@@ -2310,13 +2329,13 @@ yyreduce:
       (yyval.text_list).last->next = node;
       (yyval.text_list).last = node;
     }
-#line 2314 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2333 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 4:
 #line 309 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.text_list).first = (yyval.text_list).last = nullptr; }
-#line 2320 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2339 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 6:
@@ -2334,13 +2353,13 @@ yyreduce:
       (yyval.text).start = data;
       (yyval.text).length = size;
     }
-#line 2338 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2357 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 7:
 #line 332 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.types) = new TypeVector(); }
-#line 2344 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2363 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 8:
@@ -2349,13 +2368,13 @@ yyreduce:
       (yyval.types) = (yyvsp[-1].types);
       (yyval.types)->push_back((yyvsp[0].type));
     }
-#line 2353 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2372 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 9:
 #line 339 "src/ast-parser.y" /* yacc.c:1646  */
     {}
-#line 2359 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2378 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 10:
@@ -2365,7 +2384,7 @@ yyreduce:
       (yyval.global)->type = (yyvsp[0].type);
       (yyval.global)->mutable_ = false;
     }
-#line 2369 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2388 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 11:
@@ -2375,19 +2394,19 @@ yyreduce:
       (yyval.global)->type = (yyvsp[-1].type);
       (yyval.global)->mutable_ = true;
     }
-#line 2379 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2398 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 12:
 #line 354 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.func_sig) = (yyvsp[-1].func_sig); }
-#line 2385 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2404 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 13:
 #line 357 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.func_sig) = new FuncSignature(); }
-#line 2391 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2410 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 14:
@@ -2397,7 +2416,7 @@ yyreduce:
       (yyval.func_sig)->param_types = std::move(*(yyvsp[-1].types));
       delete (yyvsp[-1].types);
     }
-#line 2401 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2420 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 15:
@@ -2409,7 +2428,7 @@ yyreduce:
       (yyval.func_sig)->result_types = std::move(*(yyvsp[-1].types));
       delete (yyvsp[-1].types);
     }
-#line 2413 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2432 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 16:
@@ -2419,7 +2438,7 @@ yyreduce:
       (yyval.func_sig)->result_types = std::move(*(yyvsp[-1].types));
       delete (yyvsp[-1].types);
     }
-#line 2423 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2442 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 17:
@@ -2428,7 +2447,7 @@ yyreduce:
       (yyval.table) = new Table();
       (yyval.table)->elem_limits = (yyvsp[-1].limits);
     }
-#line 2432 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2451 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 18:
@@ -2437,7 +2456,7 @@ yyreduce:
       (yyval.memory) = new Memory();
       (yyval.memory)->page_limits = (yyvsp[0].limits);
     }
-#line 2441 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2460 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 19:
@@ -2447,7 +2466,7 @@ yyreduce:
       (yyval.limits).initial = (yyvsp[0].u64);
       (yyval.limits).max = 0;
     }
-#line 2451 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2470 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 20:
@@ -2457,13 +2476,13 @@ yyreduce:
       (yyval.limits).initial = (yyvsp[-1].u64);
       (yyval.limits).max = (yyvsp[0].u64);
     }
-#line 2461 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2480 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 21:
 #line 402 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.var) = (yyvsp[-1].var); }
-#line 2467 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2486 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 22:
@@ -2476,7 +2495,7 @@ yyreduce:
                               WABT_PRINTF_STRING_SLICE_ARG((yyvsp[0].literal).text));
       }
     }
-#line 2480 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2499 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 23:
@@ -2485,7 +2504,7 @@ yyreduce:
       (yyval.literal).type = (yyvsp[0].literal).type;
       DUPTEXT((yyval.literal).text, (yyvsp[0].literal).text);
     }
-#line 2489 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2508 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 24:
@@ -2494,7 +2513,7 @@ yyreduce:
       (yyval.literal).type = (yyvsp[0].literal).type;
       DUPTEXT((yyval.literal).text, (yyvsp[0].literal).text);
     }
-#line 2498 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2517 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 25:
@@ -2503,7 +2522,7 @@ yyreduce:
       (yyval.literal).type = (yyvsp[0].literal).type;
       DUPTEXT((yyval.literal).text, (yyvsp[0].literal).text);
     }
-#line 2507 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2526 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 26:
@@ -2513,7 +2532,7 @@ yyreduce:
       (yyval.var).type = VarType::Index;
       (yyval.var).index = (yyvsp[0].u64);
     }
-#line 2517 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2536 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 27:
@@ -2523,13 +2542,13 @@ yyreduce:
       (yyval.var).type = VarType::Name;
       DUPTEXT((yyval.var).name, (yyvsp[0].text));
     }
-#line 2527 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2546 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 28:
 #line 446 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.vars) = new VarVector(); }
-#line 2533 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2552 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 29:
@@ -2538,31 +2557,31 @@ yyreduce:
       (yyval.vars) = (yyvsp[-1].vars);
       (yyval.vars)->push_back((yyvsp[0].var));
     }
-#line 2542 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2561 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 30:
 #line 453 "src/ast-parser.y" /* yacc.c:1646  */
     { WABT_ZERO_MEMORY((yyval.text)); }
-#line 2548 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2567 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 32:
 #line 457 "src/ast-parser.y" /* yacc.c:1646  */
     { DUPTEXT((yyval.text), (yyvsp[0].text)); }
-#line 2554 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2573 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 33:
 #line 461 "src/ast-parser.y" /* yacc.c:1646  */
     { WABT_ZERO_MEMORY((yyval.text)); }
-#line 2560 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2579 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 35:
 #line 466 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.u64) = 0; }
-#line 2566 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2585 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 36:
@@ -2575,13 +2594,13 @@ yyreduce:
                             WABT_PRINTF_STRING_SLICE_ARG((yyvsp[0].text)));
       }
     }
-#line 2579 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2598 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 37:
 #line 477 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.u32) = USE_NATURAL_ALIGNMENT; }
-#line 2585 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2604 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 38:
@@ -2594,25 +2613,25 @@ yyreduce:
                        WABT_PRINTF_STRING_SLICE_ARG((yyvsp[0].text)));
       }
     }
-#line 2598 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2617 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 39:
 #line 489 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.expr_list) = join_exprs1(&(yylsp[0]), (yyvsp[0].expr)); }
-#line 2604 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2623 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 40:
 #line 490 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.expr_list) = join_exprs1(&(yylsp[0]), (yyvsp[0].expr)); }
-#line 2610 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2629 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 41:
 #line 491 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.expr_list) = (yyvsp[0].expr_list); }
-#line 2616 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2635 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 42:
@@ -2620,7 +2639,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateUnreachable();
     }
-#line 2624 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2643 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 43:
@@ -2628,7 +2647,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateNop();
     }
-#line 2632 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2651 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 44:
@@ -2636,7 +2655,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateDrop();
     }
-#line 2640 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2659 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 45:
@@ -2644,7 +2663,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateSelect();
     }
-#line 2648 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2667 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 46:
@@ -2652,7 +2671,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateBr((yyvsp[0].var));
     }
-#line 2656 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2675 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 47:
@@ -2660,7 +2679,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateBrIf((yyvsp[0].var));
     }
-#line 2664 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2683 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 48:
@@ -2668,7 +2687,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateBrTable((yyvsp[-1].vars), (yyvsp[0].var));
     }
-#line 2672 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2691 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 49:
@@ -2676,7 +2695,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateReturn();
     }
-#line 2680 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2699 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 50:
@@ -2684,7 +2703,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateCall((yyvsp[0].var));
     }
-#line 2688 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2707 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 51:
@@ -2692,7 +2711,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateCallIndirect((yyvsp[0].var));
     }
-#line 2696 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2715 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 52:
@@ -2700,7 +2719,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateGetLocal((yyvsp[0].var));
     }
-#line 2704 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2723 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 53:
@@ -2708,7 +2727,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateSetLocal((yyvsp[0].var));
     }
-#line 2712 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2731 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 54:
@@ -2716,7 +2735,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateTeeLocal((yyvsp[0].var));
     }
-#line 2720 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2739 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 55:
@@ -2724,7 +2743,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateGetGlobal((yyvsp[0].var));
     }
-#line 2728 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2747 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 56:
@@ -2732,7 +2751,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateSetGlobal((yyvsp[0].var));
     }
-#line 2736 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2755 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 57:
@@ -2740,7 +2759,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateLoad((yyvsp[-2].opcode), (yyvsp[0].u32), (yyvsp[-1].u64));
     }
-#line 2744 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2763 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 58:
@@ -2748,7 +2767,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateStore((yyvsp[-2].opcode), (yyvsp[0].u32), (yyvsp[-1].u64));
     }
-#line 2752 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2771 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 59:
@@ -2766,7 +2785,7 @@ yyreduce:
       delete [] (yyvsp[0].literal).text.start;
       (yyval.expr) = Expr::CreateConst(const_);
     }
-#line 2770 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2789 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 60:
@@ -2774,7 +2793,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateUnary((yyvsp[0].opcode));
     }
-#line 2778 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2797 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 61:
@@ -2782,7 +2801,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateBinary((yyvsp[0].opcode));
     }
-#line 2786 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2805 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 62:
@@ -2790,7 +2809,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateCompare((yyvsp[0].opcode));
     }
-#line 2794 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2813 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 63:
@@ -2798,7 +2817,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateConvert((yyvsp[0].opcode));
     }
-#line 2802 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2821 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 64:
@@ -2806,7 +2825,7 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateCurrentMemory();
     }
-#line 2810 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2829 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 65:
@@ -2814,97 +2833,113 @@ yyreduce:
     {
       (yyval.expr) = Expr::CreateGrowMemory();
     }
-#line 2818 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2837 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
   case 66:
-#line 578 "src/ast-parser.y" /* yacc.c:1646  */
+#line 576 "src/ast-parser.y" /* yacc.c:1646  */
+    {
+      (yyval.expr) = Expr::CreateMemoryCopy();
+    }
+#line 2845 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+    break;
+
+  case 67:
+#line 579 "src/ast-parser.y" /* yacc.c:1646  */
+    {
+      (yyval.expr) = Expr::CreateMemoryFill();
+    }
+#line 2853 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+    break;
+
+  case 68:
+#line 584 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr) = Expr::CreateBlock((yyvsp[-2].block));
       (yyval.expr)->block->label = (yyvsp[-3].text);
       CHECK_END_LABEL((yylsp[0]), (yyval.expr)->block->label, (yyvsp[0].text));
     }
-#line 2828 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2863 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 67:
-#line 583 "src/ast-parser.y" /* yacc.c:1646  */
+  case 69:
+#line 589 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr) = Expr::CreateLoop((yyvsp[-2].block));
       (yyval.expr)->loop->label = (yyvsp[-3].text);
       CHECK_END_LABEL((yylsp[0]), (yyval.expr)->loop->label, (yyvsp[0].text));
     }
-#line 2838 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2873 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 68:
-#line 588 "src/ast-parser.y" /* yacc.c:1646  */
+  case 70:
+#line 594 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr) = Expr::CreateIf((yyvsp[-2].block), nullptr);
       (yyval.expr)->if_.true_->label = (yyvsp[-3].text);
       CHECK_END_LABEL((yylsp[0]), (yyval.expr)->if_.true_->label, (yyvsp[0].text));
     }
-#line 2848 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2883 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 69:
-#line 593 "src/ast-parser.y" /* yacc.c:1646  */
+  case 71:
+#line 599 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr) = Expr::CreateIf((yyvsp[-5].block), (yyvsp[-2].expr_list).first);
       (yyval.expr)->if_.true_->label = (yyvsp[-6].text);
       CHECK_END_LABEL((yylsp[-3]), (yyval.expr)->if_.true_->label, (yyvsp[-3].text));
       CHECK_END_LABEL((yylsp[0]), (yyval.expr)->if_.true_->label, (yyvsp[0].text));
     }
-#line 2859 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2894 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 70:
-#line 601 "src/ast-parser.y" /* yacc.c:1646  */
+  case 72:
+#line 607 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.block) = new Block();
       (yyval.block)->sig = std::move(*(yyvsp[-1].types));
       delete (yyvsp[-1].types);
       (yyval.block)->first = (yyvsp[0].expr_list).first;
     }
-#line 2870 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2905 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 71:
-#line 610 "src/ast-parser.y" /* yacc.c:1646  */
+  case 73:
+#line 616 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.expr_list) = (yyvsp[-1].expr_list); }
-#line 2876 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2911 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 72:
-#line 614 "src/ast-parser.y" /* yacc.c:1646  */
+  case 74:
+#line 620 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr_list) = join_exprs2(&(yylsp[-1]), &(yyvsp[0].expr_list), (yyvsp[-1].expr));
     }
-#line 2884 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2919 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 73:
-#line 617 "src/ast-parser.y" /* yacc.c:1646  */
+  case 75:
+#line 623 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateBlock((yyvsp[0].block));
       expr->block->label = (yyvsp[-1].text);
       (yyval.expr_list) = join_exprs1(&(yylsp[-2]), expr);
     }
-#line 2894 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2929 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 74:
-#line 622 "src/ast-parser.y" /* yacc.c:1646  */
+  case 76:
+#line 628 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateLoop((yyvsp[0].block));
       expr->loop->label = (yyvsp[-1].text);
       (yyval.expr_list) = join_exprs1(&(yylsp[-2]), expr);
     }
-#line 2904 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2939 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 75:
-#line 627 "src/ast-parser.y" /* yacc.c:1646  */
+  case 77:
+#line 633 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr_list) = (yyvsp[0].expr_list);
       Expr* if_ = (yyvsp[0].expr_list).last;
@@ -2913,121 +2948,121 @@ yyreduce:
       if_->if_.true_->sig = std::move(*(yyvsp[-1].types));
       delete (yyvsp[-1].types);
     }
-#line 2917 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2952 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 76:
-#line 637 "src/ast-parser.y" /* yacc.c:1646  */
+  case 78:
+#line 643 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[-5].expr_list).first), (yyvsp[-1].expr_list).first);
       (yyval.expr_list) = join_exprs1(&(yylsp[-7]), expr);
     }
-#line 2926 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2961 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 77:
-#line 641 "src/ast-parser.y" /* yacc.c:1646  */
+  case 79:
+#line 647 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[-1].expr_list).first), nullptr);
       (yyval.expr_list) = join_exprs1(&(yylsp[-3]), expr);
     }
-#line 2935 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2970 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 78:
-#line 645 "src/ast-parser.y" /* yacc.c:1646  */
+  case 80:
+#line 651 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[-5].expr_list).first), (yyvsp[-1].expr_list).first);
       (yyval.expr_list) = join_exprs2(&(yylsp[-8]), &(yyvsp[-8].expr_list), expr);
     }
-#line 2944 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2979 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 79:
-#line 649 "src/ast-parser.y" /* yacc.c:1646  */
+  case 81:
+#line 655 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[-1].expr_list).first), nullptr);
       (yyval.expr_list) = join_exprs2(&(yylsp[-4]), &(yyvsp[-4].expr_list), expr);
     }
-#line 2953 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2988 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 80:
-#line 653 "src/ast-parser.y" /* yacc.c:1646  */
+  case 82:
+#line 659 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[-1].expr_list).first), (yyvsp[0].expr_list).first);
       (yyval.expr_list) = join_exprs2(&(yylsp[-2]), &(yyvsp[-2].expr_list), expr);
     }
-#line 2962 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 2997 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 81:
-#line 657 "src/ast-parser.y" /* yacc.c:1646  */
+  case 83:
+#line 663 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateIf(new Block((yyvsp[0].expr_list).first), nullptr);
       (yyval.expr_list) = join_exprs2(&(yylsp[-1]), &(yyvsp[-1].expr_list), expr);
     }
-#line 2971 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3006 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 82:
-#line 664 "src/ast-parser.y" /* yacc.c:1646  */
+  case 84:
+#line 670 "src/ast-parser.y" /* yacc.c:1646  */
     { WABT_ZERO_MEMORY((yyval.expr_list)); }
-#line 2977 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3012 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 83:
-#line 665 "src/ast-parser.y" /* yacc.c:1646  */
+  case 85:
+#line 671 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr_list).first = (yyvsp[-1].expr_list).first;
       (yyvsp[-1].expr_list).last->next = (yyvsp[0].expr_list).first;
       (yyval.expr_list).last = (yyvsp[0].expr_list).last ? (yyvsp[0].expr_list).last : (yyvsp[-1].expr_list).last;
       (yyval.expr_list).size = (yyvsp[-1].expr_list).size + (yyvsp[0].expr_list).size;
     }
-#line 2988 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3023 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 84:
-#line 673 "src/ast-parser.y" /* yacc.c:1646  */
+  case 86:
+#line 679 "src/ast-parser.y" /* yacc.c:1646  */
     { WABT_ZERO_MEMORY((yyval.expr_list)); }
-#line 2994 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3029 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 85:
-#line 674 "src/ast-parser.y" /* yacc.c:1646  */
+  case 87:
+#line 680 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr_list).first = (yyvsp[-1].expr_list).first;
       (yyvsp[-1].expr_list).last->next = (yyvsp[0].expr_list).first;
       (yyval.expr_list).last = (yyvsp[0].expr_list).last ? (yyvsp[0].expr_list).last : (yyvsp[-1].expr_list).last;
       (yyval.expr_list).size = (yyvsp[-1].expr_list).size + (yyvsp[0].expr_list).size;
     }
-#line 3005 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3040 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 88:
-#line 688 "src/ast-parser.y" /* yacc.c:1646  */
+  case 90:
+#line 694 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::ResultTypes;
       (yyval.func_fields)->types = (yyvsp[-2].types);
       (yyval.func_fields)->next = (yyvsp[0].func_fields);
     }
-#line 3016 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3051 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 89:
-#line 694 "src/ast-parser.y" /* yacc.c:1646  */
+  case 91:
+#line 700 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::ParamTypes;
       (yyval.func_fields)->types = (yyvsp[-2].types);
       (yyval.func_fields)->next = (yyvsp[0].func_fields);
     }
-#line 3027 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3062 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 90:
-#line 700 "src/ast-parser.y" /* yacc.c:1646  */
+  case 92:
+#line 706 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::BoundParam;
@@ -3036,33 +3071,33 @@ yyreduce:
       (yyval.func_fields)->bound_type.type = (yyvsp[-2].type);
       (yyval.func_fields)->next = (yyvsp[0].func_fields);
     }
-#line 3040 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3075 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 91:
-#line 710 "src/ast-parser.y" /* yacc.c:1646  */
+  case 93:
+#line 716 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::Exprs;
       (yyval.func_fields)->first_expr = (yyvsp[0].expr_list).first;
       (yyval.func_fields)->next = nullptr;
     }
-#line 3051 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3086 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 92:
-#line 716 "src/ast-parser.y" /* yacc.c:1646  */
+  case 94:
+#line 722 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::LocalTypes;
       (yyval.func_fields)->types = (yyvsp[-2].types);
       (yyval.func_fields)->next = (yyvsp[0].func_fields);
     }
-#line 3062 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3097 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 93:
-#line 722 "src/ast-parser.y" /* yacc.c:1646  */
+  case 95:
+#line 728 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_fields) = new FuncField();
       (yyval.func_fields)->type = FuncFieldType::BoundLocal;
@@ -3071,11 +3106,11 @@ yyreduce:
       (yyval.func_fields)->bound_type.type = (yyvsp[-2].type);
       (yyval.func_fields)->next = (yyvsp[0].func_fields);
     }
-#line 3075 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3110 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 94:
-#line 732 "src/ast-parser.y" /* yacc.c:1646  */
+  case 96:
+#line 738 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func) = new Func();
       FuncField* field = (yyvsp[0].func_fields);
@@ -3126,11 +3161,11 @@ yyreduce:
         field = next;
       }
     }
-#line 3130 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3165 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 95:
-#line 784 "src/ast-parser.y" /* yacc.c:1646  */
+  case 97:
+#line 790 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_func) = new ExportedFunc();
       (yyval.exported_func)->func.reset((yyvsp[-1].func));
@@ -3140,11 +3175,11 @@ yyreduce:
       (yyval.exported_func)->export_ = std::move(*(yyvsp[-3].optional_export));
       delete (yyvsp[-3].optional_export);
     }
-#line 3144 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3179 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 96:
-#line 794 "src/ast-parser.y" /* yacc.c:1646  */
+  case 98:
+#line 800 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_func) = new ExportedFunc();
       (yyval.exported_func)->func.reset((yyvsp[-1].func));
@@ -3152,11 +3187,11 @@ yyreduce:
       (yyval.exported_func)->func->decl.type_var = (yyvsp[-2].var);
       (yyval.exported_func)->func->name = (yyvsp[-3].text);
     }
-#line 3156 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3191 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 97:
-#line 801 "src/ast-parser.y" /* yacc.c:1646  */
+  case 99:
+#line 807 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_func) = new ExportedFunc();
       (yyval.exported_func)->func.reset((yyvsp[-1].func));
@@ -3164,29 +3199,29 @@ yyreduce:
       (yyval.exported_func)->export_ = std::move(*(yyvsp[-2].optional_export));
       delete (yyvsp[-2].optional_export);
     }
-#line 3168 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3203 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 98:
-#line 809 "src/ast-parser.y" /* yacc.c:1646  */
+  case 100:
+#line 815 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_func) = new ExportedFunc();
       (yyval.exported_func)->func.reset((yyvsp[-1].func));
       (yyval.exported_func)->func->name = (yyvsp[-2].text);
     }
-#line 3178 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3213 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 99:
-#line 819 "src/ast-parser.y" /* yacc.c:1646  */
+  case 101:
+#line 825 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.expr_list) = (yyvsp[-1].expr_list);
     }
-#line 3186 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3221 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 101:
-#line 826 "src/ast-parser.y" /* yacc.c:1646  */
+  case 103:
+#line 832 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.elem_segment) = new ElemSegment();
       (yyval.elem_segment)->table_var = (yyvsp[-3].var);
@@ -3194,11 +3229,11 @@ yyreduce:
       (yyval.elem_segment)->vars = std::move(*(yyvsp[-1].vars));
       delete (yyvsp[-1].vars);
     }
-#line 3198 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3233 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 102:
-#line 833 "src/ast-parser.y" /* yacc.c:1646  */
+  case 104:
+#line 839 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.elem_segment) = new ElemSegment();
       (yyval.elem_segment)->table_var.loc = (yylsp[-3]);
@@ -3208,11 +3243,11 @@ yyreduce:
       (yyval.elem_segment)->vars = std::move(*(yyvsp[-1].vars));
       delete (yyvsp[-1].vars);
     }
-#line 3212 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3247 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 103:
-#line 845 "src/ast-parser.y" /* yacc.c:1646  */
+  case 105:
+#line 851 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_table) = new ExportedTable();
       (yyval.exported_table)->table.reset((yyvsp[-1].table));
@@ -3221,11 +3256,11 @@ yyreduce:
       (yyval.exported_table)->export_ = std::move(*(yyvsp[-2].optional_export));
       delete (yyvsp[-2].optional_export);
     }
-#line 3225 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3260 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 104:
-#line 854 "src/ast-parser.y" /* yacc.c:1646  */
+  case 106:
+#line 860 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateConst(Const(Const::I32(), 0));
       expr->loc = (yylsp[-8]);
@@ -3244,11 +3279,11 @@ yyreduce:
       (yyval.exported_table)->export_ = std::move(*(yyvsp[-6].optional_export));
       delete (yyvsp[-6].optional_export);
     }
-#line 3248 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3283 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 105:
-#line 875 "src/ast-parser.y" /* yacc.c:1646  */
+  case 107:
+#line 881 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.data_segment) = new DataSegment();
       (yyval.data_segment)->memory_var = (yyvsp[-3].var);
@@ -3256,11 +3291,11 @@ yyreduce:
       dup_text_list(&(yyvsp[-1].text_list), &(yyval.data_segment)->data, &(yyval.data_segment)->size);
       destroy_text_list(&(yyvsp[-1].text_list));
     }
-#line 3260 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3295 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 106:
-#line 882 "src/ast-parser.y" /* yacc.c:1646  */
+  case 108:
+#line 888 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.data_segment) = new DataSegment();
       (yyval.data_segment)->memory_var.loc = (yylsp[-3]);
@@ -3270,11 +3305,11 @@ yyreduce:
       dup_text_list(&(yyvsp[-1].text_list), &(yyval.data_segment)->data, &(yyval.data_segment)->size);
       destroy_text_list(&(yyvsp[-1].text_list));
     }
-#line 3274 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3309 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 107:
-#line 894 "src/ast-parser.y" /* yacc.c:1646  */
+  case 109:
+#line 900 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_memory) = new ExportedMemory();
       (yyval.exported_memory)->memory.reset((yyvsp[-1].memory));
@@ -3283,11 +3318,11 @@ yyreduce:
       (yyval.exported_memory)->export_ = std::move(*(yyvsp[-2].optional_export));
       delete (yyvsp[-2].optional_export);
     }
-#line 3287 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3322 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 108:
-#line 902 "src/ast-parser.y" /* yacc.c:1646  */
+  case 110:
+#line 908 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateConst(Const(Const::I32(), 0));
       expr->loc = (yylsp[-7]);
@@ -3308,11 +3343,11 @@ yyreduce:
       (yyval.exported_memory)->export_ = std::move(*(yyvsp[-5].optional_export));
       delete (yyvsp[-5].optional_export);
     }
-#line 3312 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3347 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 109:
-#line 923 "src/ast-parser.y" /* yacc.c:1646  */
+  case 111:
+#line 929 "src/ast-parser.y" /* yacc.c:1646  */
     {
       Expr* expr = Expr::CreateConst(Const(Const::I32(), 0));
       expr->loc = (yylsp[-6]);
@@ -3332,11 +3367,11 @@ yyreduce:
       (yyval.exported_memory)->memory->page_limits.has_max = true;
       (yyval.exported_memory)->export_.has_export = false;
     }
-#line 3336 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3371 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 110:
-#line 945 "src/ast-parser.y" /* yacc.c:1646  */
+  case 112:
+#line 951 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_global) = new ExportedGlobal();
       (yyval.exported_global)->global.reset((yyvsp[-2].global));
@@ -3345,11 +3380,11 @@ yyreduce:
       (yyval.exported_global)->export_ = std::move(*(yyvsp[-3].optional_export));
       delete (yyvsp[-3].optional_export);
     }
-#line 3349 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3384 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 111:
-#line 953 "src/ast-parser.y" /* yacc.c:1646  */
+  case 113:
+#line 959 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.exported_global) = new ExportedGlobal();
       (yyval.exported_global)->global.reset((yyvsp[-2].global));
@@ -3357,11 +3392,11 @@ yyreduce:
       (yyval.exported_global)->global->init_expr = (yyvsp[-1].expr_list).first;
       (yyval.exported_global)->export_.has_export = false;
     }
-#line 3361 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3396 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 112:
-#line 966 "src/ast-parser.y" /* yacc.c:1646  */
+  case 114:
+#line 972 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->kind = ExternalKind::Func;
@@ -3370,11 +3405,11 @@ yyreduce:
       (yyval.import)->func->decl.has_func_type = true;
       (yyval.import)->func->decl.type_var = (yyvsp[-1].var);
     }
-#line 3374 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3409 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 113:
-#line 974 "src/ast-parser.y" /* yacc.c:1646  */
+  case 115:
+#line 980 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->kind = ExternalKind::Func;
@@ -3383,54 +3418,54 @@ yyreduce:
       (yyval.import)->func->decl.sig = std::move(*(yyvsp[-1].func_sig));
       delete (yyvsp[-1].func_sig);
     }
-#line 3387 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3422 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 114:
-#line 982 "src/ast-parser.y" /* yacc.c:1646  */
+  case 116:
+#line 988 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->kind = ExternalKind::Table;
       (yyval.import)->table = (yyvsp[-1].table);
       (yyval.import)->table->name = (yyvsp[-2].text);
     }
-#line 3398 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3433 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 115:
-#line 988 "src/ast-parser.y" /* yacc.c:1646  */
+  case 117:
+#line 994 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->kind = ExternalKind::Memory;
       (yyval.import)->memory = (yyvsp[-1].memory);
       (yyval.import)->memory->name = (yyvsp[-2].text);
     }
-#line 3409 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3444 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 116:
-#line 994 "src/ast-parser.y" /* yacc.c:1646  */
+  case 118:
+#line 1000 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->kind = ExternalKind::Global;
       (yyval.import)->global = (yyvsp[-1].global);
       (yyval.import)->global->name = (yyvsp[-2].text);
     }
-#line 3420 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3455 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 117:
-#line 1002 "src/ast-parser.y" /* yacc.c:1646  */
+  case 119:
+#line 1008 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-1].import);
       (yyval.import)->module_name = (yyvsp[-3].text);
       (yyval.import)->field_name = (yyvsp[-2].text);
     }
-#line 3430 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3465 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 118:
-#line 1007 "src/ast-parser.y" /* yacc.c:1646  */
+  case 120:
+#line 1013 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-2].import);
       (yyval.import)->kind = ExternalKind::Func;
@@ -3439,11 +3474,11 @@ yyreduce:
       (yyval.import)->func->decl.has_func_type = true;
       (yyval.import)->func->decl.type_var = (yyvsp[-1].var);
     }
-#line 3443 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3478 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 119:
-#line 1015 "src/ast-parser.y" /* yacc.c:1646  */
+  case 121:
+#line 1021 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-2].import);
       (yyval.import)->kind = ExternalKind::Func;
@@ -3452,158 +3487,158 @@ yyreduce:
       (yyval.import)->func->decl.sig = std::move(*(yyvsp[-1].func_sig));
       delete (yyvsp[-1].func_sig);
     }
-#line 3456 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3491 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 120:
-#line 1023 "src/ast-parser.y" /* yacc.c:1646  */
+  case 122:
+#line 1029 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-2].import);
       (yyval.import)->kind = ExternalKind::Table;
       (yyval.import)->table = (yyvsp[-1].table);
       (yyval.import)->table->name = (yyvsp[-3].text);
     }
-#line 3467 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3502 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 121:
-#line 1029 "src/ast-parser.y" /* yacc.c:1646  */
+  case 123:
+#line 1035 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-2].import);
       (yyval.import)->kind = ExternalKind::Memory;
       (yyval.import)->memory = (yyvsp[-1].memory);
       (yyval.import)->memory->name = (yyvsp[-3].text);
     }
-#line 3478 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3513 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 122:
-#line 1035 "src/ast-parser.y" /* yacc.c:1646  */
+  case 124:
+#line 1041 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = (yyvsp[-2].import);
       (yyval.import)->kind = ExternalKind::Global;
       (yyval.import)->global = (yyvsp[-1].global);
       (yyval.import)->global->name = (yyvsp[-3].text);
     }
-#line 3489 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3524 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 123:
-#line 1044 "src/ast-parser.y" /* yacc.c:1646  */
+  case 125:
+#line 1050 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.import) = new Import();
       (yyval.import)->module_name = (yyvsp[-2].text);
       (yyval.import)->field_name = (yyvsp[-1].text);
     }
-#line 3499 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3534 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 124:
-#line 1052 "src/ast-parser.y" /* yacc.c:1646  */
+  case 126:
+#line 1058 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.export_) = new Export();
       (yyval.export_)->kind = ExternalKind::Func;
       (yyval.export_)->var = (yyvsp[-1].var);
     }
-#line 3509 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3544 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 125:
-#line 1057 "src/ast-parser.y" /* yacc.c:1646  */
+  case 127:
+#line 1063 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.export_) = new Export();
       (yyval.export_)->kind = ExternalKind::Table;
       (yyval.export_)->var = (yyvsp[-1].var);
     }
-#line 3519 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3554 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 126:
-#line 1062 "src/ast-parser.y" /* yacc.c:1646  */
+  case 128:
+#line 1068 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.export_) = new Export();
       (yyval.export_)->kind = ExternalKind::Memory;
       (yyval.export_)->var = (yyvsp[-1].var);
     }
-#line 3529 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3564 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 127:
-#line 1067 "src/ast-parser.y" /* yacc.c:1646  */
+  case 129:
+#line 1073 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.export_) = new Export();
       (yyval.export_)->kind = ExternalKind::Global;
       (yyval.export_)->var = (yyvsp[-1].var);
     }
-#line 3539 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3574 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 128:
-#line 1074 "src/ast-parser.y" /* yacc.c:1646  */
+  case 130:
+#line 1080 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.export_) = (yyvsp[-1].export_);
       (yyval.export_)->name = (yyvsp[-2].text);
     }
-#line 3548 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3583 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 129:
-#line 1081 "src/ast-parser.y" /* yacc.c:1646  */
+  case 131:
+#line 1087 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.optional_export) = new OptionalExport();
       (yyval.optional_export)->has_export = false;
     }
-#line 3557 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3592 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 131:
-#line 1088 "src/ast-parser.y" /* yacc.c:1646  */
+  case 133:
+#line 1094 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.optional_export) = new OptionalExport();
       (yyval.optional_export)->has_export = true;
       (yyval.optional_export)->export_.reset(new Export());
       (yyval.optional_export)->export_->name = (yyvsp[-1].text);
     }
-#line 3568 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3603 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 132:
-#line 1100 "src/ast-parser.y" /* yacc.c:1646  */
+  case 134:
+#line 1106 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_type) = new FuncType();
       (yyval.func_type)->sig = std::move(*(yyvsp[-1].func_sig));
       delete (yyvsp[-1].func_sig);
     }
-#line 3578 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3613 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 133:
-#line 1105 "src/ast-parser.y" /* yacc.c:1646  */
+  case 135:
+#line 1111 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.func_type) = new FuncType();
       (yyval.func_type)->name = (yyvsp[-2].text);
       (yyval.func_type)->sig = std::move(*(yyvsp[-1].func_sig));
       delete (yyvsp[-1].func_sig);
     }
-#line 3589 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3624 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 134:
-#line 1114 "src/ast-parser.y" /* yacc.c:1646  */
+  case 136:
+#line 1120 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.var) = (yyvsp[-1].var); }
-#line 3595 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3630 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 135:
-#line 1118 "src/ast-parser.y" /* yacc.c:1646  */
+  case 137:
+#line 1124 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = new Module();
     }
-#line 3603 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3638 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 136:
-#line 1121 "src/ast-parser.y" /* yacc.c:1646  */
+  case 138:
+#line 1127 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3611,11 +3646,11 @@ yyreduce:
       APPEND_ITEM_TO_VECTOR((yyval.module), func_types, field->func_type);
       INSERT_BINDING((yyval.module), func_type, func_types, (yylsp[0]), (yyvsp[0].func_type)->name);
     }
-#line 3615 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3650 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 137:
-#line 1128 "src/ast-parser.y" /* yacc.c:1646  */
+  case 139:
+#line 1134 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3625,11 +3660,11 @@ yyreduce:
       APPEND_INLINE_EXPORT((yyval.module), Global, (yylsp[0]), (yyvsp[0].exported_global), (yyval.module)->globals.size() - 1);
       delete (yyvsp[0].exported_global);
     }
-#line 3629 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3664 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 138:
-#line 1137 "src/ast-parser.y" /* yacc.c:1646  */
+  case 140:
+#line 1143 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3647,11 +3682,11 @@ yyreduce:
       }
       delete (yyvsp[0].exported_table);
     }
-#line 3651 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3686 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 139:
-#line 1154 "src/ast-parser.y" /* yacc.c:1646  */
+  case 141:
+#line 1160 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3669,11 +3704,11 @@ yyreduce:
       }
       delete (yyvsp[0].exported_memory);
     }
-#line 3673 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3708 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 140:
-#line 1171 "src/ast-parser.y" /* yacc.c:1646  */
+  case 142:
+#line 1177 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3684,44 +3719,44 @@ yyreduce:
       APPEND_INLINE_EXPORT((yyval.module), Func, (yylsp[0]), (yyvsp[0].exported_func), (yyval.module)->funcs.size() - 1);
       delete (yyvsp[0].exported_func);
     }
-#line 3688 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3723 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 141:
-#line 1181 "src/ast-parser.y" /* yacc.c:1646  */
+  case 143:
+#line 1187 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
       APPEND_FIELD_TO_LIST((yyval.module), field, ElemSegment, elem_segment, (yylsp[0]), (yyvsp[0].elem_segment));
       APPEND_ITEM_TO_VECTOR((yyval.module), elem_segments, field->elem_segment);
     }
-#line 3699 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3734 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 142:
-#line 1187 "src/ast-parser.y" /* yacc.c:1646  */
+  case 144:
+#line 1193 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
       APPEND_FIELD_TO_LIST((yyval.module), field, DataSegment, data_segment, (yylsp[0]), (yyvsp[0].data_segment));
       APPEND_ITEM_TO_VECTOR((yyval.module), data_segments, field->data_segment);
     }
-#line 3710 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3745 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 143:
-#line 1193 "src/ast-parser.y" /* yacc.c:1646  */
+  case 145:
+#line 1199 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
       APPEND_FIELD_TO_LIST((yyval.module), field, Start, start, (yylsp[0]), (yyvsp[0].var));
       (yyval.module)->start = &field->start;
     }
-#line 3721 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3756 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 144:
-#line 1199 "src/ast-parser.y" /* yacc.c:1646  */
+  case 146:
+#line 1205 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3755,11 +3790,11 @@ yyreduce:
       }
       APPEND_ITEM_TO_VECTOR((yyval.module), imports, field->import);
     }
-#line 3759 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3794 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 145:
-#line 1232 "src/ast-parser.y" /* yacc.c:1646  */
+  case 147:
+#line 1238 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.module) = (yyvsp[-1].module);
       ModuleField* field;
@@ -3767,11 +3802,11 @@ yyreduce:
       APPEND_ITEM_TO_VECTOR((yyval.module), exports, field->export_);
       INSERT_BINDING((yyval.module), export, exports, (yylsp[0]), field->export_->name);
     }
-#line 3771 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3806 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 146:
-#line 1242 "src/ast-parser.y" /* yacc.c:1646  */
+  case 148:
+#line 1248 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.raw_module) = new RawModule();
       (yyval.raw_module)->type = RawModuleType::Text;
@@ -3792,11 +3827,11 @@ yyreduce:
         }
       }
     }
-#line 3796 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3831 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 147:
-#line 1262 "src/ast-parser.y" /* yacc.c:1646  */
+  case 149:
+#line 1268 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.raw_module) = new RawModule();
       (yyval.raw_module)->type = RawModuleType::Binary;
@@ -3805,11 +3840,11 @@ yyreduce:
       dup_text_list(&(yyvsp[-1].text_list), &(yyval.raw_module)->binary.data, &(yyval.raw_module)->binary.size);
       destroy_text_list(&(yyvsp[-1].text_list));
     }
-#line 3809 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3844 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 148:
-#line 1273 "src/ast-parser.y" /* yacc.c:1646  */
+  case 150:
+#line 1279 "src/ast-parser.y" /* yacc.c:1646  */
     {
       if ((yyvsp[0].raw_module)->type == RawModuleType::Text) {
         (yyval.module) = (yyvsp[0].raw_module)->text;
@@ -3833,31 +3868,31 @@ yyreduce:
       }
       delete (yyvsp[0].raw_module);
     }
-#line 3837 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3872 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 149:
-#line 1301 "src/ast-parser.y" /* yacc.c:1646  */
+  case 151:
+#line 1307 "src/ast-parser.y" /* yacc.c:1646  */
     {
       WABT_ZERO_MEMORY((yyval.var));
       (yyval.var).type = VarType::Index;
       (yyval.var).index = INVALID_VAR_INDEX;
     }
-#line 3847 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3882 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 150:
-#line 1306 "src/ast-parser.y" /* yacc.c:1646  */
+  case 152:
+#line 1312 "src/ast-parser.y" /* yacc.c:1646  */
     {
       WABT_ZERO_MEMORY((yyval.var));
       (yyval.var).type = VarType::Name;
       DUPTEXT((yyval.var).name, (yyvsp[0].text));
     }
-#line 3857 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3892 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 151:
-#line 1314 "src/ast-parser.y" /* yacc.c:1646  */
+  case 153:
+#line 1320 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.action) = new Action();
       (yyval.action)->loc = (yylsp[-4]);
@@ -3868,11 +3903,11 @@ yyreduce:
       (yyval.action)->invoke->args = std::move(*(yyvsp[-1].consts));
       delete (yyvsp[-1].consts);
     }
-#line 3872 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3907 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 152:
-#line 1324 "src/ast-parser.y" /* yacc.c:1646  */
+  case 154:
+#line 1330 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.action) = new Action();
       (yyval.action)->loc = (yylsp[-3]);
@@ -3880,128 +3915,128 @@ yyreduce:
       (yyval.action)->type = ActionType::Get;
       (yyval.action)->name = (yyvsp[-1].text);
     }
-#line 3884 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3919 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 153:
-#line 1334 "src/ast-parser.y" /* yacc.c:1646  */
+  case 155:
+#line 1340 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertMalformed;
       (yyval.command)->assert_malformed.module = (yyvsp[-2].raw_module);
       (yyval.command)->assert_malformed.text = (yyvsp[-1].text);
     }
-#line 3895 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3930 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 154:
-#line 1340 "src/ast-parser.y" /* yacc.c:1646  */
+  case 156:
+#line 1346 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertInvalid;
       (yyval.command)->assert_invalid.module = (yyvsp[-2].raw_module);
       (yyval.command)->assert_invalid.text = (yyvsp[-1].text);
     }
-#line 3906 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3941 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 155:
-#line 1346 "src/ast-parser.y" /* yacc.c:1646  */
+  case 157:
+#line 1352 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertUnlinkable;
       (yyval.command)->assert_unlinkable.module = (yyvsp[-2].raw_module);
       (yyval.command)->assert_unlinkable.text = (yyvsp[-1].text);
     }
-#line 3917 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3952 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 156:
-#line 1352 "src/ast-parser.y" /* yacc.c:1646  */
+  case 158:
+#line 1358 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertUninstantiable;
       (yyval.command)->assert_uninstantiable.module = (yyvsp[-2].raw_module);
       (yyval.command)->assert_uninstantiable.text = (yyvsp[-1].text);
     }
-#line 3928 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3963 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 157:
-#line 1358 "src/ast-parser.y" /* yacc.c:1646  */
+  case 159:
+#line 1364 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertReturn;
       (yyval.command)->assert_return.action = (yyvsp[-2].action);
       (yyval.command)->assert_return.expected = (yyvsp[-1].consts);
     }
-#line 3939 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3974 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 158:
-#line 1364 "src/ast-parser.y" /* yacc.c:1646  */
+  case 160:
+#line 1370 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertReturnCanonicalNan;
       (yyval.command)->assert_return_canonical_nan.action = (yyvsp[-1].action);
     }
-#line 3949 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3984 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 159:
-#line 1369 "src/ast-parser.y" /* yacc.c:1646  */
+  case 161:
+#line 1375 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertReturnArithmeticNan;
       (yyval.command)->assert_return_arithmetic_nan.action = (yyvsp[-1].action);
     }
-#line 3959 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 3994 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 160:
-#line 1374 "src/ast-parser.y" /* yacc.c:1646  */
+  case 162:
+#line 1380 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertTrap;
       (yyval.command)->assert_trap.action = (yyvsp[-2].action);
       (yyval.command)->assert_trap.text = (yyvsp[-1].text);
     }
-#line 3970 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4005 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 161:
-#line 1380 "src/ast-parser.y" /* yacc.c:1646  */
+  case 163:
+#line 1386 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::AssertExhaustion;
       (yyval.command)->assert_trap.action = (yyvsp[-2].action);
       (yyval.command)->assert_trap.text = (yyvsp[-1].text);
     }
-#line 3981 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4016 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 162:
-#line 1389 "src/ast-parser.y" /* yacc.c:1646  */
+  case 164:
+#line 1395 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::Action;
       (yyval.command)->action = (yyvsp[0].action);
     }
-#line 3991 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4026 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 164:
-#line 1395 "src/ast-parser.y" /* yacc.c:1646  */
+  case 166:
+#line 1401 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::Module;
       (yyval.command)->module = (yyvsp[0].module);
     }
-#line 4001 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4036 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 165:
-#line 1400 "src/ast-parser.y" /* yacc.c:1646  */
+  case 167:
+#line 1406 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.command) = new Command();
       (yyval.command)->type = CommandType::Register;
@@ -4009,26 +4044,26 @@ yyreduce:
       (yyval.command)->register_.var = (yyvsp[-1].var);
       (yyval.command)->register_.var.loc = (yylsp[-1]);
     }
-#line 4013 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4048 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 166:
-#line 1409 "src/ast-parser.y" /* yacc.c:1646  */
+  case 168:
+#line 1415 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.commands) = new CommandPtrVector(); }
-#line 4019 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4054 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 167:
-#line 1410 "src/ast-parser.y" /* yacc.c:1646  */
+  case 169:
+#line 1416 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.commands) = (yyvsp[-1].commands);
       (yyval.commands)->emplace_back((yyvsp[0].command));
     }
-#line 4028 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4063 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 168:
-#line 1417 "src/ast-parser.y" /* yacc.c:1646  */
+  case 170:
+#line 1423 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.const_).loc = (yylsp[-2]);
       if (WABT_FAILED(parse_const((yyvsp[-2].type), (yyvsp[-1].literal).type, (yyvsp[-1].literal).text.start,
@@ -4039,26 +4074,26 @@ yyreduce:
       }
       delete [] (yyvsp[-1].literal).text.start;
     }
-#line 4043 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4078 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 169:
-#line 1429 "src/ast-parser.y" /* yacc.c:1646  */
+  case 171:
+#line 1435 "src/ast-parser.y" /* yacc.c:1646  */
     { (yyval.consts) = new ConstVector(); }
-#line 4049 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4084 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 170:
-#line 1430 "src/ast-parser.y" /* yacc.c:1646  */
+  case 172:
+#line 1436 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.consts) = (yyvsp[-1].consts);
       (yyval.consts)->push_back((yyvsp[0].const_));
     }
-#line 4058 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4093 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
-  case 171:
-#line 1437 "src/ast-parser.y" /* yacc.c:1646  */
+  case 173:
+#line 1443 "src/ast-parser.y" /* yacc.c:1646  */
     {
       (yyval.script) = new Script();
       (yyval.script)->commands = std::move(*(yyvsp[0].commands));
@@ -4120,11 +4155,11 @@ yyreduce:
       }
       parser->script = (yyval.script);
     }
-#line 4124 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4159 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
     break;
 
 
-#line 4128 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
+#line 4163 "src/prebuilt/ast-parser-gen.cc" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -4359,7 +4394,7 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 1506 "src/ast-parser.y" /* yacc.c:1906  */
+#line 1512 "src/ast-parser.y" /* yacc.c:1906  */
 
 
 void append_expr_list(ExprList* expr_list, ExprList* expr) {
@@ -97,35 +97,37 @@ extern int wabt_ast_parser_debug;
     WABT_TOKEN_TYPE_UNREACHABLE = 298,
     WABT_TOKEN_TYPE_CURRENT_MEMORY = 299,
     WABT_TOKEN_TYPE_GROW_MEMORY = 300,
-    WABT_TOKEN_TYPE_FUNC = 301,
-    WABT_TOKEN_TYPE_START = 302,
-    WABT_TOKEN_TYPE_TYPE = 303,
-    WABT_TOKEN_TYPE_PARAM = 304,
-    WABT_TOKEN_TYPE_RESULT = 305,
-    WABT_TOKEN_TYPE_LOCAL = 306,
-    WABT_TOKEN_TYPE_GLOBAL = 307,
-    WABT_TOKEN_TYPE_MODULE = 308,
-    WABT_TOKEN_TYPE_TABLE = 309,
-    WABT_TOKEN_TYPE_ELEM = 310,
-    WABT_TOKEN_TYPE_MEMORY = 311,
-    WABT_TOKEN_TYPE_DATA = 312,
-    WABT_TOKEN_TYPE_OFFSET = 313,
-    WABT_TOKEN_TYPE_IMPORT = 314,
-    WABT_TOKEN_TYPE_EXPORT = 315,
-    WABT_TOKEN_TYPE_REGISTER = 316,
-    WABT_TOKEN_TYPE_INVOKE = 317,
-    WABT_TOKEN_TYPE_GET = 318,
-    WABT_TOKEN_TYPE_ASSERT_MALFORMED = 319,
-    WABT_TOKEN_TYPE_ASSERT_INVALID = 320,
-    WABT_TOKEN_TYPE_ASSERT_UNLINKABLE = 321,
-    WABT_TOKEN_TYPE_ASSERT_RETURN = 322,
-    WABT_TOKEN_TYPE_ASSERT_RETURN_CANONICAL_NAN = 323,
-    WABT_TOKEN_TYPE_ASSERT_RETURN_ARITHMETIC_NAN = 324,
-    WABT_TOKEN_TYPE_ASSERT_TRAP = 325,
-    WABT_TOKEN_TYPE_ASSERT_EXHAUSTION = 326,
-    WABT_TOKEN_TYPE_INPUT = 327,
-    WABT_TOKEN_TYPE_OUTPUT = 328,
-    WABT_TOKEN_TYPE_LOW = 329
+    WABT_TOKEN_TYPE_MEMORY_COPY = 301,
+    WABT_TOKEN_TYPE_MEMORY_FILL = 302,
+    WABT_TOKEN_TYPE_FUNC = 303,
+    WABT_TOKEN_TYPE_START = 304,
+    WABT_TOKEN_TYPE_TYPE = 305,
+    WABT_TOKEN_TYPE_PARAM = 306,
+    WABT_TOKEN_TYPE_RESULT = 307,
+    WABT_TOKEN_TYPE_LOCAL = 308,
+    WABT_TOKEN_TYPE_GLOBAL = 309,
+    WABT_TOKEN_TYPE_MODULE = 310,
+    WABT_TOKEN_TYPE_TABLE = 311,
+    WABT_TOKEN_TYPE_ELEM = 312,
+    WABT_TOKEN_TYPE_MEMORY = 313,
+    WABT_TOKEN_TYPE_DATA = 314,
+    WABT_TOKEN_TYPE_OFFSET = 315,
+    WABT_TOKEN_TYPE_IMPORT = 316,
+    WABT_TOKEN_TYPE_EXPORT = 317,
+    WABT_TOKEN_TYPE_REGISTER = 318,
+    WABT_TOKEN_TYPE_INVOKE = 319,
+    WABT_TOKEN_TYPE_GET = 320,
+    WABT_TOKEN_TYPE_ASSERT_MALFORMED = 321,
+    WABT_TOKEN_TYPE_ASSERT_INVALID = 322,
+    WABT_TOKEN_TYPE_ASSERT_UNLINKABLE = 323,
+    WABT_TOKEN_TYPE_ASSERT_RETURN = 324,
+    WABT_TOKEN_TYPE_ASSERT_RETURN_CANONICAL_NAN = 325,
+    WABT_TOKEN_TYPE_ASSERT_RETURN_ARITHMETIC_NAN = 326,
+    WABT_TOKEN_TYPE_ASSERT_TRAP = 327,
+    WABT_TOKEN_TYPE_ASSERT_EXHAUSTION = 328,
+    WABT_TOKEN_TYPE_INPUT = 329,
+    WABT_TOKEN_TYPE_OUTPUT = 330,
+    WABT_TOKEN_TYPE_LOW = 331
   };
 #endif
 
@@ -278,7 +278,7 @@ namespace std {
 // hash support
 template <>
 struct hash<::wabt::string_view> {
-  ::wabt::hash_code operator()(const ::wabt::string_view& sv) {
+  ::wabt::hash_code operator()(const ::wabt::string_view& sv) const {
     return ::wabt::hash_range(sv.begin(), sv.end());
   }
 };
@@ -0,0 +1,571 @@
+/*
+ * Copyright 2017 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "ast.h"
+#include "ast-parser.h"
+#include "binary-reader.h"
+#include "binary-reader-interpreter.h"
+#include "binary-writer.h"
+#include "interpreter.h"
+#include "option-parser.h"
+#include "resolve-names.h"
+#include "stream.h"
+#include "validator.h"
+#include "writer.h"
+
+#define PROGRAM_NAME "wabt-bench"
+
+#define NOPE HasArgument::No
+#define YEP HasArgument::Yes
+
+#define BENCH_RESULTS_VERSION 1
+
+#define CHECK_RESULT(expr)  \
+  do {                      \
+    if (WABT_FAILED(expr))  \
+      return Result::Error; \
+  } while (0)
+
+using namespace wabt;
+
+static std::vector<const char*> s_infiles;
+static const char* s_outfile;
+static int s_repeat = 5;
+static uint32_t s_iterations;
+static bool s_decode;
+static ReadBinaryOptions s_read_binary_options =
+    WABT_READ_BINARY_OPTIONS_DEFAULT;
+static ReadBinaryInterpreterOptions s_read_binary_interpreter_options =
+    WABT_READ_BINARY_INTERPRETER_OPTIONS_DEFAULT;
+static InterpreterThreadOptions s_thread_options =
+    WABT_INTERPRETER_THREAD_OPTIONS_DEFAULT;
+
+static SourceErrorHandler s_source_error_handler =
+    WABT_SOURCE_ERROR_HANDLER_DEFAULT;
+static BinaryErrorHandler s_binary_error_handler =
+    WABT_BINARY_ERROR_HANDLER_DEFAULT;
+
+enum {
+  FLAG_HELP,
+  FLAG_OUTPUT,
+  FLAG_REPEAT,
+  FLAG_ITERATIONS,
+  FLAG_ALIGNED_ISTREAM,
+  FLAG_REGISTER_OPS,
+  FLAG_TIER_UP,
+  FLAG_DECODE,
+  NUM_FLAGS
+};
+
+static const char s_description[] =
+    "  run interpreter benchmarks, and write the timings as JSON.\n"
+    "\n"
+    "  each benchmark is a .wast or .wasm module that exports a function\n"
+    "  \"run\" taking an iteration count and returning an i32, and an i32\n"
+    "  global \"iterations\" with its default iteration count. if it also\n"
+    "  exports a function \"verify\", that is called after the last run, and\n"
+    "  must return non-zero.\n"
+    "\n"
+    "  the time to instantiate the module and the time of each run are\n"
+    "  measured --repeat times, after one untimed warm-up run.\n"
+    "\n"
+    "  with --decode, any .wasm or .wast module can be given instead. only\n"
+    "  the binary reader is timed, without callbacks, and the decode\n"
+    "  throughput is reported in bytes per second.\n"
+    "\n"
+    "examples:\n"
+    "  # run the benchmark suite and write the results to results.json\n"
+    "  $ wabt-bench bench/*.wast -o results.json\n"
+    "\n"
+    "  # same, with the interpreter's register instructions\n"
+    "  $ wabt-bench bench/*.wast --register-ops -o results.json\n"
+    "\n"
+    "  # measure the binary reader's throughput on some real modules\n"
+    "  $ wabt-bench --decode app.wasm lib.wasm\n";
+
+static Option s_options[] = {
+    {FLAG_HELP, 'h', "help", nullptr, NOPE, "print this help message"},
+    {FLAG_OUTPUT, 'o', "output", "FILENAME", YEP,
+     "output file for the JSON results, stdout by default"},
+    {FLAG_REPEAT, 'r', "repeat", "COUNT", YEP,
+     "number of timed runs of each benchmark, 5 by default"},
+    {FLAG_ITERATIONS, 'n', "iterations", "COUNT", YEP,
+     "iteration count passed to every benchmark, instead of its own"},
+    {FLAG_ALIGNED_ISTREAM, 0, "aligned-istream", nullptr, NOPE,
+     "use the aligned (larger, but faster to decode) internal bytecode"},
+    {FLAG_REGISTER_OPS, 0, "register-ops", nullptr, NOPE,
+     "compile integer ops on locals and constants to register instructions"},
+    {FLAG_TIER_UP, 0, "tier-up", "COUNT", YEP,
+     "recompile a function with register instructions once it has been "
+     "called, or looped, COUNT times"},
+    {FLAG_DECODE, 0, "decode", nullptr, NOPE,
+     "only time decoding each module with the binary reader"},
+};
+WABT_STATIC_ASSERT(NUM_FLAGS == WABT_ARRAY_SIZE(s_options));
+
+static void on_option(struct OptionParser* parser,
+                      struct Option* option,
+                      const char* argument) {
+  switch (option->id) {
+    case FLAG_HELP:
+      print_help(parser, PROGRAM_NAME);
+      exit(0);
+      break;
+
+    case FLAG_OUTPUT:
+      s_outfile = argument;
+      break;
+
+    case FLAG_REPEAT:
+      s_repeat = atoi(argument);
+      if (s_repeat <= 0)
+        WABT_FATAL("--repeat must be positive.\n");
+      break;
+
+    case FLAG_ITERATIONS:
+      s_iterations = atoi(argument);
+      break;
+
+    case FLAG_ALIGNED_ISTREAM:
+      s_read_binary_interpreter_options.istream_encoding =
+          InterpreterIstreamEncoding::Aligned;
+      break;
+
+    case FLAG_REGISTER_OPS:
+      s_read_binary_interpreter_options.register_ops = true;
+      break;
+
+    case FLAG_TIER_UP:
+      s_read_binary_interpreter_options.tier_up_threshold = atoi(argument);
+      break;
+
+    case FLAG_DECODE:
+      s_decode = true;
+      break;
+  }
+}
+
+static void on_argument(struct OptionParser* parser, const char* argument) {
+  s_infiles.push_back(argument);
+}
+
+static void on_option_error(struct OptionParser* parser, const char* message) {
+  WABT_FATAL("%s\n", message);
+}
+
+static void parse_options(int argc, char** argv) {
+  OptionParser parser;
+  WABT_ZERO_MEMORY(parser);
+  parser.description = s_description;
+  parser.options = s_options;
+  parser.num_options = WABT_ARRAY_SIZE(s_options);
+  parser.on_option = on_option;
+  parser.on_argument = on_argument;
+  parser.on_error = on_option_error;
+  parse_options(&parser, argc, argv);
+
+  if (s_infiles.empty()) {
+    print_help(&parser, PROGRAM_NAME);
+    WABT_FATAL("No filename given.\n");
+  }
+}
+
+struct Timings {
+  uint64_t min_ns;
+  uint64_t median_ns;
+};
+
+struct BenchResult {
+  BenchResult()
+      : size(0), iterations(0), result(0), has_verify(false), verified(false) {
+    WABT_ZERO_MEMORY(decode);
+    WABT_ZERO_MEMORY(instantiate);
+    WABT_ZERO_MEMORY(run);
+  }
+
+  const char* filename;
+  size_t size;
+  uint32_t iterations;
+  uint32_t result;
+  bool has_verify;
+  bool verified;
+  Timings decode;
+  Timings instantiate;
+  Timings run;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+static uint64_t elapsed_ns(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              start)
+      .count();
+}
+
+static Timings summarize(std::vector<uint64_t>* samples) {
+  assert(!samples->empty());
+  std::sort(samples->begin(), samples->end());
+  Timings timings;
+  timings.min_ns = samples->front();
+  timings.median_ns = (*samples)[samples->size() / 2];
+  return timings;
+}
+
+static bool has_suffix(const char* s, const char* suffix) {
+  size_t length = strlen(s);
+  size_t suffix_length = strlen(suffix);
+  return length >= suffix_length &&
+         strcmp(s + length - suffix_length, suffix) == 0;
+}
+
+/* Reads |filename| into |out_buf|, converting it to the binary format if it
+ * is a .wast file. */
+static Result read_module_binary(const char* filename, OutputBuffer* out_buf) {
+  if (!has_suffix(filename, ".wast")) {
+    char* data;
+    size_t size;
+    if (WABT_FAILED(read_file(filename, &data, &size)))
+      return Result::Error;
+    init_output_buffer(out_buf, size);
+    if (size != 0)
+      memcpy(out_buf->start, data, size);
+    out_buf->size = size;
+    delete[] data;
+    return Result::Ok;
+  }
+
+  AstLexer* lexer = new_ast_file_lexer(filename);
+  if (!lexer) {
+    fprintf(stderr, "unable to read file: %s\n", filename);
+    return Result::Error;
+  }
+
+  Script* script = nullptr;
+  Result result = parse_ast(lexer, &script, &s_source_error_handler);
+  if (WABT_SUCCEEDED(result))
+    result = resolve_names_script(lexer, script, &s_source_error_handler);
+  if (WABT_SUCCEEDED(result))
+    result = validate_script(lexer, script, &s_source_error_handler);
+  if (WABT_SUCCEEDED(result)) {
+    Module* module = get_first_module(script);
+    if (module) {
+      MemoryWriter writer;
+      WABT_ZERO_MEMORY(writer);
+      result = init_mem_writer(&writer);
+      if (WABT_SUCCEEDED(result)) {
+        WriteBinaryOptions options = WABT_WRITE_BINARY_OPTIONS_DEFAULT;
+        result = write_binary_module(&writer.base, module, &options);
+        if (WABT_SUCCEEDED(result))
+          steal_mem_writer_output_buffer(&writer, out_buf);
+        close_mem_writer(&writer);
+      }
+    } else {
+      fprintf(stderr, "%s: no module found\n", filename);
+      result = Result::Error;
+    }
+  }
+
+  destroy_ast_lexer(lexer);
+  delete script;
+  return result;
+}
+
+static Result instantiate(InterpreterEnvironment* env,
+                          InterpreterThread* thread,
+                          const OutputBuffer* buf,
+                          DefinedInterpreterModule** out_module) {
+  CHECK_RESULT(read_binary_interpreter(env, buf->start, buf->size,
+                                       &s_read_binary_options,
+                                       &s_read_binary_interpreter_options,
+                                       &s_binary_error_handler, out_module));
+  DefinedInterpreterModule* module = *out_module;
+  if (module->start_func_index == WABT_INVALID_INDEX)
+    return Result::Ok;
+
+  InterpreterCallable callable;
+  init_interpreter_callable(env, module->start_func_index, &callable);
+  InterpreterResult iresult =
+      call_interpreter_callable(thread, &callable, nullptr, nullptr);
+  return iresult == InterpreterResult::Ok ? Result::Ok : Result::Error;
+}
+
+static Result get_callable(InterpreterEnvironment* env,
+                           DefinedInterpreterModule* module,
+                           const char* name,
+                           uint32_t num_params,
+                           InterpreterCallable* out_callable) {
+  StringSlice name_slice = string_slice_from_cstr(name);
+  if (get_interpreter_callable_by_name(env, module, &name_slice,
+                                       out_callable) != InterpreterResult::Ok) {
+    return Result::Error;
+  }
+  if (out_callable->num_params != num_params ||
+      out_callable->num_results != 1) {
+    return Result::Error;
+  }
+  return Result::Ok;
+}
+
+static Result get_default_iterations(InterpreterEnvironment* env,
+                                     DefinedInterpreterModule* module,
+                                     uint32_t* out_iterations) {
+  StringSlice name = string_slice_from_cstr("iterations");
+  InterpreterExport* export_ = get_interpreter_export_by_name(module, &name);
+  if (!export_ || export_->kind != ExternalKind::Global)
+    return Result::Error;
+  const InterpreterTypedValue& value = env->globals[export_->index].typed_value;
+  if (value.type != Type::I32)
+    return Result::Error;
+  *out_iterations = value.value.i32;
+  return Result::Ok;
+}
+
+static Result call_i32(InterpreterThread* thread,
+                       const InterpreterCallable* callable,
+                       const InterpreterValue* args,
+                       uint32_t* out_result) {
+  InterpreterValue result;
+  InterpreterResult iresult =
+      call_interpreter_callable(thread, callable, args, &result);
+  if (iresult != InterpreterResult::Ok)
+    return Result::Error;
+  *out_result = result.i32;
+  return Result::Ok;
+}
+
+/* Times read_binary with no callbacks, so only the decoding itself is
+ * measured. */
+static Result run_decode_benchmark(const char* filename,
+                                   BenchResult* out_result) {
+  OutputBuffer buf;
+  WABT_ZERO_MEMORY(buf);
+  if (WABT_FAILED(read_module_binary(filename, &buf)))
+    return Result::Error;
+
+  out_result->filename = filename;
+  out_result->size = buf.size;
+
+  BinaryReader reader;
+  WABT_ZERO_MEMORY(reader);
+  Result result = Result::Ok;
+  std::vector<uint64_t> samples;
+  for (int i = 0; i <= s_repeat && WABT_SUCCEEDED(result); ++i) {
+    Clock::time_point start = Clock::now();
+    result = read_binary(buf.start, buf.size, &reader, 1,
+                         &s_read_binary_options);
+    samples.push_back(elapsed_ns(start));
+  }
+  if (WABT_SUCCEEDED(result)) {
+    samples.erase(samples.begin());
+    out_result->decode = summarize(&samples);
+  } else {
+    fprintf(stderr, "%s: unable to decode\n", filename);
+  }
+  destroy_output_buffer(&buf);
+  return result;
+}
+
+static Result run_benchmark(const char* filename, BenchResult* out_result) {
+  OutputBuffer buf;
+  WABT_ZERO_MEMORY(buf);
+  if (WABT_FAILED(read_module_binary(filename, &buf)))
+    return Result::Error;
+
+  InterpreterEnvironment env;
+  InterpreterThread thread;
+  init_interpreter_thread(&env, &thread, &s_thread_options);
+  out_result->filename = filename;
+
+  Result result = Result::Ok;
+  DefinedInterpreterModule* module = nullptr;
+  std::vector<uint64_t> samples;
+  InterpreterEnvironmentMark mark = mark_interpreter_environment(&env);
+  for (int i = 0; i <= s_repeat && WABT_SUCCEEDED(result); ++i) {
+    reset_interpreter_environment_to_mark(&env, mark);
+    Clock::time_point start = Clock::now();
+    result = instantiate(&env, &thread, &buf, &module);
+    samples.push_back(elapsed_ns(start));
+  }
+  if (WABT_FAILED(result)) {
+    fprintf(stderr, "%s: unable to instantiate\n", filename);
+    goto done;
+  }
+  /* the first instantiation is the warm-up */
+  samples.erase(samples.begin());
+  out_result->instantiate = summarize(&samples);
+
+  {
+    InterpreterCallable run;
+    InterpreterCallable verify;
+    if (WABT_FAILED(get_callable(&env, module, "run", 1, &run))) {
+      fprintf(stderr, "%s: expected an exported func \"run\" (i32) -> i32\n",
+              filename);
+      result = Result::Error;
+      goto done;
+    }
+    out_result->iterations = s_iterations;
+    if (out_result->iterations == 0 &&
+        WABT_FAILED(get_default_iterations(&env, module,
+                                           &out_result->iterations))) {
+      fprintf(stderr, "%s: expected an exported i32 global \"iterations\"\n",
+              filename);
+      result = Result::Error;
+      goto done;
+    }
+
+    InterpreterValue arg;
+    arg.i32 = out_result->iterations;
+    samples.clear();
+    for (int i = 0; i <= s_repeat && WABT_SUCCEEDED(result); ++i) {
+      Clock::time_point start = Clock::now();
+      result = call_i32(&thread, &run, &arg, &out_result->result);
+      samples.push_back(elapsed_ns(start));
+    }
+    if (WABT_FAILED(result)) {
+      fprintf(stderr, "%s: \"run\" trapped\n", filename);
+      goto done;
+    }
+    samples.erase(samples.begin());
+    out_result->run = summarize(&samples);
+
+    if (WABT_SUCCEEDED(get_callable(&env, module, "verify", 0, &verify))) {
+      uint32_t verified;
+      out_result->has_verify = true;
+      out_result->verified =
+          WABT_SUCCEEDED(call_i32(&thread, &verify, nullptr, &verified)) &&
+          verified != 0;
+      if (!out_result->verified) {
+        fprintf(stderr, "%s: verify failed\n", filename);
+        result = Result::Error;
+      }
+    }
+  }
+
+done:
+  destroy_interpreter_environment(&env);
+  destroy_output_buffer(&buf);
+  return result;
+}
+
+static void write_json_string(Stream* stream, const char* s) {
+  write_char(stream, '"');
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      write_char(stream, '\\');
+    write_char(stream, *s);
+  }
+  write_char(stream, '"');
+}
+
+static void write_timings(Stream* stream, const char* name, Timings timings) {
+  writef(stream, "      \"%s\": {\"min\": %" PRIu64 ", \"median\": %" PRIu64
+                 "}",
+         name, timings.min_ns, timings.median_ns);
+}
+
+static void write_decode_result(Stream* stream, const BenchResult& result) {
+  writef(stream, "      \"size\": %" PRIu64 ",\n",
+         static_cast<uint64_t>(result.size));
+  write_timings(stream, "decode_ns", result.decode);
+  uint64_t bytes_per_second =
+      result.decode.min_ns
+          ? static_cast<uint64_t>(result.size * 1e9 / result.decode.min_ns)
+          : 0;
+  writef(stream, ",\n      \"decode_bytes_per_second\": %" PRIu64,
+         bytes_per_second);
+}
+
+static void write_run_result(Stream* stream, const BenchResult& result) {
+  writef(stream, "      \"iterations\": %u,\n", result.iterations);
+  writef(stream, "      \"result\": %u,\n", result.result);
+  if (result.has_verify)
+    writef(stream, "      \"verified\": %s,\n",
+           result.verified ? "true" : "false");
+  write_timings(stream, "instantiate_ns", result.instantiate);
+  writef(stream, ",\n");
+  write_timings(stream, "run_ns", result.run);
+}
+
+static void write_results(Stream* stream,
+                          const std::vector<BenchResult>& results) {
+  writef(stream, "{\n  \"version\": %d,\n", BENCH_RESULTS_VERSION);
+  writef(stream, "  \"repeat\": %d,\n", s_repeat);
+  if (s_decode) {
+    writef(stream, "  \"decode\": true,\n");
+  } else {
+    writef(stream, "  \"options\": {\"aligned_istream\": %s, "
+                   "\"register_ops\": %s, \"tier_up\": %u},\n",
+           s_read_binary_interpreter_options.istream_encoding ==
+                   InterpreterIstreamEncoding::Aligned
+               ? "true"
+               : "false",
+           s_read_binary_interpreter_options.register_ops ? "true" : "false",
+           s_read_binary_interpreter_options.tier_up_threshold);
+  }
+  writef(stream, "  \"benchmarks\": [");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& result = results[i];
+    writef(stream, "%s\n    {\n      \"file\": ", i == 0 ? "" : ",");
+    write_json_string(stream, result.filename);
+    writef(stream, ",\n");
+    if (s_decode)
+      write_decode_result(stream, result);
+    else
+      write_run_result(stream, result);
+    writef(stream, "\n    }");
+  }
+  writef(stream, "\n  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+  init_stdio();
+  parse_options(argc, argv);
+
+  Result result = Result::Ok;
+  std::vector<BenchResult> results;
+  for (const char* filename : s_infiles) {
+    BenchResult bench_result;
+    Result bench = s_decode ? run_decode_benchmark(filename, &bench_result)
+                            : run_benchmark(filename, &bench_result);
+    if (WABT_SUCCEEDED(bench))
+      results.push_back(bench_result);
+    else
+      result = Result::Error;
+  }
+
+  if (s_outfile) {
+    FileWriter writer;
+    if (WABT_FAILED(init_file_writer(&writer, s_outfile)))
+      WABT_FATAL("unable to open %s for writing\n", s_outfile);
+    Stream stream;
+    init_stream(&stream, &writer.base, nullptr);
+    write_results(&stream, results);
+    close_file_writer(&writer);
+  } else {
+    write_results(init_stdout_stream(), results);
+  }
+  return result != Result::Ok;
+}
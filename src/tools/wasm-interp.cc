@@ -19,14 +19,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include "binary-reader.h"
 #include "binary-reader-interpreter.h"
 #include "interpreter.h"
+#include "interpreter-host-log.h"
 #include "literal.h"
 #include "option-parser.h"
 #include "stream.h"
+#include "writer.h"
 
 #define INSTRUCTION_QUANTUM 1000
 #define PROGRAM_NAME "wasm-interp"
@@ -41,14 +46,34 @@ static int s_verbose;
 static const char* s_infile;
 static ReadBinaryOptions s_read_binary_options =
     WABT_READ_BINARY_OPTIONS_DEFAULT;
+static ReadBinaryInterpreterOptions s_read_binary_interpreter_options =
+    WABT_READ_BINARY_INTERPRETER_OPTIONS_DEFAULT;
 static InterpreterThreadOptions s_thread_options =
     WABT_INTERPRETER_THREAD_OPTIONS_DEFAULT;
 static bool s_trace;
 static bool s_spec;
 static bool s_run_all_exports;
-static Stream* s_stdout_stream;
+static bool s_suspend_host_calls;
+static bool s_map_data_segments;
+static size_t s_read_chunk_size;
+static const char* s_record_host_calls_filename;
+static const char* s_replay_host_calls_filename;
+static int s_jobs = 1;
 
-static BinaryErrorHandler s_error_handler = WABT_BINARY_ERROR_HANDLER_DEFAULT;
+/* Everything printed while running goes to these streams. With --jobs, each
+ * thread points them at the buffers of the commands it is running, so the
+ * output can be written in order afterward. */
+static thread_local Stream* s_stdout_stream;
+static thread_local Stream* s_stderr_stream;
+
+/* the results of the suspended host call, with --suspend-host-calls */
+static thread_local std::vector<InterpreterTypedValue> s_pending_host_results;
+
+static bool on_binary_error(uint32_t offset,
+                            const char* error,
+                            void* user_data);
+
+static BinaryErrorHandler s_error_handler = {on_binary_error, nullptr};
 
 static FileWriter s_log_stream_writer;
 static Stream s_log_stream;
@@ -69,6 +94,15 @@ enum {
   FLAG_TRACE,
   FLAG_SPEC,
   FLAG_RUN_ALL_EXPORTS,
+  FLAG_ALIGNED_ISTREAM,
+  FLAG_REGISTER_OPS,
+  FLAG_TIER_UP,
+  FLAG_MAP_DATA_SEGMENTS,
+  FLAG_READ_CHUNK_SIZE,
+  FLAG_SUSPEND_HOST_CALLS,
+  FLAG_RECORD_HOST_CALLS,
+  FLAG_REPLAY_HOST_CALLS,
+  FLAG_JOBS,
   NUM_FLAGS
 };
 
@@ -90,9 +124,17 @@ static const char s_description[] =
     "  # parse test.json and run the spec tests\n"
     "  $ wasm-interp test.json --spec\n"
     "\n"
+    "  # run the spec tests, running independent modules on 4 threads\n"
+    "  $ wasm-interp test.json --spec -j 4\n"
+    "\n"
     "  # parse test.wasm and run all its exported functions, setting the\n"
     "  # value stack size to 100 elements\n"
-    "  $ wasm-interp test.wasm -V 100 --run-all-exports\n";
+    "  $ wasm-interp test.wasm -V 100 --run-all-exports\n"
+    "\n"
+    "  # run test.wasm, logging its host calls, then run it again with the\n"
+    "  # host calls answered from the log\n"
+    "  $ wasm-interp test.wasm --run-all-exports --record-host-calls=test.log\n"
+    "  $ wasm-interp test.wasm --run-all-exports --replay-host-calls=test.log\n";
 
 static Option s_options[] = {
     {FLAG_VERBOSE, 'v', "verbose", nullptr, NOPE,
@@ -107,6 +149,31 @@ static Option s_options[] = {
      "run spec tests (input file should be .json)"},
     {FLAG_RUN_ALL_EXPORTS, 0, "run-all-exports", nullptr, NOPE,
      "run all the exported functions, in order. useful for testing"},
+    {FLAG_ALIGNED_ISTREAM, 0, "aligned-istream", nullptr, NOPE,
+     "use the aligned (larger, but faster to decode) internal bytecode"},
+    {FLAG_REGISTER_OPS, 0, "register-ops", nullptr, NOPE,
+     "compile integer ops on locals and constants to register instructions"},
+    {FLAG_TIER_UP, 0, "tier-up", "COUNT", YEP,
+     "recompile a function with register instructions once it has been "
+     "called, or looped, COUNT times"},
+    {FLAG_MAP_DATA_SEGMENTS, 0, "map-data-segments", nullptr, NOPE,
+     "map data segments copy-on-write from the module file where page "
+     "alignment allows, instead of copying them into memory. the file must "
+     "not be truncated while running"},
+    {FLAG_READ_CHUNK_SIZE, 0, "read-chunk-size", "SIZE", YEP,
+     "read the module in chunks of SIZE bytes, compiling each function as "
+     "soon as it has been read. useful for pipes"},
+    {FLAG_SUSPEND_HOST_CALLS, 0, "suspend-host-calls", nullptr, NOPE,
+     "suspend the thread on each host call, and resume it with the results "
+     "afterward. useful for testing"},
+    {FLAG_RECORD_HOST_CALLS, 0, "record-host-calls", "FILE", YEP,
+     "write the arguments and results of every host call to FILE"},
+    {FLAG_REPLAY_HOST_CALLS, 0, "replay-host-calls", "FILE", YEP,
+     "answer host calls with the results recorded in FILE, without calling "
+     "the host. the functions named in FILE can be imported even if there "
+     "is no host for them"},
+    {FLAG_JOBS, 'j', "jobs", "N", YEP,
+     "with --spec, run the commands of independent modules on N threads"},
 };
 WABT_STATIC_ASSERT(NUM_FLAGS == WABT_ARRAY_SIZE(s_options));
 
@@ -147,6 +214,47 @@ static void on_option(struct OptionParser* parser,
     case FLAG_RUN_ALL_EXPORTS:
       s_run_all_exports = true;
       break;
+
+    case FLAG_ALIGNED_ISTREAM:
+      s_read_binary_interpreter_options.istream_encoding =
+          InterpreterIstreamEncoding::Aligned;
+      break;
+
+    case FLAG_REGISTER_OPS:
+      s_read_binary_interpreter_options.register_ops = true;
+      break;
+
+    case FLAG_TIER_UP:
+      s_read_binary_interpreter_options.tier_up_threshold = atoi(argument);
+      break;
+
+    case FLAG_MAP_DATA_SEGMENTS:
+      s_map_data_segments = true;
+      break;
+
+    case FLAG_READ_CHUNK_SIZE:
+      s_read_chunk_size = atoi(argument);
+      if (s_read_chunk_size == 0)
+        WABT_FATAL("--read-chunk-size must be at least 1.\n");
+      break;
+
+    case FLAG_SUSPEND_HOST_CALLS:
+      s_suspend_host_calls = true;
+      break;
+
+    case FLAG_RECORD_HOST_CALLS:
+      s_record_host_calls_filename = argument;
+      break;
+
+    case FLAG_REPLAY_HOST_CALLS:
+      s_replay_host_calls_filename = argument;
+      break;
+
+    case FLAG_JOBS:
+      s_jobs = atoi(argument);
+      if (s_jobs < 1)
+        WABT_FATAL("--jobs must be at least 1.\n");
+      break;
   }
 }
 
@@ -172,6 +280,29 @@ static void parse_options(int argc, char** argv) {
   if (s_spec && s_run_all_exports)
     WABT_FATAL("--spec and --run-all-exports are incompatible.\n");
 
+  if (s_record_host_calls_filename && s_replay_host_calls_filename)
+    WABT_FATAL("--record-host-calls and --replay-host-calls are "
+               "incompatible.\n");
+
+  if (s_spec &&
+      (s_record_host_calls_filename || s_replay_host_calls_filename)) {
+    WABT_FATAL("--spec can't be used with --record-host-calls or "
+               "--replay-host-calls.\n");
+  }
+
+  if (s_map_data_segments && s_read_chunk_size)
+    WABT_FATAL("--map-data-segments and --read-chunk-size are "
+               "incompatible.\n");
+
+  if (s_jobs > 1) {
+    if (!s_spec)
+      WABT_FATAL("--jobs can only be used with --spec.\n");
+    /* The binary reader log is written directly to stdout, so it can't be
+     * buffered per thread. */
+    if (s_verbose)
+      WABT_FATAL("--jobs can't be used with --verbose.\n");
+  }
+
   if (!s_infile) {
     print_help(&parser, PROGRAM_NAME);
     WABT_FATAL("No filename given.\n");
@@ -233,7 +364,7 @@ static void sprint_typed_value(char* buffer,
 static void print_typed_value(const InterpreterTypedValue* tv) {
   char buffer[MAX_TYPED_VALUE_CHARS];
   sprint_typed_value(buffer, sizeof(buffer), tv);
-  printf("%s", buffer);
+  writef(s_stdout_stream, "%s", buffer);
 }
 
 static void print_typed_value_vector(
@@ -241,13 +372,14 @@ static void print_typed_value_vector(
   for (size_t i = 0; i < values.size(); ++i) {
     print_typed_value(&values[i]);
     if (i != values.size() - 1)
-      printf(", ");
+      writef(s_stdout_stream, ", ");
   }
 }
 
 static void print_interpreter_result(const char* desc,
                                      InterpreterResult iresult) {
-  printf("%s: %s\n", desc, s_trap_strings[static_cast<size_t>(iresult)]);
+  writef(s_stdout_stream, "%s: %s\n", desc,
+         s_trap_strings[static_cast<size_t>(iresult)]);
 }
 
 static void print_call(StringSlice module_name,
@@ -255,22 +387,36 @@ static void print_call(StringSlice module_name,
                        const std::vector<InterpreterTypedValue>& args,
                        const std::vector<InterpreterTypedValue>& results,
                        InterpreterResult iresult) {
-  if (module_name.length)
-    printf(PRIstringslice ".", WABT_PRINTF_STRING_SLICE_ARG(module_name));
-  printf(PRIstringslice "(", WABT_PRINTF_STRING_SLICE_ARG(func_name));
+  if (module_name.length) {
+    writef(s_stdout_stream, PRIstringslice ".",
+           WABT_PRINTF_STRING_SLICE_ARG(module_name));
+  }
+  writef(s_stdout_stream, PRIstringslice "(",
+         WABT_PRINTF_STRING_SLICE_ARG(func_name));
   print_typed_value_vector(args);
-  printf(") =>");
+  writef(s_stdout_stream, ") =>");
   if (iresult == InterpreterResult::Ok) {
     if (results.size() > 0) {
-      printf(" ");
+      writef(s_stdout_stream, " ");
       print_typed_value_vector(results);
     }
-    printf("\n");
+    writef(s_stdout_stream, "\n");
   } else {
     print_interpreter_result(" error", iresult);
   }
 }
 
+/* Delivers the results saved by default_host_callback, as if the host call
+ * had completed asynchronously. */
+static InterpreterResult resume_host_call(InterpreterThread* thread) {
+  if (s_trace)
+    writef(s_stdout_stream, ">>> resuming suspended host call\n");
+  InterpreterResult iresult = resume_interpreter_thread(
+      thread, s_pending_host_results.size(), s_pending_host_results.data());
+  s_pending_host_results.clear();
+  return iresult;
+}
+
 static InterpreterResult run_defined_function(InterpreterThread* thread,
                                               uint32_t offset) {
   thread->pc = offset;
@@ -281,6 +427,8 @@ static InterpreterResult run_defined_function(InterpreterThread* thread,
     if (s_trace)
       trace_pc(thread, s_stdout_stream);
     iresult = run_interpreter(thread, quantum, call_stack_return_top);
+    if (iresult == InterpreterResult::Suspended)
+      iresult = resume_host_call(thread);
   }
   if (iresult != InterpreterResult::Returned)
     return iresult;
@@ -288,8 +436,7 @@ static InterpreterResult run_defined_function(InterpreterThread* thread,
   return InterpreterResult::Ok;
 }
 
-static InterpreterResult push_args(
-    InterpreterThread* thread,
+static InterpreterResult check_args(
     const InterpreterFuncSignature* sig,
     const std::vector<InterpreterTypedValue>& args) {
   if (sig->param_types.size() != args.size())
@@ -298,8 +445,15 @@ static InterpreterResult push_args(
   for (size_t i = 0; i < sig->param_types.size(); ++i) {
     if (sig->param_types[i] != args[i].type)
       return InterpreterResult::ArgumentTypeMismatch;
+  }
+  return InterpreterResult::Ok;
+}
 
-    InterpreterResult iresult = push_thread_value(thread, args[i].value);
+static InterpreterResult push_args(
+    InterpreterThread* thread,
+    const std::vector<InterpreterTypedValue>& args) {
+  for (const InterpreterTypedValue& arg : args) {
+    InterpreterResult iresult = push_thread_value(thread, arg.value);
     if (iresult != InterpreterResult::Ok) {
       thread->value_stack_top = thread->value_stack.data();
       return iresult;
@@ -333,11 +487,47 @@ static InterpreterResult run_function(
   assert(sig_index < thread->env->sigs.size());
   InterpreterFuncSignature* sig = &thread->env->sigs[sig_index];
 
-  InterpreterResult iresult = push_args(thread, sig, args);
+  InterpreterResult iresult = check_args(sig, args);
+  if (iresult != InterpreterResult::Ok)
+    return iresult;
+
+  if (!s_trace) {
+    /* use the embedder API; only tracing needs to step the thread here */
+    InterpreterCallable callable;
+    init_interpreter_callable(thread->env, func_index, &callable);
+    std::vector<InterpreterValue> arg_values;
+    for (const InterpreterTypedValue& arg : args)
+      arg_values.push_back(arg.value);
+    std::vector<InterpreterValue> result_values(callable.num_results);
+    iresult = call_interpreter_callable(thread, &callable, arg_values.data(),
+                                        result_values.data());
+    while (iresult == InterpreterResult::Suspended) {
+      iresult = resume_host_call(thread);
+      if (iresult == InterpreterResult::Ok) {
+        iresult = resume_interpreter_callable(thread, &callable,
+                                              result_values.data());
+      }
+    }
+    if (iresult == InterpreterResult::Ok) {
+      out_results->clear();
+      for (size_t i = 0; i < result_values.size(); ++i)
+        out_results->emplace_back(sig->result_types[i], result_values[i]);
+    }
+    /* resume_host_call may have failed without resetting the stacks */
+    thread->value_stack_top = thread->value_stack.data();
+    thread->call_stack_top = thread->call_stack.data();
+    return iresult;
+  }
+
+  iresult = push_args(thread, args);
   if (iresult == InterpreterResult::Ok) {
-    iresult = func->is_host
-                  ? call_host(thread, func->as_host())
-                  : run_defined_function(thread, func->as_defined()->offset);
+    if (func->is_host) {
+      iresult = call_host(thread, func->as_host());
+      if (iresult == InterpreterResult::Suspended)
+        iresult = resume_host_call(thread);
+    } else {
+      iresult = run_defined_function(thread, func->as_defined()->offset);
+    }
     if (iresult == InterpreterResult::Ok)
       copy_results(thread, sig, out_results);
   }
@@ -354,7 +544,7 @@ static InterpreterResult run_start_function(InterpreterThread* thread,
     return InterpreterResult::Ok;
 
   if (s_trace)
-    printf(">>> running start function:\n");
+    writef(s_stdout_stream, ">>> running start function:\n");
   std::vector<InterpreterTypedValue> args;
   std::vector<InterpreterTypedValue> results;
   InterpreterResult iresult =
@@ -369,7 +559,7 @@ static InterpreterResult run_export(
     const std::vector<InterpreterTypedValue>& args,
     std::vector<InterpreterTypedValue>* out_results) {
   if (s_trace) {
-    printf(">>> running export \"" PRIstringslice "\":\n",
+    writef(s_stdout_stream, ">>> running export \"" PRIstringslice "\":\n",
            WABT_PRINTF_STRING_SLICE_ARG(export_->name));
   }
 
@@ -422,31 +612,88 @@ static void run_all_exports(InterpreterModule* module,
   }
 }
 
+static Result read_module_in_chunks(const char* module_filename,
+                                    InterpreterEnvironment* env,
+                                    BinaryErrorHandler* error_handler,
+                                    DefinedInterpreterModule** out_module) {
+  FILE* infile = fopen(module_filename, "rb");
+  if (!infile) {
+    writef(s_stderr_stream, "unable to read file %s\n", module_filename);
+    return Result::Error;
+  }
+
+  InterpreterModuleStream* stream = new_interpreter_module_stream(
+      env, &s_read_binary_options, &s_read_binary_interpreter_options,
+      error_handler);
+  if (!stream) {
+    fclose(infile);
+    return Result::Error;
+  }
+
+  Result result = Result::Ok;
+  std::vector<char> chunk(s_read_chunk_size);
+  while (WABT_SUCCEEDED(result)) {
+    size_t bytes = fread(chunk.data(), 1, chunk.size(), infile);
+    if (bytes == 0)
+      break;
+    result = feed_interpreter_module_stream(stream, chunk.data(), bytes);
+  }
+  if (ferror(infile)) {
+    writef(s_stderr_stream, "unable to read file %s\n", module_filename);
+    result = Result::Error;
+  }
+  fclose(infile);
+
+  if (WABT_SUCCEEDED(result))
+    result = finish_interpreter_module_stream(stream, out_module);
+  delete_interpreter_module_stream(stream);
+  if (WABT_SUCCEEDED(result) && s_verbose)
+    disassemble_module(env, s_stdout_stream, *out_module);
+  return result;
+}
+
+static Result read_mapped_module(const MappedFile* file,
+                                 InterpreterEnvironment* env,
+                                 BinaryErrorHandler* error_handler,
+                                 DefinedInterpreterModule** out_module) {
+  ReadBinaryInterpreterOptions interp_options =
+      s_read_binary_interpreter_options;
+  if (s_map_data_segments)
+    interp_options.data_segment_file = file;
+  Result result = read_binary_interpreter(
+      env, file->data, file->size, &s_read_binary_options, &interp_options,
+      error_handler, out_module);
+
+  if (WABT_SUCCEEDED(result)) {
+    if (s_verbose)
+      disassemble_module(env, s_stdout_stream, *out_module);
+  }
+  return result;
+}
+
 static Result read_module(const char* module_filename,
                           InterpreterEnvironment* env,
                           BinaryErrorHandler* error_handler,
                           DefinedInterpreterModule** out_module) {
   Result result;
-  char* data;
-  size_t size;
+  MappedFile file;
 
   *out_module = nullptr;
+  if (s_read_chunk_size)
+    return read_module_in_chunks(module_filename, env, error_handler,
+                                 out_module);
 
-  result = read_file(module_filename, &data, &size);
+  result = map_file(module_filename, &file);
   if (WABT_SUCCEEDED(result)) {
-    result = read_binary_interpreter(env, data, size, &s_read_binary_options,
-                                     error_handler, out_module);
-
-    if (WABT_SUCCEEDED(result)) {
-      if (s_verbose)
-        disassemble_module(env, s_stdout_stream, *out_module);
-    }
-    delete[] data;
+    result = read_mapped_module(&file, env, error_handler, out_module);
+    /* mapped data segment pages keep their own reference to the file */
+    unmap_file(&file);
   }
   return result;
 }
 
-static Result default_host_callback(const HostInterpreterFunc* func,
+static Result default_host_callback(InterpreterThread* thread,
+                                    const HostInterpreterFunc* func,
                                     const InterpreterFuncSignature* sig,
                                     uint32_t num_args,
                                     InterpreterTypedValue* args,
@@ -461,9 +708,14 @@ static Result default_host_callback(const HostInterpreterFunc* func,
   std::vector<InterpreterTypedValue> vec_results(out_results,
                                                  out_results + num_results);
 
-  printf("called host ");
+  writef(s_stdout_stream, "called host ");
   print_call(func->module_name, func->field_name, vec_args, vec_results,
              InterpreterResult::Ok);
+
+  if (s_suspend_host_calls) {
+    s_pending_host_results = vec_results;
+    suspend_interpreter_thread(thread);
+  }
   return Result::Ok;
 }
 
@@ -485,6 +737,7 @@ static Result spectest_import_func(InterpreterImport* import,
                                    void* user_data) {
   if (string_slice_eq_cstr(&import->field_name, "print")) {
     func->as_host()->callback = default_host_callback;
+    func->as_host()->user_data = user_data;
     return Result::Ok;
   } else {
     print_error(callback, "unknown host function import " PRIimport,
@@ -581,10 +834,24 @@ static Result read_and_run_module(const char* module_filename) {
   DefinedInterpreterModule* module = nullptr;
   InterpreterThread thread;
 
+  InterpreterHostLog host_log;
+
   init_environment(&env);
   init_interpreter_thread(&env, &thread, &s_thread_options);
-  result = read_module(module_filename, &env, &s_error_handler, &module);
+  if (s_replay_host_calls_filename) {
+    result = init_host_log_replayer(&host_log, s_replay_host_calls_filename);
+    if (WABT_SUCCEEDED(result))
+      add_host_log_imports(&host_log, &env);
+  } else {
+    init_host_log_recorder(&host_log);
+    result = Result::Ok;
+  }
+  if (WABT_SUCCEEDED(result))
+    result = read_module(module_filename, &env, &s_error_handler, &module);
   if (WABT_SUCCEEDED(result)) {
+    if (s_record_host_calls_filename)
+      wrap_host_funcs(&host_log, &env);
+
     InterpreterResult iresult = run_start_function(&thread, module);
     if (iresult == InterpreterResult::Ok) {
       if (s_run_all_exports)
@@ -592,7 +859,17 @@ static Result read_and_run_module(const char* module_filename) {
     } else {
       print_interpreter_result("error running start function", iresult);
     }
+
+    if (host_log.error) {
+      fprintf(stderr, "error replaying host calls: %s\n", host_log.error);
+      result = Result::Error;
+    }
+    if (s_record_host_calls_filename) {
+      result =
+          write_host_log_to_file(&host_log, s_record_host_calls_filename);
+    }
   }
+  destroy_host_log(&host_log);
   destroy_interpreter_environment(&env);
   return result;
 }
@@ -602,13 +879,15 @@ static Result read_and_run_module(const char* module_filename) {
 struct Context {
   Context()
       : last_module(nullptr),
+        module_file(nullptr),
         json_data(nullptr),
         json_data_size(0),
         json_offset(0),
         has_prev_loc(0),
         command_line_number(0),
         passed(0),
-        total(0) {
+        total(0),
+        module_failed(false) {
     WABT_ZERO_MEMORY(source_filename);
     WABT_ZERO_MEMORY(loc);
     WABT_ZERO_MEMORY(prev_loc);
@@ -617,6 +896,8 @@ struct Context {
   InterpreterEnvironment env;
   InterpreterThread thread;
   DefinedInterpreterModule* last_module;
+  /* With --jobs, the already mapped file of the module command being run */
+  const MappedFile* module_file;
 
   /* Parsing info */
   char* json_data;
@@ -631,6 +912,7 @@ struct Context {
   /* Test info */
   int passed;
   int total;
+  bool module_failed;
 };
 
 enum class ActionType {
@@ -650,6 +932,40 @@ struct Action {
   std::vector<InterpreterTypedValue> args;
 };
 
+enum class CommandType {
+  Module,
+  Action,
+  Register,
+  AssertMalformed,
+  AssertInvalid,
+  AssertUnlinkable,
+  AssertUninstantiable,
+  AssertReturn,
+  AssertReturnCanonicalNan,
+  AssertReturnArithmeticNan,
+  AssertTrap,
+  AssertExhaustion,
+};
+
+/* A parsed command. Which of the fields are used depends on the type. */
+struct Command {
+  Command() : type(CommandType::Module), line(0) {
+    WABT_ZERO_MEMORY(name);
+    WABT_ZERO_MEMORY(filename);
+    WABT_ZERO_MEMORY(text);
+    WABT_ZERO_MEMORY(as);
+  }
+
+  CommandType type;
+  uint32_t line;
+  StringSlice name;
+  StringSlice filename;
+  StringSlice text;
+  StringSlice as;
+  Action action;
+  std::vector<InterpreterTypedValue> expected;
+};
+
 #define CHECK_RESULT(x)     \
   do {                      \
     if (WABT_FAILED(x))     \
@@ -664,14 +980,14 @@ struct Action {
 static void WABT_PRINTF_FORMAT(2, 3)
     print_parse_error(Context* ctx, const char* format, ...) {
   WABT_SNPRINTF_ALLOCA(buffer, length, format);
-  fprintf(stderr, "%s:%d:%d: %s\n", ctx->loc.filename, ctx->loc.line,
-          ctx->loc.first_column, buffer);
+  writef(s_stderr_stream, "%s:%d:%d: %s\n", ctx->loc.filename, ctx->loc.line,
+         ctx->loc.first_column, buffer);
 }
 
 static void WABT_PRINTF_FORMAT(2, 3)
     print_command_error(Context* ctx, const char* format, ...) {
   WABT_SNPRINTF_ALLOCA(buffer, length, format);
-  printf(PRIstringslice ":%u: %s\n",
+  writef(s_stdout_stream, PRIstringslice ":%u: %s\n",
          WABT_PRINTF_STRING_SLICE_ARG(ctx->source_filename),
          ctx->command_line_number, buffer);
 }
@@ -1008,8 +1324,14 @@ static Result on_module_command(Context* ctx,
                                 StringSlice name) {
   char* path = create_module_path(ctx, filename);
   InterpreterEnvironmentMark mark = mark_interpreter_environment(&ctx->env);
-  Result result =
-      read_module(path, &ctx->env, &s_error_handler, &ctx->last_module);
+  Result result;
+  if (ctx->module_file && !s_read_chunk_size) {
+    result = read_mapped_module(ctx->module_file, &ctx->env, &s_error_handler,
+                                &ctx->last_module);
+  } else {
+    result =
+        read_module(path, &ctx->env, &s_error_handler, &ctx->last_module);
+  }
 
   if (WABT_FAILED(result)) {
     reset_interpreter_environment_to_mark(&ctx->env, mark);
@@ -1097,6 +1419,42 @@ static Result on_action_command(Context* ctx, Action* action) {
   return result;
 }
 
+/* Like default_binary_error_callback, but writes to |stream|. */
+static void print_binary_error(Stream* stream,
+                               DefaultErrorHandlerInfo* info,
+                               uint32_t offset,
+                               const char* error) {
+  if (info && info->header) {
+    if (info->print_header != PrintErrorHeader::Never) {
+      if (info->print_header == PrintErrorHeader::Once)
+        info->print_header = PrintErrorHeader::Never;
+      writef(stream, "%s:\n", info->header);
+    }
+    /* If there's a header, indent the following message. */
+    writef(stream, "  ");
+  }
+  if (offset == WABT_UNKNOWN_OFFSET)
+    writef(stream, "error: %s\n", error);
+  else
+    writef(stream, "error: @0x%08x: %s\n", offset, error);
+}
+
+static bool on_binary_error(uint32_t offset,
+                            const char* error,
+                            void* user_data) {
+  print_binary_error(s_stderr_stream, nullptr, offset, error);
+  return true;
+}
+
+static bool on_command_binary_error(uint32_t offset,
+                                    const char* error,
+                                    void* user_data) {
+  print_binary_error(s_stdout_stream,
+                     static_cast<DefaultErrorHandlerInfo*>(user_data), offset,
+                     error);
+  return true;
+}
+
 static BinaryErrorHandler* new_custom_error_handler(Context* ctx,
                                                     const char* desc) {
   size_t header_size = ctx->source_filename.length + strlen(desc) + 100;
@@ -1107,11 +1465,11 @@ static BinaryErrorHandler* new_custom_error_handler(Context* ctx,
 
   DefaultErrorHandlerInfo* info = new DefaultErrorHandlerInfo();
   info->header = header;
-  info->out_file = stdout;
+  info->out_file = nullptr;
   info->print_header = PrintErrorHeader::Once;
 
   BinaryErrorHandler* error_handler = new BinaryErrorHandler();
-  error_handler->on_error = default_binary_error_callback;
+  error_handler->on_error = on_command_binary_error;
   error_handler->user_data = info;
   return error_handler;
 }
@@ -1440,159 +1798,172 @@ static Result on_assert_exhaustion_command(Context* ctx, Action* action) {
   return result;
 }
 
-static Result parse_command(Context* ctx) {
+static Result parse_command(Context* ctx, Command* out_command) {
   EXPECT("{");
   EXPECT_KEY("type");
   if (match(ctx, "\"module\"")) {
-    StringSlice name;
-    StringSlice filename;
-    WABT_ZERO_MEMORY(name);
-    WABT_ZERO_MEMORY(filename);
-
+    out_command->type = CommandType::Module;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_opt_name_string_value(ctx, &name));
-    PARSE_KEY_STRING_VALUE("filename", &filename);
-    on_module_command(ctx, filename, name);
+    CHECK_RESULT(parse_opt_name_string_value(ctx, &out_command->name));
+    PARSE_KEY_STRING_VALUE("filename", &out_command->filename);
   } else if (match(ctx, "\"action\"")) {
-    Action action;
-
+    out_command->type = CommandType::Action;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
-    on_action_command(ctx, &action);
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
   } else if (match(ctx, "\"register\"")) {
-    StringSlice as;
-    StringSlice name;
-    WABT_ZERO_MEMORY(as);
-    WABT_ZERO_MEMORY(name);
-
+    out_command->type = CommandType::Register;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_opt_name_string_value(ctx, &name));
-    PARSE_KEY_STRING_VALUE("as", &as);
-    on_register_command(ctx, name, as);
+    CHECK_RESULT(parse_opt_name_string_value(ctx, &out_command->name));
+    PARSE_KEY_STRING_VALUE("as", &out_command->as);
   } else if (match(ctx, "\"assert_malformed\"")) {
-    StringSlice filename;
-    StringSlice text;
-    WABT_ZERO_MEMORY(filename);
-    WABT_ZERO_MEMORY(text);
-
+    out_command->type = CommandType::AssertMalformed;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("filename", &filename);
+    PARSE_KEY_STRING_VALUE("filename", &out_command->filename);
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("text", &text);
-    on_assert_malformed_command(ctx, filename, text);
+    PARSE_KEY_STRING_VALUE("text", &out_command->text);
   } else if (match(ctx, "\"assert_invalid\"")) {
-    StringSlice filename;
-    StringSlice text;
+    out_command->type = CommandType::AssertInvalid;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("filename", &filename);
+    PARSE_KEY_STRING_VALUE("filename", &out_command->filename);
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("text", &text);
-    on_assert_invalid_command(ctx, filename, text);
+    PARSE_KEY_STRING_VALUE("text", &out_command->text);
   } else if (match(ctx, "\"assert_unlinkable\"")) {
-    StringSlice filename;
-    StringSlice text;
-    WABT_ZERO_MEMORY(filename);
-    WABT_ZERO_MEMORY(text);
-
+    out_command->type = CommandType::AssertUnlinkable;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("filename", &filename);
+    PARSE_KEY_STRING_VALUE("filename", &out_command->filename);
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("text", &text);
-    on_assert_unlinkable_command(ctx, filename, text);
+    PARSE_KEY_STRING_VALUE("text", &out_command->text);
   } else if (match(ctx, "\"assert_uninstantiable\"")) {
-    StringSlice filename;
-    StringSlice text;
-    WABT_ZERO_MEMORY(filename);
-    WABT_ZERO_MEMORY(text);
-
+    out_command->type = CommandType::AssertUninstantiable;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("filename", &filename);
+    PARSE_KEY_STRING_VALUE("filename", &out_command->filename);
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("text", &text);
-    on_assert_uninstantiable_command(ctx, filename, text);
+    PARSE_KEY_STRING_VALUE("text", &out_command->text);
   } else if (match(ctx, "\"assert_return\"")) {
-    Action action;
-    std::vector<InterpreterTypedValue> expected;
-
+    out_command->type = CommandType::AssertReturn;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
     EXPECT(",");
     EXPECT_KEY("expected");
-    CHECK_RESULT(parse_const_vector(ctx, &expected));
-    on_assert_return_command(ctx, &action, expected);
+    CHECK_RESULT(parse_const_vector(ctx, &out_command->expected));
   } else if (match(ctx, "\"assert_return_canonical_nan\"")) {
-    Action action;
     TypeVector expected;
 
+    out_command->type = CommandType::AssertReturnCanonicalNan;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
     EXPECT(",");
     /* Not needed for wabt-interp, but useful for other parsers. */
     EXPECT_KEY("expected");
     CHECK_RESULT(parse_type_vector(ctx, &expected));
-    on_assert_return_nan_command(ctx, &action, true);
   } else if (match(ctx, "\"assert_return_arithmetic_nan\"")) {
-    Action action;
     TypeVector expected;
 
+    out_command->type = CommandType::AssertReturnArithmeticNan;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
     EXPECT(",");
     /* Not needed for wabt-interp, but useful for other parsers. */
     EXPECT_KEY("expected");
     CHECK_RESULT(parse_type_vector(ctx, &expected));
-    on_assert_return_nan_command(ctx, &action, false);
   } else if (match(ctx, "\"assert_trap\"")) {
-    Action action;
-    StringSlice text;
-    WABT_ZERO_MEMORY(text);
-
+    out_command->type = CommandType::AssertTrap;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
     EXPECT(",");
-    PARSE_KEY_STRING_VALUE("text", &text);
-    on_assert_trap_command(ctx, &action, text);
+    PARSE_KEY_STRING_VALUE("text", &out_command->text);
   } else if (match(ctx, "\"assert_exhaustion\"")) {
-    Action action;
-    StringSlice text;
-    WABT_ZERO_MEMORY(text);
-
+    out_command->type = CommandType::AssertExhaustion;
     EXPECT(",");
     CHECK_RESULT(parse_line(ctx));
     EXPECT(",");
-    CHECK_RESULT(parse_action(ctx, &action));
-    on_assert_exhaustion_command(ctx, &action);
+    CHECK_RESULT(parse_action(ctx, &out_command->action));
   } else {
     print_command_error(ctx, "unknown command type");
     return Result::Error;
   }
+  out_command->line = ctx->command_line_number;
   EXPECT("}");
   return Result::Ok;
 }
 
-static Result parse_commands(Context* ctx) {
+static Result run_command(Context* ctx, Command* command) {
+  ctx->command_line_number = command->line;
+  switch (command->type) {
+    case CommandType::Module: {
+      Result result =
+          on_module_command(ctx, command->filename, command->name);
+      if (WABT_FAILED(result))
+        ctx->module_failed = true;
+      return result;
+    }
+
+    case CommandType::Action:
+      return on_action_command(ctx, &command->action);
+
+    case CommandType::Register:
+      return on_register_command(ctx, command->name, command->as);
+
+    case CommandType::AssertMalformed:
+      return on_assert_malformed_command(ctx, command->filename,
+                                         command->text);
+
+    case CommandType::AssertInvalid:
+      return on_assert_invalid_command(ctx, command->filename, command->text);
+
+    case CommandType::AssertUnlinkable:
+      return on_assert_unlinkable_command(ctx, command->filename,
+                                          command->text);
+
+    case CommandType::AssertUninstantiable:
+      return on_assert_uninstantiable_command(ctx, command->filename,
+                                              command->text);
+
+    case CommandType::AssertReturn:
+      return on_assert_return_command(ctx, &command->action,
+                                      command->expected);
+
+    case CommandType::AssertReturnCanonicalNan:
+      return on_assert_return_nan_command(ctx, &command->action, true);
+
+    case CommandType::AssertReturnArithmeticNan:
+      return on_assert_return_nan_command(ctx, &command->action, false);
+
+    case CommandType::AssertTrap:
+      return on_assert_trap_command(ctx, &command->action, command->text);
+
+    case CommandType::AssertExhaustion:
+      return on_assert_exhaustion_command(ctx, &command->action);
+  }
+  assert(0);
+  return Result::Error;
+}
+
+/* If |out_commands| is null, each command is run as soon as it is parsed.
+ * Otherwise the commands are only collected. */
+static Result parse_commands(Context* ctx, std::vector<Command>* out_commands) {
   EXPECT("{");
   PARSE_KEY_STRING_VALUE("source_filename", &ctx->source_filename);
   EXPECT(",");
@@ -1602,38 +1973,345 @@ static Result parse_commands(Context* ctx) {
   while (!match(ctx, "]")) {
     if (!first)
       EXPECT(",");
-    CHECK_RESULT(parse_command(ctx));
+    Command command;
+    CHECK_RESULT(parse_command(ctx, &command));
+    if (out_commands)
+      out_commands->push_back(std::move(command));
+    else
+      run_command(ctx, &command);
     first = false;
   }
   EXPECT("}");
   return Result::Ok;
 }
 
+static void init_context(Context* ctx,
+                         const char* spec_json_filename,
+                         char* data,
+                         size_t size) {
+  ctx->loc.filename = spec_json_filename;
+  ctx->loc.line = 1;
+  ctx->loc.first_column = 1;
+  init_environment(&ctx->env);
+  init_interpreter_thread(&ctx->env, &ctx->thread, &s_thread_options);
+  ctx->json_data = data;
+  ctx->json_data_size = size;
+}
+
 static void destroy_context(Context* ctx) {
   destroy_interpreter_environment(&ctx->env);
-  delete[] ctx->json_data;
 }
 
-static Result read_and_run_spec_json(const char* spec_json_filename) {
+/* With --jobs, the commands are split into groups, each starting at a module
+ * command. A group is run on a worker thread, in its own environment, only if
+ * nothing else can observe its module: it doesn't register it, no other
+ * group names it, and it has no imports. (Even importing from "spectest"
+ * changes the host module, and so the errors printed for later modules.) All
+ * other groups run in order on the main thread. Each group's output is
+ * buffered and written in order once everything has finished, so the output
+ * is the same as running serially. */
+struct CommandGroup {
+  CommandGroup()
+      : first_command(0),
+        num_commands(0),
+        parallel(false),
+        passed(0),
+        total(0),
+        module_failed(false) {
+    WABT_ZERO_MEMORY(stdout_writer);
+    WABT_ZERO_MEMORY(stdout_stream);
+    WABT_ZERO_MEMORY(stderr_writer);
+    WABT_ZERO_MEMORY(stderr_stream);
+  }
+
+  size_t first_command;
+  size_t num_commands;
+  bool parallel;
+  MemoryWriter stdout_writer;
+  Stream stdout_stream;
+  MemoryWriter stderr_writer;
+  Stream stderr_stream;
+  /* the group's module, if it was mapped to check for imports */
+  MappedFile module_file;
+  int passed;
+  int total;
+  bool module_failed;
+};
+
+struct CommandGroupQueue {
+  CommandGroupQueue() : spec_json_filename(nullptr), next(0) {
+    WABT_ZERO_MEMORY(source_filename);
+  }
+
+  const char* spec_json_filename;
+  StringSlice source_filename;
+  std::vector<Command>* commands;
+  std::vector<CommandGroup>* groups;
+  std::vector<size_t> parallel_groups;
+  std::atomic<size_t> next;
+};
+
+static bool on_import_scan_error(BinaryReaderContext* ctx,
+                                 const char* message) {
+  /* Stopping the scan early is reported as an error; ignore it. */
+  return true;
+}
+
+static Result on_import_scan_begin_section(BinaryReaderContext* ctx,
+                                           BinarySection section_type,
+                                           uint32_t size) {
+  /* The import section is the only one that matters, so stop after it. */
+  if (section_type > BinarySection::Import)
+    return Result::Error;
+  return Result::Ok;
+}
+
+static Result on_import_scan_import_count(uint32_t count, void* user_data) {
+  *static_cast<bool*>(user_data) = count != 0;
+  return Result::Ok;
+}
+
+/* Maps the module to |out_file|, which the group keeps so that running its
+ * module command doesn't read the file again. */
+static bool module_has_imports(Context* ctx,
+                               StringSlice filename,
+                               MappedFile* out_file) {
+  char* path = create_module_path(ctx, filename);
+  Result result = map_file(path, out_file);
+  delete[] path;
+  if (WABT_FAILED(result)) {
+    out_file->data = nullptr;
+    return true;
+  }
+
+  bool has_imports = false;
+  BinaryReader reader;
+  WABT_ZERO_MEMORY(reader);
+  reader.user_data = &has_imports;
+  reader.on_error = on_import_scan_error;
+  reader.begin_section = on_import_scan_begin_section;
+  reader.on_import_count = on_import_scan_import_count;
+
+  ReadBinaryOptions options = WABT_READ_BINARY_OPTIONS_DEFAULT;
+  read_binary(out_file->data, out_file->size, &reader, 1, &options);
+  return has_imports;
+}
+
+static void split_command_groups(Context* ctx,
+                                 std::vector<Command>* commands,
+                                 std::vector<CommandGroup>* out_groups) {
+  /* The group that each command belongs to; commands before the first module
+   * belong to a group of their own. */
+  std::vector<size_t> command_group(commands->size());
+  for (size_t i = 0; i < commands->size(); ++i) {
+    if (i == 0 || (*commands)[i].type == CommandType::Module) {
+      out_groups->emplace_back();
+      out_groups->back().first_command = i;
+    }
+    out_groups->back().num_commands++;
+    command_group[i] = out_groups->size() - 1;
+  }
+
+  for (size_t i = 0; i < out_groups->size(); ++i) {
+    CommandGroup* group = &(*out_groups)[i];
+    const Command* module_command = &(*commands)[group->first_command];
+    if (module_command->type != CommandType::Module)
+      continue;
+
+    group->parallel = true;
+    for (size_t j = 0; j < group->num_commands && group->parallel; ++j) {
+      const Command* command = &(*commands)[group->first_command + j];
+      switch (command->type) {
+        case CommandType::Register:
+        case CommandType::AssertUnlinkable:
+        case CommandType::AssertUninstantiable:
+          group->parallel = false;
+          break;
+
+        case CommandType::Action:
+        case CommandType::AssertReturn:
+        case CommandType::AssertReturnCanonicalNan:
+        case CommandType::AssertReturnArithmeticNan:
+        case CommandType::AssertTrap:
+        case CommandType::AssertExhaustion:
+          if (!string_slice_is_empty(&command->action.module_name))
+            group->parallel = false;
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    if (group->parallel && !string_slice_is_empty(&module_command->name)) {
+      for (size_t j = 0; j < commands->size(); ++j) {
+        const Command* command = &(*commands)[j];
+        if (command_group[j] != i &&
+            (string_slices_are_equal(&command->name, &module_command->name) ||
+             string_slices_are_equal(&command->action.module_name,
+                                     &module_command->name))) {
+          group->parallel = false;
+          break;
+        }
+      }
+    }
+
+    if (group->parallel)
+      group->parallel = !module_has_imports(ctx, module_command->filename,
+                                            &group->module_file);
+  }
+}
+
+static void run_command_group(Context* ctx,
+                              std::vector<Command>* commands,
+                              CommandGroup* group) {
+  s_stdout_stream = &group->stdout_stream;
+  s_stderr_stream = &group->stderr_stream;
+  ctx->passed = ctx->total = 0;
+  ctx->module_failed = false;
+  if (group->module_file.data)
+    ctx->module_file = &group->module_file;
+  for (size_t i = 0; i < group->num_commands; ++i)
+    run_command(ctx, &(*commands)[group->first_command + i]);
+  ctx->module_file = nullptr;
+  group->passed = ctx->passed;
+  group->total = ctx->total;
+  group->module_failed = ctx->module_failed;
+}
+
+static void run_parallel_command_groups(CommandGroupQueue* queue) {
   Context ctx;
-  ctx.loc.filename = spec_json_filename;
-  ctx.loc.line = 1;
-  ctx.loc.first_column = 1;
-  init_environment(&ctx.env);
-  init_interpreter_thread(&ctx.env, &ctx.thread, &s_thread_options);
+  init_context(&ctx, queue->spec_json_filename, nullptr, 0);
+  ctx.source_filename = queue->source_filename;
+  InterpreterEnvironmentMark mark = mark_interpreter_environment(&ctx.env);
 
+  while (true) {
+    size_t index = queue->next++;
+    if (index >= queue->parallel_groups.size())
+      break;
+    CommandGroup* group = &(*queue->groups)[queue->parallel_groups[index]];
+    run_command_group(&ctx, queue->commands, group);
+    reset_interpreter_environment_to_mark(&ctx.env, mark);
+  }
+
+  destroy_context(&ctx);
+}
+
+/* Returns false, having printed nothing, if the script has to be run serially
+ * instead. */
+static bool run_spec_json_in_parallel(const char* spec_json_filename,
+                                      char* data,
+                                      size_t size,
+                                      Result* out_result) {
+  Stream* stdout_stream = s_stdout_stream;
+  Stream* stderr_stream = s_stderr_stream;
+
+  /* Discard the parse errors; running serially will report them. */
+  MemoryWriter discard_writer;
+  Stream discard_stream;
+  init_mem_writer(&discard_writer);
+  init_stream(&discard_stream, &discard_writer.base, nullptr);
+  s_stdout_stream = s_stderr_stream = &discard_stream;
+
+  Context ctx;
+  init_context(&ctx, spec_json_filename, data, size);
+  std::vector<Command> commands;
+  Result result = parse_commands(&ctx, &commands);
+  close_mem_writer(&discard_writer);
+  if (WABT_FAILED(result)) {
+    s_stdout_stream = stdout_stream;
+    s_stderr_stream = stderr_stream;
+    destroy_context(&ctx);
+    return false;
+  }
+
+  std::vector<CommandGroup> groups;
+  split_command_groups(&ctx, &commands, &groups);
+
+  CommandGroupQueue queue;
+  queue.spec_json_filename = spec_json_filename;
+  queue.source_filename = ctx.source_filename;
+  queue.commands = &commands;
+  queue.groups = &groups;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    CommandGroup* group = &groups[i];
+    init_mem_writer(&group->stdout_writer);
+    init_stream(&group->stdout_stream, &group->stdout_writer.base, nullptr);
+    init_mem_writer(&group->stderr_writer);
+    init_stream(&group->stderr_stream, &group->stderr_writer.base, nullptr);
+    if (group->parallel)
+      queue.parallel_groups.push_back(i);
+  }
+
+  size_t num_threads = std::min(static_cast<size_t>(s_jobs - 1),
+                                queue.parallel_groups.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back(run_parallel_command_groups, &queue);
+
+  for (CommandGroup& group : groups) {
+    if (!group.parallel)
+      run_command_group(&ctx, &commands, &group);
+  }
+
+  /* Help with the parallel groups once the serial ones are done. */
+  run_parallel_command_groups(&queue);
+  for (std::thread& thread : threads)
+    thread.join();
+  destroy_context(&ctx);
+  s_stdout_stream = stdout_stream;
+  s_stderr_stream = stderr_stream;
+
+  /* A failed module changes which module the following commands use, which
+   * the grouping doesn't account for. */
+  bool module_failed = false;
+  for (const CommandGroup& group : groups)
+    module_failed = module_failed || group.module_failed;
+
+  int passed = 0;
+  int total = 0;
+  for (CommandGroup& group : groups) {
+    if (!module_failed) {
+      write_data(s_stdout_stream, group.stdout_writer.buf.start,
+                 group.stdout_writer.buf.size, nullptr);
+      write_data(s_stderr_stream, group.stderr_writer.buf.start,
+                 group.stderr_writer.buf.size, nullptr);
+    }
+    passed += group.passed;
+    total += group.total;
+    close_mem_writer(&group.stdout_writer);
+    close_mem_writer(&group.stderr_writer);
+    if (group.module_file.data)
+      unmap_file(&group.module_file);
+  }
+
+  if (module_failed)
+    return false;
+
+  writef(s_stdout_stream, "%d/%d tests passed.\n", passed, total);
+  *out_result = Result::Ok;
+  return true;
+}
+
+static Result read_and_run_spec_json(const char* spec_json_filename) {
   char* data;
   size_t size;
   Result result = read_file(spec_json_filename, &data, &size);
   if (WABT_FAILED(result))
     return Result::Error;
 
-  ctx.json_data = data;
-  ctx.json_data_size = size;
+  if (s_jobs > 1 &&
+      run_spec_json_in_parallel(spec_json_filename, data, size, &result)) {
+    delete[] data;
+    return result;
+  }
 
-  result = parse_commands(&ctx);
-  printf("%d/%d tests passed.\n", ctx.passed, ctx.total);
+  Context ctx;
+  init_context(&ctx, spec_json_filename, data, size);
+  result = parse_commands(&ctx, nullptr);
+  writef(s_stdout_stream, "%d/%d tests passed.\n", ctx.passed, ctx.total);
   destroy_context(&ctx);
+  delete[] data;
   return result;
 }
 
@@ -1642,9 +2320,12 @@ int main(int argc, char** argv) {
   parse_options(argc, argv);
 
   s_stdout_stream = init_stdout_stream();
+  s_stderr_stream = init_stderr_stream();
 
   Result result;
   if (s_spec) {
+    /* Initialize the shared opcode table before any threads use it. */
+    init_opcode_info();
     result = read_and_run_spec_json(s_infile);
   } else {
     result = read_and_run_module(s_infile);
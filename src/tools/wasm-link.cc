@@ -137,11 +137,11 @@ Section::~Section() {
 }
 
 LinkerInputBinary::LinkerInputBinary(const char* filename,
-                                     uint8_t* data,
-                                     size_t size)
+                                     const MappedFile& file)
     : filename(filename),
-      data(data),
-      size(size),
+      file(file),
+      data(reinterpret_cast<uint8_t*>(file.data)),
+      size(file.size),
       active_function_imports(0),
       active_global_imports(0),
       type_index_offset(0),
@@ -153,7 +153,7 @@ LinkerInputBinary::LinkerInputBinary(const char* filename,
       table_elem_count(0) {}
 
 LinkerInputBinary::~LinkerInputBinary() {
-  delete[] data;
+  unmap_file(&file);
 }
 
 static uint32_t relocate_func_index(LinkerInputBinary* binary,
@@ -818,13 +818,11 @@ int main(int argc, char** argv) {
     const std::string& input_filename = s_infiles[i];
     if (s_debug)
       writef(&s_log_stream, "reading file: %s\n", input_filename.c_str());
-    char* data;
-    size_t size;
-    result = read_file(input_filename.c_str(), &data, &size);
+    MappedFile file;
+    result = map_file(input_filename.c_str(), &file, true);
     if (WABT_FAILED(result))
       return result != Result::Ok;
-    LinkerInputBinary* b = new LinkerInputBinary(
-        input_filename.c_str(), reinterpret_cast<uint8_t*>(data), size);
+    LinkerInputBinary* b = new LinkerInputBinary(input_filename.c_str(), file);
     context.inputs.emplace_back(b);
     LinkOptions options = { NULL };
     if (s_debug)
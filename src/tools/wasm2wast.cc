@@ -36,7 +36,8 @@ using namespace wabt;
 static int s_verbose;
 static const char* s_infile;
 static const char* s_outfile;
-static ReadBinaryOptions s_read_binary_options = {nullptr, true};
+static ReadBinaryOptions s_read_binary_options = {
+    nullptr, true, 1, WABT_READ_BINARY_ALL_SECTIONS, nullptr};
 static bool s_generate_names;
 
 static BinaryErrorHandler s_error_handler = WABT_BINARY_ERROR_HANDLER_DEFAULT;
@@ -53,6 +54,7 @@ enum {
   FLAG_OUTPUT,
   FLAG_NO_DEBUG_NAMES,
   FLAG_GENERATE_NAMES,
+  FLAG_JOBS,
   NUM_FLAGS
 };
 
@@ -65,7 +67,10 @@ static const char s_description[] =
     "  $ wasm2wast test.wasm -o test.wast\n"
     "\n"
     "  # parse test.wasm, write test.wast, but ignore the debug names, if any\n"
-    "  $ wasm2wast test.wasm --no-debug-names -o test.wast\n";
+    "  $ wasm2wast test.wasm --no-debug-names -o test.wast\n"
+    "\n"
+    "  # decode the function bodies of a large module on 8 threads\n"
+    "  $ wasm2wast big.wasm -j 8 -o big.wast\n";
 
 static Option s_options[] = {
     {FLAG_VERBOSE, 'v', "verbose", nullptr, NOPE,
@@ -77,6 +82,8 @@ static Option s_options[] = {
      "Ignore debug names in the binary file"},
     {FLAG_GENERATE_NAMES, 0, "generate-names", nullptr, NOPE,
      "Give auto-generated names to non-named functions, types, etc."},
+    {FLAG_JOBS, 'j', "jobs", "N", YEP,
+     "decode the function bodies on N threads"},
 };
 WABT_STATIC_ASSERT(NUM_FLAGS == WABT_ARRAY_SIZE(s_options));
 
@@ -107,6 +114,14 @@ static void on_option(struct OptionParser* parser,
     case FLAG_GENERATE_NAMES:
       s_generate_names = true;
       break;
+
+    case FLAG_JOBS: {
+      int jobs = atoi(argument);
+      if (jobs < 1)
+        WABT_FATAL("--jobs must be at least 1.\n");
+      s_read_binary_options.num_threads = jobs;
+      break;
+    }
   }
 }
 
@@ -141,12 +156,11 @@ int main(int argc, char** argv) {
   init_stdio();
   parse_options(argc, argv);
 
-  char* data;
-  size_t size;
-  result = read_file(s_infile, &data, &size);
+  MappedFile file;
+  result = map_file(s_infile, &file);
   if (WABT_SUCCEEDED(result)) {
     Module module;
-    result = read_binary_ast(data, size, &s_read_binary_options,
+    result = read_binary_ast(file.data, file.size, &s_read_binary_options,
                              &s_error_handler, &module);
     if (WABT_SUCCEEDED(result)) {
       if (s_generate_names)
@@ -173,7 +187,7 @@ int main(int argc, char** argv) {
         }
       }
     }
-    delete[] data;
+    unmap_file(&file);
   }
   return result != Result::Ok;
 }
@@ -51,7 +51,9 @@ static const char s_description[] =
     "  $ wasmdump test.wasm\n";
 
 static Option s_options[] = {
-    {FLAG_HEADERS, 'h', "headers", nullptr, NOPE, "print headers"},
+    {FLAG_HEADERS, 'h', "headers", nullptr, NOPE,
+     "print headers. on its own, only the section headers and custom "
+     "sections are validated"},
     {FLAG_SECTION, 'j', "section", nullptr, YEP, "select just one section"},
     {FLAG_RAW, 's', "full-contents", nullptr, NOPE,
      "print raw section contents"},
@@ -70,6 +72,10 @@ static ObjdumpOptions s_objdump_options;
 static FileWriter s_log_stream_writer;
 static Stream s_log_stream;
 
+/* A large stdout buffer, so that dumping a big module is limited by the rate
+ * the output can be written rather than by the number of writes. */
+static char s_stdout_buffer[1 << 20];
+
 static void on_argument(struct OptionParser* parser, const char* argument) {
   s_objdump_options.infile = argument;
 }
@@ -151,63 +157,16 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  char* char_data;
-  size_t size;
-  Result result = read_file(s_objdump_options.infile, &char_data, &size);
+  MappedFile file;
+  Result result = map_file(s_objdump_options.infile, &file);
   if (WABT_FAILED(result))
     return result != Result::Ok;
 
-  uint8_t* data = reinterpret_cast<uint8_t*>(char_data);
-
-  // Perform serveral passed over the binary in order to print out different
-  // types of information.
-  s_objdump_options.print_header = true;
-  if (!s_objdump_options.headers && !s_objdump_options.details &&
-      !s_objdump_options.disassemble && !s_objdump_options.raw) {
-    printf("At least one of the following switches must be given:\n");
-    printf(" -d/--disassemble\n");
-    printf(" -h/--headers\n");
-    printf(" -x/--details\n");
-    printf(" -s/--full-contents\n");
-    return 1;
-  }
-
-  s_objdump_options.mode = ObjdumpMode::Prepass;
-  result = read_binary_objdump(data, size, &s_objdump_options);
-  if (WABT_FAILED(result))
-    goto done;
-  s_objdump_options.log_stream = nullptr;
-
-  // Pass 1: Print the section headers
-  if (s_objdump_options.headers) {
-    s_objdump_options.mode = ObjdumpMode::Headers;
-    result = read_binary_objdump(data, size, &s_objdump_options);
-    if (WABT_FAILED(result))
-      goto done;
-    s_objdump_options.print_header = false;
-  }
-  // Pass 2: Print extra information based on section type
-  if (s_objdump_options.details) {
-    s_objdump_options.mode = ObjdumpMode::Details;
-    result = read_binary_objdump(data, size, &s_objdump_options);
-    if (WABT_FAILED(result))
-      goto done;
-    s_objdump_options.print_header = false;
-  }
-  if (s_objdump_options.disassemble) {
-    s_objdump_options.mode = ObjdumpMode::Disassemble;
-    result = read_binary_objdump(data, size, &s_objdump_options);
-    if (WABT_FAILED(result))
-      goto done;
-    s_objdump_options.print_header = false;
-  }
-  // Pass 3: Dump to raw contents of the sections
-  if (s_objdump_options.raw) {
-    s_objdump_options.mode = ObjdumpMode::RawData;
-    result = read_binary_objdump(data, size, &s_objdump_options);
-  }
+  setvbuf(stdout, s_stdout_buffer, _IOFBF, sizeof(s_stdout_buffer));
 
-done:
-  delete[] data;
+  result = read_binary_objdump(reinterpret_cast<uint8_t*>(file.data),
+                               file.size, &s_objdump_options);
+  fflush(stdout);
+  unmap_file(&file);
   return result != Result::Ok;
 }
@@ -21,6 +21,9 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "binary-reader.h"
 #include "binary-reader-opcnt.h"
@@ -35,10 +38,11 @@
 using namespace wabt;
 
 static int s_verbose;
-static const char* s_infile;
+static std::vector<const char*> s_infiles;
 static const char* s_outfile;
 static size_t s_cutoff = 0;
 static const char* s_separator = ": ";
+static int s_jobs = 1;
 
 static ReadBinaryOptions s_read_binary_options =
     WABT_READ_BINARY_OPTIONS_DEFAULT;
@@ -55,16 +59,20 @@ enum {
   FLAG_OUTPUT,
   FLAG_CUTOFF,
   FLAG_SEPARATOR,
+  FLAG_JOBS,
   NUM_FLAGS
 };
 
 static const char s_description[] =
-    "  Read a file in the wasm binary format, and count opcode usage for\n"
-    "  instructions.\n"
+    "  Read files in the wasm binary format, and count opcode usage for\n"
+    "  instructions. The counts of all the files are added up.\n"
     "\n"
     "examples:\n"
     "  # parse binary file test.wasm and write pcode dist file test.dist\n"
-    "  $ wasmopcodecnt test.wasm -o test.dist\n";
+    "  $ wasmopcodecnt test.wasm -o test.dist\n"
+    "\n"
+    "  # count all the modules in corpus/, reading 8 at a time\n"
+    "  $ wasmopcodecnt -j 8 corpus/*.wasm\n";
 
 static Option s_options[] = {
     {FLAG_VERBOSE, 'v', "verbose", nullptr, NOPE,
@@ -75,7 +83,10 @@ static Option s_options[] = {
     {FLAG_CUTOFF, 'c', "cutoff", "N", YEP,
      "cutoff for reporting counts less than N"},
     {FLAG_SEPARATOR, 's', "separator", "SEPARATOR", YEP,
-     "Separator text between element and count when reporting counts"}};
+     "Separator text between element and count when reporting counts"},
+    {FLAG_JOBS, 'j', "jobs", "N", YEP,
+     "count the files on N threads, or the function bodies if there is only "
+     "one file"}};
 
 WABT_STATIC_ASSERT(NUM_FLAGS == WABT_ARRAY_SIZE(s_options));
 
@@ -106,11 +117,19 @@ static void on_option(struct OptionParser* parser,
     case FLAG_SEPARATOR:
       s_separator = argument;
       break;
+
+    case FLAG_JOBS: {
+      int jobs = atoi(argument);
+      if (jobs < 1)
+        WABT_FATAL("--jobs must be at least 1.\n");
+      s_jobs = jobs;
+      break;
+    }
   }
 }
 
 static void on_argument(struct OptionParser* parser, const char* argument) {
-  s_infile = argument;
+  s_infiles.push_back(argument);
 }
 
 static void on_option_error(struct OptionParser* parser, const char* message) {
@@ -128,7 +147,7 @@ static void parse_options(int argc, char** argv) {
   parser.on_error = on_option_error;
   parse_options(&parser, argc, argv);
 
-  if (!s_infile) {
+  if (s_infiles.empty()) {
     print_help(&parser, PROGRAM_NAME);
     WABT_FATAL("No filename given.\n");
   }
@@ -287,52 +306,138 @@ static void display_sorted_int_pair_counter_vector(
                                   display_second_fcn, opcode_name);
 }
 
+static void display_sorted_int_counter_map(FILE* out,
+                                           const char* title,
+                                           const IntCounterMap& map,
+                                           int_counter_lt_fcn lt_fcn,
+                                           display_name_fcn display_fcn,
+                                           const char* opcode_name) {
+  IntCounterVector vec;
+  for (const auto& counter : map)
+    vec.emplace_back(counter.first, counter.second);
+  display_sorted_int_counter_vector(out, title, vec, lt_fcn, display_fcn,
+                                    opcode_name);
+}
+
+static void display_sorted_int_pair_counter_map(
+    FILE* out,
+    const char* title,
+    const IntPairCounterMap& map,
+    int_pair_counter_lt_fcn lt_fcn,
+    display_name_fcn display_first_fcn,
+    display_name_fcn display_second_fcn,
+    const char* opcode_name) {
+  IntPairCounterVector vec;
+  for (const auto& pair : map)
+    vec.emplace_back(pair.first.first, pair.first.second, pair.second);
+  display_sorted_int_pair_counter_vector(out, title, vec, lt_fcn,
+                                         display_first_fcn, display_second_fcn,
+                                         opcode_name);
+}
+
+/* The counts of a file are only added to |opcnt_data| if the whole file was
+ * read. */
+static Result count_file(const char* filename,
+                         const ReadBinaryOptions* options,
+                         OpcntData* opcnt_data) {
+  MappedFile file;
+  Result result = map_file(filename, &file);
+  if (WABT_FAILED(result)) {
+    ERROR("Unable to parse: %s\n", filename);
+    return result;
+  }
+  OpcntData file_data;
+  result = read_binary_opcnt(file.data, file.size, options, &file_data);
+  if (WABT_SUCCEEDED(result))
+    merge_opcnt_data(opcnt_data, file_data);
+  unmap_file(&file);
+  return result;
+}
+
+static void count_files_thread(std::atomic<size_t>* next_file,
+                               const ReadBinaryOptions* options,
+                               OpcntData* opcnt_data,
+                               Result* out_result) {
+  while (true) {
+    size_t index = (*next_file)++;
+    if (index >= s_infiles.size())
+      break;
+    if (WABT_FAILED(count_file(s_infiles[index], options, opcnt_data)))
+      *out_result = Result::Error;
+  }
+}
+
+/* Each thread takes the next file to count, into its own OpcntData; they are
+ * added up at the end. A single file is split by function bodies instead. */
+static Result count_files(OpcntData* opcnt_data) {
+  ReadBinaryOptions options = s_read_binary_options;
+  size_t num_threads = 1;
+  if (s_infiles.size() == 1)
+    options.num_threads = s_jobs;
+  else if (!options.log_stream)
+    num_threads = std::min<size_t>(s_jobs, s_infiles.size());
+
+  std::vector<OpcntData> thread_data(num_threads);
+  std::vector<Result> thread_results(num_threads, Result::Ok);
+  std::atomic<size_t> next_file(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(count_files_thread, &next_file, &options,
+                         &thread_data[i], &thread_results[i]);
+  }
+  count_files_thread(&next_file, &options, &thread_data[0],
+                     &thread_results[0]);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  Result result = Result::Ok;
+  for (size_t i = 0; i < num_threads; ++i) {
+    merge_opcnt_data(opcnt_data, thread_data[i]);
+    if (WABT_FAILED(thread_results[i]))
+      result = Result::Error;
+  }
+  return result;
+}
+
 int main(int argc, char** argv) {
   init_stdio();
   parse_options(argc, argv);
 
-  char* data;
-  size_t size;
-  Result result = read_file(s_infile, &data, &size);
-  if (WABT_FAILED(result)) {
-    const char* input_name = s_infile ? s_infile : "stdin";
-    ERROR("Unable to parse: %s", input_name);
-    delete[] data;
-  }
   FILE* out = stdout;
   if (s_outfile) {
     out = fopen(s_outfile, "w");
-    if (!out)
+    if (!out) {
       ERROR("fopen \"%s\" failed, errno=%d\n", s_outfile, errno);
-    result = Result::Error;
-  }
-  if (WABT_SUCCEEDED(result)) {
-    OpcntData opcnt_data;
-    result = read_binary_opcnt(data, size, &s_read_binary_options, &opcnt_data);
-    if (WABT_SUCCEEDED(result)) {
-      display_sorted_int_counter_vector(
-          out, "Opcode counts:", opcnt_data.opcode_vec, opcode_counter_gt,
-          display_opcode_name, nullptr);
-      display_sorted_int_counter_vector(
-          out, "\ni32.const:", opcnt_data.i32_const_vec, int_counter_gt,
-          display_intmax, get_opcode_name(Opcode::I32Const));
-      display_sorted_int_counter_vector(
-          out, "\nget_local:", opcnt_data.get_local_vec, int_counter_gt,
-          display_intmax, get_opcode_name(Opcode::GetLocal));
-      display_sorted_int_counter_vector(
-          out, "\nset_local:", opcnt_data.set_local_vec, int_counter_gt,
-          display_intmax, get_opcode_name(Opcode::SetLocal));
-      display_sorted_int_counter_vector(
-          out, "\ntee_local:", opcnt_data.tee_local_vec, int_counter_gt,
-          display_intmax, get_opcode_name(Opcode::TeeLocal));
-      display_sorted_int_pair_counter_vector(
-          out, "\ni32.load:", opcnt_data.i32_load_vec, int_pair_counter_gt,
-          display_intmax, display_intmax, get_opcode_name(Opcode::I32Load));
-      display_sorted_int_pair_counter_vector(
-          out, "\ni32.store:", opcnt_data.i32_store_vec, int_pair_counter_gt,
-          display_intmax, display_intmax, get_opcode_name(Opcode::I32Store));
+      return 1;
     }
   }
-  delete[] data;
+
+  /* The counts of the files that were read are shown even if others
+   * failed. */
+  OpcntData opcnt_data;
+  Result result = count_files(&opcnt_data);
+  display_sorted_int_counter_vector(out, "Opcode counts:",
+                                    opcnt_data.opcode_vec, opcode_counter_gt,
+                                    display_opcode_name, nullptr);
+  display_sorted_int_counter_map(
+      out, "\ni32.const:", opcnt_data.i32_const_map, int_counter_gt,
+      display_intmax, get_opcode_name(Opcode::I32Const));
+  display_sorted_int_counter_map(
+      out, "\nget_local:", opcnt_data.get_local_map, int_counter_gt,
+      display_intmax, get_opcode_name(Opcode::GetLocal));
+  display_sorted_int_counter_map(
+      out, "\nset_local:", opcnt_data.set_local_map, int_counter_gt,
+      display_intmax, get_opcode_name(Opcode::SetLocal));
+  display_sorted_int_counter_map(
+      out, "\ntee_local:", opcnt_data.tee_local_map, int_counter_gt,
+      display_intmax, get_opcode_name(Opcode::TeeLocal));
+  display_sorted_int_pair_counter_map(
+      out, "\ni32.load:", opcnt_data.i32_load_map, int_pair_counter_gt,
+      display_intmax, display_intmax, get_opcode_name(Opcode::I32Load));
+  display_sorted_int_pair_counter_map(
+      out, "\ni32.store:", opcnt_data.i32_store_map, int_pair_counter_gt,
+      display_intmax, display_intmax, get_opcode_name(Opcode::I32Store));
+  if (s_outfile)
+    fclose(out);
   return result != Result::Ok;
 }
@@ -279,6 +279,17 @@ static Result check_opcode2(TypeChecker* tc, Opcode opcode) {
   return result;
 }
 
+static Result check_opcode3(TypeChecker* tc, Opcode opcode) {
+  /* the third operand of the bulk memory opcodes is always an i32 length */
+  const char* desc = get_opcode_name(opcode);
+  Result result = pop_and_check_1_type(tc, Type::I32, desc);
+  COMBINE_RESULT(result, pop_and_check_2_types(
+                             tc, get_opcode_param_type_1(opcode),
+                             get_opcode_param_type_2(opcode), desc));
+  push_type(tc, get_opcode_result_type(opcode));
+  return result;
+}
+
 Result typechecker_begin_function(TypeChecker* tc, const TypeVector* sig) {
   tc->type_stack.clear();
   tc->label_stack.clear();
@@ -456,6 +467,14 @@ Result typechecker_on_loop(TypeChecker* tc, const TypeVector* sig) {
   return Result::Ok;
 }
 
+Result typechecker_on_memory_copy(TypeChecker* tc) {
+  return check_opcode3(tc, Opcode::MemoryCopy);
+}
+
+Result typechecker_on_memory_fill(TypeChecker* tc) {
+  return check_opcode3(tc, Opcode::MemoryFill);
+}
+
 Result typechecker_on_return(TypeChecker* tc) {
   Result result = Result::Ok;
   TypeCheckerLabel* func_label;
@@ -80,6 +80,8 @@ Result typechecker_on_grow_memory(TypeChecker*);
 Result typechecker_on_if(TypeChecker*, const TypeVector* sig);
 Result typechecker_on_load(TypeChecker*, Opcode);
 Result typechecker_on_loop(TypeChecker*, const TypeVector* sig);
+Result typechecker_on_memory_copy(TypeChecker*);
+Result typechecker_on_memory_fill(TypeChecker*);
 Result typechecker_on_return(TypeChecker*);
 Result typechecker_on_select(TypeChecker*);
 Result typechecker_on_set_global(TypeChecker*, Type);
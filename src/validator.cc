@@ -463,6 +463,16 @@ static void check_expr(Context* ctx, const Expr* expr) {
       typechecker_on_current_memory(&ctx->typechecker);
       break;
 
+    case ExprType::MemoryCopy:
+      check_has_memory(ctx, &expr->loc, Opcode::MemoryCopy);
+      typechecker_on_memory_copy(&ctx->typechecker);
+      break;
+
+    case ExprType::MemoryFill:
+      check_has_memory(ctx, &expr->loc, Opcode::MemoryFill);
+      typechecker_on_memory_fill(&ctx->typechecker);
+      break;
+
     case ExprType::Nop:
       break;
 
@@ -99,10 +99,13 @@ typedef std::vector<Section*> SectionPtrVector;
 
 struct LinkerInputBinary {
   WABT_DISALLOW_COPY_AND_ASSIGN(LinkerInputBinary);
-  LinkerInputBinary(const char* filename, uint8_t* data, size_t size);
+  /* Takes over |file|, which must be writable: relocations are applied in
+   * place. */
+  LinkerInputBinary(const char* filename, const MappedFile& file);
   ~LinkerInputBinary();
 
   const char* filename;
+  MappedFile file;
   uint8_t* data;
   size_t size;
   std::vector<std::unique_ptr<Section>> sections;
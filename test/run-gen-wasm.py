@@ -47,6 +47,8 @@ def main(args):
                       help='print the commands that are run.')
   parser.add_argument('--no-debug-names', action='store_true')
   parser.add_argument('--generate-names', action='store_true')
+  parser.add_argument('-j', '--jobs', type=int,
+                      help='number of threads decoding function bodies.')
   parser.add_argument('file', help='test file.')
   options = parser.parse_args(args)
 
@@ -59,6 +61,7 @@ def main(args):
   wasm2wast.AppendOptionalArgs({
       '--no-debug-names': options.no_debug_names,
       '--generate-names': options.generate_names,
+      '--jobs': options.jobs,
   })
 
   gen_wasm.verbose = options.print_cmd
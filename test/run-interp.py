@@ -46,6 +46,19 @@ def main(args):
   parser.add_argument('--run-all-exports', action='store_true')
   parser.add_argument('--spec', action='store_true')
   parser.add_argument('-t', '--trace', action='store_true')
+  parser.add_argument('--aligned-istream', action='store_true')
+  parser.add_argument('--register-ops', action='store_true')
+  parser.add_argument('--tier-up', metavar='COUNT')
+  parser.add_argument('--map-data-segments', action='store_true')
+  parser.add_argument('--read-chunk-size', metavar='SIZE')
+  parser.add_argument('--suspend-host-calls', action='store_true')
+  parser.add_argument('-j', '--jobs', metavar='N')
+  parser.add_argument('--replay-host-calls',
+                      help='run once recording the host calls, then run '
+                      'again replaying them.', action='store_true')
+  parser.add_argument('--host-calls-log', metavar='HEX',
+                      help='replay the host calls from a log with these '
+                      'bytes, given in hex, without recording it first.')
   parser.add_argument('file', help='test file.')
   options = parser.parse_args(args)
 
@@ -65,6 +78,13 @@ def main(args):
       '--run-all-exports': options.run_all_exports,
       '--spec': options.spec,
       '--trace': options.trace,
+      '--aligned-istream': options.aligned_istream,
+      '--register-ops': options.register_ops,
+      '--tier-up': options.tier_up,
+      '--map-data-segments': options.map_data_segments,
+      '--read-chunk-size': options.read_chunk_size,
+      '--suspend-host-calls': options.suspend_host_calls,
+      '--jobs': options.jobs,
   })
 
   wast2wasm.verbose = options.print_cmd
@@ -74,7 +94,17 @@ def main(args):
     new_ext = '.json' if options.spec else '.wasm'
     out_file = utils.ChangeDir(utils.ChangeExt(options.file, new_ext), out_dir)
     wast2wasm.RunWithArgs(options.file, '-o', out_file)
-    wasm_interp.RunWithArgs(out_file)
+    if options.host_calls_log:
+      log_file = utils.ChangeExt(out_file, '.log')
+      with open(log_file, 'wb') as f:
+        f.write(bytearray.fromhex(options.host_calls_log))
+      wasm_interp.RunWithArgs(out_file, '--replay-host-calls=' + log_file)
+    elif options.replay_host_calls:
+      log_file = utils.ChangeExt(out_file, '.log')
+      wasm_interp.RunWithArgs(out_file, '--record-host-calls=' + log_file)
+      wasm_interp.RunWithArgs(out_file, '--replay-host-calls=' + log_file)
+    else:
+      wasm_interp.RunWithArgs(out_file)
 
   return 0
 
@@ -42,6 +42,11 @@ def main(args):
                       action='store_false')
   parser.add_argument('--print-cmd', help='print the commands that are run.',
                       action='store_true')
+  parser.add_argument('-j', '--jobs', type=int,
+                      help='number of threads counting the files, or the '
+                      'function bodies if there is only one.')
+  parser.add_argument('--spec', action='store_true',
+                      help='count all the modules of a spec test together.')
   parser.add_argument('file', help='test file.')
   options = parser.parse_args(args)
 
@@ -49,20 +54,33 @@ def main(args):
       find_exe.GetWast2WasmExecutable(options.bindir),
       error_cmdline=options.error_cmdline)
   wast2wasm.AppendOptionalArgs({
+      '--spec': options.spec,
       '-v': options.verbose,
   })
 
   wasmopcodecnt = utils.Executable(
       find_exe.GetWasmOpcodeCntExecutable(options.bindir),
       error_cmdline=options.error_cmdline)
+  wasmopcodecnt.AppendOptionalArgs({
+      '--jobs': options.jobs,
+  })
 
   wast2wasm.verbose = options.print_cmd
   wasmopcodecnt.verbose = options.print_cmd
 
   with utils.TempDirectory(options.out_dir, 'run-opcodecnt-') as out_dir:
-    out_file = utils.ChangeDir(utils.ChangeExt(options.file, '.wasm'), out_dir)
-    wast2wasm.RunWithArgs(options.file, '-o', out_file)
-    wasmopcodecnt.RunWithArgs(out_file)
+    if options.spec:
+      out_file = utils.ChangeDir(utils.ChangeExt(options.file, '.json'),
+                                 out_dir)
+      wast2wasm.RunWithArgs(options.file, '-o', out_file)
+      wasm_files = utils.GetModuleFilenamesFromSpecJSON(out_file)
+      wasm_files = [utils.ChangeDir(f, out_dir) for f in wasm_files]
+    else:
+      out_file = utils.ChangeDir(utils.ChangeExt(options.file, '.wasm'),
+                                 out_dir)
+      wast2wasm.RunWithArgs(options.file, '-o', out_file)
+      wasm_files = [out_file]
+    wasmopcodecnt.RunWithArgs(*wasm_files)
 
   return 0
 
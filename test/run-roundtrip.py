@@ -115,6 +115,8 @@ def main(args):
   parser.add_argument('--no-check', action='store_true')
   parser.add_argument('--debug-names', action='store_true')
   parser.add_argument('--generate-names', action='store_true')
+  parser.add_argument('-j', '--jobs', type=int,
+                      help='number of threads decoding function bodies.')
   parser.add_argument('file', help='test file.')
   options = parser.parse_args(args)
 
@@ -132,6 +134,7 @@ def main(args):
   wasm2wast.AppendOptionalArgs({
       '--no-debug-names': not options.debug_names,
       '--generate-names': options.generate_names,
+      '--jobs': options.jobs,
   })
 
   wast2wasm.verbose = options.print_cmd
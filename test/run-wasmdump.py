@@ -52,6 +52,8 @@ def main(args):
   parser.add_argument('--spec', action='store_true')
   parser.add_argument('--no-canonicalize-leb128s', action='store_true')
   parser.add_argument('--debug-names', action='store_true')
+  parser.add_argument('--section', metavar='NAME',
+                      help='only dump the details of this section.')
   parser.add_argument('file', help='test file.')
   options = parser.parse_args(args)
 
@@ -81,6 +83,9 @@ def main(args):
       '-x': options.dump_verbose,
       '--debug': options.dump_debug,
   })
+  if options.section:
+    wasmdump.AppendArg('-j')
+    wasmdump.AppendArg(options.section)
 
   gen_wasm.verbose = options.print_cmd
   wast2wasm.verbose = options.print_cmd